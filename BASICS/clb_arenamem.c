@@ -0,0 +1,620 @@
+/*-----------------------------------------------------------------------
+
+  File  : clb_arenamem.c
+
+  Contents
+
+  Slab-based, per-thread arena backend for SizeMalloc() and
+  SizeFree(). See clb_arenamem.h.
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 11:02:17 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#include <sys/mman.h>
+#include "clb_memory.h"
+
+#ifdef USE_ARENAMEM
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+/* The arena the calling thread allocates from. It is created lazily
+   by the first allocation of the thread. */
+
+__thread MemArena_p MemThreadArena = NULL;
+
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: arena_lock()/arena_unlock()
+//
+//   Acquire/release the spin lock protecting the list of large
+//   blocks of the arena. Large blocks are rare, so contention is not
+//   an issue.
+//
+// Global Variables: -
+//
+// Side Effects    : Synchronization
+//
+/----------------------------------------------------------------------*/
+
+static void arena_lock(MemArena_p arena)
+{
+   while(__atomic_test_and_set(&(arena->lock), __ATOMIC_ACQUIRE))
+   {
+      /* Spin */
+   }
+}
+
+static void arena_unlock(MemArena_p arena)
+{
+   __atomic_clear(&(arena->lock), __ATOMIC_RELEASE);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: arena_note_footprint()
+//
+//   Update the peak values of the arena.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static void arena_note_footprint(MemArena_p arena)
+{
+   arena->slab_peak      = MAX(arena->slab_peak, arena->slab_count);
+   arena->footprint_peak = MAX(arena->footprint_peak,
+                               MemArenaFootprint(arena));
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: arena_drain_remote()
+//
+//   Move all blocks returned to arena by other threads into the
+//   regular free lists.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes arena
+//
+/----------------------------------------------------------------------*/
+
+static void arena_drain_remote(MemArena_p arena)
+{
+   Mem_p handle, next;
+   long  cls;
+
+   if(!__atomic_load_n(&(arena->remote_free), __ATOMIC_RELAXED))
+   {
+      return;
+   }
+   handle = __atomic_exchange_n(&(arena->remote_free), NULL,
+                                __ATOMIC_ACQUIRE);
+   while(handle)
+   {
+      next = handle->next;
+      cls  = MemArenaSlab(handle)->cls;
+      assert(MemArenaSlab(handle)->arena == arena);
+      assert((handle->test = MEM_FREE_PATTERN));
+      handle->next = arena->free_list[cls];
+      arena->free_list[cls] = handle;
+      arena->live_bytes -= MemArenaCellSize(cls);
+      handle = next;
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: arena_slab_alloc()
+//
+//   Return a fresh, aligned slab for size class cls, registered with
+//   arena. Slabs are mapped directly, so that releasing them really
+//   returns the memory. If no memory is available, try to return
+//   empty slabs first, then fail with OUT_OF_MEMORY.
+//
+// Global Variables: MemIsLow
+//
+// Side Effects    : Memory operations, possibly error
+//
+/----------------------------------------------------------------------*/
+
+static MemSlab_p arena_slab_alloc(MemArena_p arena, long cls)
+{
+   char      *mem;
+   uintptr_t head;
+   MemSlab_p slab;
+
+   mem = mmap(NULL, 2*MEM_SLAB_SIZE, PROT_READ|PROT_WRITE,
+              MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+   if(UNLIKELY(mem == MAP_FAILED))
+   {
+      MemIsLow = true;
+      MemFlushFreeList();
+      mem = mmap(NULL, 2*MEM_SLAB_SIZE, PROT_READ|PROT_WRITE,
+                 MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+      if(mem == MAP_FAILED)
+      {
+#ifdef PRINT_SOMEERRORS_STDOUT
+         SetMemoryLimit(RLIM_INFINITY);
+         fprintf(stdout, COMCHAR" Failure: Resource limit exceeded (memory)\n");
+         TSTPOUT(stdout, "ResourceOut");
+         fflush(stdout);
+         PrintRusage(stdout);
+#endif
+         Error("Out of Memory", OUT_OF_MEMORY);
+      }
+   }
+   /* Trim the mapping to an aligned slab */
+   head = (MEM_SLAB_SIZE-((uintptr_t)mem&(MEM_SLAB_SIZE-1)))&(MEM_SLAB_SIZE-1);
+   if(head)
+   {
+      munmap(mem, head);
+   }
+   munmap(mem+head+MEM_SLAB_SIZE, MEM_SLAB_SIZE-head);
+   mem += head;
+
+   slab          = (MemSlab_p)mem;
+   slab->arena   = arena;
+   slab->cls     = cls;
+   slab->carved  = 0;
+   slab->scratch = 0;
+   slab->next    = arena->slabs;
+   arena->slabs  = slab;
+   arena->slab_count++;
+   arena_note_footprint(arena);
+
+   return slab;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: arena_release_empty_slabs()
+//
+//   Return all slabs to the operating system that contain no cell in
+//   use, and remove their cells from the free lists.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void arena_release_empty_slabs(MemArena_p arena)
+{
+   MemSlab_p slab, *anchor;
+   Mem_p     handle, *cell_anchor;
+   long      cls;
+
+   for(slab = arena->slabs; slab; slab = slab->next)
+   {
+      slab->scratch = 0;
+   }
+   for(cls = 0; cls < MEM_ARENA_CLASSES; cls++)
+   {
+      for(handle = arena->free_list[cls]; handle; handle = handle->next)
+      {
+         MemArenaSlab(handle)->scratch++;
+      }
+   }
+   /* Mark empty slabs with scratch == -1 */
+   for(slab = arena->slabs; slab; slab = slab->next)
+   {
+      slab->scratch = (slab->scratch == slab->carved)?-1:0;
+   }
+   for(cls = 0; cls < MEM_ARENA_CLASSES; cls++)
+   {
+      cell_anchor = &(arena->free_list[cls]);
+      while(*cell_anchor)
+      {
+         if(MemArenaSlab(*cell_anchor)->scratch == -1)
+         {
+            *cell_anchor = (*cell_anchor)->next;
+         }
+         else
+         {
+            cell_anchor = &((*cell_anchor)->next);
+         }
+      }
+      if(arena->bump_slab[cls] && arena->bump_slab[cls]->scratch == -1)
+      {
+         arena->bump[cls]      = NULL;
+         arena->bump_slab[cls] = NULL;
+      }
+   }
+   anchor = &(arena->slabs);
+   while(*anchor)
+   {
+      slab = *anchor;
+      if(slab->scratch == -1)
+      {
+         *anchor = slab->next;
+         munmap(slab, MEM_SLAB_SIZE);
+         arena->slab_count--;
+      }
+      else
+      {
+         anchor = &(slab->next);
+      }
+   }
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: MemArenaAlloc()
+//
+//   Return a new, empty arena.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+MemArena_p MemArenaAlloc(void)
+{
+   MemArena_p handle = SecureMalloc(sizeof(MemArenaCell));
+
+   memset(handle, 0, sizeof(MemArenaCell));
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: MemArenaFree()
+//
+//   Release all memory of the arena and the arena itself. The arena
+//   must not be the current arena of any thread.
+//
+// Global Variables: MemThreadArena
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void MemArenaFree(MemArena_p junk)
+{
+   assert(junk != MemThreadArena);
+
+   MemArenaReset(junk);
+   FREE(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: MemArenaReset()
+//
+//   Release all memory allocated from arena in one go, no matter if
+//   it is still in use or not. All blocks from the arena become
+//   invalid. This is meant for tearing down complete data structures
+//   (e.g. a proof state) that have been built with the arena selected.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void MemArenaReset(MemArena_p arena)
+{
+   MemSlab_p  slab;
+   MemLarge_p large;
+
+   while(arena->slabs)
+   {
+      slab = arena->slabs;
+      arena->slabs = slab->next;
+      munmap(slab, MEM_SLAB_SIZE);
+   }
+   arena_lock(arena);
+   while(arena->large)
+   {
+      large = arena->large;
+      arena->large = large->next;
+      free(large);
+   }
+   arena_unlock(arena);
+
+   memset(arena->free_list, 0, sizeof(arena->free_list));
+   memset(arena->bump, 0, sizeof(arena->bump));
+   memset(arena->bump_slab, 0, sizeof(arena->bump_slab));
+   arena->remote_free = NULL;
+   arena->slab_count  = 0;
+   arena->large_bytes = 0;
+   arena->live_bytes  = 0;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: MemArenaSelect()
+//
+//   Make arena the current arena of the calling thread and return the
+//   previous one (which may be NULL).
+//
+// Global Variables: MemThreadArena
+//
+// Side Effects    : Changes where SizeMalloc() takes memory from
+//
+/----------------------------------------------------------------------*/
+
+MemArena_p MemArenaSelect(MemArena_p arena)
+{
+   MemArena_p old = MemThreadArena;
+
+   MemThreadArena = arena;
+
+   return old;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: MemArenaThreadInit()
+//
+//   Give the calling thread an arena (if it does not have one yet)
+//   and return it.
+//
+// Global Variables: MemThreadArena
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+MemArena_p MemArenaThreadInit(void)
+{
+   if(!MemThreadArena)
+   {
+      MemThreadArena = MemArenaAlloc();
+   }
+   return MemThreadArena;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: MemArenaFlush()
+//
+//   Collect blocks freed by other threads and return all slabs
+//   without live cells to the operating system.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void MemArenaFlush(MemArena_p arena)
+{
+   arena_drain_remote(arena);
+   arena_release_empty_slabs(arena);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: MemArenaRefill()
+//
+//   Slow path of ArenaMallocReal(): Return a cell of size class cls
+//   from the blocks freed by other threads, or carve it from the
+//   current slab of the class, or from a new slab.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void* MemArenaRefill(MemArena_p arena, long cls)
+{
+   Mem_p     handle;
+   MemSlab_p slab;
+   long      cell_size = MemArenaCellSize(cls);
+
+   arena_drain_remote(arena);
+   if(arena->free_list[cls])
+   {
+      handle = arena->free_list[cls];
+      arena->free_list[cls] = handle->next;
+   }
+   else
+   {
+      slab = arena->bump_slab[cls];
+      if(!slab ||
+         arena->bump[cls]+cell_size > (char*)slab+MEM_SLAB_SIZE)
+      {
+         slab = arena_slab_alloc(arena, cls);
+         arena->bump_slab[cls] = slab;
+         arena->bump[cls]      = (char*)slab+MEM_SLAB_HEADER;
+      }
+      handle = (Mem_p)arena->bump[cls];
+      arena->bump[cls] += cell_size;
+      slab->carved++;
+   }
+   assert((handle->test = MEM_RSET_PATTERN, true));
+   arena->live_bytes += cell_size;
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: MemArenaLargeMalloc()
+//
+//   Return a block too large for the slabs. It is taken from
+//   malloc(), but registered with the arena.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void* MemArenaLargeMalloc(MemArena_p arena, size_t size)
+{
+   MemLarge_p handle = SecureMalloc(sizeof(MemLargeCell)+size);
+
+   handle->arena = arena;
+   handle->size  = size;
+   handle->prev  = NULL;
+
+   arena_lock(arena);
+   handle->next  = arena->large;
+   if(arena->large)
+   {
+      arena->large->prev = handle;
+   }
+   arena->large = handle;
+   arena->large_bytes += size;
+   arena_note_footprint(arena);
+   arena_unlock(arena);
+
+   return handle+1;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: MemArenaLargeFree()
+//
+//   Return a block allocated with MemArenaLargeMalloc(). This may
+//   happen from any thread.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void MemArenaLargeFree(void* junk)
+{
+   MemLarge_p handle = ((MemLarge_p)junk)-1;
+   MemArena_p arena  = handle->arena;
+
+   arena_lock(arena);
+   if(handle->prev)
+   {
+      handle->prev->next = handle->next;
+   }
+   else
+   {
+      arena->large = handle->next;
+   }
+   if(handle->next)
+   {
+      handle->next->prev = handle->prev;
+   }
+   arena->large_bytes -= handle->size;
+   arena_unlock(arena);
+
+   FREE(handle);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: MemArenaRemoteFree()
+//
+//   Return a small block to an arena that is not the current arena of
+//   the calling thread. The block is pushed onto a lock-free list
+//   that the owner collects on its next slow-path allocation.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, synchronization
+//
+/----------------------------------------------------------------------*/
+
+void MemArenaRemoteFree(MemArena_p arena, void* junk)
+{
+   Mem_p cell = junk;
+   Mem_p head = __atomic_load_n(&(arena->remote_free), __ATOMIC_RELAXED);
+
+   do
+   {
+      cell->next = head;
+   }
+   while(!__atomic_compare_exchange_n(&(arena->remote_free), &head, cell,
+                                      true, __ATOMIC_RELEASE,
+                                      __ATOMIC_RELAXED));
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: MemArenaPrintStats()
+//
+//   Print size, peak size and fragmentation of arena (or the current
+//   arena of the calling thread, if arena is NULL). Fragmentation is
+//   the fraction of slab memory not occupied by cells in use.
+//
+// Global Variables: MemThreadArena
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+void MemArenaPrintStats(FILE* out, MemArena_p arena)
+{
+   long slab_bytes;
+
+   if(!arena)
+   {
+      arena = MemThreadArena;
+   }
+   if(!arena)
+   {
+      return;
+   }
+   arena_drain_remote(arena);
+   slab_bytes = arena->slab_count*MEM_SLAB_SIZE;
+
+   fprintf(out, COMCHAR" Arena slabs (current/peak)           : %ld/%ld\n",
+           arena->slab_count, arena->slab_peak);
+   fprintf(out, COMCHAR" Arena large block memory             : %ld\n",
+           arena->large_bytes);
+   fprintf(out, COMCHAR" Arena memory footprint (current/peak): %ld/%ld\n",
+           MemArenaFootprint(arena), arena->footprint_peak);
+   fprintf(out, COMCHAR" Arena slab fragmentation             : %5.2f%%\n",
+           slab_bytes?100.0*(slab_bytes-arena->live_bytes)/slab_bytes:0.0);
+}
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
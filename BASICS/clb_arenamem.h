@@ -0,0 +1,217 @@
+/*-----------------------------------------------------------------------
+
+  File  : clb_arenamem.h
+
+  Contents
+
+  Alternative backend for SizeMalloc()/SizeFree(), selected with
+  USE_ARENAMEM. Small blocks are rounded up to a multiple of
+  MEM_ARENA_ALIGN and cut from slabs of MEM_SLAB_SIZE bytes, each
+  slab serving only one size class. Slabs belong to an arena, and
+  each thread allocates from its own (current) arena, so that the
+  fast paths need no locking. Blocks returned by a different thread
+  are handed back to the owning arena via a lock-free list. Arenas
+  can be switched, flushed (empty slabs are returned to the
+  operating system) and reset as a whole.
+
+  Larger blocks are taken from malloc(), but are still registered
+  with the arena, so that a reset returns them as well.
+
+  This file is only included from clb_memory.h.
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 11:02:17 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#ifndef CLB_ARENAMEM
+
+#define CLB_ARENAMEM
+
+#include <stdint.h>
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+#define MEM_ARENA_ALIGN     16
+#define MEM_ARENA_MAX_SMALL 1024  /* Larger blocks bypass the slabs */
+#define MEM_ARENA_CLASSES   (MEM_ARENA_MAX_SMALL/MEM_ARENA_ALIGN+1)
+#define MEM_SLAB_SIZE       65536 /* Power of 2, slabs are aligned to it */
+
+struct memarena;
+
+typedef struct memslab
+{
+   struct memarena *arena;   /* Owner */
+   struct memslab  *next;    /* All slabs of the arena */
+   long            cls;      /* Size class of all cells in the slab */
+   long            carved;   /* Cells handed out at least once */
+   long            scratch;  /* Free cells, only during flushing */
+}MemSlabCell, *MemSlab_p;
+
+typedef struct memlarge
+{
+   struct memlarge *prev;
+   struct memlarge *next;
+   struct memarena *arena;
+   size_t          size;
+}MemLargeCell, *MemLarge_p;
+
+typedef struct memarena
+{
+   Mem_p     free_list[MEM_ARENA_CLASSES];
+   char      *bump[MEM_ARENA_CLASSES];      /* Next uncarved cell */
+   MemSlab_p bump_slab[MEM_ARENA_CLASSES];  /* ...and its slab */
+   Mem_p     remote_free;  /* Blocks freed by other threads */
+   MemSlab_p slabs;
+   MemLarge_p large;       /* Doubly linked, protected by lock */
+   int       lock;
+   long      slab_count;
+   long      slab_peak;
+   long      large_bytes;  /* Only modified under lock */
+   long      live_bytes;   /* Small cells handed out, rounded */
+   long      footprint_peak;
+}MemArenaCell, *MemArena_p;
+
+#define MEM_SLAB_HEADER ((sizeof(MemSlabCell)+MEM_ARENA_ALIGN-1)&\
+                         ~(size_t)(MEM_ARENA_ALIGN-1))
+
+#define MemArenaClass(size)     (((size)+MEM_ARENA_ALIGN-1)/MEM_ARENA_ALIGN)
+#define MemArenaCellSize(cls)   ((cls)?(cls)*MEM_ARENA_ALIGN:MEM_ARENA_ALIGN)
+#define MemArenaSlab(ptr)       ((MemSlab_p)((uintptr_t)(ptr)&\
+                                 ~(uintptr_t)(MEM_SLAB_SIZE-1)))
+#define MemArenaFootprint(arena) ((arena)->slab_count*MEM_SLAB_SIZE+\
+                                  (arena)->large_bytes)
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+extern __thread MemArena_p MemThreadArena;
+
+MemArena_p MemArenaAlloc(void);
+void       MemArenaFree(MemArena_p junk);
+void       MemArenaReset(MemArena_p arena);
+MemArena_p MemArenaSelect(MemArena_p arena);
+MemArena_p MemArenaThreadInit(void);
+void       MemArenaFlush(MemArena_p arena);
+
+void*      MemArenaRefill(MemArena_p arena, long cls);
+void*      MemArenaLargeMalloc(MemArena_p arena, size_t size);
+void       MemArenaLargeFree(void* junk);
+void       MemArenaRemoteFree(MemArena_p arena, void* junk);
+
+void       MemArenaPrintStats(FILE* out, MemArena_p arena);
+
+static inline void* ArenaMallocReal(size_t size);
+static inline void  ArenaFreeReal(void* junk, size_t size);
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ArenaMallocReal()
+//
+//   Return a block of memory sized size from the current arena of
+//   the calling thread. Contrary to SizeMallocReal(), the block
+//   cannot be given to free().
+//
+// Global Variables: MemThreadArena
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static inline void* ArenaMallocReal(size_t size)
+{
+   MemArena_p arena = MemThreadArena;
+   Mem_p      handle;
+   long       cls;
+
+   if(UNLIKELY(!arena))
+   {
+      arena = MemArenaThreadInit();
+   }
+   if(UNLIKELY(size > MEM_ARENA_MAX_SMALL))
+   {
+      return MemArenaLargeMalloc(arena, size);
+   }
+   cls    = MemArenaClass(size);
+   handle = arena->free_list[cls];
+   if(handle)
+   {
+      assert(handle->test == MEM_FREE_PATTERN);
+      assert((handle->test = MEM_RSET_PATTERN, true));
+      arena->free_list[cls] = handle->next;
+      arena->live_bytes += MemArenaCellSize(cls);
+   }
+   else
+   {
+      handle = MemArenaRefill(arena, cls);
+   }
+#ifdef CLB_MEMORY_DEBUG
+   size_malloc_mem+=size;
+   size_malloc_count++;
+#endif
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ArenaFreeReal()
+//
+//   Return a block sized size to the arena it was allocated
+//   from. As with SizeFreeReal(), size has to be exact.
+//
+// Global Variables: MemThreadArena
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static inline void ArenaFreeReal(void* junk, size_t size)
+{
+   MemArena_p arena;
+   long       cls;
+
+   assert(junk!=NULL);
+
+#ifdef CLB_MEMORY_DEBUG
+   size_free_mem+=size;
+   size_free_count++;
+#endif
+   if(UNLIKELY(size > MEM_ARENA_MAX_SMALL))
+   {
+      MemArenaLargeFree(junk);
+      return;
+   }
+   cls   = MemArenaClass(size);
+   arena = MemArenaSlab(junk)->arena;
+   assert(MemArenaSlab(junk)->cls == cls);
+
+   if(LIKELY(arena == MemThreadArena))
+   {
+      assert(((Mem_p)junk)->test != MEM_FREE_PATTERN);
+      assert((((Mem_p)junk)->test = MEM_FREE_PATTERN));
+      ((Mem_p)junk)->next   = arena->free_list[cls];
+      arena->free_list[cls] = (Mem_p)junk;
+      arena->live_bytes    -= MemArenaCellSize(cls);
+   }
+   else
+   {
+      MemArenaRemoteFree(arena, junk);
+   }
+}
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
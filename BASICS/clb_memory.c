@@ -102,9 +102,10 @@ static long free_list_size(Mem_p list)
 //   Returns all memory kept in free_mem_list[] to the operation
 //   system. This is useful if a very different memory access pattern
 //   is expected (SizeFree() never reorganizes the memory
-//   automatically).
+//   automatically). With USE_ARENAMEM, return the empty slabs of
+//   the current arena instead.
 //
-// Global Variables: free_mem_list[]
+// Global Variables: free_mem_list[], MemThreadArena
 //
 // Side Effects    : Memory operations
 //
@@ -125,6 +126,12 @@ void MemFlushFreeList(void)
          FREE(handle);
       }
    }
+#ifdef USE_ARENAMEM
+   if(MemThreadArena)
+   {
+      MemArenaFlush(MemThreadArena);
+   }
+#endif
 }
 
 
@@ -87,6 +87,18 @@ static inline void  SizeFreeReal(void* junk, size_t size);
 #define ENSURE_NULL(junk) /* Only defined in debug mode */
 #endif
 
+#elif defined(USE_ARENAMEM)
+
+#ifndef NDEBUG
+#define SizeFree(junk, size) ArenaFreeReal(junk, size); junk=NULL
+#define SizeMalloc(size)     ArenaMallocReal(size)
+#define ENSURE_NULL(junk)    junk=NULL
+#else
+#define SizeFree(junk, size) ArenaFreeReal(junk, size);
+#define SizeMalloc(size)     ArenaMallocReal(size)
+#define ENSURE_NULL(junk) /* Only defined in debug mode */
+#endif
+
 #else
 
 #ifndef NDEBUG
@@ -134,6 +146,10 @@ void MemFreeListPrint(FILE* out);
    free(junk); junk=NULL
 #endif
 
+#ifdef USE_ARENAMEM
+#include <clb_arenamem.h>
+#endif
+
 /*-------------------------------------------------------------------------
   If you want to have a special Allocator and Deallocator for a
   datatype just copy the following templates to your .h-file and fill
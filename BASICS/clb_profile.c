@@ -0,0 +1,381 @@
+/*-----------------------------------------------------------------------
+
+  File  : clb_profile.c
+
+  Contents
+
+  Hierarchical self-profiling: Scope tables, sampling and output.
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sun Oct 18 10:12:40 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#include <sys/time.h>
+#include "clb_profile.h"
+#include "clb_os_wrapper.h"
+
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+/* Parents have to come before their children. */
+
+const ProfScope ProfScopeParent[] =
+{
+   ProfOther,            /* ProfOther (root) */
+   ProfOther,            /* ProfSaturate */
+   ProfSaturate,         /* ProfSelect */
+   ProfSaturate,         /* ProfForwardContract */
+   ProfSaturate,         /* ProfBackwardSimplify */
+   ProfSaturate,         /* ProfGenerate */
+   ProfSaturate,         /* ProfInsert */
+   ProfInsert            /* ProfEvaluate */
+};
+
+static char* prof_scope_names[] =
+{
+   "other",
+   "saturate",
+   "select",
+   "forward_contract",
+   "backward_simplify",
+   "generate",
+   "insert",
+   "evaluate"
+};
+
+static char* prof_counter_names[] =
+{
+   "pdt_searches",
+   "pdt_visits",
+   "pdt_hits",
+   "fp_searches",
+   "fp_visits",
+   "fp_hits",
+   "fv_searches",
+   "fv_visits",
+   "fv_hits"
+};
+
+volatile sig_atomic_t ProfCurrentScope = ProfOther;
+ProfTick_t            ProfScopeStart[ProfScopeCount];
+ProfTick_t            ProfScopeTicks[ProfScopeCount];
+ProfTick_t            ProfScopeChildTicks[ProfScopeCount];
+unsigned long         ProfScopeCalls[ProfScopeCount];
+unsigned long         ProfCounters[ProfCounterCount];
+
+static volatile unsigned long prof_samples[ProfScopeCount];
+static long                   prof_sample_interval = 0;
+static ProfTick_t             prof_start_ticks = 0;
+static long long              prof_start_usec = 0;
+
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: prof_sample_handler()
+//
+//   SIGPROF handler: Count a sample for the current scope.
+//
+// Global Variables: ProfCurrentScope, prof_samples
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static void prof_sample_handler(int sig)
+{
+   prof_samples[ProfCurrentScope]++;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prof_collect()
+//
+//   Compute inclusive and self ticks and samples for all scopes. The
+//   root gets the total time since ProfInit() as its inclusive time.
+//   Return the number of ticks per microsecond (0 if unknown).
+//
+// Global Variables: ProfScope*, prof_*
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static double prof_collect(ProfTick_t *ticks, ProfTick_t *self_ticks,
+                           unsigned long *samples,
+                           unsigned long *self_samples)
+{
+   ProfTick_t total = ProfTicks()-prof_start_ticks;
+   long long  usec  = GetUSecTime()-prof_start_usec;
+   int        i;
+
+   for(i=0; i<ProfScopeCount; i++)
+   {
+      ticks[i]        = i==ProfOther?total:ProfScopeTicks[i];
+      self_ticks[i]   = ticks[i]>ProfScopeChildTicks[i]?
+         ticks[i]-ProfScopeChildTicks[i]:0;
+      self_samples[i] = prof_samples[i];
+      samples[i]      = prof_samples[i];
+   }
+   for(i=ProfScopeCount-1; i>ProfOther; i--)
+   {
+      samples[ProfScopeParent[i]] += samples[i];
+   }
+   return usec>0?(double)total/usec:0.0;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProfInit()
+//
+//   Reset all profiling data and start the clock of the root scope.
+//
+// Global Variables: ProfScope*, ProfCounters, prof_*
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+void ProfInit(void)
+{
+   int i;
+
+   for(i=0; i<ProfScopeCount; i++)
+   {
+      ProfScopeStart[i]      = 0;
+      ProfScopeTicks[i]      = 0;
+      ProfScopeChildTicks[i] = 0;
+      ProfScopeCalls[i]      = 0;
+      prof_samples[i]        = 0;
+   }
+   for(i=0; i<ProfCounterCount; i++)
+   {
+      ProfCounters[i] = 0;
+   }
+   ProfCurrentScope  = ProfOther;
+   ProfScopeCalls[ProfOther] = 1;
+   prof_start_usec   = GetUSecTime();
+   prof_start_ticks  = ProfTicks();
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProfSamplingStart()
+//
+//   Start sampling the current scope every interval microseconds of
+//   CPU time. Interval timers are not inherited by fork(), so this
+//   needs to be called in the process doing the actual search. Return
+//   success.
+//
+// Global Variables: prof_sample_interval
+//
+// Side Effects    : Installs a SIGPROF handler, starts a timer
+//
+/----------------------------------------------------------------------*/
+
+bool ProfSamplingStart(long interval)
+{
+   struct sigaction act;
+   struct itimerval timer;
+
+   assert(interval > 0);
+
+   act.sa_handler = prof_sample_handler;
+   sigemptyset(&act.sa_mask);
+   act.sa_flags = SA_RESTART;
+   if(sigaction(SIGPROF, &act, NULL))
+   {
+      return false;
+   }
+   timer.it_interval.tv_sec  = interval/1000000;
+   timer.it_interval.tv_usec = interval%1000000;
+   timer.it_value            = timer.it_interval;
+   if(setitimer(ITIMER_PROF, &timer, NULL))
+   {
+      return false;
+   }
+   prof_sample_interval = interval;
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProfSamplingStop()
+//
+//   Stop the sampling timer (if any).
+//
+// Global Variables: prof_sample_interval
+//
+// Side Effects    : Stops the timer
+//
+/----------------------------------------------------------------------*/
+
+void ProfSamplingStop(void)
+{
+   struct itimerval timer;
+
+   if(prof_sample_interval)
+   {
+      timer.it_interval.tv_sec  = 0;
+      timer.it_interval.tv_usec = 0;
+      timer.it_value            = timer.it_interval;
+      setitimer(ITIMER_PROF, &timer, NULL);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProfPrintJSON()
+//
+//   Print the profile as a JSON object. Times (and the seconds
+//   derived from them via the measured clock rate) are only available
+//   with INSTRUMENT_PROFILE, samples only if sampling was active.
+//
+// Global Variables: ProfScope*, ProfCounters, prof_*
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+void ProfPrintJSON(FILE* out)
+{
+   ProfTick_t    ticks[ProfScopeCount], self_ticks[ProfScopeCount];
+   unsigned long samples[ProfScopeCount], self_samples[ProfScopeCount];
+   double        rate = prof_collect(ticks, self_ticks, samples, self_samples);
+   int           i;
+#ifdef INSTRUMENT_PROFILE
+   bool          timing = true;
+#else
+   bool          timing = false;
+#endif
+
+   fprintf(out, "{\n  \"timing\": %s,\n", timing?"true":"false");
+   fprintf(out, "  \"ticks_per_usec\": %.3f,\n", rate);
+   fprintf(out, "  \"sample_interval_usec\": %ld,\n", prof_sample_interval);
+   fprintf(out, "  \"scopes\": [\n");
+   for(i=0; i<ProfScopeCount; i++)
+   {
+      fprintf(out,
+              "    {\"name\": \"%s\", \"parent\": %s%s%s, \"calls\": %lu, "
+              "\"ticks\": %llu, \"self_ticks\": %llu, "
+              "\"seconds\": %.6f, \"self_seconds\": %.6f, "
+              "\"samples\": %lu, \"self_samples\": %lu}%s\n",
+              prof_scope_names[i],
+              i==ProfOther?"":"\"",
+              i==ProfOther?"null":prof_scope_names[ProfScopeParent[i]],
+              i==ProfOther?"":"\"",
+              ProfScopeCalls[i],
+              ticks[i], self_ticks[i],
+              rate>0.0?ticks[i]/rate/1000000.0:0.0,
+              rate>0.0?self_ticks[i]/rate/1000000.0:0.0,
+              samples[i], self_samples[i],
+              i==ProfScopeCount-1?"":",");
+   }
+   fprintf(out, "  ],\n  \"counters\": {\n");
+   for(i=0; i<ProfCounterCount; i++)
+   {
+      fprintf(out, "    \"%s\": %lu%s\n", prof_counter_names[i],
+              ProfCounters[i], i==ProfCounterCount-1?"":",");
+   }
+   fprintf(out, "  }\n}\n");
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProfPrintCSV()
+//
+//   Print the profile as CSV, one line per scope and one per
+//   counter (see ProfPrintJSON() for the meaning of the fields).
+//
+// Global Variables: ProfScope*, ProfCounters, prof_*
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+void ProfPrintCSV(FILE* out)
+{
+   ProfTick_t    ticks[ProfScopeCount], self_ticks[ProfScopeCount];
+   unsigned long samples[ProfScopeCount], self_samples[ProfScopeCount];
+   double        rate = prof_collect(ticks, self_ticks, samples, self_samples);
+   int           i;
+
+   fprintf(out, "kind,name,parent,calls,ticks,self_ticks,seconds,"
+           "self_seconds,samples,self_samples,value\n");
+   for(i=0; i<ProfScopeCount; i++)
+   {
+      fprintf(out, "scope,%s,%s,%lu,%llu,%llu,%.6f,%.6f,%lu,%lu,\n",
+              prof_scope_names[i],
+              i==ProfOther?"":prof_scope_names[ProfScopeParent[i]],
+              ProfScopeCalls[i],
+              ticks[i], self_ticks[i],
+              rate>0.0?ticks[i]/rate/1000000.0:0.0,
+              rate>0.0?self_ticks[i]/rate/1000000.0:0.0,
+              samples[i], self_samples[i]);
+   }
+   for(i=0; i<ProfCounterCount; i++)
+   {
+      fprintf(out, "counter,%s,,,,,,,,,%lu\n", prof_counter_names[i],
+              ProfCounters[i]);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProfDump()
+//
+//   Stop sampling and print the profile to out, as CSV or JSON.
+//
+// Global Variables: -
+//
+// Side Effects    : Output, stops the sampling timer
+//
+/----------------------------------------------------------------------*/
+
+void ProfDump(FILE* out, bool csv)
+{
+   ProfSamplingStop();
+   if(csv)
+   {
+      ProfPrintCSV(out);
+   }
+   else
+   {
+      ProfPrintJSON(out);
+   }
+   fflush(out);
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -0,0 +1,209 @@
+/*-----------------------------------------------------------------------
+
+  File  : clb_profile.h
+
+  Contents
+
+  Hierarchical self-profiling of the proof search. The given-clause
+  loop is split into a fixed tree of scopes (select, forward
+  contraction, backward simplification, generation, insertion and
+  evaluation). There are two independent ways to attribute time to
+  them:
+
+  - With INSTRUMENT_PROFILE, every scope entry and exit reads a cheap
+    cycle counter (rdtsc on x86, a monotonic clock elsewhere), and
+    inclusive and self times per scope are accumulated exactly. The
+    same flag enables a set of event counters (searches, node visits
+    and hits for the PDT, FP and FV indices).
+
+  - Without it, entering and leaving a scope only records the current
+    scope in a global variable. A SIGPROF interval timer
+    (ProfSamplingStart()) then counts in which scope the process is
+    found. This is cheap enough to be left on in production runs.
+
+  The results can be written in JSON or CSV form with ProfDump().
+
+  Scopes have a fixed parent, and a scope can only be entered from
+  its parent. This keeps the macros trivial (no stack is needed).
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sun Oct 18 10:12:40 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#ifndef CLB_PROFILE
+
+#define CLB_PROFILE
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <signal.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+/* The scope tree (see ProfScopeParent[] for the structure). ProfOther
+   is the root and covers everything outside the proof search
+   proper. */
+
+typedef enum
+{
+   ProfOther = 0,
+   ProfSaturate,         /* The given-clause loop */
+   ProfSelect,           /* Picking the given clause */
+   ProfForwardContract,  /* Simplification of the given clause */
+   ProfBackwardSimplify, /* Interreduction with the given clause */
+   ProfGenerate,         /* Generating inferences */
+   ProfInsert,           /* Simplification and insertion of new clauses */
+   ProfEvaluate,         /* Heuristic evaluation of new clauses */
+   ProfScopeCount        /* Must be last */
+}ProfScope;
+
+typedef enum
+{
+   ProfPDTSearches = 0, /* Demodulator searches in PDTs */
+   ProfPDTVisits,       /* Nodes visited by these */
+   ProfPDTHits,         /* Candidate demodulators returned */
+   ProfFPSearches,      /* Unification/matching queries to FP indices */
+   ProfFPVisits,        /* Index nodes visited by these */
+   ProfFPHits,          /* Candidate leaves returned */
+   ProfFVSearches,      /* Forward and backward FV subsumption queries */
+   ProfFVVisits,        /* Trie nodes or flat blocks inspected */
+   ProfFVHits,          /* Subsuming/subsumed clauses found */
+   ProfCounterCount     /* Must be last */
+}ProfCounter;
+
+typedef unsigned long long ProfTick_t;
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+extern volatile sig_atomic_t ProfCurrentScope;
+extern const ProfScope       ProfScopeParent[];
+extern ProfTick_t            ProfScopeStart[];
+extern ProfTick_t            ProfScopeTicks[];
+extern ProfTick_t            ProfScopeChildTicks[];
+extern unsigned long         ProfScopeCalls[];
+extern unsigned long         ProfCounters[];
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ProfTicks() ((ProfTick_t)__rdtsc())
+#else
+static inline ProfTick_t ProfTicks(void);
+#endif
+
+static inline void ProfScopeEnter(ProfScope scope);
+static inline void ProfScopeExit(ProfScope scope);
+
+#ifdef INSTRUMENT_PROFILE
+#define PROF_SCOPE_ENTER(scope) ProfScopeEnter(scope)
+#define PROF_SCOPE_EXIT(scope)  ProfScopeExit(scope)
+#define PROF_COUNT(ctr)         (ProfCounters[ctr]++)
+#define PROF_COUNT_ADD(ctr, n)  (ProfCounters[ctr]+=(n))
+#else
+#define PROF_SCOPE_ENTER(scope) (ProfCurrentScope = (scope))
+#define PROF_SCOPE_EXIT(scope)  (ProfCurrentScope = ProfScopeParent[scope])
+#define PROF_COUNT(ctr)
+#define PROF_COUNT_ADD(ctr, n)
+#endif
+
+void ProfInit(void);
+bool ProfSamplingStart(long interval);
+void ProfSamplingStop(void);
+void ProfPrintJSON(FILE* out);
+void ProfPrintCSV(FILE* out);
+void ProfDump(FILE* out, bool csv);
+
+
+/*---------------------------------------------------------------------*/
+/*                     Inline Functions                                */
+/*---------------------------------------------------------------------*/
+
+#if !defined(__x86_64__) && !defined(__i386__)
+/*-----------------------------------------------------------------------
+//
+// Function: ProfTicks()
+//
+//   Return the current value of the profiling clock (here in
+//   nanoseconds).
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline ProfTick_t ProfTicks(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (ProfTick_t)ts.tv_sec*1000000000ULL+ts.tv_nsec;
+}
+#endif
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProfScopeEnter()
+//
+//   Enter scope (from its parent) and start its clock.
+//
+// Global Variables: ProfCurrentScope, ProfScopeStart
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline void ProfScopeEnter(ProfScope scope)
+{
+   assert(ProfCurrentScope == ProfScopeParent[scope]);
+   ProfCurrentScope = scope;
+   ProfScopeStart[scope] = ProfTicks();
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ProfScopeExit()
+//
+//   Leave scope and account for the time spent in it (for itself and
+//   as child time for its parent).
+//
+// Global Variables: ProfCurrentScope, ProfScope*
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline void ProfScopeExit(ProfScope scope)
+{
+   ProfTick_t ticks = ProfTicks()-ProfScopeStart[scope];
+
+   assert(ProfCurrentScope == scope);
+   ProfScopeTicks[scope] += ticks;
+   ProfScopeChildTicks[ProfScopeParent[scope]] += ticks;
+   ProfScopeCalls[scope]++;
+   ProfCurrentScope = ProfScopeParent[scope];
+}
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -340,6 +340,44 @@ long ComputeGCD(long a, long b)
 
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: MemHash64()
+//
+//   Compute a 64 bit hash of len bytes at mem, processing 8 bytes at
+//   a time. This is fast enough to hash large input files, but of
+//   course not cryptographically secure.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+uint64_t MemHash64(const void* mem, size_t len, uint64_t seed)
+{
+   const unsigned char *p = mem;
+   uint64_t            h = seed^(len*0x9e3779b97f4a7c15ULL), w;
+
+   while(len >= sizeof(w))
+   {
+      memcpy(&w, p, sizeof(w));
+      h ^= w;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h>>32;
+      p   += sizeof(w);
+      len -= sizeof(w);
+   }
+   w = 0;
+   memcpy(&w, p, len);
+   h ^= w;
+   h *= 0xc4ceb9fe1a85ec53ULL;
+   h ^= h>>29;
+
+   return h;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: SetProblemType()
@@ -25,6 +25,7 @@
 #define CLB_SIMPLE_STUFF
 
 #include <string.h>
+#include <stdint.h>
 #include <clb_error.h>
 #include <pthread.h>
 #include <semaphore.h>
@@ -101,6 +102,8 @@ long   StringArrayCardinality(char *array[]);
 
 long   ComputeGCD(long a, long b);
 
+uint64_t MemHash64(const void* mem, size_t len, uint64_t seed);
+
 void   SetProblemType(ProblemType t);
 
 #define DBG_PRINT(out, prefix, main, suffix) \
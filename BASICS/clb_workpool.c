@@ -0,0 +1,261 @@
+/*-----------------------------------------------------------------------
+
+  File  : clb_workpool.c
+
+  Contents
+
+  A pool of persistent worker threads for data-parallel loops.
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 18:02:11 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#include <signal.h>
+#include "clb_workpool.h"
+
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+typedef struct workpool_arg_cell
+{
+   WorkPool_p pool;
+   int        worker;
+}WorkPoolArgCell, *WorkPoolArg_p;
+
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: workpool_run_slice()
+//
+//   Run the current job of pool on the slice of worker.
+//
+// Global Variables: -
+//
+// Side Effects    : By the work function
+//
+/----------------------------------------------------------------------*/
+
+static void workpool_run_slice(WorkPool_p pool, int worker)
+{
+   long first = WorkPoolSliceStart(pool->items, pool->workers, worker),
+      last = WorkPoolSliceStart(pool->items, pool->workers, worker+1);
+
+   if(first < last)
+   {
+      pool->fun(pool->data, worker, first, last);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: workpool_helper()
+//
+//   Main loop of a helper thread: Wait for a new job (or shutdown),
+//   run its slice, report back.
+//
+// Global Variables: -
+//
+// Side Effects    : By the work functions
+//
+/----------------------------------------------------------------------*/
+
+static void* workpool_helper(void* arg)
+{
+   WorkPool_p    pool   = ((WorkPoolArg_p)arg)->pool;
+   int           worker = ((WorkPoolArg_p)arg)->worker;
+   unsigned long seen   = 0;
+
+   pthread_mutex_lock(&pool->lock);
+   while(true)
+   {
+      while(!pool->shutdown && pool->generation == seen)
+      {
+         pthread_cond_wait(&pool->start, &pool->lock);
+      }
+      if(pool->shutdown)
+      {
+         break;
+      }
+      seen = pool->generation;
+      pthread_mutex_unlock(&pool->lock);
+
+      workpool_run_slice(pool, worker);
+
+      pthread_mutex_lock(&pool->lock);
+      pool->pending--;
+      if(!pool->pending)
+      {
+         pthread_cond_signal(&pool->done);
+      }
+   }
+   pthread_mutex_unlock(&pool->lock);
+   return NULL;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: WorkPoolAlloc()
+//
+//   Create a pool with the given number of workers (including the
+//   calling thread, i.e. workers-1 threads are started). If threads
+//   cannot be created, the pool has fewer workers (at least 1).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, starts threads
+//
+/----------------------------------------------------------------------*/
+
+WorkPool_p WorkPoolAlloc(int workers)
+{
+   WorkPool_p    handle = WorkPoolCellAlloc();
+   WorkPoolArg_p args;
+   sigset_t      all, old;
+   int           i;
+
+   workers = MAX(1, MIN(workers, WORKPOOL_MAX_WORKERS));
+
+   pthread_mutex_init(&handle->lock, NULL);
+   pthread_cond_init(&handle->start, NULL);
+   pthread_cond_init(&handle->done, NULL);
+   handle->generation = 0;
+   handle->pending    = 0;
+   handle->shutdown   = false;
+   handle->fun        = NULL;
+   handle->data       = NULL;
+   handle->items      = 0;
+   handle->threads    = SecureMalloc(sizeof(pthread_t)*workers);
+
+   /* Helpers must never handle signals (time limits and the like are
+      the business of the main thread), so they inherit a full
+      mask. */
+   sigfillset(&all);
+   pthread_sigmask(SIG_SETMASK, &all, &old);
+   args = SecureMalloc(sizeof(WorkPoolArgCell)*workers);
+   for(i=1; i<workers; i++)
+   {
+      args[i].pool   = handle;
+      args[i].worker = i;
+      if(pthread_create(&handle->threads[i], NULL,
+                        workpool_helper, &args[i]))
+      {
+         break;
+      }
+   }
+   pthread_sigmask(SIG_SETMASK, &old, NULL);
+   handle->workers     = i;
+   handle->helper_args = args;
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: WorkPoolFree()
+//
+//   Stop all helper threads and free the pool.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, joins threads
+//
+/----------------------------------------------------------------------*/
+
+void WorkPoolFree(WorkPool_p junk)
+{
+   int i;
+
+   pthread_mutex_lock(&junk->lock);
+   junk->shutdown = true;
+   pthread_cond_broadcast(&junk->start);
+   pthread_mutex_unlock(&junk->lock);
+
+   for(i=1; i<junk->workers; i++)
+   {
+      pthread_join(junk->threads[i], NULL);
+   }
+   pthread_cond_destroy(&junk->done);
+   pthread_cond_destroy(&junk->start);
+   pthread_mutex_destroy(&junk->lock);
+   FREE(junk->threads);
+   FREE(junk->helper_args);
+   WorkPoolCellFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: WorkPoolRun()
+//
+//   Call fun on data for items [0, items), split into one slice per
+//   worker. The calling thread processes slice 0. Returns once all
+//   slices are done.
+//
+// Global Variables: -
+//
+// Side Effects    : By fun
+//
+/----------------------------------------------------------------------*/
+
+void WorkPoolRun(WorkPool_p pool, WorkPoolFun fun, void* data,
+                 long items)
+{
+   if(pool->workers == 1 || items < pool->workers)
+   {
+      if(items)
+      {
+         fun(data, 0, 0, items);
+      }
+      return;
+   }
+   pthread_mutex_lock(&pool->lock);
+   pool->fun     = fun;
+   pool->data    = data;
+   pool->items   = items;
+   pool->pending = pool->workers-1;
+   pool->generation++;
+   pthread_cond_broadcast(&pool->start);
+   pthread_mutex_unlock(&pool->lock);
+
+   workpool_run_slice(pool, 0);
+
+   pthread_mutex_lock(&pool->lock);
+   while(pool->pending)
+   {
+      pthread_cond_wait(&pool->done, &pool->lock);
+   }
+   pool->fun  = NULL;
+   pool->data = NULL;
+   pthread_mutex_unlock(&pool->lock);
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
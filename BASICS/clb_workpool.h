@@ -0,0 +1,86 @@
+/*-----------------------------------------------------------------------
+
+  File  : clb_workpool.h
+
+  Contents
+
+  A small pool of persistent worker threads for data-parallel loops
+  over a range of items. The range is cut into one contiguous slice
+  per worker (the calling thread handles the first slice), and the
+  call returns only when all slices are done. Results should be
+  written per item, so that they do not depend on the scheduling of
+  the threads.
+
+  Almost nothing in E is thread-safe (in particular SizeMalloc() and
+  the variable bindings stored in term cells). Work functions must
+  only read shared data and use memory prepared by the caller.
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 18:02:11 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#ifndef CLB_WORKPOOL
+
+#define CLB_WORKPOOL
+
+#include <pthread.h>
+#include <clb_memory.h>
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+#define WORKPOOL_MAX_WORKERS 64
+
+/* Process items [first, last) of data. worker is the number of the
+   slice (0 is the calling thread). */
+
+typedef void (*WorkPoolFun)(void* data, int worker, long first, long last);
+
+typedef struct workpool_cell
+{
+   int             workers;    /* Including the calling thread */
+   pthread_t       *threads;   /* workers-1 helper threads */
+   void*           helper_args;/* Start arguments of the helpers */
+   pthread_mutex_t lock;
+   pthread_cond_t  start;
+   pthread_cond_t  done;
+   unsigned long   generation; /* Incremented for each job */
+   int             pending;    /* Helpers still working on the job */
+   bool            shutdown;
+   WorkPoolFun     fun;
+   void*           data;
+   long            items;
+}WorkPoolCell, *WorkPool_p;
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+#define WorkPoolCellAlloc()    (WorkPoolCell*)SizeMalloc(sizeof(WorkPoolCell))
+#define WorkPoolCellFree(junk) SizeFree(junk, sizeof(WorkPoolCell))
+
+WorkPool_p WorkPoolAlloc(int workers);
+void       WorkPoolFree(WorkPool_p junk);
+
+#define    WorkPoolWorkers(pool) ((pool)->workers)
+#define    WorkPoolSliceStart(items, workers, i) \
+           ((long)(((long long)(items)*(i))/(workers)))
+
+void       WorkPoolRun(WorkPool_p pool, WorkPoolFun fun, void* data,
+                       long items);
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
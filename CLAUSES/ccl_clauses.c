@@ -125,6 +125,7 @@ Clause_p clause_copy_meta(Clause_p clause)
    handle->date        = clause->date;
    handle->proof_depth = clause->proof_depth;
    handle->proof_size  = clause->proof_size;
+   handle->watch_progress = clause->watch_progress;
    handle->pred        = NULL;
    handle->succ        = NULL;
 
@@ -238,7 +239,8 @@ Clause_p ClauseCellAlloc(void)
 #ifdef CLAUSE_PERM_IDENT
    handle->perm_ident = clause_perm_ident_counter++;
 #endif
-
+   handle->is_packed = false;
+   handle->watch_progress = 0;
 
    return handle;
 }
@@ -693,7 +695,14 @@ void ClauseFree(Clause_p junk)
 {
    assert(!junk->set);
    EvalsFree(junk->evaluations);
-   EqnListFree(junk->literals);
+   if(ClauseIsPacked(junk))
+   {
+      SizeFree(junk->packed, PACKED_LITS_SIZE(ClauseLiteralNumber(junk)));
+   }
+   else
+   {
+      EqnListFree(junk->literals);
+   }
    ClauseInfoFree(junk->info);
    if(junk->derivation)
    {
@@ -707,6 +716,144 @@ void ClauseFree(Clause_p junk)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: ClausePack()
+//
+//   Replace the literal list of clause by its compact form (one
+//   flat array of literal descriptions). A packed clause keeps its
+//   identity, evaluations and derivation, but its literals must not
+//   be accessed until ClauseUnpack() has been called. Return true if
+//   the clause has been packed, false if it is empty or uses terms
+//   from more than one bank.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, updates the set counters
+//
+/----------------------------------------------------------------------*/
+
+bool ClausePack(Clause_p clause)
+{
+   int          i, lit_no = ClauseLiteralNumber(clause);
+   Eqn_p        handle, next;
+   PackedLits_p packed;
+
+   assert(!ClauseIsPacked(clause));
+
+   if(!lit_no)
+   {
+      return false;
+   }
+   for(handle = clause->literals->next; handle; handle = handle->next)
+   {
+      if(handle->bank != clause->literals->bank)
+      {
+         return false;
+      }
+   }
+   packed = SizeMalloc(PACKED_LITS_SIZE(lit_no));
+   packed->bank = clause->literals->bank;
+   for(i = 0, handle = clause->literals; handle; i++, handle = next)
+   {
+      assert(i < lit_no);
+      next = handle->next;
+      packed->lits[i].properties = handle->properties;
+      packed->lits[i].pos        = handle->pos;
+      packed->lits[i].lterm      = handle->lterm;
+      packed->lits[i].rterm      = handle->rterm;
+      EqnFree(handle);
+   }
+   assert(i == lit_no);
+   clause->packed    = packed;
+   clause->is_packed = true;
+   if(clause->set)
+   {
+      clause->set->packed_literals += lit_no;
+   }
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseUnpack()
+//
+//   Restore the literal list of a packed clause (it is the exact
+//   list the clause had when it was packed). Does nothing for clauses
+//   that are not packed.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, updates the set counters
+//
+/----------------------------------------------------------------------*/
+
+void ClauseUnpack(Clause_p clause)
+{
+   int          i, lit_no = ClauseLiteralNumber(clause);
+   Eqn_p        handle, *anchor;
+   PackedLits_p packed;
+
+   if(!ClauseIsPacked(clause))
+   {
+      return;
+   }
+   packed = clause->packed;
+   anchor = &(clause->literals);
+   for(i = 0; i < lit_no; i++)
+   {
+      handle = EqnCellAlloc();
+      handle->properties = packed->lits[i].properties;
+      handle->pos        = packed->lits[i].pos;
+      handle->lterm      = packed->lits[i].lterm;
+      handle->rterm      = packed->lits[i].rterm;
+      handle->bank       = packed->bank;
+      *anchor = handle;
+      anchor  = &(handle->next);
+   }
+   *anchor = NULL;
+   SizeFree(packed, PACKED_LITS_SIZE(lit_no));
+   clause->is_packed = false;
+   if(clause->set)
+   {
+      clause->set->packed_literals -= lit_no;
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseGCMarkTerms()
+//
+//   Mark all terms in clause for the garbage collection. Works for
+//   packed and normal clauses.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+void ClauseGCMarkTerms(Clause_p clause)
+{
+   int i;
+
+   if(ClauseIsPacked(clause))
+   {
+      for(i = 0; i < ClauseLiteralNumber(clause); i++)
+      {
+         TBGCMarkTerm(clause->packed->bank, clause->packed->lits[i].lterm);
+         TBGCMarkTerm(clause->packed->bank, clause->packed->lits[i].rterm);
+      }
+   }
+   else
+   {
+      EqnListGCMarkTerms(clause->literals);
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: ClauseIsSemFalse()
@@ -1412,9 +1559,9 @@ void ClausePCLPrint(FILE* out, Clause_p clause, bool fullterms)
               ClauseQueryProp(clause, CPLimitedRW),
               clause->date,
               clause->literals->lterm->entry_no,
-              clause->literals->lterm->rw_data.nf_date[RewriteAdr(FullRewrite)],
+              TermNFDates(clause->literals->lterm)[RewriteAdr(FullRewrite)],
               clause->literals->rterm->entry_no,
-              clause->literals->rterm->rw_data.nf_date[RewriteAdr(FullRewrite)]
+              TermNFDates(clause->literals->rterm)[RewriteAdr(FullRewrite)]
          );
    }
 #endif
@@ -2102,7 +2249,7 @@ double ClauseSymTypeWeight(Clause_p clause, double
 // Function: ClauseStandardWeight()
 //
 //   Compute the standard weight of a clause (Vars = 1, Funs = 2,
-//   everything counts equally.
+//   everything counts equally. Works for packed clauses as well.
 //
 // Global Variables:
 //
@@ -2114,7 +2261,17 @@ double ClauseStandardWeight(Clause_p clause)
 {
    Eqn_p  handle;
    double res = 0;
+   int    i;
 
+   if(ClauseIsPacked(clause))
+   {
+      for(i=0; i<ClauseLiteralNumber(clause); i++)
+      {
+         res += TermStandardWeight(clause->packed->lits[i].lterm)+
+            TermStandardWeight(clause->packed->lits[i].rterm);
+      }
+      return res;
+   }
    for(handle = clause->literals; handle; handle = handle->next)
    {
       res += EqnStandardWeight(handle);
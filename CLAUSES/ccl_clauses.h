@@ -132,6 +132,26 @@ typedef enum
 }FormulaProperties;
 
 
+/* Compact form of a literal list, used to store clauses that are
+   only waiting (e.g. in the unprocessed set) with less overhead. The
+   literals are kept in one flat array in list order, all sharing a
+   single term bank. See ClausePack()/ClauseUnpack(). */
+
+typedef struct packed_lit_cell
+{
+   EqnProperties properties;
+   int           pos;
+   Term_p        lterm;
+   Term_p        rterm;
+}PackedLitCell, *PackedLit_p;
+
+typedef struct packed_lits_cell
+{
+   TB_p          bank;
+   PackedLitCell lits[];  /* ClauseLiteralNumber() entries */
+}PackedLitsCell, *PackedLits_p;
+
+
 typedef struct clause_cell
 {
    long                  ident;       /* Hopefully unique ident for
@@ -143,11 +163,21 @@ typedef struct clause_cell
 #endif
    SysDate               date;        /* ...at which this clause
                                          became a demodulator */
-   Eqn_p                 literals;    /* List of literals */
+   union
+   {
+      Eqn_p              literals;    /* List of literals */
+      PackedLits_p       packed;      /* ...or their compact form if
+                                         is_packed is set */
+   };
    int                   neg_lit_no;  /* Negative literals */
    int                   pos_lit_no;  /* Positive literals */
    FormulaProperties     properties;  /* Anything we want to note at
                                          the clause? */
+   bool                  is_packed;   /* Literals are packed */
+   unsigned char         watch_progress; /* Best progress (percent)
+                                            of a proof whose
+                                            watchlist hints this
+                                            clause matched */
    long                  weight;      /* ClauseStandardWeight()
                                          precomputed at some points in
                                          the program */
@@ -209,6 +239,14 @@ void ClauseSetTPTPType(Clause_p clause, FormulaProperties type);
 #define ClauseCellAllocRaw() (ClauseCell*)SizeMalloc(sizeof(ClauseCell))
 #define ClauseCellFree(junk) SizeFree(junk, sizeof(ClauseCell))
 
+#define PACKED_LITS_SIZE(n) (sizeof(PackedLitsCell)+(n)*sizeof(PackedLitCell))
+
+#ifdef CONSTANT_MEM_ESTIMATE
+#define PACKED_LIT_MEM 16
+#else
+#define PACKED_LIT_MEM sizeof(PackedLitCell)
+#endif
+
 #ifdef CONSTANT_MEM_ESTIMATE
 #define CLAUSECELL_MEM 68
 #else
@@ -221,8 +259,10 @@ Clause_p ClauseAlloc(Eqn_p literals);
 void     ClauseFree(Clause_p junk);
 void     ClauseRecomputeLitCounts(Clause_p clause);
 
-
-#define  ClauseGCMarkTerms(clause) EqnListGCMarkTerms((clause)->literals)
+#define  ClauseIsPacked(clause) ((clause)->is_packed)
+bool     ClausePack(Clause_p clause);
+void     ClauseUnpack(Clause_p clause);
+void     ClauseGCMarkTerms(Clause_p clause);
 
 #define  ClauseLiteralNumber(clause)                    \
    ((clause)->pos_lit_no+(clause)->neg_lit_no)
@@ -268,7 +268,11 @@ static void tptp_eq_pred_axiom_print(FILE* out, char* symbol, int arity,
 static void clause_set_extract_entry(Clause_p clause)
 {
    int     i;
+#ifdef EVAL_HEAP_QUEUES
+   EvalHeap_p heap;
+#else
    Eval_p *root;
+#endif
 
    assert(clause);
    assert(clause->set);
@@ -278,17 +282,26 @@ static void clause_set_extract_entry(Clause_p clause)
    {
       for(i=0; i<clause->evaluations->eval_no; i++)
       {
-         root = (void*)&PDArrayElementP(clause->set->eval_indices, i);
          // This may fail (silently) if the clause evaluation was
          // added to a clause already in a set!
+#ifdef EVAL_HEAP_QUEUES
+         heap = PDArrayElementP(clause->set->eval_indices, i);
+         EvalHeapExtractEntry(heap, clause->evaluations);
+#else
+         root = (void*)&PDArrayElementP(clause->set->eval_indices, i);
          EvalTreeExtractEntry(root,
                               clause->evaluations,
                               i);
+#endif
       }
    }
    clause->pred->succ = clause->succ;
    clause->succ->pred = clause->pred;
    clause->set->literals-=ClauseLiteralNumber(clause);
+   if(ClauseIsPacked(clause))
+   {
+      clause->set->packed_literals-=ClauseLiteralNumber(clause);
+   }
    clause->set->members--;
    clause->set = NULL;
    clause->succ = NULL;
@@ -296,6 +309,38 @@ static void clause_set_extract_entry(Clause_p clause)
 }
 
 
+#ifdef EVAL_HEAP_QUEUES
+/*-----------------------------------------------------------------------
+//
+// Function: clause_set_free_eval_heaps()
+//
+//   Free the evaluation heaps of set (but not the evaluations) and
+//   reset the corresponding entries of set->eval_indices.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void clause_set_free_eval_heaps(ClauseSet_p set)
+{
+   long       i;
+   EvalHeap_p heap;
+
+   for(i=0; i<set->eval_indices->size; i++)
+   {
+      heap = PDArrayElementP(set->eval_indices, i);
+      if(heap)
+      {
+         EvalHeapFree(heap);
+         PDArrayAssignP(set->eval_indices, i, NULL);
+      }
+   }
+}
+#endif
+
+
 /*---------------------------------------------------------------------*/
 /*                         Exported Functions                          */
 /*---------------------------------------------------------------------*/
@@ -321,6 +366,7 @@ ClauseSet_p ClauseSetAlloc(void)
 
    handle->members = 0;
    handle->literals = 0;
+   handle->packed_literals = 0;
    handle->anchor = ClauseCellAlloc();
    handle->anchor->literals = NULL;
    handle->anchor->pred = handle->anchor->succ = handle->anchor;
@@ -390,6 +436,9 @@ void ClauseSetFree(ClauseSet_p junk)
    {
       FVIAnchorFree(junk->fvindex);
    }
+#ifdef EVAL_HEAP_QUEUES
+   clause_set_free_eval_heaps(junk);
+#endif
    PDArrayFree(junk->eval_indices);
    ClauseCellFree(junk->anchor);
    DStrFree(junk->identifier);
@@ -450,6 +499,65 @@ void ClauseSetGCMarkTerms(ClauseSet_p set)
    }
 }
 
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseSetPackClauses()
+//
+//   Pack all (not yet packed) clauses in set, see
+//   ClausePack(). Return the number of clauses packed.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+long ClauseSetPackClauses(ClauseSet_p set)
+{
+   Clause_p handle;
+   long     res = 0;
+
+   for(handle = set->anchor->succ; handle!=set->anchor; handle =
+          handle->succ)
+   {
+      if(!ClauseIsPacked(handle) && ClausePack(handle))
+      {
+         res++;
+      }
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseSetUnpackClauses()
+//
+//   Unpack all packed clauses in set, so that the literals of all
+//   clauses can be accessed.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void ClauseSetUnpackClauses(ClauseSet_p set)
+{
+   Clause_p handle;
+
+   if(!ClauseSetHasPackedClauses(set))
+   {
+      return;
+   }
+   for(handle = set->anchor->succ; handle!=set->anchor; handle =
+          handle->succ)
+   {
+      ClauseUnpack(handle);
+   }
+   assert(!ClauseSetHasPackedClauses(set));
+}
+
 /*-----------------------------------------------------------------------
 //
 // Function: ClauseSetInsert()
@@ -465,10 +573,14 @@ void ClauseSetGCMarkTerms(ClauseSet_p set)
 void ClauseSetInsert(ClauseSet_p set, Clause_p newclause)
 {
    int    i;
+#ifdef EVAL_HEAP_QUEUES
+   EvalHeap_p heap;
+#else
 #ifndef NDEBUG
    Eval_p test;
 #endif
    Eval_p *root;
+#endif
 
    assert(!newclause->set);
 
@@ -479,16 +591,30 @@ void ClauseSetInsert(ClauseSet_p set, Clause_p newclause)
    newclause->set = set;
    set->members++;
    set->literals+=ClauseLiteralNumber(newclause);
+   if(ClauseIsPacked(newclause))
+   {
+      set->packed_literals+=ClauseLiteralNumber(newclause);
+   }
    if(newclause->evaluations)
    {
       for(i=0; i<newclause->evaluations->eval_no; i++)
       {
+#ifdef EVAL_HEAP_QUEUES
+         heap = PDArrayElementP(set->eval_indices, i);
+         if(!heap)
+         {
+            heap = EvalHeapAlloc(i);
+            PDArrayAssignP(set->eval_indices, i, heap);
+         }
+         EvalHeapInsert(heap, newclause->evaluations);
+#else
          root = (void*)&(PDArrayElementP(newclause->set->eval_indices,i));
 #ifndef NDEBUG
          test =
 #endif
             EvalTreeInsert(root, newclause->evaluations, i);
          assert(!test);
+#endif
       }
       set->eval_no = MAX(newclause->evaluations->eval_no, set->eval_no);
    }
@@ -763,8 +889,13 @@ Clause_p ClauseSetFindBest(ClauseSet_p set, int idx)
    Eval_p   evaluation;
 
    /* printf("I: %d", idx); */
+#ifdef EVAL_HEAP_QUEUES
+   evaluation =
+      EvalHeapFindSmallest((EvalHeap_p)PDArrayElementP(set->eval_indices, idx));
+#else
    evaluation =
       EvalTreeFindSmallest(PDArrayElementP(set->eval_indices, idx), idx);
+#endif
 
    if(!evaluation)
    {
@@ -780,6 +911,53 @@ Clause_p ClauseSetFindBest(ClauseSet_p set, int idx)
 
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseSetEvalTraverseInit()
+//
+//   Return a state for traversing the clauses of set in ascending
+//   order of evaluation idx. The set must not be changed during the
+//   traversal.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+PStack_p ClauseSetEvalTraverseInit(ClauseSet_p set, int idx)
+{
+#ifdef EVAL_HEAP_QUEUES
+   return EvalHeapTraverseInit(PDArrayElementP(set->eval_indices, idx));
+#else
+   return EvalTreeTraverseInit(PDArrayElementP(set->eval_indices, idx), idx);
+#endif
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseSetEvalTraverseNext()
+//
+//   Return the next evaluation in a traversal started with
+//   ClauseSetEvalTraverseInit(), or NULL if there is none.
+//
+// Global Variables: -
+//
+// Side Effects    : Updates state
+//
+/----------------------------------------------------------------------*/
+
+Eval_p ClauseSetEvalTraverseNext(ClauseSet_p set, PStack_p state, int idx)
+{
+#ifdef EVAL_HEAP_QUEUES
+   return EvalHeapTraverseNext(state, PDArrayElementP(set->eval_indices, idx));
+#else
+   return EvalTreeTraverseNext(state, idx);
+#endif
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: ClauseSetPrint()
@@ -1127,7 +1305,8 @@ long ClauseSetDeleteNonUnits(ClauseSet_p set)
 // Function: ClauseSetGetTermNodes()
 //
 //   Count the nodes of terms in the clauses of set as though they
-//   were unshared.
+//   were unshared. Packed clauses are unpacked one at a time for
+//   this.
 //
 // Global Variables: -
 //
@@ -1139,11 +1318,18 @@ long ClauseSetGetTermNodes(ClauseSet_p set)
 {
    long     res = 0;
    Clause_p handle;
+   bool     packed;
 
    for(handle = set->anchor->succ; handle != set->anchor; handle =
           handle->succ)
    {
+      packed = ClauseIsPacked(handle);
+      ClauseUnpack(handle);
       res += ClauseWeight(handle, 1, 1, 1, 1, 1, 1, true);
+      if(packed)
+      {
+         ClausePack(handle);
+      }
    }
    return res;
 }
@@ -1445,6 +1631,9 @@ void ClauseSetRemoveEvaluations(ClauseSet_p set)
 {
    int i;
    Clause_p handle;
+#ifdef EVAL_HEAP_QUEUES
+   clause_set_free_eval_heaps(set);
+#endif
    for(i=0; i<set->eval_indices->size; i++)
    {
       PDArrayAssignP(set->eval_indices, i, NULL);
@@ -41,6 +41,7 @@ typedef struct clausesetcell
 {
    long      members; /* How many clauses are there? */
    long      literals; /* And how many literals? */
+   long      packed_literals; /* ...of which are in packed clauses */
    Clause_p  anchor;  /* The clauses */
    SysDate   date;    /* Age of the clause set, used for optimizing
           rewriting. The special date SysCreationDate()
@@ -66,7 +67,8 @@ typedef long (*ClauseFunType)(Clause_p);
 
 #define     ClauseSetStorage(set)\
             (((CLAUSECELL_DYN_MEM+EVAL_MEM((set)->eval_no))*(set)->members+\
-            EQN_CELL_MEM*(set)->literals)+\
+            EQN_CELL_MEM*((set)->literals-(set)->packed_literals)+\
+            PACKED_LIT_MEM*(set)->packed_literals)+\
             PDTreeStorage(set->demod_index)+\
        FVIndexStorage(set->fvindex))
 
@@ -78,6 +80,9 @@ void        ClauseSetFreeClauses(ClauseSet_p set);
 long        ClauseSetStackCardinality(PStack_p stack);
 void        ClauseSetFree(ClauseSet_p junk);
 void        ClauseSetGCMarkTerms(ClauseSet_p set);
+long        ClauseSetPackClauses(ClauseSet_p set);
+void        ClauseSetUnpackClauses(ClauseSet_p set);
+#define     ClauseSetHasPackedClauses(set) ((set)->packed_literals!=0)
 void        ClauseSetInsert(ClauseSet_p set, Clause_p newclause);
 long        ClauseSetInsertSet(ClauseSet_p set, ClauseSet_p from);
 void        ClauseSetPDTIndexedInsert(ClauseSet_p set, Clause_p newclause);
@@ -90,6 +95,10 @@ Clause_p    ClauseSetExtractEntry(Clause_p clause);
 Clause_p    ClauseSetExtractFirst(ClauseSet_p set);
 void        ClauseSetDeleteEntry(Clause_p clause);
 Clause_p    ClauseSetFindBest(ClauseSet_p set, int idx);
+PStack_p    ClauseSetEvalTraverseInit(ClauseSet_p set, int idx);
+Eval_p      ClauseSetEvalTraverseNext(ClauseSet_p set, PStack_p state,
+                                      int idx);
+#define     ClauseSetEvalTraverseExit(state) PStackFree(state)
 void        ClauseSetPrint(FILE* out, ClauseSet_p set, bool
             fullterms);
 void        ClauseSetTSTPPrint(FILE* out, ClauseSet_p set, bool fullterms);
@@ -57,6 +57,7 @@ FVIndexParmsCell FVIDefaultParameters =
    false,  /* eliminate_uninformative */
    FVINDEX_MAX_FEATURES_DEFAULT,
    FVINDEX_SYMBOL_SLACK_DEFAULT,
+   false,  /* flat_index */
 };
 
 /*---------------------------------------------------------------------*/
@@ -319,6 +320,7 @@ FVIAnchor_p FVIAnchorAlloc(FVCollect_p cspec, PermVector_p perm)
    handle->perm_vector  = perm;
    handle->cspec        = cspec;
    handle->index        = FVIndexAlloc();
+   handle->flat         = NULL;
    handle->storage      = 0;
 
    return handle;
@@ -350,6 +352,10 @@ void FVIAnchorFree(FVIAnchor_p junk)
       FVIndexStorage(junk));*/
 
    FVIndexFree(junk->index);
+   if(junk->flat)
+   {
+      FVFlatIndexFree(junk->flat);
+   }
    if(junk->perm_vector)
    {
       PermVectorFree(junk->perm_vector);
@@ -358,6 +364,51 @@ void FVIAnchorFree(FVIAnchor_p junk)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: FVIAnchorUseFlatIndex()
+//
+//   Switch an empty anchor to the flat backend, if its feature
+//   vectors are short enough. Return true if the flat index is used.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+bool FVIAnchorUseFlatIndex(FVIAnchor_p anchor)
+{
+   long features;
+
+   assert(!anchor->index->clause_count);
+
+   if(anchor->flat)
+   {
+      return true;
+   }
+   if(anchor->perm_vector)
+   {
+      features = anchor->perm_vector->size;
+   }
+   else if(anchor->cspec->features == FVICollectFeatures)
+   {
+      features = anchor->cspec->res_vec_len;
+   }
+   else
+   {
+      features = FVSize(anchor->cspec->max_symbols,
+                        anchor->cspec->features);
+   }
+   if(features > FVFLAT_MAX_FEATURES)
+   {
+      return false;
+   }
+   anchor->flat = FVFlatIndexAlloc(features);
+   return true;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: FVIndexGetNextNonEmptyNode()
@@ -410,6 +461,12 @@ void FVIndexInsert(FVIAnchor_p index, FreqVector_p vec_clause)
 
    ClauseSubsumeOrderSortLits(vec_clause->clause);
 
+   if(index->flat)
+   {
+      FVFlatIndexInsert(index->flat, vec_clause);
+      PERF_CTR_EXIT(FVIndexTimer);
+      return;
+   }
    handle = index->index;
    handle->clause_count++;
 
@@ -456,6 +513,13 @@ bool FVIndexDelete(FVIAnchor_p index, Clause_p clause)
    long i;
    bool res;
 
+   if(index->flat)
+   {
+      PERF_CTR_ENTRY(FVIndexTimer);
+      res = FVFlatIndexDelete(index->flat, clause);
+      PERF_CTR_EXIT(FVIndexTimer);
+      return res;
+   }
    vec = OptimizedVarFreqVectorCompute(clause, index->perm_vector,
                    index->cspec);
    /* FreqVector-Computation is measured independently */
@@ -21,6 +21,8 @@ Changes
     New
 <2> Sun Feb  6 02:16:41 CET 2005 (actually 2 weeks or so earlier)
     Switched to IntMap
+<3> Sat Oct 17 14:12:40 CEST 2026
+    Optional flat backend (ccl_fvflatindex.h)
 
 -----------------------------------------------------------------------*/
 
@@ -35,6 +37,7 @@ Changes
 #endif
 
 #include <ccl_freqvectors.h>
+#include <ccl_fvflatindex.h>
 
 /*---------------------------------------------------------------------*/
 /*                    Data type declarations                           */
@@ -51,6 +54,7 @@ typedef struct fvindex_parms_cell
    bool eliminate_uninformative;
    long max_symbols;
    long symbol_slack;
+   bool flat_index;
 }FVIndexParmsCell, *FVIndexParms_p;
 
 
@@ -68,10 +72,11 @@ typedef struct fv_index_cell
 
 typedef struct fvi_anchor_cell
 {
-   FVCollect_p  cspec;
-   PermVector_p perm_vector;
-   FVIndex_p    index;
-   long         storage;
+   FVCollect_p   cspec;
+   PermVector_p  perm_vector;
+   FVIndex_p     index;
+   FVFlatIndex_p flat;   /* If set, used instead of index */
+   long          storage;
 }FVIAnchorCell, *FVIAnchor_p;
 
 
@@ -99,6 +104,7 @@ void      FVIndexFree(FVIndex_p junk);
 
 FVIAnchor_p FVIAnchorAlloc(FVCollect_p cspec, PermVector_p perm);
 void        FVIAnchorFree(FVIAnchor_p junk);
+bool        FVIAnchorUseFlatIndex(FVIAnchor_p anchor);
 
 #ifdef CONSTANT_MEM_ESTIMATE
 #define FVINDEX_MEM 16
@@ -106,7 +112,11 @@ void        FVIAnchorFree(FVIAnchor_p junk);
 #define FVINDEX_MEM MEMSIZE(FVIndexCell)
 #endif
 
-#define FVIndexStorage(index) ((index)?(index)->storage:0)
+#define FVIndexStorage(index) ((index)?                                \
+                               ((index)->storage+                     \
+                                ((index)->flat?                       \
+                                 FVFlatIndexStorage((index)->flat):0)):\
+                               0)
 
 FVIndex_p   FVIndexGetNextNonEmptyNode(FVIndex_p node, long key);
 void        FVIndexInsert(FVIAnchor_p index, FreqVector_p vec_clause);
@@ -0,0 +1,1058 @@
+/*-----------------------------------------------------------------------
+
+  File  : ccl_formula_cache.c
+
+  Contents
+
+  Writing and loading binary caches of parsed formula sets.
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 20:05:13 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#include <sys/mman.h>
+#include <fcntl.h>
+#include "ccl_formula_cache.h"
+
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+/* The file consists of a header followed by the sections below, in
+   this order. All records consist of 64 bit integers only, so that
+   they can be used in place in the mapped file. References between
+   records are indices, references to strings are offsets into the
+   string section (-1 for NULL). */
+
+typedef enum
+{
+   FCInputs = 0,
+   FCTypeCons,
+   FCTypes,
+   FCSymbols,
+   FCVars,
+   FCTerms,
+   FCArgs,
+   FCSets,
+   FCFormulas,
+   FCStrings,
+   FCSectionCount
+}FCSection;
+
+#define FC_MAGIC      "EFCACHE"
+#define FC_BYTE_ORDER 0x0102030405060708LL
+#define FC_HASH_SEED  0x45464341434845ULL
+#define FC_NO_REF     -1
+
+/* Term properties that are restored on loaded terms. Everything else
+   is either recomputed on insertion, only used temporarily, or (for
+   TPHasColdData) refers to data not stored in the cache. */
+
+#define FC_TERM_PROPS (~(TPOpFlag|TPCheckFlag|TPOutputFlag|TPSpecialFlag|\
+                         TPHasColdData))
+
+typedef struct
+{
+   char                  magic[8];
+   int64_t               version;
+   int64_t               byte_order;
+   uint64_t              key;
+   int64_t               body_size;
+   uint64_t              body_hash;
+   FormulaCacheStateCell state;
+   int64_t               problem_type;
+   int64_t               typed_symbols;
+   int64_t               fresh_count;
+   int64_t               count[FCSectionCount];
+   int64_t               offset[FCSectionCount];
+}FCHeader;
+
+typedef struct
+{
+   int64_t  name;
+   int64_t  size;
+   uint64_t hash;
+}FCInput;
+
+typedef struct
+{
+   int64_t code;
+   int64_t name;
+   int64_t arity;
+}FCTypeCon;
+
+typedef struct
+{
+   int64_t code;
+   int64_t arity;
+   int64_t args;       /* First argument in FCArgs */
+}FCType;
+
+typedef struct
+{
+   int64_t name;
+   int64_t pname;
+   int64_t arity;
+   int64_t type;       /* Or FC_NO_REF */
+   int64_t properties;
+}FCSymbol;
+
+typedef struct
+{
+   int64_t f_code;
+   int64_t type;
+}FCVar;
+
+typedef struct
+{
+   int64_t f_code;
+   int64_t arity;
+   int64_t type;       /* Or FC_NO_REF */
+   int64_t properties;
+   int64_t args;       /* First argument in FCArgs. Arguments >= 0 are
+                          term indices, others variable f_codes. */
+}FCTerm;
+
+typedef struct
+{
+   int64_t name;
+   int64_t first;      /* First formula */
+   int64_t count;
+}FCSet;
+
+typedef struct
+{
+   int64_t term;
+   int64_t properties;
+   int64_t is_clause;
+   int64_t has_info;
+   int64_t name;
+   int64_t source;
+   int64_t line;
+   int64_t column;
+}FCFormula;
+
+static const size_t fc_record_size[] =
+{
+   sizeof(FCInput),
+   sizeof(FCTypeCon),
+   sizeof(FCType),
+   sizeof(FCSymbol),
+   sizeof(FCVar),
+   sizeof(FCTerm),
+   sizeof(int64_t),
+   sizeof(FCSet),
+   sizeof(FCFormula),
+   1
+};
+
+/* A growing section buffer for writing */
+
+typedef struct
+{
+   char    *data;
+   int64_t len;
+   int64_t size;
+}FCBuffer;
+
+typedef struct
+{
+   TB_p      terms;
+   NumTree_p types;    /* type_uid -> type, index */
+   NumTree_p cells;    /* entry_no -> term, index */
+   FCBuffer  section[FCSectionCount];
+}FCWriterCell, *FCWriter_p;
+
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: fc_append()
+//
+//   Append len bytes to the given section of the writer. Return the
+//   index of the new record (or the offset for strings).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static int64_t fc_append(FCWriter_p writer, FCSection sec,
+                         const void* data, int64_t len)
+{
+   FCBuffer *buf = &(writer->section[sec]);
+   int64_t  res = buf->len/fc_record_size[sec];
+
+   if(buf->len+len > buf->size)
+   {
+      buf->size = MAX(2*buf->size, buf->len+len+1024);
+      buf->data = SecureRealloc(buf->data, buf->size);
+   }
+   memcpy(buf->data+buf->len, data, len);
+   buf->len += len;
+
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: fc_add_string()
+//
+//   Add a string to the string section and return its offset, or
+//   FC_NO_REF for NULL.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static int64_t fc_add_string(FCWriter_p writer, const char* str)
+{
+   if(!str)
+   {
+      return FC_NO_REF;
+   }
+   return fc_append(writer, FCStrings, str, strlen(str)+1);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: fc_collect_type()
+//
+//   Record type and its arguments in writer->types. Return false if
+//   the type cannot be cached (it uses type variables).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static bool fc_collect_type(FCWriter_p writer, Type_p type)
+{
+   IntOrP val1, val2;
+   int    i;
+
+   if(!type || NumTreeFind(&(writer->types), type->type_uid))
+   {
+      return true;
+   }
+   if(type->f_code < 0 || type->type_uid == INVALID_TYPE_UID)
+   {
+      return false;
+   }
+   for(i=0; i<type->arity; i++)
+   {
+      if(!fc_collect_type(writer, type->args[i]))
+      {
+         return false;
+      }
+   }
+   val1.p_val = type;
+   val2.i_val = FC_NO_REF;
+   NumTreeStore(&(writer->types), type->type_uid, val1, val2);
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: fc_collect_term()
+//
+//   Record all non-variable subterms of term in writer->cells (and
+//   their types in writer->types). Return false if a term cannot be
+//   cached.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static bool fc_collect_term(FCWriter_p writer, Term_p term)
+{
+   IntOrP val1, val2;
+   int    i;
+
+   if(TermIsFreeVar(term) ||
+      NumTreeFind(&(writer->cells), term->entry_no))
+   {
+      return true;
+   }
+   if(TermIsDBVar(term) || !TermIsShared(term) ||
+      !fc_collect_type(writer, term->type))
+   {
+      return false;
+   }
+   for(i=0; i<term->arity; i++)
+   {
+      if(!fc_collect_term(writer, term->args[i]))
+      {
+         return false;
+      }
+   }
+   val1.p_val = term;
+   val2.i_val = FC_NO_REF;
+   NumTreeStore(&(writer->cells), term->entry_no, val1, val2);
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: fc_type_index()
+//
+//   Return the index of a collected type (FC_NO_REF for NULL).
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static int64_t fc_type_index(FCWriter_p writer, Type_p type)
+{
+   NumTree_p cell;
+
+   if(!type)
+   {
+      return FC_NO_REF;
+   }
+   cell = NumTreeFind(&(writer->types), type->type_uid);
+   assert(cell && cell->val2.i_val != FC_NO_REF);
+   return cell->val2.i_val;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: fc_tree_nodes()
+//
+//   Return a stack with all nodes of tree in ascending order of their
+//   keys. NumTreeFind() splays the tree, so the writers cannot look up
+//   arguments while traversing the tree itself.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static PStack_p fc_tree_nodes(NumTree_p tree)
+{
+   PStack_p  res   = PStackAlloc();
+   PStack_p  stack = NumTreeTraverseInit(tree);
+   NumTree_p cell;
+
+   while((cell = NumTreeTraverseNext(stack)))
+   {
+      PStackPushP(res, cell);
+   }
+   NumTreeTraverseExit(stack);
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: fc_write_types()
+//
+//   Write all collected types in the order of their creation (so that
+//   arguments always come first).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void fc_write_types(FCWriter_p writer)
+{
+   PStack_p      nodes = fc_tree_nodes(writer->types);
+   PStackPointer sp;
+   NumTree_p     cell;
+   Type_p        type;
+   FCType        rec;
+   int64_t       arg;
+   int           i;
+
+   for(sp=0; sp<PStackGetSP(nodes); sp++)
+   {
+      cell = PStackElementP(nodes, sp);
+      type = cell->val1.p_val;
+      rec.code  = type->f_code;
+      rec.arity = type->arity;
+      rec.args  = writer->section[FCArgs].len/sizeof(int64_t);
+      for(i=0; i<type->arity; i++)
+      {
+         arg = fc_type_index(writer, type->args[i]);
+         fc_append(writer, FCArgs, &arg, sizeof(arg));
+      }
+      cell->val2.i_val = fc_append(writer, FCTypes, &rec, sizeof(rec));
+   }
+   PStackFree(nodes);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: fc_write_terms()
+//
+//   Write all collected terms in the order of their creation. Return
+//   false if a term refers to a later one (which would make loading
+//   impossible).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static bool fc_write_terms(FCWriter_p writer)
+{
+   PStack_p      nodes = fc_tree_nodes(writer->cells);
+   PStackPointer sp;
+   NumTree_p     cell, arg_cell;
+   Term_p        term, arg_term;
+   FCTerm        rec;
+   int64_t       arg;
+   bool          res = true;
+   int           i;
+
+   for(sp=0; res && sp<PStackGetSP(nodes); sp++)
+   {
+      cell = PStackElementP(nodes, sp);
+      term = cell->val1.p_val;
+      rec.f_code     = term->f_code;
+      rec.arity      = term->arity;
+      rec.type       = fc_type_index(writer, term->type);
+      rec.properties = term->properties & FC_TERM_PROPS;
+      rec.args       = writer->section[FCArgs].len/sizeof(int64_t);
+      for(i=0; i<term->arity; i++)
+      {
+         arg_term = term->args[i];
+         if(TermIsFreeVar(arg_term))
+         {
+            arg = arg_term->f_code;
+         }
+         else
+         {
+            arg_cell = NumTreeFind(&(writer->cells), arg_term->entry_no);
+            arg = arg_cell->val2.i_val;
+            if(arg == FC_NO_REF)
+            {
+               res = false;
+            }
+         }
+         fc_append(writer, FCArgs, &arg, sizeof(arg));
+      }
+      cell->val2.i_val = fc_append(writer, FCTerms, &rec, sizeof(rec));
+   }
+   PStackFree(nodes);
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: fc_hash_file()
+//
+//   Compute size and content hash of the named file. Return false if
+//   it cannot be read.
+//
+// Global Variables: -
+//
+// Side Effects    : File operations
+//
+/----------------------------------------------------------------------*/
+
+static bool fc_hash_file(const char* name, int64_t *size, uint64_t *hash)
+{
+   struct stat stat_buf;
+   void*       map;
+   int         fd = open(name, O_RDONLY);
+
+   if(fd < 0)
+   {
+      return false;
+   }
+   if(fstat(fd, &stat_buf) || !S_ISREG(stat_buf.st_mode))
+   {
+      close(fd);
+      return false;
+   }
+   *size = stat_buf.st_size;
+   if(!stat_buf.st_size)
+   {
+      *hash = MemHash64(NULL, 0, FC_HASH_SEED);
+      close(fd);
+      return true;
+   }
+   map = mmap(NULL, stat_buf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if(map == MAP_FAILED)
+   {
+      return false;
+   }
+   *hash = MemHash64(map, stat_buf.st_size, FC_HASH_SEED);
+   munmap(map, stat_buf.st_size);
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: fc_writer_build()
+//
+//   Fill the sections of writer with the cache data. Return false if
+//   the data cannot be cached.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, file operations (hashing
+//                   inputs)
+//
+/----------------------------------------------------------------------*/
+
+static bool fc_writer_build(FCWriter_p writer, FormulaCacheState_p state,
+                            PStack_p fsets, PStack_p set_names,
+                            PStack_p inputs)
+{
+   TB_p          terms = writer->terms;
+   Sig_p         sig   = terms->sig;
+   TypeBank_p    bank  = sig->type_bank;
+   VarBank_p     vars  = terms->vars;
+   FormulaSet_p  fset;
+   WFormula_p    form;
+   Term_p        var;
+   PStackPointer i;
+   FunCode       f;
+   long          j;
+   FCInput       input;
+   FCTypeCon     tcon;
+   FCSymbol      symbol;
+   FCVar         var_rec;
+   FCSet         set;
+   FCFormula     formula;
+
+   /* Collect everything reachable */
+   for(i=0; i<PStackGetSP(fsets); i++)
+   {
+      fset = PStackElementP(fsets, i);
+      for(form = fset->anchor->succ; form != fset->anchor; form = form->succ)
+      {
+         if(TermIsFreeVar(form->tformula) ||
+            !fc_collect_term(writer, form->tformula))
+         {
+            return false;
+         }
+      }
+   }
+   for(f = state->f_count+1; f <= sig->f_count; f++)
+   {
+      if(!fc_collect_type(writer, sig->f_info[f].type) ||
+         SigQueryFuncProp(sig, f, FPTypePoly))
+      {
+         return false;
+      }
+   }
+   for(j = state->max_var+1; j <= vars->max_var; j++)
+   {
+      var = PDArrayElementP(vars->variables, j);
+      if(var && !fc_collect_type(writer, var->type))
+      {
+         return false;
+      }
+   }
+
+   /* Write sections in dependency order */
+   for(i=0; i<PStackGetSP(inputs); i++)
+   {
+      if(!fc_hash_file(PStackElementP(inputs, i), &input.size, &input.hash))
+      {
+         return false;
+      }
+      input.name = fc_add_string(writer, PStackElementP(inputs, i));
+      fc_append(writer, FCInputs, &input, sizeof(input));
+   }
+   for(j = state->tc_count; j < bank->names_count; j++)
+   {
+      tcon.code  = j;
+      tcon.name  = fc_add_string(writer, TypeBankFindTCName(bank, j));
+      tcon.arity = TypeBankFindTCArity(bank, j);
+      fc_append(writer, FCTypeCons, &tcon, sizeof(tcon));
+   }
+   fc_write_types(writer);
+   for(f = state->f_count+1; f <= sig->f_count; f++)
+   {
+      symbol.name       = fc_add_string(writer, sig->f_info[f].name);
+      symbol.pname      = fc_add_string(writer, sig->f_info[f].pname);
+      symbol.arity      = sig->f_info[f].arity;
+      symbol.type       = fc_type_index(writer, sig->f_info[f].type);
+      symbol.properties = sig->f_info[f].properties & ~FPOpFlag;
+      fc_append(writer, FCSymbols, &symbol, sizeof(symbol));
+   }
+   for(j = state->max_var+1; j <= vars->max_var; j++)
+   {
+      var = PDArrayElementP(vars->variables, j);
+      if(var)
+      {
+         var_rec.f_code = var->f_code;
+         var_rec.type   = fc_type_index(writer, var->type);
+         fc_append(writer, FCVars, &var_rec, sizeof(var_rec));
+      }
+   }
+   if(!fc_write_terms(writer))
+   {
+      return false;
+   }
+   formula.term = 0;
+   for(i=0; i<PStackGetSP(fsets); i++)
+   {
+      fset = PStackElementP(fsets, i);
+      set.name  = fc_add_string(writer, PStackElementP(set_names, i));
+      set.first = writer->section[FCFormulas].len/sizeof(FCFormula);
+      set.count = 0;
+      for(form = fset->anchor->succ; form != fset->anchor; form = form->succ)
+      {
+         formula.term = NumTreeFind(&(writer->cells),
+                                    form->tformula->entry_no)->val2.i_val;
+         formula.properties = form->properties;
+         formula.is_clause  = form->is_clause;
+         formula.has_info   = form->info!=NULL;
+         formula.name       = fc_add_string(writer,
+                                            form->info?form->info->name:NULL);
+         formula.source     = fc_add_string(writer,
+                                            form->info?form->info->source:NULL);
+         formula.line       = form->info?form->info->line:0;
+         formula.column     = form->info?form->info->column:0;
+         fc_append(writer, FCFormulas, &formula, sizeof(formula));
+         set.count++;
+      }
+      fc_append(writer, FCSets, &set, sizeof(set));
+   }
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: fc_header_check()
+//
+//   Check that the header of a mapped cache file of the given size
+//   matches key and the current state, and that all sections are
+//   within the file. Return the header or NULL.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static FCHeader* fc_header_check(char* map, int64_t size, uint64_t key,
+                                 FormulaCacheState_p state)
+{
+   FCHeader *header = (FCHeader*)map;
+   int      i;
+
+   if(size < (int64_t)sizeof(FCHeader) ||
+      memcmp(header->magic, FC_MAGIC, sizeof(header->magic)) ||
+      header->version != FORMULA_CACHE_VERSION ||
+      header->byte_order != FC_BYTE_ORDER ||
+      header->key != key ||
+      header->body_size != size-(int64_t)sizeof(FCHeader) ||
+      memcmp(&(header->state), state, sizeof(FormulaCacheStateCell)))
+   {
+      return NULL;
+   }
+   for(i=0; i<FCSectionCount; i++)
+   {
+      if(header->count[i] < 0 || header->offset[i] < 0 ||
+         header->offset[i]%sizeof(int64_t) ||
+         header->count[i] > header->body_size/(int64_t)fc_record_size[i] ||
+         header->offset[i]+header->count[i]*(int64_t)fc_record_size[i] >
+         header->body_size)
+      {
+         return NULL;
+      }
+   }
+   if(MemHash64(map+sizeof(FCHeader), header->body_size, FC_HASH_SEED)
+      != header->body_hash)
+   {
+      return NULL;
+   }
+   return header;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: FormulaCacheGetState()
+//
+//   Record the state of the term bank (and signature) that is
+//   relevant for caches.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+void FormulaCacheGetState(TB_p terms, FormulaCacheState_p state)
+{
+   memset(state, 0, sizeof(FormulaCacheStateCell));
+   state->f_count     = terms->sig->f_count;
+   state->tc_count    = terms->sig->type_bank->names_count;
+   state->types_count = terms->sig->type_bank->types_count;
+   state->max_var     = terms->vars->max_var;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: FormulaCacheWrite()
+//
+//   Write the formula sets in fsets (with the names in set_names),
+//   which were parsed from the files in inputs into terms in state
+//   state, to a cache file with the given key. Return success (the
+//   data may not be cacheable, in this case no file is written). On
+//   success, the hash of the cache contents (which identifies them
+//   for derived caches) is stored in *body_hash.
+//
+// Global Variables: problemType
+//
+// Side Effects    : File operations, memory operations
+//
+/----------------------------------------------------------------------*/
+
+bool FormulaCacheWrite(char* file, uint64_t key, FormulaCacheState_p state,
+                       TB_p terms, PStack_p fsets, PStack_p set_names,
+                       PStack_p inputs, uint64_t *body_hash)
+{
+   FCWriterCell writer;
+   FCHeader     header;
+   DStr_p       tmp_name;
+   FILE         *out;
+   int64_t      offset = 0;
+   char         *body;
+   bool         res;
+   int          i;
+
+   assert(PStackGetSP(fsets) == PStackGetSP(set_names));
+
+   if(problemType == PROBLEM_HO)
+   {
+      return false;
+   }
+   memset(&writer, 0, sizeof(writer));
+   writer.terms = terms;
+
+   res = fc_writer_build(&writer, state, fsets, set_names, inputs);
+   if(res)
+   {
+      memset(&header, 0, sizeof(header));
+      memcpy(header.magic, FC_MAGIC, sizeof(header.magic));
+      header.version       = FORMULA_CACHE_VERSION;
+      header.byte_order    = FC_BYTE_ORDER;
+      header.key           = key;
+      header.state         = *state;
+      header.problem_type  = problemType;
+      header.typed_symbols = terms->sig->typed_symbols;
+      header.fresh_count   = terms->vars->fresh_count;
+
+      for(i=0; i<FCSectionCount; i++)
+      {
+         /* Pad the strings to keep all sections aligned */
+         while(writer.section[i].len%sizeof(int64_t))
+         {
+            fc_append(&writer, i, "", 1);
+         }
+         header.count[i]  = writer.section[i].len/fc_record_size[i];
+         header.offset[i] = offset;
+         offset += writer.section[i].len;
+      }
+      header.body_size = offset;
+      body = SecureMalloc(MAX(offset, 1));
+      for(i=0; i<FCSectionCount; i++)
+      {
+         if(writer.section[i].len)
+         {
+            memcpy(body+header.offset[i], writer.section[i].data,
+                   writer.section[i].len);
+         }
+      }
+      header.body_hash = MemHash64(body, offset, FC_HASH_SEED);
+      *body_hash       = header.body_hash;
+
+      /* Write to a temporary file first, so that concurrent readers
+         never see a partial cache. */
+      tmp_name = DStrAlloc();
+      DStrAppendStr(tmp_name, file);
+      DStrAppendStr(tmp_name, ".");
+      DStrAppendInt(tmp_name, getpid());
+      out = fopen(DStrView(tmp_name), "w");
+      res = out &&
+         fwrite(&header, sizeof(header), 1, out) == 1 &&
+         (offset == 0 || fwrite(body, offset, 1, out) == 1);
+      if(out && fclose(out))
+      {
+         res = false;
+      }
+      if(res && rename(DStrView(tmp_name), file))
+      {
+         res = false;
+      }
+      if(!res)
+      {
+         SysWarning("Cannot write formula cache %s", file);
+         unlink(DStrView(tmp_name));
+      }
+      DStrFree(tmp_name);
+      FREE(body);
+   }
+   for(i=0; i<FCSectionCount; i++)
+   {
+      if(writer.section[i].data)
+      {
+         FREE(writer.section[i].data);
+      }
+   }
+   NumTreeFree(writer.types);
+   NumTreeFree(writer.cells);
+
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: FormulaCacheLoad()
+//
+//   Try to load the formula sets from a cache file with the given key
+//   into terms, pushing them onto fsets and their names (as copies)
+//   onto set_names. Return the number of formulas loaded, or -1 if
+//   there is no valid and up-to-date cache for the current state of
+//   terms (in this case, nothing is changed). On success, the hash of
+//   the cache contents is stored in *body_hash.
+//
+// Global Variables: problemType
+//
+// Side Effects    : File operations, memory operations, changes the
+//                   signature, type bank and term bank
+//
+/----------------------------------------------------------------------*/
+
+long FormulaCacheLoad(char* file, uint64_t key, TB_p terms,
+                      PStack_p fsets, PStack_p set_names,
+                      uint64_t *body_hash)
+{
+   Sig_p                 sig  = terms->sig;
+   TypeBank_p            bank = sig->type_bank;
+   FormulaCacheStateCell state;
+   struct stat           stat_buf;
+   FCHeader              *header;
+   char                  *map, *strings;
+   int64_t               *args, size, in_size, i, j;
+   uint64_t              hash;
+   FCInput               *input;
+   FCTypeCon             *tcon;
+   FCType                *type_rec;
+   FCSymbol              *symbol;
+   FCVar                 *var_rec;
+   FCTerm                *term_rec;
+   FCSet                 *set;
+   FCFormula             *formula;
+   Type_p                *types, *type_args;
+   Term_p                *cells, term;
+   FormulaSet_p          fset;
+   WFormula_p            form;
+   FunCode               f;
+   long                  res = 0;
+   int                   fd = open(file, O_RDONLY);
+
+#define FC_SECTION(header, sec, type) \
+   ((type*)(map+sizeof(FCHeader)+(header)->offset[sec]))
+#define FC_STRING(ref) ((ref)==FC_NO_REF?NULL:strings+(ref))
+
+   if(fd < 0)
+   {
+      return -1;
+   }
+   if(fstat(fd, &stat_buf) || !S_ISREG(stat_buf.st_mode) ||
+      stat_buf.st_size < (off_t)sizeof(FCHeader))
+   {
+      close(fd);
+      return -1;
+   }
+   size = stat_buf.st_size;
+   map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if(map == MAP_FAILED)
+   {
+      return -1;
+   }
+   FormulaCacheGetState(terms, &state);
+   header = fc_header_check(map, size, key, &state);
+   if(!header)
+   {
+      munmap(map, size);
+      return -1;
+   }
+   strings = FC_SECTION(header, FCStrings, char);
+   input   = FC_SECTION(header, FCInputs, FCInput);
+   for(i=0; i<header->count[FCInputs]; i++)
+   {
+      if(!fc_hash_file(FC_STRING(input[i].name), &in_size, &hash) ||
+         in_size != input[i].size || hash != input[i].hash)
+      {
+         munmap(map, size);
+         return -1;
+      }
+   }
+   args = FC_SECTION(header, FCArgs, int64_t);
+
+   /* From here on, the cache is valid and we change the banks. */
+   tcon = FC_SECTION(header, FCTypeCons, FCTypeCon);
+   for(i=0; i<header->count[FCTypeCons]; i++)
+   {
+      if(TypeBankDefineTypeConstructor(bank, FC_STRING(tcon[i].name),
+                                       tcon[i].arity) != tcon[i].code)
+      {
+         Error("Inconsistent type constructors in formula cache %s",
+               FILE_ERROR, file);
+      }
+   }
+   type_rec = FC_SECTION(header, FCTypes, FCType);
+   types    = SizeMalloc(sizeof(Type_p)*MAX(header->count[FCTypes], 1));
+   for(i=0; i<header->count[FCTypes]; i++)
+   {
+      type_args = TypeArgArrayAlloc(type_rec[i].arity);
+      for(j=0; j<type_rec[i].arity; j++)
+      {
+         type_args[j] = types[args[type_rec[i].args+j]];
+      }
+      types[i] = TypeBankInsertTypeShared(
+         bank, TypeAlloc(type_rec[i].code, type_rec[i].arity, type_args));
+   }
+   symbol = FC_SECTION(header, FCSymbols, FCSymbol);
+   for(i=0; i<header->count[FCSymbols]; i++)
+   {
+      if(symbol[i].name == FC_NO_REF ||
+         SigFindFCode(sig, strings+symbol[i].name))
+      {
+         Error("Inconsistent signature in formula cache %s",
+               FILE_ERROR, file);
+      }
+      f = SigAppendId(sig, strings+symbol[i].name,
+                      symbol[i].pname == FC_NO_REF?
+                      strings+symbol[i].name:strings+symbol[i].pname,
+                      symbol[i].arity);
+      assert(f == state.f_count+1+i);
+      if(symbol[i].type != FC_NO_REF)
+      {
+         SigDeclareType(sig, f, types[symbol[i].type]);
+      }
+      SigSetFuncProp(sig, f, symbol[i].properties);
+   }
+   var_rec = FC_SECTION(header, FCVars, FCVar);
+   for(i=0; i<header->count[FCVars]; i++)
+   {
+      VarBankVarAssertAlloc(terms->vars, var_rec[i].f_code,
+                            types[var_rec[i].type]);
+   }
+   terms->vars->fresh_count = MAX(terms->vars->fresh_count,
+                                  header->fresh_count);
+   term_rec = FC_SECTION(header, FCTerms, FCTerm);
+   cells    = SizeMalloc(sizeof(Term_p)*MAX(header->count[FCTerms], 1));
+   for(i=0; i<header->count[FCTerms]; i++)
+   {
+      term = TermTopAlloc(term_rec[i].f_code, term_rec[i].arity);
+      if(term_rec[i].type != FC_NO_REF)
+      {
+         term->type = types[term_rec[i].type];
+      }
+      TermCellSetProp(term, term_rec[i].properties & TPPredPos);
+      for(j=0; j<term_rec[i].arity; j++)
+      {
+         if(args[term_rec[i].args+j] >= 0)
+         {
+            term->args[j] = cells[args[term_rec[i].args+j]];
+         }
+         else
+         {
+            term->args[j] = PDArrayElementP(terms->vars->variables,
+                                            -args[term_rec[i].args+j]);
+         }
+      }
+      cells[i] = TBTermTopInsert(terms, term);
+      TermCellSetProp(cells[i], term_rec[i].properties);
+   }
+   set     = FC_SECTION(header, FCSets, FCSet);
+   formula = FC_SECTION(header, FCFormulas, FCFormula);
+   for(i=0; i<header->count[FCSets]; i++)
+   {
+      fset = FormulaSetAlloc();
+      for(j=set[i].first; j<set[i].first+set[i].count; j++)
+      {
+         form = WTFormulaAlloc(terms, cells[formula[j].term]);
+         form->properties = formula[j].properties;
+         form->is_clause  = formula[j].is_clause;
+         if(formula[j].has_info)
+         {
+            form->info = ClauseInfoAlloc(FC_STRING(formula[j].name),
+                                         FC_STRING(formula[j].source),
+                                         formula[j].line,
+                                         formula[j].column);
+         }
+         FormulaSetInsert(fset, form);
+         res++;
+      }
+      PStackPushP(fsets, fset);
+      PStackPushP(set_names, SecureStrdup(FC_STRING(set[i].name)));
+   }
+   if(header->problem_type != PROBLEM_NOT_INIT)
+   {
+      SetProblemType(header->problem_type);
+   }
+   sig->typed_symbols = sig->typed_symbols || header->typed_symbols;
+   *body_hash = header->body_hash;
+
+   SizeFree(cells, sizeof(Term_p)*MAX(header->count[FCTerms], 1));
+   SizeFree(types, sizeof(Type_p)*MAX(header->count[FCTypes], 1));
+   munmap(map, size);
+
+#undef FC_SECTION
+#undef FC_STRING
+
+   return res;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
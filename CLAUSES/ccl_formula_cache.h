@@ -0,0 +1,79 @@
+/*-----------------------------------------------------------------------
+
+  File  : ccl_formula_cache.h
+
+  Contents
+
+  A binary cache for parsed formula sets (typically large axiom files
+  used by many problems in batch mode). A cache file stores the
+  formula sets together with everything they added to the term bank:
+  type constructors, types, function symbols, variables and the
+  shared term cells. Terms are stored as a DAG in creation order,
+  with arguments referring to earlier entries by index, so loading
+  only has to map the file and re-insert the cells bottom-up. There
+  is no scanning, name lookup of variables or type inference.
+
+  Because signature and term bank are shared with everything else,
+  a cache can only be loaded into a bank in exactly the state it was
+  written from (recorded as a FormulaCacheStateCell), and this is
+  normally the fresh bank of a batch run. The cache also records all
+  input files read (including nested includes) with their size and
+  a content hash, and is ignored if any of them has changed. Caches
+  are only written for first-order problems parsed completely into
+  formula sets.
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 20:05:13 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#ifndef CCL_FORMULA_CACHE
+
+#define CCL_FORMULA_CACHE
+
+#include <stdint.h>
+#include <ccl_formulasets.h>
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+#define FORMULA_CACHE_VERSION 1
+
+/* The parts of the state of a term bank (and its signature) that the
+   contents of a cache depend on. */
+
+typedef struct formula_cache_state_cell
+{
+   int64_t f_count;     /* Symbols in the signature */
+   int64_t tc_count;    /* Type constructors in the type bank */
+   int64_t types_count; /* Types in the type bank */
+   int64_t max_var;     /* Largest variable in the variable bank */
+}FormulaCacheStateCell, *FormulaCacheState_p;
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+void FormulaCacheGetState(TB_p terms, FormulaCacheState_p state);
+
+bool FormulaCacheWrite(char* file, uint64_t key, FormulaCacheState_p state,
+                       TB_p terms, PStack_p fsets, PStack_p set_names,
+                       PStack_p inputs, uint64_t *body_hash);
+long FormulaCacheLoad(char* file, uint64_t key, TB_p terms,
+                      PStack_p fsets, PStack_p set_names,
+                      uint64_t *body_hash);
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
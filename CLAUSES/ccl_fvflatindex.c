@@ -0,0 +1,547 @@
+/*-----------------------------------------------------------------------
+
+  File  : ccl_fvflatindex.c
+
+  Contents
+
+  Flat, SIMD-scanned feature vector tables for subsumption.
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 14:12:40 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#include "ccl_fvflatindex.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FVFLAT_X86
+#include <immintrin.h>
+#endif
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+static uint32_t fvflat_scan_dispatch(int16_t **cols, long features,
+                                     long block, int16_t *query,
+                                     FVFlatQueryType type);
+
+/* Selected on first use */
+static FVFlatScanFun fvflat_scan      = fvflat_scan_dispatch;
+static const char*   fvflat_scan_name = "undecided";
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: fvflat_saturate()
+//
+//   Return val, cut off at FVFLAT_MAXVAL.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline int16_t fvflat_saturate(long val)
+{
+   assert(val >= 0);
+   return val > FVFLAT_MAXVAL ? FVFLAT_MAXVAL : val;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: fvflat_scan_scalar()
+//
+//   Portable version of the block scan.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static uint32_t fvflat_scan_scalar(int16_t **cols, long features,
+                                   long block, int16_t *query,
+                                   FVFlatQueryType type)
+{
+   uint32_t fail = 0;
+   long     f, i;
+   int16_t  *col, q;
+
+   for(f=0; f<features && fail != 0xffff; f++)
+   {
+      col = cols[f]+block*FVFLAT_BLOCK;
+      q   = query[f];
+      for(i=0; i<FVFLAT_BLOCK; i++)
+      {
+         switch(type)
+         {
+         case FVFSubsuming:
+               fail |= (uint32_t)(col[i] > q) << i;
+               break;
+         case FVFSubsumed:
+               fail |= (uint32_t)(col[i] < q) << i;
+               break;
+         default:
+               fail |= (uint32_t)(col[i] != q) << i;
+               break;
+         }
+      }
+   }
+   /* Spread to the 2-bits-per-row format of the vector versions */
+   fail = ~fail & 0xffff;
+   fail = (fail | (fail << 8)) & 0x00ff00ff;
+   fail = (fail | (fail << 4)) & 0x0f0f0f0f;
+   fail = (fail | (fail << 2)) & 0x33333333;
+   fail = (fail | (fail << 1)) & 0x55555555;
+   return fail;
+}
+
+
+#ifdef FVFLAT_X86
+
+/*-----------------------------------------------------------------------
+//
+// Function: fvflat_scan_sse2()
+//
+//   SSE2 version of the block scan, two registers per block.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+__attribute__((target("sse2")))
+static uint32_t fvflat_scan_sse2(int16_t **cols, long features,
+                                 long block, int16_t *query,
+                                 FVFlatQueryType type)
+{
+   __m128i fail_lo = _mm_setzero_si128(), fail_hi = _mm_setzero_si128();
+   __m128i ones    = _mm_set1_epi16(-1);
+   __m128i lo, hi, q;
+   int16_t *col;
+   long    f;
+
+   for(f=0; f<features; f++)
+   {
+      col = cols[f]+block*FVFLAT_BLOCK;
+      lo  = _mm_loadu_si128((__m128i*)col);
+      hi  = _mm_loadu_si128((__m128i*)(col+8));
+      q   = _mm_set1_epi16(query[f]);
+      switch(type)
+      {
+      case FVFSubsuming:
+            fail_lo = _mm_or_si128(fail_lo, _mm_cmpgt_epi16(lo, q));
+            fail_hi = _mm_or_si128(fail_hi, _mm_cmpgt_epi16(hi, q));
+            break;
+      case FVFSubsumed:
+            fail_lo = _mm_or_si128(fail_lo, _mm_cmpgt_epi16(q, lo));
+            fail_hi = _mm_or_si128(fail_hi, _mm_cmpgt_epi16(q, hi));
+            break;
+      default:
+            fail_lo = _mm_or_si128(fail_lo,
+                                   _mm_xor_si128(_mm_cmpeq_epi16(lo, q), ones));
+            fail_hi = _mm_or_si128(fail_hi,
+                                   _mm_xor_si128(_mm_cmpeq_epi16(hi, q), ones));
+            break;
+      }
+      if((f & 7) == 7 &&
+         _mm_movemask_epi8(_mm_and_si128(fail_lo, fail_hi)) == 0xffff)
+      {
+         return 0;
+      }
+   }
+   return ~((uint32_t)_mm_movemask_epi8(fail_lo) |
+            ((uint32_t)_mm_movemask_epi8(fail_hi) << 16));
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: fvflat_scan_avx2()
+//
+//   AVX2 version of the block scan, one register per block.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+__attribute__((target("avx2")))
+static uint32_t fvflat_scan_avx2(int16_t **cols, long features,
+                                 long block, int16_t *query,
+                                 FVFlatQueryType type)
+{
+   __m256i fail = _mm256_setzero_si256();
+   __m256i ones = _mm256_set1_epi16(-1);
+   __m256i v, q;
+   long    f;
+
+   for(f=0; f<features; f++)
+   {
+      v = _mm256_loadu_si256((__m256i*)(cols[f]+block*FVFLAT_BLOCK));
+      q = _mm256_set1_epi16(query[f]);
+      switch(type)
+      {
+      case FVFSubsuming:
+            fail = _mm256_or_si256(fail, _mm256_cmpgt_epi16(v, q));
+            break;
+      case FVFSubsumed:
+            fail = _mm256_or_si256(fail, _mm256_cmpgt_epi16(q, v));
+            break;
+      default:
+            fail = _mm256_or_si256(fail,
+                                   _mm256_xor_si256(_mm256_cmpeq_epi16(v, q),
+                                                    ones));
+            break;
+      }
+      if((f & 7) == 7 && _mm256_testc_si256(fail, ones))
+      {
+         return 0;
+      }
+   }
+   return ~(uint32_t)_mm256_movemask_epi8(fail);
+}
+
+#endif
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: fvflat_scan_dispatch()
+//
+//   Pick the best block scan for the CPU we are running on, install
+//   it, and use it for this first call.
+//
+// Global Variables: fvflat_scan, fvflat_scan_name
+//
+// Side Effects    : Sets the scan function.
+//
+/----------------------------------------------------------------------*/
+
+static uint32_t fvflat_scan_dispatch(int16_t **cols, long features,
+                                     long block, int16_t *query,
+                                     FVFlatQueryType type)
+{
+   fvflat_scan      = fvflat_scan_scalar;
+   fvflat_scan_name = "scalar";
+#ifdef FVFLAT_X86
+   __builtin_cpu_init();
+   if(__builtin_cpu_supports("avx2"))
+   {
+      fvflat_scan      = fvflat_scan_avx2;
+      fvflat_scan_name = "avx2";
+   }
+   else if(__builtin_cpu_supports("sse2"))
+   {
+      fvflat_scan      = fvflat_scan_sse2;
+      fvflat_scan_name = "sse2";
+   }
+#endif
+   return fvflat_scan(cols, features, block, query, type);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: fvflat_grow()
+//
+//   Add room for another block of rows.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void fvflat_grow(FVFlatIndex_p index)
+{
+   long old = index->capacity, f, i;
+
+   index->capacity = old ? 2*old : FVFLAT_BLOCK;
+   for(f=0; f<index->features; f++)
+   {
+      index->cols[f] = SecureRealloc(index->cols[f],
+                                     index->capacity*sizeof(int16_t));
+      for(i=old; i<index->capacity; i++)
+      {
+         index->cols[f][i] = FVFLAT_PAD;
+      }
+   }
+   index->clauses = SecureRealloc(index->clauses,
+                                  index->capacity*sizeof(Clause_p));
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: FVFlatIndexAlloc()
+//
+//   Allocate an empty flat index for feature vectors of the given
+//   length.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+FVFlatIndex_p FVFlatIndexAlloc(long features)
+{
+   FVFlatIndex_p handle = FVFlatIndexCellAlloc();
+   long f;
+
+   assert(features >= 0);
+
+   handle->features  = features;
+   handle->rows      = 0;
+   handle->capacity  = 0;
+   handle->cols      = SecureMalloc(MAX(features,1)*sizeof(int16_t*));
+   for(f=0; f<features; f++)
+   {
+      handle->cols[f] = NULL;
+   }
+   handle->clauses   = NULL;
+   handle->row_index = NULL;
+   handle->query     = SecureMalloc(MAX(features,1)*sizeof(int16_t));
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: FVFlatIndexFree()
+//
+//   Free a flat index (but not the indexed clauses).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void FVFlatIndexFree(FVFlatIndex_p junk)
+{
+   long f;
+
+   assert(junk);
+
+   if(junk->capacity)
+   {
+      for(f=0; f<junk->features; f++)
+      {
+         FREE(junk->cols[f]);
+      }
+      FREE(junk->clauses);
+   }
+   FREE(junk->cols);
+   FREE(junk->query);
+   NumTreeFree(junk->row_index);
+   FVFlatIndexCellFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: FVFlatIndexInsert()
+//
+//   Add vec->clause with the feature vector vec as a new row.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes the index
+//
+/----------------------------------------------------------------------*/
+
+void FVFlatIndexInsert(FVFlatIndex_p index, FreqVector_p vec)
+{
+   long   f, row;
+   IntOrP val1, val2;
+
+   assert(vec->size == index->features);
+   assert(vec->clause);
+
+   if(index->rows == index->capacity)
+   {
+      fvflat_grow(index);
+   }
+   row = index->rows++;
+   for(f=0; f<index->features; f++)
+   {
+      index->cols[f][row] = fvflat_saturate(vec->array[f]);
+   }
+   index->clauses[row] = vec->clause;
+   val1.i_val = row;
+   val2.i_val = 0;
+   NumTreeStore(&(index->row_index), (long)vec->clause, val1, val2);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: FVFlatIndexDelete()
+//
+//   Remove clause from the index (if it is there). The last row moves
+//   into the gap. Return true if the clause was found.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes the index
+//
+/----------------------------------------------------------------------*/
+
+bool FVFlatIndexDelete(FVFlatIndex_p index, Clause_p clause)
+{
+   NumTree_p cell, moved;
+   long      f, row, last;
+
+   cell = NumTreeExtractEntry(&(index->row_index), (long)clause);
+   if(!cell)
+   {
+      return false;
+   }
+   row  = cell->val1.i_val;
+   NumTreeCellFree(cell);
+   last = --index->rows;
+   assert(index->clauses[row] == clause);
+
+   if(row != last)
+   {
+      for(f=0; f<index->features; f++)
+      {
+         index->cols[f][row] = index->cols[f][last];
+      }
+      index->clauses[row] = index->clauses[last];
+      moved = NumTreeFind(&(index->row_index), (long)index->clauses[row]);
+      assert(moved);
+      moved->val1.i_val = row;
+   }
+   for(f=0; f<index->features; f++)
+   {
+      index->cols[f][last] = FVFLAT_PAD;
+   }
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: FVFlatIndexSetQuery()
+//
+//   Make vec the query for the following FVFlatIndexNextCandidates()
+//   calls.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes the query buffer
+//
+/----------------------------------------------------------------------*/
+
+void FVFlatIndexSetQuery(FVFlatIndex_p index, FreqVector_p vec)
+{
+   long f;
+
+   assert(vec->size == index->features);
+
+   for(f=0; f<index->features; f++)
+   {
+      index->query[f] = fvflat_saturate(vec->array[f]);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: FVFlatIndexNextCandidates()
+//
+//   Scan the table starting at *block, up to and including the first
+//   block with at least one row passing the test. Push the clauses of
+//   the passing rows onto res, set *block to the next block to scan,
+//   and return the number of clauses pushed. A return value of 0
+//   means that the table is exhausted. Candidates are returned in
+//   row order.
+//
+// Global Variables: -
+//
+// Side Effects    : Pushes onto res
+//
+/----------------------------------------------------------------------*/
+
+long FVFlatIndexNextCandidates(FVFlatIndex_p index,
+                               FVFlatQueryType type,
+                               long *block,
+                               PStack_p res)
+{
+   long     blocks = (index->rows+FVFLAT_BLOCK-1)/FVFLAT_BLOCK;
+   long     rest, found = 0, row;
+   uint32_t mask;
+
+   while(*block < blocks && !found)
+   {
+      mask = fvflat_scan(index->cols, index->features, *block,
+                         index->query, type) & 0x55555555;
+      rest = index->rows - *block*FVFLAT_BLOCK;
+      if(rest < FVFLAT_BLOCK)
+      {
+         mask &= (1u << (2*rest))-1;
+      }
+      while(mask)
+      {
+         row = *block*FVFLAT_BLOCK + __builtin_ctz(mask)/2;
+         PStackPushP(res, index->clauses[row]);
+         found++;
+         mask &= mask-1;
+      }
+      (*block)++;
+   }
+   return found;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: FVFlatIndexScanVariant()
+//
+//   Return the name of the scan implementation in use ("undecided" if
+//   none has been used yet).
+//
+// Global Variables: fvflat_scan_name
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+const char* FVFlatIndexScanVariant(void)
+{
+   return fvflat_scan_name;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -0,0 +1,115 @@
+/*-----------------------------------------------------------------------
+
+  File  : ccl_fvflatindex.h
+
+  Contents
+
+  A flat alternative to the FV-index trie for small and medium sized
+  feature vectors. The feature vectors of all indexed clauses are
+  stored as (saturated) 16 bit values in a structure-of-arrays table,
+  one column per feature and one row per clause. A query scans the
+  table in blocks of FVFLAT_BLOCK rows and computes a mask of rows
+  that pass the dominance test (<= for forward subsumption, >= for
+  backward subsumption, = for variants). On x86 CPUs with AVX2 (or
+  SSE2), this uses vector compares. The choice is made once at run
+  time, a scalar version is always available.
+
+  Saturation is monotonic, so the filter never rejects a real
+  candidate. It may let through some clauses the exact vectors would
+  have excluded, but all candidates are checked by the caller anyway.
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 14:12:40 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#ifndef CCL_FVFLATINDEX
+
+#define CCL_FVFLATINDEX
+
+#include <stdint.h>
+#include <clb_numtrees.h>
+#include <ccl_freqvectors.h>
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+/* Rows are scanned in blocks of this size (16 int16 lanes fill an
+   AVX2 register). Columns are always allocated in whole blocks, and
+   unused rows of the last block are padded with FVFLAT_PAD. */
+
+#define FVFLAT_BLOCK   16
+#define FVFLAT_MAXVAL  INT16_MAX
+#define FVFLAT_PAD     INT16_MAX
+
+/* Vectors longer than this are not worth a linear scan - anchors
+   with longer vectors keep using the trie. */
+
+#define FVFLAT_MAX_FEATURES 256
+
+typedef enum
+{
+   FVFSubsuming,   /* Rows with row <= query in all features */
+   FVFSubsumed,    /* Rows with row >= query in all features */
+   FVFVariant      /* Rows with row == query in all features */
+}FVFlatQueryType;
+
+/* Scan one block. The result has bit 2*i set if row i of the block
+   passes the test (bit 2*i+1 may be set as well). */
+
+typedef uint32_t (*FVFlatScanFun)(int16_t **cols, long features,
+                                  long block, int16_t *query,
+                                  FVFlatQueryType type);
+
+typedef struct fv_flat_index_cell
+{
+   long      features;   /* Number of columns */
+   long      rows;       /* Number of used rows */
+   long      capacity;   /* Allocated rows, multiple of FVFLAT_BLOCK */
+   int16_t   **cols;     /* features columns of capacity values */
+   Clause_p  *clauses;   /* Clause of each row */
+   NumTree_p row_index;  /* Clause address -> row */
+   int16_t   *query;     /* Saturated copy of the current query */
+}FVFlatIndexCell, *FVFlatIndex_p;
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+#define FVFlatIndexCellAlloc()    (FVFlatIndexCell*)SizeMalloc(sizeof(FVFlatIndexCell))
+#define FVFlatIndexCellFree(junk) SizeFree(junk, sizeof(FVFlatIndexCell))
+
+FVFlatIndex_p FVFlatIndexAlloc(long features);
+void          FVFlatIndexFree(FVFlatIndex_p junk);
+
+#define FVFlatIndexRows(index) ((index)->rows)
+#define FVFlatIndexStorage(index)                                     \
+   ((index)->capacity*((index)->features*(long)sizeof(int16_t)        \
+                       +(long)sizeof(Clause_p))                       \
+    +(index)->rows*NUMTREECELL_MEM)
+
+void          FVFlatIndexInsert(FVFlatIndex_p index, FreqVector_p vec);
+bool          FVFlatIndexDelete(FVFlatIndex_p index, Clause_p clause);
+
+void          FVFlatIndexSetQuery(FVFlatIndex_p index, FreqVector_p vec);
+long          FVFlatIndexNextCandidates(FVFlatIndex_p index,
+                                        FVFlatQueryType type,
+                                        long *block,
+                                        PStack_p res);
+
+const char*   FVFlatIndexScanVariant(void);
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -18,6 +18,8 @@ Changes
 
 <1> Sat Mar 20 09:55:09 CET 2010
     New
+<2> Sat Oct 17 18:05:12 CEST 2026
+    Minor (generational) collections
 
 -----------------------------------------------------------------------*/
 
@@ -40,32 +42,24 @@ Changes
 /*---------------------------------------------------------------------*/
 
 
-
-/*---------------------------------------------------------------------*/
-/*                         Exported Functions                          */
-/*---------------------------------------------------------------------*/
-
-
 /*-----------------------------------------------------------------------
 //
-// Function: TBGCCollect()
+// Function: gc_mark_roots()
 //
-//   Perform garbage collection on bank.
+//   Mark all terms reachable from the clause sets, formula sets and
+//   term stacks registered with bank.
 //
 // Global Variables: -
 //
-// Side Effects    : -
+// Side Effects    : Marks terms
 //
 /----------------------------------------------------------------------*/
 
-long TBGCCollect(TB_p bank)
+static void gc_mark_roots(TB_p bank)
 {
    PTree_p entry;
    PStack_p trav;
 
-   assert(bank);
-   assert(bank->gc);
-
    //printf(COMCHAR" GCCollect(%p)\n", gc);
    trav = PTreeTraverseInit(bank->gc->clause_sets);
    while((entry = PTreeTraverseNext(trav)))
@@ -83,10 +77,79 @@ long TBGCCollect(TB_p bank)
    }
    PTreeTraverseExit(trav);
 
+   trav = PTreeTraverseInit(bank->gc->term_stacks);
+   while((entry = PTreeTraverseNext(trav)))
+   {
+      PStack_p      stack = entry->key;
+      PStackPointer i;
+
+      for(i=0; i<PStackGetSP(stack); i++)
+      {
+         TBGCMarkTerm(bank, PStackElementP(stack, i));
+      }
+   }
+   PTreeTraverseExit(trav);
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: TBGCCollect()
+//
+//   Perform garbage collection on bank.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+long TBGCCollect(TB_p bank)
+{
+   assert(bank);
+   assert(bank->gc);
+
+   gc_mark_roots(bank);
+
    return TBGCSweep(bank);
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: TBGCCollectMinor()
+//
+//   Perform a minor collection on bank, i.e. only collect term cells
+//   created since the last collection. Requires generational
+//   collection to be enabled for bank (see TBGCEnableGenerations()).
+//   Marking still starts from all registered sets, but stops at the
+//   first old cell, so the pause is determined by the number of
+//   roots and young cells, not by the size of the bank.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+long TBGCCollectMinor(TB_p bank)
+{
+   assert(bank);
+   assert(bank->gc);
+   assert(bank->young);
+
+   bank->gc_minor = true;
+   gc_mark_roots(bank);
+
+   return TBGCSweepYoung(bank);
+}
+
+
 /*---------------------------------------------------------------------*/
 /*                        End of File                                  */
 /*---------------------------------------------------------------------*/
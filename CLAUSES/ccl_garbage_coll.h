@@ -39,6 +39,7 @@
 /*---------------------------------------------------------------------*/
 
 long TBGCCollect(TB_p bank);
+long TBGCCollectMinor(TB_p bank);
 
 #endif
 
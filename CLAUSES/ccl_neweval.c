@@ -57,11 +57,162 @@ static Eval_p evals_alloc_raw(int eval_no)
 
    eval->eval_no    = eval_no;
    eval->eval_count = 0;
+#ifdef EVAL_HEAP_QUEUES
+   for(int i=0; i<eval_no; i++)
+   {
+      eval->evals[i].heap_pos = -1;
+   }
+#endif
 
    return eval;
 }
 
 
+#ifdef EVAL_HEAP_QUEUES
+
+/*-----------------------------------------------------------------------
+//
+// Function: eval_heap_place()
+//
+//   Store eval at position i of the heap and record the position in
+//   eval.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes heap
+//
+/----------------------------------------------------------------------*/
+
+static inline void eval_heap_place(EvalHeap_p heap, Eval_p eval, long i)
+{
+   heap->heap[i] = eval;
+   eval->evals[heap->pos].heap_pos = i;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: eval_heap_bubble_up()
+//
+//   Move the entry at position i towards the root until its parent is
+//   smaller.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes heap
+//
+/----------------------------------------------------------------------*/
+
+static void eval_heap_bubble_up(EvalHeap_p heap, long i)
+{
+   Eval_p eval = heap->heap[i];
+   long   parent;
+
+   while(i)
+   {
+      parent = (i-1)/EVAL_HEAP_ARITY;
+      if(EvalCompare(eval, heap->heap[parent], heap->pos) >= 0)
+      {
+         break;
+      }
+      eval_heap_place(heap, heap->heap[parent], i);
+      i = parent;
+   }
+   eval_heap_place(heap, eval, i);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: eval_heap_drop_down()
+//
+//   Move the entry at position i towards the leaves until all its
+//   children are bigger.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes heap
+//
+/----------------------------------------------------------------------*/
+
+static void eval_heap_drop_down(EvalHeap_p heap, long i)
+{
+   Eval_p eval = heap->heap[i];
+   long   child, last, min_child;
+
+   while((child = i*EVAL_HEAP_ARITY+1) < heap->members)
+   {
+      last = MIN(child+EVAL_HEAP_ARITY, heap->members);
+      for(min_child = child++; child<last; child++)
+      {
+         if(EvalCompare(heap->heap[child], heap->heap[min_child],
+                        heap->pos) < 0)
+         {
+            min_child = child;
+         }
+      }
+      if(EvalCompare(heap->heap[min_child], eval, heap->pos) >= 0)
+      {
+         break;
+      }
+      eval_heap_place(heap, heap->heap[min_child], i);
+      i = min_child;
+   }
+   eval_heap_place(heap, eval, i);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: eval_heap_grow()
+//
+//   Double the size of the heap array. Realloc is emulated in terms
+//   of SizeMalloc()/SizeFree() as in PStackGrow().
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void eval_heap_grow(EvalHeap_p heap)
+{
+   Eval_p *tmp;
+   long   old_size = heap->size;
+
+   heap->size = heap->size*2;
+   tmp = SizeMalloc(heap->size*sizeof(Eval_p));
+   memcpy(tmp, heap->heap, old_size*sizeof(Eval_p));
+   SizeFree(heap->heap, old_size*sizeof(Eval_p));
+   heap->heap = tmp;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: trav_less()
+//
+//   Compare two entries of a traversal state (positions in heap).
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline bool trav_less(EvalHeap_p heap, PStack_p state,
+                             PStackPointer i, PStackPointer j)
+{
+   return EvalCompare(heap->heap[PStackElementInt(state, i)],
+                      heap->heap[PStackElementInt(state, j)],
+                      heap->pos) < 0;
+}
+
+#endif
+
+
+#ifndef EVAL_HEAP_QUEUES
+
 /*-----------------------------------------------------------------------
 //
 // Function: splay_tree()
@@ -149,6 +300,7 @@ static Eval_p splay_tree(Eval_p tree, Eval_p splay, int pos)
    return tree;
 }
 
+#endif
 
 
 /*---------------------------------------------------------------------*/
@@ -413,6 +565,8 @@ long EvalCompare(Eval_p ev1, Eval_p ev2, int pos)
 
 
 
+#ifndef EVAL_HEAP_QUEUES
+
 /*-----------------------------------------------------------------------
 //
 // Function: EvalTreeInsert()
@@ -668,6 +822,227 @@ void EvalTreePrintInOrder(FILE* out, Eval_p tree, int pos)
    EvalTreeTraverseExit(state);
 }
 
+#else
+
+/*-----------------------------------------------------------------------
+//
+// Function: EvalHeapAlloc()
+//
+//   Allocate an empty heap of evaluations, ordered by evaluation
+//   pos.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+EvalHeap_p EvalHeapAlloc(int pos)
+{
+   EvalHeap_p handle = EvalHeapCellAlloc();
+
+   handle->pos     = pos;
+   handle->size    = 64;
+   handle->members = 0;
+   handle->heap    = SizeMalloc(handle->size*sizeof(Eval_p));
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EvalHeapFree()
+//
+//   Free a heap. The evaluations are unlinked, but not freed.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void EvalHeapFree(EvalHeap_p junk)
+{
+   long i;
+
+   assert(junk);
+
+   for(i=0; i<junk->members; i++)
+   {
+      junk->heap[i]->evals[junk->pos].heap_pos = -1;
+   }
+   SizeFree(junk->heap, junk->size*sizeof(Eval_p));
+   EvalHeapCellFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EvalHeapInsert()
+//
+//   Insert newnode into the heap. newnode must not be in any heap
+//   for the same position.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes heap, memory operations
+//
+/----------------------------------------------------------------------*/
+
+void EvalHeapInsert(EvalHeap_p heap, Eval_p newnode)
+{
+   assert(newnode->evals[heap->pos].heap_pos == -1);
+   assert(heap->members < INT_MAX);
+
+   if(heap->members == heap->size)
+   {
+      eval_heap_grow(heap);
+   }
+   heap->heap[heap->members] = newnode;
+   heap->members++;
+   eval_heap_bubble_up(heap, heap->members-1);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EvalHeapExtractEntry()
+//
+//   Remove key from the heap and return it. Return NULL if key is not
+//   in the heap.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes heap
+//
+/----------------------------------------------------------------------*/
+
+Eval_p EvalHeapExtractEntry(EvalHeap_p heap, Eval_p key)
+{
+   long   i;
+   Eval_p last;
+
+   if(!heap)
+   {
+      return NULL;
+   }
+   i = key->evals[heap->pos].heap_pos;
+   if(i < 0 || i >= heap->members || heap->heap[i] != key)
+   {
+      return NULL;
+   }
+   key->evals[heap->pos].heap_pos = -1;
+   heap->members--;
+   if(i != heap->members)
+   {
+      last = heap->heap[heap->members];
+      heap->heap[i] = last;
+      if(i && EvalCompare(last, heap->heap[(i-1)/EVAL_HEAP_ARITY],
+                          heap->pos) < 0)
+      {
+         eval_heap_bubble_up(heap, i);
+      }
+      else
+      {
+         eval_heap_drop_down(heap, i);
+      }
+   }
+   return key;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EvalHeapTraverseInit()
+//
+//   Return a state for traversing the heap in ascending order. The
+//   state is a stack of heap positions, itself organized as a binary
+//   heap (the frontier of the traversal). The heap must not be
+//   changed while the traversal is in progress.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+PStack_p EvalHeapTraverseInit(EvalHeap_p heap)
+{
+   PStack_p stack = PStackAlloc();
+
+   if(heap && heap->members)
+   {
+      PStackPushInt(stack, 0);
+   }
+   return stack;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: EvalHeapTraverseNext()
+//
+//   Given a traversal state, return the next smallest evaluation and
+//   update the state. Return NULL if the traversal is complete.
+//
+// Global Variables: -
+//
+// Side Effects    : Updates stack
+//
+/----------------------------------------------------------------------*/
+
+Eval_p EvalHeapTraverseNext(PStack_p state, EvalHeap_p heap)
+{
+   long          res, child, last;
+   PStackPointer i, j, min;
+
+   if(PStackEmpty(state))
+   {
+      return NULL;
+   }
+   res = PStackElementInt(state, 0);
+
+   /* Remove the frontier minimum... */
+   PStackElementRef(state, 0)->i_val = PStackTopInt(state);
+   PStackDiscardTop(state);
+   for(i=0; (j = 2*i+1) < PStackGetSP(state); i=min)
+   {
+      min = i;
+      if(trav_less(heap, state, j, min))
+      {
+         min = j;
+      }
+      if(j+1 < PStackGetSP(state) && trav_less(heap, state, j+1, min))
+      {
+         min = j+1;
+      }
+      if(min == i)
+      {
+         break;
+      }
+      SWAP(*PStackElementRef(state, i), *PStackElementRef(state, min));
+   }
+
+   /* ...and add its children */
+   last = MIN(res*EVAL_HEAP_ARITY+1+EVAL_HEAP_ARITY, heap->members);
+   for(child = res*EVAL_HEAP_ARITY+1; child < last; child++)
+   {
+      PStackPushInt(state, child);
+      for(i=PStackGetTopSP(state); i; i=j)
+      {
+         j = (i-1)/2;
+         if(!trav_less(heap, state, i, j))
+         {
+            break;
+         }
+         SWAP(*PStackElementRef(state, i), *PStackElementRef(state, j));
+      }
+   }
+   return heap->heap[res];
+}
+
+#endif
 
 
 /*---------------------------------------------------------------------*/
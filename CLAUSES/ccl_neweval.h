@@ -23,6 +23,8 @@ Changes
 <3> Thu Apr 20 00:32:11 CEST 2006
     Imported code and history for new, more efficient evaluations for
     ccl_evaluations.h
+<4> Sat Oct 17 16:40:12 CEST 2026
+    Added d-ary heaps as an alternative to the splay trees
 
 -----------------------------------------------------------------------*/
 
@@ -47,6 +49,14 @@ typedef long EvalPriority;
 #define PrioLargestReasonable MEGA
 
 
+#ifdef EVAL_HEAP_QUEUES
+typedef struct simple_eval_cell
+{
+   EvalPriority      priority;   /* Technical considerations */
+   float             heuristic;  /* Heuristical evaluation   */
+   int               heap_pos;   /* Position in queue heap or -1 */
+}SimpleEvalCell, *SimpleEval_p;
+#else
 typedef struct simple_eval_cell
 {
    EvalPriority      priority;   /* Technical considerations */
@@ -54,6 +64,7 @@ typedef struct simple_eval_cell
    struct eval_cell* lson;       /* Successors in ordered tree */
    struct eval_cell* rson;
 }SimpleEvalCell, *SimpleEval_p;
+#endif
 
 typedef struct eval_cell
 {
@@ -64,6 +75,21 @@ typedef struct eval_cell
    SimpleEvalCell    evals[];
 }EvalCell, *Eval_p;
 
+/* Alternative to the splay trees: An indexed d-ary min-heap of
+   evaluations, ordered by the evaluation at position pos. The
+   position of each entry is kept in evals[pos].heap_pos, so that
+   arbitrary entries can be removed in O(log n). */
+
+#define EVAL_HEAP_ARITY 4
+
+typedef struct eval_heap_cell
+{
+   int     pos;      /* Which evaluation is the key */
+   long    size;     /* Allocated entries */
+   long    members;  /* Used entries */
+   Eval_p  *heap;
+}EvalHeapCell, *EvalHeap_p;
+
 
 /*---------------------------------------------------------------------*/
 /*        Macros for a common interface with old evaluations           */
@@ -85,6 +111,9 @@ extern long EvaluationCounter;
 
 #ifdef CONSTANT_MEM_ESTIMATE
 #define EVAL_MEM(eval_no) (32+(4*(eval_no)))
+#elif defined(EVAL_HEAP_QUEUES)
+#define EVAL_MEM(eval_no) (MEMSIZE(EvalCell)+(EVAL_SIZE((eval_no)))+\
+                           (eval_no)*sizeof(Eval_p))
 #else
 #define EVAL_MEM(eval_no) (MEMSIZE(EvalCell)+(EVAL_SIZE((eval_no))))
 #endif
@@ -103,6 +132,8 @@ void     EvalListChangePriority(Eval_p list, EvalPriority diff);
 bool     EvalGreater(Eval_p ev1, Eval_p ev2, int pos);
 long     EvalCompare(Eval_p ev1, Eval_p ev2, int pos);
 
+#ifndef EVAL_HEAP_QUEUES
+
 Eval_p   EvalTreeInsert(Eval_p *root, Eval_p newnode, int pos);
 Eval_p   EvalTreeFind(Eval_p *root, Eval_p key, int pos);
 Eval_p   EvalTreeExtractEntry(Eval_p *root, Eval_p key, int pos);
@@ -118,6 +149,24 @@ Eval_p   EvalTreeTraverseNext(PStack_p state, int pos);
 
 void EvalTreePrintInOrder(FILE* out, Eval_p tree, int pos);
 
+#else
+
+#define EvalHeapCellAlloc()    (EvalHeapCell*)SizeMalloc(sizeof(EvalHeapCell))
+#define EvalHeapCellFree(junk) SizeFree(junk, sizeof(EvalHeapCell))
+
+#define EvalHeapFindSmallest(eheap)\
+   (((eheap)&&(eheap)->members)?(eheap)->heap[0]:NULL)
+#define EvalHeapTraverseExit(stack) PStackFree(stack)
+
+EvalHeap_p EvalHeapAlloc(int pos);
+void       EvalHeapFree(EvalHeap_p junk);
+void       EvalHeapInsert(EvalHeap_p heap, Eval_p newnode);
+Eval_p     EvalHeapExtractEntry(EvalHeap_p heap, Eval_p key);
+PStack_p   EvalHeapTraverseInit(EvalHeap_p heap);
+Eval_p     EvalHeapTraverseNext(PStack_p state, EvalHeap_p heap);
+
+#endif
+
 #endif
 
 /*---------------------------------------------------------------------*/
@@ -25,9 +25,11 @@
 
 #define CCL_PARAMOD
 
+#include <clb_workpool.h>
 #include <ccl_clausesets.h>
 #include "ccl_clausecpos.h"
 #include <cte_replace.h>
+#include <cte_localsubst.h>
 
 /*---------------------------------------------------------------------*/
 /*                    Data type declarations                           */
@@ -61,8 +63,15 @@ typedef struct
    CompactPos  into_cpos;
    ClausePos_p into_pos;
    bool        subst_is_ho;
+   WorkPool_p  workers;   /* If set, filter partners in parallel */
 }ParamodInfoCell, *ParamodInfo_p;
 
+/* With a worker pool, the unifiability of the overlap term with the
+   candidate partner terms is only checked in parallel if the index
+   returns at least this many term occurrences. */
+
+#define PAR_PM_MIN_TERMS 512
+
 
 /*---------------------------------------------------------------------*/
 /*                Exported Functions and Variables                     */
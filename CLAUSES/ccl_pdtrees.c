@@ -22,6 +22,7 @@
 
 #include "ccl_pdtrees.h"
 #include <clb_ptrees.h>
+#include <clb_profile.h>
 #include <cte_lambda.h>
 #include "ccl_derivation.h"
 
@@ -32,6 +33,7 @@
 
 bool PDTreeUseAgeConstraints  = true;
 bool PDTreeUseSizeConstraints = true;
+bool PDTreeUseCode            = true;
 
 #ifdef PDT_COUNT_NODES
 unsigned long PDTNodeCounter = 0;
@@ -521,6 +523,7 @@ static long  delete_clause_entries(PTree_p *root, Clause_p clause, Deleter delet
 static bool pdtree_verify_node_constr(PDTree_p tree)
 {
    PDT_COUNT_INC(PDTNodeCounter);
+   PROF_COUNT(ProfPDTVisits);
 
    /* Is largest term at or beyond node greater than the query term? */
 
@@ -821,10 +824,549 @@ void pdt_node_print(FILE* out, PDTNode_p node, Sig_p sig, int level)
    }
 }
 
+/*-----------------------------------------------------------------------
+//
+// Function: pdtree_code_invalidate()
+//
+//   Drop the compiled form of tree (which is about to change).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void pdtree_code_invalidate(PDTree_p tree)
+{
+   assert(!tree->code_active);
+
+   if(tree->code)
+   {
+      PDTCodeFree(tree->code);
+      tree->code = NULL;
+   }
+   tree->code_searches = 0;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pdt_code_arrtree_succs()
+//
+//   Push the (f_code, node) pairs stored in the NumArrTree at tree
+//   onto stack, in ascending order of f_code.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static void pdt_code_arrtree_succs(NumArrTree_p tree, PStack_p stack)
+{
+   int i;
+
+   while(tree)
+   {
+      pdt_code_arrtree_succs(tree->lson, stack);
+      for(i=0; i<NUMARRTREEVALUES; i++)
+      {
+         if(tree->vals[i].p_val)
+         {
+            PStackPushInt(stack, tree->key+i);
+            PStackPushP(stack, tree->vals[i].p_val);
+         }
+      }
+      tree = tree->rson;
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pdt_code_f_succs()
+//
+//   Push the function symbol successors of node as (f_code, node)
+//   pairs onto stack, in ascending order of f_code. This walks the
+//   map directly instead of using an IntMapIter, as the compiled code
+//   must not miss any successor.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static void pdt_code_f_succs(PDTNode_p node, PStack_p stack)
+{
+   IntMap_p map = node->f_alternatives;
+
+   if(!map)
+   {
+      return;
+   }
+   switch(map->type)
+   {
+   case IMEmpty:
+         break;
+   case IMSingle:
+         if(map->values.value)
+         {
+            PStackPushInt(stack, map->max_key);
+            PStackPushP(stack, map->values.value);
+         }
+         break;
+   case IMArrTree:
+         pdt_code_arrtree_succs(map->values.tree, stack);
+         break;
+   default:
+         assert(false && "Unknown IntMap type.");
+         break;
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pdt_code_reserve()
+//
+//   Make sure that code has room for nodes more nodes, edges more
+//   edges and entries more entries.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void pdt_code_reserve(PDTCode_p code, long nodes, long edges,
+                             long entries)
+{
+   if(code->node_count+nodes > code->node_size)
+   {
+      code->node_size = MAX(2*code->node_size, code->node_count+nodes);
+      code->nodes = SecureRealloc(code->nodes,
+                                  code->node_size*sizeof(PDTCodeNodeCell));
+   }
+   if(code->edge_count+edges > code->edge_size)
+   {
+      code->edge_size = MAX(2*code->edge_size, code->edge_count+edges);
+      code->f_keys = SecureRealloc(code->f_keys,
+                                   code->edge_size*sizeof(FunCode));
+      code->f_next = SecureRealloc(code->f_next,
+                                   code->edge_size*sizeof(long));
+      code->v_vars = SecureRealloc(code->v_vars,
+                                   code->edge_size*sizeof(Term_p));
+      code->v_next = SecureRealloc(code->v_next,
+                                   code->edge_size*sizeof(long));
+   }
+   if(code->entry_count+entries > code->entry_size)
+   {
+      code->entry_size = MAX(2*code->entry_size, code->entry_count+entries);
+      code->entries = SecureRealloc(code->entries,
+                                    code->entry_size*sizeof(ClausePos_p));
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pdt_code_add_entries()
+//
+//   Append the keys of the PTree entries to the entries of code, in
+//   the same order as PTreeTraverseNext() would return them.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void pdt_code_add_entries(PDTCode_p code, PTree_p entries)
+{
+   while(entries)
+   {
+      pdt_code_add_entries(code, entries->lson);
+      pdt_code_reserve(code, 0, 0, 1);
+      code->entries[code->entry_count++] = entries->key;
+      entries = entries->rson;
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pdt_code_compile_node()
+//
+//   Append the code for the subtree at node to code and return the
+//   index of the node.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, computes lazy constraints in
+//                   the tree.
+//
+/----------------------------------------------------------------------*/
+
+static long pdt_code_compile_node(PDTCode_p code, PDTNode_p node,
+                                  PStack_p succs, PStack_p trav)
+{
+   long          idx, i, f_first, v_first, f_count, v_count;
+   PStackPointer base = PStackGetSP(succs);
+   PDTNode_p     next;
+
+   pdt_code_reserve(code, 1, 0, 0);
+   idx = code->node_count++;
+   code->nodes[idx].size_constr = PDTNodeGetSizeConstraint(node);
+   code->nodes[idx].age_constr  = PDTNodeGetAgeConstraint(node);
+
+   code->nodes[idx].e_first = code->entry_count;
+   pdt_code_add_entries(code, node->entries);
+   code->nodes[idx].e_count = code->entry_count-code->nodes[idx].e_first;
+
+   pdt_code_f_succs(node, succs);
+   f_count = (PStackGetSP(succs)-base)/2;
+   PObjMapTraverseInit(node->v_alternatives, trav);
+   while((next = PObjMapTraverseNext(trav, NULL)))
+   {
+      PStackPushP(succs, next);
+   }
+   PObjMapTraverseExit(trav);
+   v_count = PStackGetSP(succs)-base-2*f_count;
+
+   /* Reserve contiguous edge slots first, the children follow */
+   pdt_code_reserve(code, 0, f_count+v_count, 0);
+   f_first = code->edge_count;
+   v_first = f_first+f_count;
+   code->edge_count += f_count+v_count;
+   code->nodes[idx].f_first = f_first;
+   code->nodes[idx].f_count = f_count;
+   code->nodes[idx].v_first = v_first;
+   code->nodes[idx].v_count = v_count;
+
+   for(i=0; i<f_count; i++)
+   {
+      code->f_keys[f_first+i] = PStackElementInt(succs, base+2*i);
+      assert(!i || code->f_keys[f_first+i-1] < code->f_keys[f_first+i]);
+      code->f_next[f_first+i] =
+         pdt_code_compile_node(code, PStackElementP(succs, base+2*i+1),
+                               succs, trav);
+   }
+   for(i=0; i<v_count; i++)
+   {
+      next = PStackElementP(succs, base+2*f_count+i);
+      code->v_vars[v_first+i] = next->variable;
+      code->v_next[v_first+i] = pdt_code_compile_node(code, next,
+                                                      succs, trav);
+   }
+   while(PStackGetSP(succs) > base)
+   {
+      PStackDiscardTop(succs);
+   }
+   return idx;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pdt_code_find_fun()
+//
+//   Return the node reached from node via the edge for f_code, or -1.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline long pdt_code_find_fun(PDTCode_p code, PDTCodeNode_p node,
+                                     FunCode f_code)
+{
+   long lo = node->f_first, hi = node->f_first+node->f_count-1, mid;
+
+   while(lo <= hi)
+   {
+      mid = (lo+hi)/2;
+      if(code->f_keys[mid] < f_code)
+      {
+         lo = mid+1;
+      }
+      else if(code->f_keys[mid] > f_code)
+      {
+         hi = mid-1;
+      }
+      else
+      {
+         return code->f_next[mid];
+      }
+   }
+   return -1;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pdt_code_pop()
+//
+//   Leave the current node of the code search, undoing the term
+//   traversal and any variable binding made when entering it.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes tree state, backtracks subst
+//
+/----------------------------------------------------------------------*/
+
+static void pdt_code_pop(PDTree_p tree, PDTCode_p code, Subst_p subst)
+{
+   PDTCodeFrame_p frame = &(code->frames[--code->depth]);
+
+   if(frame->variable)
+   {
+      tree->term_weight += (TermStandardWeight(frame->term) -
+                            TermStandardWeight(frame->variable));
+      PStackPushP(tree->term_stack, frame->term);
+      SubstBacktrackToPos(subst, frame->prev_subst);
+   }
+   else if(frame->term)
+   {
+      TermLRTraversePrev(tree->term_stack, frame->term);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pdt_code_push()
+//
+//   Enter node (via an edge that consumed term, and, for variable
+//   edges, bound variable). If the query term is completely matched,
+//   make the entries of the node available. Otherwise, if the node
+//   constraints exclude a match, leave it immediately.
+//
+// Global Variables: PDTreeUseSizeConstraints, PDTreeUseAgeConstraints
+//
+// Side Effects    : Changes tree state
+//
+/----------------------------------------------------------------------*/
+
+static void pdt_code_push(PDTree_p tree, PDTCode_p code, Subst_p subst,
+                          long node, Term_p term, Term_p variable,
+                          PStackPointer prev_subst)
+{
+   PDTCodeFrame_p frame;
+   PDTCodeNode_p  handle = &(code->nodes[node]);
+
+   if(code->depth == code->frame_size)
+   {
+      code->frame_size = code->frame_size*2;
+      code->frames = SecureRealloc(code->frames,
+                                   code->frame_size*sizeof(PDTCodeFrameCell));
+   }
+   frame = &(code->frames[code->depth++]);
+   frame->node       = node;
+   frame->alt        = 0;
+   frame->term       = term;
+   frame->variable   = variable;
+   frame->prev_subst = prev_subst;
+
+   if(variable)
+   {
+      PStackDiscardTop(tree->term_stack);
+      tree->term_weight -= (TermStandardWeight(term) -
+                            TermStandardWeight(variable));
+   }
+   else if(term)
+   {
+      TermLRTraverseNext(tree->term_stack);
+   }
+#ifdef MEASURE_EXPENSIVE
+   tree->visited_count++;
+#endif
+   PDT_COUNT_INC(PDTNodeCounter);
+   PROF_COUNT(ProfPDTVisits);
+
+   if(handle->e_count && PStackEmpty(tree->term_stack))
+   {
+      /* Like PDTreeFindNextIndexedLeaf(), hand out the entries of a
+         newly reached leaf without looking at its constraints - the
+         caller checks each entry anyway. */
+      code->entry_cur = handle->e_first;
+      code->entry_end = handle->e_first+handle->e_count;
+   }
+   else if((PDTreeUseSizeConstraints &&
+            (tree->term_weight < handle->size_constr))
+           ||
+           (PDTreeUseAgeConstraints &&
+            tree->term_date != PDTREE_IGNORE_NF_DATE &&
+            !SysDateIsEarlier(tree->term_date, handle->age_constr)))
+   {
+      pdt_code_pop(tree, code, subst);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: pdt_code_find_next()
+//
+//   Code version of PDTreeFindNextDemodulator(). Symbols and
+//   variables are tried in the same order as in the pointer tree, but
+//   each leaf is reported only once.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes tree state, extends subst
+//
+/----------------------------------------------------------------------*/
+
+static ClausePos_p pdt_code_find_next(PDTree_p tree, Subst_p subst)
+{
+   PDTCode_p      code = tree->code;
+   PDTCodeFrame_p frame;
+   PDTCodeNode_p  node;
+   Term_p         term, var;
+   long           alt, sym_alt, next;
+   PStackPointer  prev_subst;
+
+   while(true)
+   {
+      if(code->entry_cur < code->entry_end)
+      {
+         return code->entries[code->entry_cur++];
+      }
+      if(!code->depth)
+      {
+         return NULL;
+      }
+      frame = &(code->frames[code->depth-1]);
+      node  = &(code->nodes[frame->node]);
+      if(PStackEmpty(tree->term_stack) || frame->alt > node->v_count)
+      {
+         pdt_code_pop(tree, code, subst);
+         continue;
+      }
+      term    = PStackTopP(tree->term_stack);
+      alt     = frame->alt++;
+      sym_alt = code->prefer_general?0:node->v_count;
+      if(alt == sym_alt)
+      {
+         if(!TermIsFreeVar(term) &&
+            (next = pdt_code_find_fun(code, node, term->f_code)) != -1)
+         {
+            pdt_code_push(tree, code, subst, next, term, NULL,
+                          PStackGetSP(subst));
+         }
+         continue;
+      }
+      if(code->prefer_general)
+      {
+         alt--;
+      }
+      var = code->v_vars[node->v_first+alt];
+      if(var->type != term->type)
+      {
+         continue;
+      }
+      prev_subst = PStackGetSP(subst);
+      if(var->binding?
+         (var->binding == term):
+         SubstMatchComplete(var, term, subst))
+      {
+         pdt_code_push(tree, code, subst, code->v_next[node->v_first+alt],
+                       term, var, prev_subst);
+      }
+      else
+      {
+         SubstBacktrackToPos(subst, prev_subst);
+      }
+   }
+}
+
+
 /*---------------------------------------------------------------------*/
 /*                         Exported Functions                          */
 /*---------------------------------------------------------------------*/
 
+/*-----------------------------------------------------------------------
+//
+// Function: PDTCodeCompile()
+//
+//   Create the compiled form of tree. Only first-order trees (without
+//   DeBruijn alternatives) can be compiled.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, computes lazy constraints in
+//                   the tree.
+//
+/----------------------------------------------------------------------*/
+
+PDTCode_p PDTCodeCompile(PDTree_p tree)
+{
+   PDTCode_p handle = PDTCodeCellAlloc();
+   PStack_p  succs, trav;
+
+   assert(problemType == PROBLEM_FO);
+
+   handle->node_size   = tree->node_count+1;
+   handle->edge_size   = tree->node_count+1;
+   handle->entry_size  = MAX(tree->clause_count, 1);
+   handle->nodes       = SecureMalloc(handle->node_size*sizeof(PDTCodeNodeCell));
+   handle->f_keys      = SecureMalloc(handle->edge_size*sizeof(FunCode));
+   handle->f_next      = SecureMalloc(handle->edge_size*sizeof(long));
+   handle->v_vars      = SecureMalloc(handle->edge_size*sizeof(Term_p));
+   handle->v_next      = SecureMalloc(handle->edge_size*sizeof(long));
+   handle->entries     = SecureMalloc(handle->entry_size*sizeof(ClausePos_p));
+   handle->node_count  = 0;
+   handle->edge_count  = 0;
+   handle->entry_count = 0;
+   handle->frame_size  = 16;
+   handle->frames      = SecureMalloc(handle->frame_size*
+                                      sizeof(PDTCodeFrameCell));
+   handle->depth       = 0;
+   handle->entry_cur   = 0;
+   handle->entry_end   = 0;
+   handle->prefer_general = true;
+
+   succs = PStackAlloc();
+   trav  = PStackAlloc();
+   pdt_code_compile_node(handle, tree->tree, succs, trav);
+   PStackFree(succs);
+   PStackFree(trav);
+   assert(handle->edge_count == handle->node_count-1);
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: PDTCodeFree()
+//
+//   Free a compiled PDTree.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void PDTCodeFree(PDTCode_p junk)
+{
+   assert(junk);
+
+   FREE(junk->nodes);
+   FREE(junk->f_keys);
+   FREE(junk->f_next);
+   FREE(junk->v_vars);
+   FREE(junk->v_next);
+   FREE(junk->entries);
+   FREE(junk->frames);
+   PDTCodeCellFree(junk);
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: PDTreeAllocWDeleter()
@@ -859,6 +1401,9 @@ PDTree_p PDTreeAllocWDeleter(TB_p bank, Deleter deleter)
    handle->visited_count   = 0;
    handle->bank            = bank;
    handle->deleter         = deleter;
+   handle->code            = NULL;
+   handle->code_searches   = 0;
+   handle->code_active     = false;
 
    return handle;
 }
@@ -883,6 +1428,10 @@ void PDTreeFree(PDTree_p tree)
    PStackFree(tree->term_stack);
    PStackFree(tree->term_proc);
    assert(!tree->store_stack);
+   if(tree->code)
+   {
+      PDTCodeFree(tree->code);
+   }
    PDTreeCellFree(tree);
 }
 
@@ -1120,6 +1669,7 @@ bool PDTreeInsertTerm(PDTree_p tree, Term_p term, ClausePos_p demod_side,
       term = LambdaEtaReduceDB(tree->bank, term);
    }
 
+   pdtree_code_invalidate(tree);
    TermLRTraverseInit(tree->term_stack, term);
    node              = tree->tree;
    tmp               = TermStandardWeight(term);
@@ -1268,6 +1818,7 @@ long PDTreeDelete(PDTree_p tree, Term_p term, Clause_p clause)
       term = LambdaEtaReduceDB(tree->bank, term);
    }
 
+   pdtree_code_invalidate(tree);
    PStack_p  del_stack = PStackAlloc();
    TermLRTraverseInit(tree->term_stack, term);
    node = tree->tree;
@@ -1390,6 +1941,31 @@ void PDTreeSearchInit(PDTree_p tree, Term_p term, SysDate age_constr,
 
    TermLRTraverseInit(tree->term_stack, term);
    PStackReset(tree->term_proc);
+   tree->term             = term;
+   tree->term_date        = age_constr;
+   assert(TermStandardWeight(term) == TermWeight(term,DEFAULT_VWEIGHT,DEFAULT_FWEIGHT));
+   tree->term_weight      = TermStandardWeight(term);
+   tree->match_count++;
+   PROF_COUNT(ProfPDTSearches);
+
+   tree->code_searches++;
+   if(!tree->code && PDTreeUseCode && problemType == PROBLEM_FO &&
+      tree->code_searches >= PDT_CODE_MIN_SEARCHES+
+                             tree->node_count*PDT_CODE_SEARCHES_PER_NODE)
+   {
+      tree->code = PDTCodeCompile(tree);
+   }
+   if(tree->code)
+   {
+      tree->code_active          = true;
+      tree->code->prefer_general = prefer_general;
+      tree->code->depth          = 0;
+      tree->code->entry_cur      = 0;
+      tree->code->entry_end      = 0;
+      pdt_code_push(tree, tree->code, NULL, 0, NULL, NULL, 0);
+      return;
+   }
+
    tree->tree_pos         = tree->tree;
    tree->tree->trav_state = 0;
    if(prefer_general)
@@ -1404,11 +1980,6 @@ void PDTreeSearchInit(PDTree_p tree, Term_p term, SysDate age_constr,
       PObjMapTraverseInit(tree->tree_pos->v_alternatives,
                           tree->tree_pos->var_traverse_stack);
    }
-   tree->term             = term;
-   tree->term_date        = age_constr;
-   assert(TermStandardWeight(term) == TermWeight(term,DEFAULT_VWEIGHT,DEFAULT_FWEIGHT));
-   tree->term_weight      = TermStandardWeight(term);
-   tree->match_count++;
 }
 
 /*-----------------------------------------------------------------------
@@ -1433,6 +2004,7 @@ void PDTreeSearchExit(PDTree_p tree)
       PTreeTraverseExit(tree->store_stack);
       tree->store_stack = NULL;
    }
+   tree->code_active = false;
    tree->term = NULL;
 }
 
@@ -1453,6 +2025,8 @@ void PDTreeSearchExit(PDTree_p tree)
 
 PDTNode_p PDTreeFindNextIndexedLeaf(PDTree_p tree, Subst_p subst)
 {
+   assert(!tree->code_active);
+
    while(tree->tree_pos)
    {
       // if it is FOL problem, then if it has entries it is a leaf
@@ -1496,8 +2070,18 @@ PDTNode_p PDTreeFindNextIndexedLeaf(PDTree_p tree, Subst_p subst)
 
 ClausePos_p PDTreeFindNextDemodulator(PDTree_p tree, Subst_p subst)
 {
-   PTree_p res_cell = NULL;
+   PTree_p     res_cell = NULL;
+   ClausePos_p res;
 
+   if(tree->code_active)
+   {
+      res = pdt_code_find_next(tree, subst);
+      if(res)
+      {
+         PROF_COUNT(ProfPDTHits);
+      }
+      return res;
+   }
    while(tree->tree_pos)
    {
       if(tree->store_stack)
@@ -1505,6 +2089,7 @@ ClausePos_p PDTreeFindNextDemodulator(PDTree_p tree, Subst_p subst)
          res_cell = PTreeTraverseNext(tree->store_stack);
          if(res_cell)
          {
+            PROF_COUNT(ProfPDTHits);
             return res_cell->key;
          }
          else
@@ -87,6 +87,59 @@ typedef struct pdt_node_cell
                                   so we mark leaves explicitly -- an optimization */
 }PDTNodeCell, *PDTNode_p;
 
+/* A read-only, compiled form of a (first-order) PDTree. Nodes are
+   stored in depth-first order in one array, and their outgoing edges
+   and indexed entries are contiguous slices of shared arrays. Function
+   symbol edges are sorted by f_code, variable edges and entries are
+   in the same order as in the pointer tree, so that searches in both
+   forms return results in the same order. */
+
+typedef struct pdt_code_node_cell
+{
+   long     size_constr;   /* As in PDTNodeCell, computed at */
+   SysDate  age_constr;    /* compile time */
+   long     f_first;       /* Function symbol edges */
+   long     f_count;
+   long     v_first;       /* Variable edges */
+   long     v_count;
+   long     e_first;       /* Indexed entries */
+   long     e_count;
+}PDTCodeNodeCell, *PDTCodeNode_p;
+
+/* Search state: One frame for each node on the current path */
+
+typedef struct pdt_code_frame_cell
+{
+   long          node;
+   long          alt;        /* Next alternative to try */
+   Term_p        term;       /* Query subterm consumed by the edge
+                                into node, NULL for the root */
+   Term_p        variable;   /* Variable of the edge, if any */
+   PStackPointer prev_subst; /* For backtracking of bindings */
+}PDTCodeFrameCell, *PDTCodeFrame_p;
+
+typedef struct pdt_code_cell
+{
+   PDTCodeNode_p nodes;
+   long          node_count;
+   long          node_size;
+   FunCode       *f_keys;     /* Edges, ordered by f_code per node */
+   long          *f_next;
+   Term_p        *v_vars;
+   long          *v_next;
+   long          edge_count;
+   long          edge_size;
+   ClausePos_p   *entries;
+   long          entry_count;
+   long          entry_size;
+   PDTCodeFrame_p frames;
+   long          frame_size;
+   long          depth;
+   long          entry_cur;   /* Entries of the current leaf still */
+   long          entry_end;   /* to be returned */
+   bool          prefer_general;
+}PDTCodeCell, *PDTCode_p;
+
 /* A PDTreeCell is an object encapsulating a PDTree and the necessary
    data structures to efficiently seach it */
 
@@ -110,6 +163,9 @@ typedef struct pd_tree_cell
    TB_p      bank;            /* When we make a prefix term, we want to
                                  make it shared */
    Deleter   deleter;         /* frees the extra data stored in ClausePos_p */
+   PDTCode_p code;            /* Compiled form, NULL if outdated */
+   unsigned long code_searches; /* Searches since last change */
+   bool      code_active;     /* Current search uses code */
 }PDTreeCell, *PDTree_p;
 
 
@@ -166,6 +222,20 @@ void      PDTreeFree(PDTree_p tree);
 
 extern bool PDTreeUseAgeConstraints;
 extern bool PDTreeUseSizeConstraints;
+extern bool PDTreeUseCode;
+
+/* Compile a (FO) tree once it has been searched this often without
+   being changed, plus PDT_CODE_SEARCHES_PER_NODE times for each of
+   its nodes. Compilation touches every node, so it has to be
+   amortized over many searches. */
+#define PDT_CODE_MIN_SEARCHES      32
+#define PDT_CODE_SEARCHES_PER_NODE 8
+
+#define   PDTCodeCellAlloc()    (PDTCodeCell*)SizeMalloc(sizeof(PDTCodeCell))
+#define   PDTCodeCellFree(junk) SizeFree(junk, sizeof(PDTCodeCell))
+
+PDTCode_p PDTCodeCompile(PDTree_p tree);
+void      PDTCodeFree(PDTCode_p junk);
 
 #define PDTNodeGetSizeConstraint(node) ((node)->size_constr != -1 ? (node)->size_constr : pdt_compute_size_constraint((node)))
 #define PDTNodeGetAgeConstraint(node) (!SysDateIsInvalid((node)->age_constr))? (node)->age_constr: pdt_compute_age_constraint((node))
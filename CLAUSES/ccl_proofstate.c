@@ -20,6 +20,8 @@
 
 #include "ccl_proofstate.h"
 #include <picosat.h>
+#include <dirent.h>
+#include <sys/stat.h>
 
 
 
@@ -38,6 +40,113 @@ char* UseInlinedWatchList = WATCHLIST_INLINE_STRING;
 /*                         Internal Functions                          */
 /*---------------------------------------------------------------------*/
 
+/*-----------------------------------------------------------------------
+//
+// Function: str_cmp_wrapper()
+//
+//   Compare two strings stored as PStack elements.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static int str_cmp_wrapper(const void* s1, const void* s2)
+{
+   const IntOrP* e1 = (const IntOrP*) s1;
+   const IntOrP* e2 = (const IntOrP*) s2;
+
+   return strcmp(e1->p_val, e2->p_val);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: load_watchlist_file()
+//
+//   Parse the clauses in file into state->watchlist, registering
+//   them as the hints from one proof.
+//
+// Global Variables: -
+//
+// Side Effects    : IO, memory ops.
+//
+/----------------------------------------------------------------------*/
+
+static void load_watchlist_file(ProofState_p state, char* file,
+                                IOFormat parse_format)
+{
+   Scanner_p   in;
+   ClauseSet_p hints = ClauseSetAlloc();
+
+   in = CreateScanner(StreamTypeFile, file, true, NULL, true);
+   ScannerSetFormat(in, parse_format);
+   ClauseSetParseList(in, hints, state->terms);
+   CheckInpTok(in, NoToken);
+   DestroyScanner(in);
+
+   WatchlistIndexAddProof(state->wlindex, hints, file);
+   ClauseSetInsertSet(state->watchlist, hints);
+   ClauseSetFree(hints);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: load_watchlist_dir()
+//
+//   Load all regular files in dir (in alphabetic order) as
+//   watchlist files, each representing one proof.
+//
+// Global Variables: -
+//
+// Side Effects    : IO, memory ops.
+//
+/----------------------------------------------------------------------*/
+
+static void load_watchlist_dir(ProofState_p state, char* dirname,
+                               IOFormat parse_format)
+{
+   DIR           *dir;
+   struct dirent *entry;
+   struct stat   info;
+   PStack_p      files = PStackAlloc();
+   DStr_p        path = DStrAlloc();
+   char*         file;
+   PStackPointer i;
+
+   dir = opendir(dirname);
+   if(!dir)
+   {
+      TmpErrno = errno;
+      SysError("Cannot open watchlist directory %s", FILE_ERROR, dirname);
+   }
+   while((entry = readdir(dir)))
+   {
+      DStrSet(path, dirname);
+      DStrAppendChar(path, '/');
+      DStrAppendStr(path, entry->d_name);
+      if(entry->d_name[0] != '.' &&
+         stat(DStrView(path), &info) == 0 && S_ISREG(info.st_mode))
+      {
+         PStackPushP(files, SecureStrdup(DStrView(path)));
+      }
+   }
+   closedir(dir);
+
+   PStackSort(files, str_cmp_wrapper);
+   for(i=0; i<PStackGetSP(files); i++)
+   {
+      file = PStackElementP(files, i);
+      load_watchlist_file(state, file, parse_format);
+      FREE(file);
+   }
+   DStrFree(path);
+   PStackFree(files);
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: clause_set_analyse_gc()
@@ -164,6 +273,7 @@ ProofState_p ProofStateAlloc(FunctionProperties free_symb_prop)
    handle->unprocessed          = ClauseSetAlloc();
    handle->tmp_store            = ClauseSetAlloc();
    handle->eval_store           = ClauseSetAlloc();
+   handle->lazy_store           = ClauseSetAlloc();
    handle->archive              = ClauseSetAlloc();
    handle->watchlist            = ClauseSetAlloc();
    handle->f_archive            = FormulaSetAlloc();
@@ -178,6 +288,7 @@ ProofState_p ProofStateAlloc(FunctionProperties free_symb_prop)
    handle->demods[1]            = handle->processed_pos_eqns;
    handle->demods[2]            = NULL;
    GlobalIndicesNull(&(handle->wlindices));
+   handle->wlindex              = WatchlistIndexAlloc(handle->signature);
    handle->state_is_complete       = true;
    handle->has_interpreted_symbols = false;
    handle->definition_store     = DefStoreAlloc(handle->terms);
@@ -194,6 +305,7 @@ ProofState_p ProofStateAlloc(FunctionProperties free_symb_prop)
    TBGCRegisterClauseSet(handle->terms, handle->unprocessed);
    TBGCRegisterClauseSet(handle->terms, handle->tmp_store);
    TBGCRegisterClauseSet(handle->terms, handle->eval_store);
+   TBGCRegisterClauseSet(handle->terms, handle->lazy_store);
    TBGCRegisterClauseSet(handle->terms, handle->archive);
    TBGCRegisterClauseSet(handle->terms, handle->watchlist);
    TBGCRegisterClauseSet(handle->terms, handle->definition_store->def_clauses);
@@ -236,6 +348,11 @@ ProofState_p ProofStateAlloc(FunctionProperties free_symb_prop)
    handle->satcheck_encoding_stime = 0.0;
    handle->satcheck_solver_stime   = 0.0;
 
+   handle->lazy_held_count       = 0;
+   handle->lazy_promoted_count   = 0;
+   handle->lazy_orphan_count     = 0;
+   handle->lazy_held_lits        = 0;
+   handle->lazy_promoted_lits    = 0;
    handle->filter_orphans_base   = 0;
    handle->forward_contract_base = 0;
 
@@ -272,7 +389,8 @@ ProofState_p ProofStateAlloc(FunctionProperties free_symb_prop)
 // Function: ProofStateLoadWatchlist()
 //
 //   Load the watchlist (if requested and not inline), remove it if
-//   not requested.
+//   not requested. If watchlist_filename names a directory, every
+//   file in it is read as the watchlist of a separate proof.
 //
 // Global Variables: -
 //
@@ -284,7 +402,7 @@ void ProofStateLoadWatchlist(ProofState_p state,
                              char* watchlist_filename,
                              IOFormat parse_format)
 {
-   Scanner_p in;
+   struct stat info;
 
    assert(state->watchlist);
 
@@ -292,12 +410,14 @@ void ProofStateLoadWatchlist(ProofState_p state,
    {
       if(watchlist_filename!=UseInlinedWatchList)
       {
-         in = CreateScanner(StreamTypeFile, watchlist_filename, true, NULL, true);
-         ScannerSetFormat(in, parse_format);
-         ClauseSetParseList(in, state->watchlist,
-                            state->terms);
-         CheckInpTok(in, NoToken);
-         DestroyScanner(in);
+         if(stat(watchlist_filename, &info) == 0 && S_ISDIR(info.st_mode))
+         {
+            load_watchlist_dir(state, watchlist_filename, parse_format);
+         }
+         else
+         {
+            load_watchlist_file(state, watchlist_filename, parse_format);
+         }
       }
       ClauseSetSetTPTPType(state->watchlist, CPTypeWatchClause);
       ClauseSetSetProp(state->watchlist, CPWatchOnly);
@@ -346,6 +466,8 @@ void ProofStateInitWatchlist(ProofState_p state, OCB_p ocb)
       ClauseSetIndexedInsertClauseSet(state->watchlist, tmpset);
       ClauseSetFree(tmpset);
       GlobalIndicesInsertClauseSet(&(state->wlindices),state->watchlist, false);
+      WatchlistIndexInit(state->wlindex, state->watchlist,
+                         problemType == PROBLEM_FO);
       // ClauseSetPrint(stdout, state->watchlist, true);
    }
 }
@@ -378,6 +500,7 @@ void ProofStateResetClauseSets(ProofState_p state, bool term_gc)
    ClauseSetFreeClauses(state->unprocessed);
    ClauseSetFreeClauses(state->tmp_store);
    ClauseSetFreeClauses(state->eval_store);
+   ClauseSetFreeClauses(state->lazy_store);
    ClauseSetFreeClauses(state->archive);
    ClauseSetFreeClauses(state->ax_archive);
    FormulaSetFreeFormulas(state->f_ax_archive);
@@ -386,6 +509,7 @@ void ProofStateResetClauseSets(ProofState_p state, bool term_gc)
    {
       ClauseSetFreeClauses(state->watchlist);
       GlobalIndicesReset(&(state->wlindices));
+      WatchlistIndexReset(state->wlindex);
    }
    if(term_gc)
    {
@@ -420,6 +544,7 @@ void ProofStateFree(ProofState_p junk)
    ClauseSetFree(junk->unprocessed);
    ClauseSetFree(junk->tmp_store);
    ClauseSetFree(junk->eval_store);
+   ClauseSetFree(junk->lazy_store);
    ClauseSetFree(junk->archive);
    ClauseSetFree(junk->ax_archive);
    FormulaSetFree(junk->f_archive);
@@ -430,6 +555,7 @@ void ProofStateFree(ProofState_p junk)
       ClauseSetFree(junk->watchlist);
    }
    GlobalIndicesFreeIndices(&(junk->wlindices));
+   WatchlistIndexFree(junk->wlindex);
 
    DefStoreFree(junk->definition_store);
    if(junk->fvi_cspec)
@@ -735,6 +861,26 @@ void ProofStateStatisticsPrint(FILE* out, ProofState_p state)
    fprintf(out,
            COMCHAR" ...number of literals in the above   : %ld\n",
            state->unprocessed->literals);
+   if(state->lazy_held_count)
+   {
+      fprintf(out,
+              COMCHAR" Lazily held new clauses              : %ld\n"
+              COMCHAR" ...fully processed later             : %ld\n"
+              COMCHAR" ...discarded as orphans              : %ld\n"
+              COMCHAR" ...never processed                   : %ld\n"
+              COMCHAR" Clauses never simplified or evaluated: %ld\n"
+              COMCHAR" ...number of literals in the above   : %ld\n",
+              state->lazy_held_count,
+              state->lazy_promoted_count,
+              state->lazy_orphan_count,
+              state->lazy_store->members,
+              state->lazy_held_count-state->lazy_promoted_count,
+              state->lazy_held_lits-state->lazy_promoted_lits);
+   }
+   if(state->watchlist)
+   {
+      WatchlistIndexStatisticsPrint(out, state->wlindex);
+   }
    fprintf(out,
            COMCHAR" Current number of archived formulas  : %ld\n",
            state->f_archive->members);
@@ -762,6 +908,7 @@ void ProofStateStatisticsPrint(FILE* out, ProofState_p state)
               TBTermNodes(state->terms),
               ClauseSetGetTermNodes(state->tmp_store)+
               ClauseSetGetTermNodes(state->eval_store)+
+              ClauseSetGetTermNodes(state->lazy_store)+
               ClauseSetGetTermNodes(state->processed_pos_rules)+
               ClauseSetGetTermNodes(state->processed_pos_eqns)+
               ClauseSetGetTermNodes(state->processed_neg_units)+
@@ -29,6 +29,7 @@
 #include <ccl_def_handling.h>
 #include <ccl_garbage_coll.h>
 #include <ccl_global_indices.h>
+#include <ccl_watchlist.h>
 #include <ccl_rewrite.h>
 #include <picosat.h>
 
@@ -58,6 +59,10 @@ typedef struct proofstatecell
    ClauseSet_p   unprocessed;
    ClauseSet_p   tmp_store;
    ClauseSet_p   eval_store;
+   ClauseSet_p   lazy_store;      /* New clauses not yet simplified
+                                     and evaluated, ordered only by
+                                     symbol count and age (see
+                                     lazy_eval_batch) */
    ClauseSet_p   archive;
    FormulaSet_p  f_archive;
    PStack_p      extract_roots;
@@ -70,6 +75,8 @@ typedef struct proofstatecell
                                      processed_pos_eqns */
    ClauseSet_p   watchlist;
    GlobalIndices wlindices;
+   WatchlistIndex_p wlindex;      /* Unit subsumption index and
+                                     proof progress for watchlist */
    bool          state_is_complete;
    bool          has_interpreted_symbols;
    DefStore_p    definition_store;
@@ -112,6 +119,11 @@ typedef struct proofstatecell
    double        satcheck_preproc_stime;
    double        satcheck_encoding_stime;
    double        satcheck_solver_stime;
+   unsigned long lazy_held_count;     /* Clauses put into lazy_store */
+   unsigned long lazy_promoted_count; /* ...and fully processed later */
+   unsigned long lazy_orphan_count;   /* ...and discarded as orphans */
+   unsigned long lazy_held_lits;      /* Literals of the held clauses */
+   unsigned long lazy_promoted_lits;  /* ...and of the promoted ones */
    unsigned long filter_orphans_base;  /* Number of back-simplified
                                           clauses at last orphan
                                           filtering */
@@ -160,6 +172,7 @@ long         ProofStateProcessDistinct(ProofState_p state);
 
 #define      ProofStateStorage(state)                   \
    (ClauseSetStorage((state)->unprocessed)+             \
+    ClauseSetStorage((state)->lazy_store)+              \
     ClauseSetStorage((state)->processed_pos_rules)+     \
     ClauseSetStorage((state)->processed_pos_eqns)+      \
     ClauseSetStorage((state)->processed_neg_units)+     \
@@ -174,7 +187,12 @@ long         ProofStateProcessDistinct(ProofState_p state);
     ClauseSetCardinality((state)->processed_non_units))
 
 #define      ProofStateUnprocCardinality(state)  \
-    ClauseSetCardinality((state)->unprocessed)
+   (ClauseSetCardinality((state)->unprocessed)+\
+    ClauseSetCardinality((state)->lazy_store))
+
+#define      ProofStateUnprocEmpty(state)  \
+   (ClauseSetEmpty((state)->unprocessed)&&\
+    ClauseSetEmpty((state)->lazy_store))
 
 #define      ProofStateCardinality(state)          \
    (ProofStateProcCardinality(state)+              \
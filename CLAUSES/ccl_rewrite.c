@@ -240,6 +240,7 @@ static RWResultType term_is_top_rewritable(TB_p bank, OCB_p ocb,
             else
             {
                TermAddRWLink(term, repl, new_demod, ClauseIsSOS(new_demod), res);
+               TBGCNoteRWLink(bank, term, repl);
                RewriteUncached++;
             }
          }
@@ -280,6 +281,7 @@ static RWResultType term_is_top_rewritable(TB_p bank, OCB_p ocb,
             else
             {
                TermAddRWLink(term, repl, new_demod, ClauseIsSOS(new_demod), res);
+               TBGCNoteRWLink(bank, term, repl);
                RewriteUncached++;
             }
          }
@@ -339,7 +341,7 @@ static bool term_is_rewritable(TB_p bank, OCB_p ocb, Term_p term, Clause_p
 
    /* assert(!TermIsRewritten(term));*/
 
-   if(SysDateEqual(term->rw_data.nf_date[RewriteAdr(FullRewrite)], nf_date))
+   if(SysDateEqual(TermNFDates(term)[RewriteAdr(FullRewrite)], nf_date))
    {
       return false;
    }
@@ -376,8 +378,8 @@ static bool term_is_rewritable(TB_p bank, OCB_p ocb, Term_p term, Clause_p
                             TPIsRewritten|TPIsRRewritten)
       &&!restricted_rw)
    {
-      term->rw_data.nf_date[RewriteAdr(RuleRewrite)] =
-         term->rw_data.nf_date[RewriteAdr(FullRewrite)] = nf_date;
+      TermNFDates(term)[RewriteAdr(RuleRewrite)] = nf_date;
+      TermNFDates(term)[RewriteAdr(FullRewrite)] = nf_date;
    }
    /* printf("...term_is_rewritable() = false (no match)\n");*/
    return false;
@@ -702,6 +704,7 @@ static Term_p rewrite_with_clause_set(OCB_p ocb, TB_p bank, Term_p term,
       assert(pos->clause->ident);
       TermAddRWLink(term, repl, pos->clause, ClauseIsSOS(pos->clause),
                     restricted_rw?RWAlwaysRewritable:RWLimitedRewritable);
+      TBGCNoteRWLink(bank, term, repl);
       RewriteUncached++;
       // assert(TOGreater(ocb, term, repl, DEREF_NEVER, DEREF_NEVER));
       // The assertion is logically true, but in practice LPO fails on
@@ -802,6 +805,7 @@ static bool term_subterm_rewrite(RWDesc_p desc, Term_p *term, bool lambda_demod)
       assert(new_term!=*term);
       TermAddRWLink(*term, new_term, REWRITE_AT_SUBTERM, false,
                     RWAlwaysRewritable);
+      TBGCNoteRWLink(desc->bank, *term, new_term);
       *term = new_term;
    }
    else
@@ -841,7 +845,7 @@ static Term_p term_li_normalform(RWDesc_p desc, Term_p term,
    assert(!TermIsTopRewritten(term)||restricted_rw);
 
    if(!TermIsRewritten(term)&&
-      !SysDateIsEarlier(term->rw_data.nf_date[desc->level-1],desc->demod_date))
+      !SysDateIsEarlier(TermNFDates(term)[desc->level-1],desc->demod_date))
    {
       return term;
    }
@@ -885,10 +889,10 @@ static Term_p term_li_normalform(RWDesc_p desc, Term_p term,
       be due to the extra constraint and does not carry over. */
    if(!TermIsRewritten(term)&&!restricted_rw)
    {
-      term->rw_data.nf_date[RewriteAdr(RuleRewrite)] = desc->demod_date;
+      TermNFDates(term)[RewriteAdr(RuleRewrite)] = desc->demod_date;
       if(desc->level == FullRewrite)
       {
-         term->rw_data.nf_date[RewriteAdr(FullRewrite)] = desc->demod_date;
+         TermNFDates(term)[RewriteAdr(FullRewrite)] = desc->demod_date;
       }
    }
    return term;
@@ -1108,6 +1112,7 @@ static long term_find_rw_clauses(Clause_p demod,
             else
             {
                TermAddRWLink(term, repl, demod, ClauseIsSOS(demod), rwres);
+               TBGCNoteRWLink(eqn->bank, term, repl);
                RewriteUncached++;
                //TermDeleteRWLink(term);
             }
@@ -1163,12 +1168,145 @@ static long tree_find_rw_clauses(Clause_p demod,
 }
 
 
+/* Parallel matching for backward rewriting: The pattern is matched
+   against each of the term occurrences, one LocalSubst per worker. */
+
+typedef struct par_match_job_cell
+{
+   Term_p       pattern;
+   PStack_p     occs;
+   bool         *hits;
+   LocalSubst_p substs[WORKPOOL_MAX_WORKERS];
+}ParMatchJobCell, *ParMatchJob_p;
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: par_match_slice()
+//
+//   Work function for the worker pool: Check which of the term
+//   occurrences [first,last) of the job are instances of the pattern
+//   and record the result in job->hits.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes job->hits
+//
+/----------------------------------------------------------------------*/
+
+static void par_match_slice(void* data, int worker, long first, long last)
+{
+   ParMatchJob_p job   = data;
+   LocalSubst_p  subst = job->substs[worker];
+   SubtermOcc_p  occ;
+   long          i;
+
+   for(i=first; i<last; i++)
+   {
+      occ = PStackElementP(job->occs, i);
+      job->hits[i] = LocalSubstComputeMatch(subst, job->pattern, occ->term);
+      LocalSubstBacktrack(subst);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: par_find_rw_clauses()
+//
+//   Push all clauses in the termtrees (which are consumed) that are
+//   rewritable with lterm->rterm onto stack. Return number of
+//   clauses. If there are enough term occurrences, the workers of
+//   pool first find out which of them match lterm. Only these are
+//   then processed (sequentially, as they change the term bank). The
+//   result is the same as for tree_find_rw_clauses() on each tree.
+//
+// Global Variables: BWRWMatchAttempts
+//
+// Side Effects    : As tree_find_rw_clauses(), uses pool
+//
+/----------------------------------------------------------------------*/
+
+static long par_find_rw_clauses(Clause_p demod,
+                                OCB_p ocb,
+                                PStack_p termtrees,
+                                PStack_p stack,
+                                Term_p lterm,
+                                Term_p rterm,
+                                bool oriented,
+                                SysDate nf_date,
+                                WorkPool_p pool)
+{
+   long            res = 0, i, items;
+   PStack_p        occs = PStackAlloc(), iterstack;
+   SubtermTree_p   cell;
+   ParMatchJobCell job;
+   int             w;
+
+   while(!PStackEmpty(termtrees))
+   {
+      iterstack = PTreeTraverseInit(PStackPopP(termtrees));
+      while((cell = PTreeTraverseNext(iterstack)))
+      {
+         PStackPushP(occs, cell->key);
+      }
+      PTreeTraverseExit(iterstack);
+   }
+   items = PStackGetSP(occs);
+
+   if(items < PAR_BW_RW_MIN_TERMS)
+   {
+      for(i=0; i<items; i++)
+      {
+         res += term_find_rw_clauses(demod, ocb, PStackElementP(occs, i),
+                                     stack, lterm, rterm, oriented,
+                                     nf_date);
+      }
+      PStackFree(occs);
+      return res;
+   }
+
+   job.pattern = lterm;
+   job.occs    = occs;
+   job.hits    = SizeMalloc(sizeof(bool)*items);
+   for(w=0; w<WorkPoolWorkers(pool); w++)
+   {
+      job.substs[w] = LocalSubstAlloc();
+      LocalSubstReserveTerm(job.substs[w], lterm);
+   }
+
+   WorkPoolRun(pool, par_match_slice, &job, items);
+
+   for(i=0; i<items; i++)
+   {
+      if(job.hits[i])
+      {
+         res += term_find_rw_clauses(demod, ocb, PStackElementP(occs, i),
+                                     stack, lterm, rterm, oriented,
+                                     nf_date);
+      }
+      else
+      {
+         BWRWMatchAttempts++;
+      }
+   }
+   for(w=0; w<WorkPoolWorkers(pool); w++)
+   {
+      LocalSubstFree(job.substs[w]);
+   }
+   SizeFree(job.hits, sizeof(bool)*items);
+   PStackFree(occs);
+   return res;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: find_rewritable_clauses_indexed()
 //
 //   Push all clauses in index that are rewritable with lterm->rterm
-//   onto stack. Return true if there is at least one.
+//   onto stack. Return true if there is at least one. If pool is
+//   given, matching is done in parallel (first-order only).
 //
 // Global Variables: -
 //
@@ -1187,7 +1325,8 @@ static long find_rewritable_clauses_indexed(Clause_p demod,
                                             Term_p lterm,
                                             Term_p rterm,
                                             bool oriented,
-                                            SysDate nf_date)
+                                            SysDate nf_date,
+                                            WorkPool_p pool)
 {
    long          res = 0;
    PStack_p      termtrees = PStackAlloc();
@@ -1195,6 +1334,11 @@ static long find_rewritable_clauses_indexed(Clause_p demod,
 
    FPIndexFindMatchable(index, lterm, termtrees);
 
+   if(pool && problemType == PROBLEM_FO)
+   {
+      res = par_find_rw_clauses(demod, ocb, termtrees, stack,
+                                lterm, rterm, oriented, nf_date, pool);
+   }
    while(!PStackEmpty(termtrees))
    {
       tree = PStackPopP(termtrees);
@@ -1396,7 +1540,8 @@ bool FindRewritableClauses(OCB_p ocb, ClauseSet_p set,
 //
 //   New version - find all clauses that are rewritable with
 //   new_demod using the subterm index. Returns true if any rewritable
-//   clause was found.
+//   clause was found. If pool is not NULL, its workers look for
+//   matching subterms in parallel.
 //
 // Global Variables: -
 //
@@ -1407,7 +1552,7 @@ bool FindRewritableClauses(OCB_p ocb, ClauseSet_p set,
 
 long FindRewritableClausesIndexed(OCB_p ocb, SubtermIndex_p index,
                                   PStack_p stack, Clause_p new_demod,
-                                  SysDate nf_date)
+                                  SysDate nf_date, WorkPool_p pool)
 {
    long res;
    Eqn_p eqn = new_demod->literals;
@@ -1420,7 +1565,7 @@ long FindRewritableClausesIndexed(OCB_p ocb, SubtermIndex_p index,
                                          eqn->lterm,
                                          eqn->rterm,
                                          EqnIsOriented(eqn),
-                                         nf_date);
+                                         nf_date, pool);
    if(!EqnIsOriented(eqn))
    {
       res += find_rewritable_clauses_indexed(new_demod,
@@ -1429,7 +1574,7 @@ long FindRewritableClausesIndexed(OCB_p ocb, SubtermIndex_p index,
                                              eqn->rterm,
                                              eqn->lterm,
                                              false,
-                                             nf_date);
+                                             nf_date, pool);
    }
    /*printf("Found %ld rewritable clauses\n", res);
      {
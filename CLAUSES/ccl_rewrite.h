@@ -25,7 +25,9 @@ Changes
 
 #define CCL_REWRITE
 
+#include <clb_workpool.h>
 #include <cte_replace.h>
+#include <cte_localsubst.h>
 #include <ccl_pdtrees.h>
 #include <ccl_clausefunc.h>
 #include <ccl_subterm_index.h>
@@ -48,6 +50,12 @@ typedef struct rw_desc_cell
    bool         sos_rewritten; /* Return value! */
 }RWDescCell, *RWDesc_p;
 
+/* Backward rewriting with a worker pool only hands out the matching
+   of the demodulator to the workers if the index returns at least
+   this many term occurrences. */
+
+#define PAR_BW_RW_MIN_TERMS 512
+
 
 
 
@@ -91,7 +99,7 @@ bool FindRewritableClauses(OCB_p ocb, ClauseSet_p set,
 
 long FindRewritableClausesIndexed(OCB_p ocb, SubtermIndex_p index,
                                   PStack_p stack, Clause_p new_demod,
-                                  SysDate nf_date);
+                                  SysDate nf_date, WorkPool_p pool);
 
 bool ClauseLocalRW(OCB_p ocb, Clause_p clause);
 
@@ -106,6 +106,10 @@ int sat_translate_literal(Eqn_p eqn, SatClauseSet_p set)
    {
       atom = ++set->max_lit;
       PDRangeArrAssignInt(set->renumber_index, lit_code, atom);
+      if(set->atoms)
+      {
+         PStackPushP(set->atoms, lit_term);
+      }
    }
    if(EqnIsPositive(eqn))
    {
@@ -386,6 +390,251 @@ void export_to_solver(SatSolver_p solver, SatClauseSet_p set, SatClauseFilter fi
    }
 }
 
+/*-----------------------------------------------------------------------
+//
+// Function: sat_grounding_subst()
+//
+//   Create the (pseudo-)grounding substitution for the variables of
+//   state->terms according to strat.
+//
+// Global Variables: -
+//
+// Side Effects    : Binds variables
+//
+/----------------------------------------------------------------------*/
+
+static Subst_p sat_grounding_subst(ProofState_p state, GroundingStrategy strat,
+                                   bool norm_const)
+{
+   Subst_p pseudogroundsubst = NULL;
+
+   switch(strat)
+   {
+   case GMPseudoVar:
+         pseudogroundsubst = SubstPseudoGroundVarBank(state->terms->vars);
+         break;
+   case GMFirstConst:
+         pseudogroundsubst = SubstGroundVarBankFirstConst(state->terms,
+                                                          norm_const);
+         break;
+   case GMConjMinMinFreq:
+         pseudogroundsubst = SubstGroundFreqBased(state->terms,
+                                                  state->axioms,
+                                                  prefer_conj_min_min_freq,
+                                                  norm_const);
+         break;
+   case GMConjMaxMinFreq:
+         pseudogroundsubst = SubstGroundFreqBased(state->terms,
+                                                  state->axioms,
+                                                  prefer_conj_max_min_freq,
+                                                  norm_const);
+         break;
+   case GMConjMinMaxFreq:
+         pseudogroundsubst = SubstGroundFreqBased(state->terms,
+                                                  state->axioms,
+                                                  prefer_conj_min_max_freq,
+                                                  norm_const);
+         break;
+   case GMConjMaxMaxFreq:
+         pseudogroundsubst = SubstGroundFreqBased(state->terms,
+                                                  state->axioms,
+                                                  prefer_conj_max_max_freq,
+                                                  norm_const);
+         break;
+   case GMGlobalMax:
+         pseudogroundsubst = SubstGroundFreqBased(state->terms,
+                                                  state->axioms,
+                                                  prefer_global_max_freq,
+                                                  norm_const);
+         break;
+   case GMGlobalMin:
+         pseudogroundsubst = SubstGroundFreqBased(state->terms,
+                                                  state->axioms,
+                                                  prefer_global_min_freq,
+                                                  norm_const);
+         break;
+   default:
+         assert(false && "Unimplemented grounding strategy");
+         break;
+   }
+   return pseudogroundsubst;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: sat_clause_fingerprint()
+//
+//   Compute a hash of the literals of clause. Terms are shared and
+//   their entry_no is never reused, so a clause modified in place
+//   (e.g. rewritten or with renamed variables) will almost certainly
+//   get a new fingerprint.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static unsigned long sat_clause_fingerprint(Clause_p clause)
+{
+   unsigned long res = ClauseLiteralNumber(clause);
+   Eqn_p         lit;
+
+   for(lit = clause->literals; lit; lit = lit->next)
+   {
+      res = res*1000003 ^ (unsigned long)lit->lterm->entry_no;
+      res = res*1000003 ^ (unsigned long)lit->rterm->entry_no;
+      res = res*1000003 ^ (EqnIsPositive(lit)?1:2);
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: sat_inc_retract()
+//
+//   Permanently switch off an encoded clause by adding the negated
+//   selector as a unit clause, and forget the clause. ident is the
+//   key of the clause in inc->encoded (clause->source may already be
+//   gone).
+//
+// Global Variables: -
+//
+// Side Effects    : Adds to the solver, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void sat_inc_retract(SatIncState_p inc, SatSolver_p solver,
+                            SatClause_p clause, long ident)
+{
+   NumTree_p cell;
+
+   picosat_add(solver, -clause->activator);
+   picosat_add(solver, 0);
+   PDArrayAssignP(inc->selectors, clause->activator, NULL);
+   cell = NumTreeExtractEntry(&(inc->encoded), ident);
+   assert(cell && cell->val1.p_val == clause);
+   NumTreeCellFree(cell);
+   SatClauseFree(clause);
+   inc->active--;
+   inc->retracted++;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: sat_inc_encode()
+//
+//   Ground and encode clause, extended with a fresh negative selector
+//   literal. If old is not NULL and the encoding is identical to it,
+//   the new encoding is dropped and old is kept (with updated
+//   bookkeeping). Otherwise old is retracted and the new clause is
+//   added to the solver. Return true if the solver got a new clause.
+//
+// Global Variables: -
+//
+// Side Effects    : Adds to the solver, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static bool sat_inc_encode(SatIncState_p inc, SatSolver_p solver,
+                           Clause_p clause, SatClause_p old,
+                           unsigned long fingerprint)
+{
+   SatClause_p handle;
+   Eqn_p       lit;
+   int         i;
+   IntOrP      tmp;
+
+   handle = SatClauseAlloc(ClauseLiteralNumber(clause)+1);
+   for(i=0, lit=clause->literals; lit; i++, lit=lit->next)
+   {
+      handle->literals[i] = sat_translate_literal(lit, inc->satset);
+   }
+   handle->source      = clause;
+   handle->stamp       = inc->stamp;
+   handle->fingerprint = fingerprint;
+
+   if(old && old->lit_no == handle->lit_no &&
+      memcmp(old->literals, handle->literals,
+             (handle->lit_no-1)*sizeof(int))==0)
+   {
+      SatClauseFree(handle);
+      old->source      = clause;
+      old->stamp       = inc->stamp;
+      old->fingerprint = fingerprint;
+      return false;
+   }
+   if(old)
+   {
+      sat_inc_retract(inc, solver, old, clause->ident);
+   }
+   handle->activator = ++inc->satset->max_lit;
+   handle->literals[handle->lit_no-1] = -handle->activator;
+   picosat_add_lits(solver, handle->literals);
+
+   tmp.p_val = handle;
+   NumTreeStore(&(inc->encoded), clause->ident, tmp, tmp);
+   PDArrayAssignP(inc->selectors, handle->activator, handle);
+   inc->active++;
+   inc->added++;
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: sat_inc_import_set()
+//
+//   Encode all clauses in set that are new or changed since the last
+//   import round, and stamp the unchanged ones as still present.
+//   Return number of clauses added to the solver.
+//
+// Global Variables: -
+//
+// Side Effects    : Adds to the solver, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static long sat_inc_import_set(SatIncState_p inc, SatSolver_p solver,
+                               ClauseSet_p set)
+{
+   Clause_p      handle;
+   NumTree_p     cell;
+   SatClause_p   old;
+   unsigned long fingerprint;
+   long          res = 0;
+
+   for(handle = set->anchor->succ;
+       handle != set->anchor;
+       handle = handle->succ)
+   {
+      fingerprint = sat_clause_fingerprint(handle);
+      cell = NumTreeFind(&(inc->encoded), handle->ident);
+      old  = cell?cell->val1.p_val:NULL;
+      if(old && old->stamp == inc->stamp)
+      {
+         /* Several clauses with the same ident - only the first one
+            can be tracked. */
+         continue;
+      }
+      if(old && old->fingerprint == fingerprint)
+      {
+         old->source = handle;
+         old->stamp  = inc->stamp;
+         continue;
+      }
+      if(sat_inc_encode(inc, solver, handle, old, fingerprint))
+      {
+         res++;
+      }
+   }
+   return res;
+}
+
+
 /*---------------------------------------------------------------------*/
 /*                         Exported Functions                          */
 /*---------------------------------------------------------------------*/
@@ -414,6 +663,9 @@ SatClause_p SatClauseAlloc(int lit_no)
    handle->literals     = SizeMalloc((lit_no+1)*sizeof(int));
    handle->literals[handle->lit_no] = 0;
    handle->source       = NULL;
+   handle->activator    = 0;
+   handle->stamp        = 0;
+   handle->fingerprint  = 0;
 
    return handle;
 }
@@ -463,6 +715,7 @@ SatClauseSet_p SatClauseSetAlloc(void)
                                // the first index!
    set->set      = PStackAlloc();
    set->exported = PStackAlloc();
+   set->atoms    = NULL;
    set->core_size = 0;
    set->set_size_limit = -1;
    return set;
@@ -496,6 +749,10 @@ void SatClauseSetFree(SatClauseSet_p junk)
    }
    PStackFree(junk->set);
    PStackFree(junk->exported);
+   if(junk->atoms)
+   {
+      PStackFree(junk->atoms);
+   }
    SatClauseSetCellFree(junk);
 }
 
@@ -875,61 +1132,13 @@ long SatClauseSetImportProofState(SatClauseSet_p satset, ProofState_p state,
                                   GroundingStrategy strat, bool norm_const)
 {
    long    res = 0;
-   Subst_p pseudogroundsubst = NULL;
+   Subst_p pseudogroundsubst;
    assert(satset);
    assert(state);
 
    //printf(COMCHAR" SatClauseSetImportProofState()\n");
 
-   switch(strat)
-   {
-   case GMPseudoVar:
-         pseudogroundsubst = SubstPseudoGroundVarBank(state->terms->vars);
-         break;
-   case GMFirstConst:
-         pseudogroundsubst = SubstGroundVarBankFirstConst(state->terms,
-                                                          norm_const);
-         break;
-   case GMConjMinMinFreq:
-         pseudogroundsubst = SubstGroundFreqBased(state->terms,
-                                                  state->axioms,
-                                                  prefer_conj_min_min_freq,
-                                                  norm_const);
-         break;
-   case GMConjMaxMinFreq:
-         pseudogroundsubst = SubstGroundFreqBased(state->terms,
-                                                  state->axioms,
-                                                  prefer_conj_max_min_freq,
-                                                  norm_const);
-         break;
-   case GMConjMinMaxFreq:
-         pseudogroundsubst = SubstGroundFreqBased(state->terms,
-                                                  state->axioms,
-                                                  prefer_conj_min_max_freq,
-                                                  norm_const);
-         break;
-   case GMConjMaxMaxFreq:
-         pseudogroundsubst = SubstGroundFreqBased(state->terms,
-                                                  state->axioms,
-                                                  prefer_conj_max_max_freq,
-                                                  norm_const);
-         break;
-   case GMGlobalMax:
-         pseudogroundsubst = SubstGroundFreqBased(state->terms,
-                                                  state->axioms,
-                                                  prefer_global_max_freq,
-                                                  norm_const);
-         break;
-   case GMGlobalMin:
-         pseudogroundsubst = SubstGroundFreqBased(state->terms,
-                                                  state->axioms,
-                                                  prefer_global_min_freq,
-                                                  norm_const);
-         break;
-   default:
-         assert(false && "Unimplemented grounding strategy");
-         break;
-   }
+   pseudogroundsubst = sat_grounding_subst(state, strat, norm_const);
    // printf(COMCHAR" Pseudogrounded()\n");
 
    res += SatClauseSetImportClauseSet(satset, state->processed_pos_rules);
@@ -1110,6 +1319,207 @@ bool SatClauseSetCheckAndGetCore(SatClauseSet_p satset,
    return solverres == PICOSAT_UNSATISFIABLE;
 }
 
+/*-----------------------------------------------------------------------
+//
+// Function: SatIncStateAlloc()
+//
+//   Allocate an empty state for incremental SAT checking of clauses
+//   from bank. The ground atoms encoded are registered with the
+//   garbage collector of bank, so that equal atoms keep the same
+//   propositional variable over all checks.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, registers with bank->gc
+//
+/----------------------------------------------------------------------*/
+
+SatIncState_p SatIncStateAlloc(TB_p bank)
+{
+   SatIncState_p handle = SatIncStateCellAlloc();
+
+   handle->satset        = SatClauseSetAlloc();
+   handle->satset->atoms = PStackAlloc();
+   handle->bank          = bank;
+   handle->encoded       = NULL;
+   handle->selectors     = PDArrayAlloc(1024, 0);
+   handle->stamp         = 0;
+   handle->active        = 0;
+   handle->retracted     = 0;
+   handle->added         = 0;
+   handle->core_size     = 0;
+   TBGCRegisterTermStack(bank, handle->satset->atoms);
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: SatIncStateFree()
+//
+//   Free an incremental SAT state. The solver is not touched.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, deregisters from bank->gc
+//
+/----------------------------------------------------------------------*/
+
+void SatIncStateFree(SatIncState_p junk)
+{
+   NumTree_p cell;
+
+   assert(junk);
+
+   TBGCDeregisterTermStack(junk->bank, junk->satset->atoms);
+   while(junk->encoded)
+   {
+      cell = NumTreeExtractEntry(&(junk->encoded), junk->encoded->key);
+      SatClauseFree(cell->val1.p_val);
+      NumTreeCellFree(cell);
+   }
+   PDArrayFree(junk->selectors);
+   SatClauseSetFree(junk->satset);
+   SatIncStateCellFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: SatIncStateImportProofState()
+//
+//   Bring the solver in sync with the proof state: Clauses that are
+//   new (or have been modified in place) since the last import are
+//   pseudo-grounded and added, clauses that are no longer present are
+//   retracted. Unchanged clauses keep their old encoding, even if the
+//   grounding substitution would be different now (any instance is
+//   fine for refutation). Return number of clauses added.
+//
+// Global Variables: -
+//
+// Side Effects    : Adds to the solver, memory operations
+//
+/----------------------------------------------------------------------*/
+
+long SatIncStateImportProofState(SatIncState_p inc,
+                                 SatSolver_p solver,
+                                 ProofState_p state,
+                                 GroundingStrategy strat,
+                                 bool norm_const)
+{
+   Subst_p       pseudogroundsubst;
+   PStack_p      stale, trav;
+   NumTree_p     cell;
+   SatClause_p   clause;
+
+   assert(inc);
+   assert(state);
+   assert(inc->bank == state->terms);
+
+   inc->stamp++;
+   inc->added = 0;
+
+   pseudogroundsubst = sat_grounding_subst(state, strat, norm_const);
+
+   sat_inc_import_set(inc, solver, state->processed_pos_rules);
+   sat_inc_import_set(inc, solver, state->processed_pos_eqns);
+   sat_inc_import_set(inc, solver, state->processed_neg_units);
+   sat_inc_import_set(inc, solver, state->processed_non_units);
+   sat_inc_import_set(inc, solver, state->unprocessed);
+
+   SubstDelete(pseudogroundsubst);
+
+   stale = PStackAlloc();
+   trav  = NumTreeTraverseInit(inc->encoded);
+   while((cell = NumTreeTraverseNext(trav)))
+   {
+      clause = cell->val1.p_val;
+      if(clause->stamp != inc->stamp)
+      {
+         PStackPushInt(stale, cell->key);
+         PStackPushP(stale, clause);
+      }
+   }
+   NumTreeTraverseExit(trav);
+   while(!PStackEmpty(stale))
+   {
+      clause = PStackPopP(stale);
+      sat_inc_retract(inc, solver, clause, PStackPopInt(stale));
+   }
+   PStackFree(stale);
+
+   return inc->added;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: SatIncStateCheckUnsat()
+//
+//   Run the solver with all active clauses assumed. If unsat can be
+//   shown, create the empty clause (with the clauses owning failed
+//   selectors as premises) in *empty.
+//
+// Global Variables: -
+//
+// Side Effects    : Runs SAT solver, output, memory operations
+//
+/----------------------------------------------------------------------*/
+
+ProverResult SatIncStateCheckUnsat(SatIncState_p inc, Clause_p *empty,
+                                   SatSolver_p solver,
+                                   int sat_check_decision_limit)
+{
+   ProverResult res;
+   PStack_p     trav;
+   NumTree_p    cell;
+   SatClause_p  clause;
+   const int    *failed;
+   Clause_p     parent;
+   bool         first = true;
+
+   trav = NumTreeTraverseInit(inc->encoded);
+   while((cell = NumTreeTraverseNext(trav)))
+   {
+      clause = cell->val1.p_val;
+      picosat_assume(solver, clause->activator);
+   }
+   NumTreeTraverseExit(trav);
+
+   switch(picosat_sat(solver, sat_check_decision_limit))
+   {
+   case PICOSAT_SATISFIABLE:
+         res = PRSatisfiable;
+         break;
+   case PICOSAT_UNSATISFIABLE:
+         res = PRUnsatisfiable;
+         break;
+   default:
+         res = PRGaveUp;
+   }
+
+   if(res == PRUnsatisfiable)
+   {
+      fprintf(GlobalOut, COMCHAR" SatCheck found unsatisfiable ground set\n");
+      *empty = EmptyClauseAlloc();
+      inc->core_size = 0;
+      for(failed = picosat_failed_assumptions(solver); *failed; failed++)
+      {
+         clause = PDArrayElementP(inc->selectors, *failed);
+         assert(clause);
+         parent = clause->source;
+         ClausePushDerivation(*empty, first?DCSatGen:DCCnfAddArg,
+                              parent, NULL);
+         first = false;
+         inc->core_size++;
+      }
+      assert(!first);
+   }
+   return res;
+}
+
+
 /*---------------------------------------------------------------------*/
 /*                        End of File                                  */
 /*---------------------------------------------------------------------*/
@@ -43,6 +43,11 @@ typedef struct satclausecell
    int *      literals; // null-terminated (PicoSAT requirement),
                         // length(literals) = lit_no+1 !
    Clause_p   source;
+   int        activator;   // Incremental mode: selector variable of
+                           // the clause, 0 otherwise
+   long       stamp;       // Incremental mode: last import that
+                           // found source in the proof state
+   unsigned long fingerprint; // Incremental mode: literals of source
 }SatClauseCell, *SatClause_p;
 
 typedef struct satclausesetcell
@@ -51,12 +56,38 @@ typedef struct satclausesetcell
    int          max_lit;
    PStack_p     set;            // Actual set (clauses must be freed)
    PStack_p     exported;       // Subset of clauses exported to the solver state
+   PStack_p     atoms;          // If non-NULL, new atom terms are
+                                // recorded here
    long         core_size;      // Size of the unsat core, if any
    long         set_size_limit; // Limit after which insertions will fail
                                 // if -1 no limit is set.
 }SatClauseSetCell, *SatClauseSet_p;
 
 
+/* State for incremental SAT checking. The solver is kept alive
+   between checks, every clause is added with an extra negative
+   selector literal, and only clauses with asserted selectors are
+   active. Clauses that disappear from the proof state are switched
+   off for good by a unit clause with the negated selector. */
+
+typedef struct satincstatecell
+{
+   SatClauseSet_p satset;    // Atom numbering, only set->atoms is used
+   TB_p           bank;      // Atom terms are protected from GC here
+   NumTree_p      encoded;   // Clause ident -> active SatClause
+   PDArray_p      selectors; // Selector variable -> active SatClause
+   long           stamp;     // Current import round
+   long           active;    // Clauses currently in encoded
+   long           retracted; // Clauses switched off since creation
+   long           added;     // Clauses encoded in the last import
+   long           core_size; // Clauses in the last unsat core
+}SatIncStateCell, *SatIncState_p;
+
+/* Rebuild the solver from scratch if more clauses are dead than
+   alive (and there are enough of them to matter) */
+#define SAT_INC_REBUILD_MIN 10000
+
+
 typedef enum
 {
    GMNoGrounding,
@@ -124,6 +155,25 @@ ProverResult SatClauseSetCheckUnsat(SatClauseSet_p satset, Clause_p *empty,
 bool        SatClauseSetCheckAndGetCore(SatClauseSet_p satset, SatSolver_p solver,
                                         PStack_p unsat_core);
 
+#define SatIncStateCellAlloc()    (SatIncStateCell*)SizeMalloc(sizeof(SatIncStateCell))
+#define SatIncStateCellFree(junk) SizeFree(junk, sizeof(SatIncStateCell))
+
+SatIncState_p SatIncStateAlloc(TB_p bank);
+void          SatIncStateFree(SatIncState_p junk);
+
+#define SatIncStateNeedsRebuild(inc) \
+   (((inc)->retracted > SAT_INC_REBUILD_MIN) && \
+    ((inc)->retracted > (inc)->active))
+
+long          SatIncStateImportProofState(SatIncState_p inc,
+                                          SatSolver_p solver,
+                                          ProofState_p state,
+                                          GroundingStrategy strat,
+                                          bool norm_const);
+ProverResult  SatIncStateCheckUnsat(SatIncState_p inc, Clause_p *empty,
+                                    SatSolver_p solver,
+                                    int sat_check_decision_limit);
+
 
 
 #endif
@@ -29,6 +29,48 @@ Changes
 /*                        Global Variables                             */
 /*---------------------------------------------------------------------*/
 
+/* Layout of DRelBase files: A header, then the distribution (one
+   DRCGen per symbol), then for each filter a DRCFilter followed by
+   d_start, d_syms and conjectures (as int32_t, padded to 8 bytes). */
+
+#define DRC_MAGIC      "EDRCACHE"
+#define DRC_VERSION    1
+#define DRC_BYTE_ORDER 0x0102030405060708LL
+#define DRC_HASH_SEED  0x4452454c42415345ULL
+
+typedef struct
+{
+   char     magic[8];
+   int64_t  version;
+   int64_t  byte_order;
+   uint64_t key;
+   int64_t  f_count;
+   int64_t  clauses;
+   int64_t  formulas;
+   int64_t  filters;
+   int64_t  body_size;
+   uint64_t body_hash;
+}DRCHeader;
+
+typedef struct
+{
+   int64_t term_freq;
+   int64_t fc_freq;
+}DRCGen;
+
+typedef struct
+{
+   int64_t gen_measure;
+   double  benevolence;
+   int64_t generosity;
+   int64_t trim_implications;
+   int64_t defined_symbols_in_drel;
+   int64_t d_syms;
+   int64_t conjectures;
+}DRCFilter;
+
+#define DRC_ALIGN(size) (((size)+7)/8*8)
+
 
 /*---------------------------------------------------------------------*/
 /*                      Forward Declarations                           */
@@ -39,6 +81,243 @@ Changes
 /*                         Internal Functions                          */
 /*---------------------------------------------------------------------*/
 
+/*-----------------------------------------------------------------------
+//
+// Function: formula_compute_d_syms()
+//
+//   Push the symbols in D-relation with form onto symbols (including
+//   the symbol defined by form if force_def is set).
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static void formula_compute_d_syms(GenDistrib_p generality,
+                                   GeneralityMeasure gentype,
+                                   double benevolence,
+                                   long generosity,
+                                   bool trim_impl,
+                                   bool force_definition,
+                                   WFormula_p form,
+                                   PStack_p symbols)
+{
+   FormulaComputeDRel(generality,
+                      gentype,
+                      benevolence,
+                      generosity,
+                      form,
+                      symbols,
+                      trim_impl);
+   if(force_definition)
+   {
+      FunCode l_fc = WFormulaGetLambdaDefinedSym(form);
+      if(l_fc != -1 && !PStackFindInt(symbols, l_fc))
+      {
+         PStackPushInt(symbols, l_fc);
+      }
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: drel_add_clause_syms()
+//
+//   Add clause to the D-relation entries of the symbols popped from
+//   symbols (or to the entry for 0 if there are none).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, empties symbols
+//
+/----------------------------------------------------------------------*/
+
+static void drel_add_clause_syms(DRelation_p drel, Clause_p clause,
+                                 PStack_p symbols)
+{
+   DRel_p rel;
+
+   if(PStackEmpty(symbols))
+   {
+      rel = DRelationGetFEntry(drel, 0);
+      PStackPushP(rel->d_clauses, clause);
+   }
+   while(!PStackEmpty(symbols))
+   {
+      rel = DRelationGetFEntry(drel, PStackPopInt(symbols));
+      PStackPushP(rel->d_clauses, clause);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: drel_add_formula_syms()
+//
+//   Add form to the D-relation entries of the symbols popped from
+//   symbols (or to the entry for 0 if there are none).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, empties symbols
+//
+/----------------------------------------------------------------------*/
+
+static void drel_add_formula_syms(DRelation_p drel, WFormula_p form,
+                                  PStack_p symbols)
+{
+   DRel_p rel;
+
+   if(PStackEmpty(symbols))
+   {
+      rel = DRelationGetFEntry(drel, 0);
+      PStackPushP(rel->d_formulas, form);
+   }
+   while(!PStackEmpty(symbols))
+   {
+      rel = DRelationGetFEntry(drel, PStackPopInt(symbols));
+      PStackPushP(rel->d_formulas, form);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: d_rel_syms_find()
+//
+//   Return the precomputed D-relation symbols of base for the
+//   parameters of ax_filter, or NULL.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static DRelSyms_p d_rel_syms_find(DRelBase_p base, AxFilter_p ax_filter)
+{
+   PStackPointer i;
+   DRelSyms_p    syms;
+
+   for(i=0; i<PStackGetSP(base->syms); i++)
+   {
+      syms = PStackElementP(base->syms, i);
+      if(syms->gen_measure == ax_filter->gen_measure &&
+         syms->benevolence == ax_filter->benevolence &&
+         syms->generosity == ax_filter->generosity &&
+         syms->trim_implications == ax_filter->trim_implications &&
+         syms->defined_symbols_in_drel == ax_filter->defined_symbols_in_drel)
+      {
+         return syms;
+      }
+   }
+   return NULL;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: d_rel_syms_alloc()
+//
+//   Allocate an empty DRelSymsCell for the given filter parameters.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static DRelSyms_p d_rel_syms_alloc(GeneralityMeasure gen_measure,
+                                   double benevolence,
+                                   long generosity,
+                                   bool trim_implications,
+                                   bool defined_symbols_in_drel)
+{
+   DRelSyms_p syms = DRelSymsCellAlloc();
+
+   syms->gen_measure             = gen_measure;
+   syms->benevolence             = benevolence;
+   syms->generosity              = generosity;
+   syms->trim_implications       = trim_implications;
+   syms->defined_symbols_in_drel = defined_symbols_in_drel;
+   syms->d_syms                  = PStackAlloc();
+   syms->d_start                 = PStackAlloc();
+   syms->conjectures             = PStackAlloc();
+   syms->d_occ                   = PDArrayAlloc(64, 0);
+
+   return syms;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: d_rel_syms_free()
+//
+//   Free a DRelSymsCell.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void d_rel_syms_free(DRelSyms_p syms)
+{
+   long i;
+
+   for(i=0; i<syms->d_occ->size; i++)
+   {
+      if(PDArrayElementP(syms->d_occ, i))
+      {
+         PStackFree(PDArrayElementP(syms->d_occ, i));
+      }
+   }
+   PDArrayFree(syms->d_occ);
+   PStackFree(syms->d_syms);
+   PStackFree(syms->d_start);
+   PStackFree(syms->conjectures);
+   DRelSymsCellFree(syms);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: d_rel_syms_index()
+//
+//   Compute syms->d_occ from the D-relation symbols of the axioms.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void d_rel_syms_index(DRelSyms_p syms)
+{
+   PStackPointer i, j;
+   PStack_p      occ;
+   FunCode       f;
+
+   for(i=0; i<PStackGetSP(syms->d_start)-1; i++)
+   {
+      for(j=PStackElementInt(syms->d_start, i);
+          j<PStackElementInt(syms->d_start, i+1);
+          j++)
+      {
+         f   = PStackElementInt(syms->d_syms, j);
+         occ = PDArrayElementP(syms->d_occ, f);
+         if(!occ)
+         {
+            occ = PStackAlloc();
+            PDArrayAssignP(syms->d_occ, f, occ);
+         }
+         PStackPushInt(occ, i);
+      }
+   }
+}
+
 
 /*---------------------------------------------------------------------*/
 /*                         Exported Functions                          */
@@ -185,8 +464,6 @@ void DRelationAddClause(DRelation_p drel,
                         Clause_p clause)
 {
    PStack_p symbols = PStackAlloc();
-   FunCode  symbol;
-   DRel_p   rel;
 
    ClauseComputeDRel(generality,
                      gentype,
@@ -194,20 +471,7 @@ void DRelationAddClause(DRelation_p drel,
                      generosity,
                      clause,
                      symbols);
-   if(PStackEmpty(symbols))
-   {
-      rel = DRelationGetFEntry(drel, 0);
-      PStackPushP(rel->d_clauses, clause);
-   }
-   else
-   {
-      while(!PStackEmpty(symbols))
-      {
-         symbol = PStackPopInt(symbols);
-         rel = DRelationGetFEntry(drel, symbol);
-         PStackPushP(rel->d_clauses, clause);
-      }
-   }
+   drel_add_clause_syms(drel, clause, symbols);
    PStackFree(symbols);
 }
 
@@ -234,38 +498,16 @@ void DRelationAddFormula(DRelation_p drel,
                          WFormula_p form)
 {
    PStack_p symbols = PStackAlloc();
-   FunCode  symbol;
-   DRel_p   rel;
 
-   FormulaComputeDRel(generality,
-                      gentype,
-                      benevolence,
-                      generosity,
-                      form,
-                      symbols,
-                      trim_impl);
-   if(force_definition)
-   {
-      FunCode l_fc = WFormulaGetLambdaDefinedSym(form);
-      if(l_fc != -1 && !PStackFindInt(symbols, l_fc))
-      {
-         PStackPushInt(symbols, l_fc);
-      }
-   }
-   if(PStackEmpty(symbols))
-   {
-      rel = DRelationGetFEntry(drel, 0);
-      PStackPushP(rel->d_formulas, form);
-   }
-   else
-   {
-      while(!PStackEmpty(symbols))
-      {
-         symbol = PStackPopInt(symbols);
-         rel = DRelationGetFEntry(drel, symbol);
-         PStackPushP(rel->d_formulas, form);
-      }
-   }
+   formula_compute_d_syms(generality,
+                          gentype,
+                          benevolence,
+                          generosity,
+                          trim_impl,
+                          force_definition,
+                          form,
+                          symbols);
+   drel_add_formula_syms(drel, form, symbols);
    PStackFree(symbols);
 }
 
@@ -415,6 +657,600 @@ void DRelationAddFormulaSets(DRelation_p drel,
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: DRelBaseAlloc()
+//
+//   Allocate a DRelBase for the first sets clause and formula sets
+//   on the two stacks (without any filters).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+DRelBase_p DRelBaseAlloc(PStack_p clause_sets, PStack_p formula_sets,
+                         PStackPointer sets)
+{
+   DRelBase_p    base = DRelBaseCellAlloc();
+   PStackPointer i;
+   ClauseSet_p   cset;
+   FormulaSet_p  fset;
+   Clause_p      clause;
+   WFormula_p    form;
+
+   assert(sets <= PStackGetSP(clause_sets));
+   assert(sets <= PStackGetSP(formula_sets));
+
+   base->sets     = sets;
+   base->clauses  = PStackAlloc();
+   base->formulas = PStackAlloc();
+   base->syms     = PStackAlloc();
+   base->modified = false;
+
+   for(i=0; i<sets; i++)
+   {
+      cset = PStackElementP(clause_sets, i);
+      for(clause = cset->anchor->succ;
+          clause != cset->anchor;
+          clause = clause->succ)
+      {
+         PStackPushP(base->clauses, clause);
+      }
+   }
+   for(i=0; i<sets; i++)
+   {
+      fset = PStackElementP(formula_sets, i);
+      for(form = fset->anchor->succ;
+          form != fset->anchor;
+          form = form->succ)
+      {
+         PStackPushP(base->formulas, form);
+      }
+   }
+   return base;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: DRelBaseFree()
+//
+//   Free a DRelBase. Clauses and formulas are external.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void DRelBaseFree(DRelBase_p base)
+{
+   while(!PStackEmpty(base->syms))
+   {
+      d_rel_syms_free(PStackPopP(base->syms));
+   }
+   PStackFree(base->syms);
+   PStackFree(base->clauses);
+   PStackFree(base->formulas);
+   DRelBaseCellFree(base);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: DRelBaseAddFilter()
+//
+//   Precompute the D-relation symbols of all axioms in base for the
+//   parameters of ax_filter (a GSinE filter). generality has to
+//   describe exactly the sets covered by base. Return true if this
+//   was not already known.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+bool DRelBaseAddFilter(DRelBase_p base, GenDistrib_p generality,
+                       AxFilter_p ax_filter)
+{
+   DRelSyms_p    syms;
+   PStackPointer i;
+   WFormula_p    form;
+
+   assert(ax_filter->type == AFGSinE);
+
+   if(d_rel_syms_find(base, ax_filter))
+   {
+      return false;
+   }
+   syms = d_rel_syms_alloc(ax_filter->gen_measure,
+                           ax_filter->benevolence,
+                           ax_filter->generosity,
+                           ax_filter->trim_implications,
+                           ax_filter->defined_symbols_in_drel);
+
+   for(i=0; i<PStackGetSP(base->clauses); i++)
+   {
+      PStackPushInt(syms->d_start, PStackGetSP(syms->d_syms));
+      ClauseComputeDRel(generality,
+                        ax_filter->gen_measure,
+                        ax_filter->benevolence,
+                        ax_filter->generosity,
+                        PStackElementP(base->clauses, i),
+                        syms->d_syms);
+   }
+   for(i=0; i<PStackGetSP(base->formulas); i++)
+   {
+      form = PStackElementP(base->formulas, i);
+      PStackPushInt(syms->d_start, PStackGetSP(syms->d_syms));
+      formula_compute_d_syms(generality,
+                             ax_filter->gen_measure,
+                             ax_filter->benevolence,
+                             ax_filter->generosity,
+                             ax_filter->trim_implications,
+                             ax_filter->defined_symbols_in_drel,
+                             form,
+                             syms->d_syms);
+      if(ax_filter->trim_implications && FormulaIsConjecture(form))
+      {
+         PStackPushInt(syms->conjectures,
+                       PStackGetSP(base->clauses)+i);
+      }
+   }
+   PStackPushInt(syms->d_start, PStackGetSP(syms->d_syms));
+   d_rel_syms_index(syms);
+   PStackPushP(base->syms, syms);
+   base->modified = true;
+
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: DRelBaseGetDRelation()
+//
+//   Return the D-relation for ax_filter over all sets on the two
+//   stacks, the first base->sets of which have to be the ones covered
+//   by base, and generality the distribution for all sets. This is
+//   the same D-relation as built by DRelationAdd*Sets(), but only
+//   axioms in D-relation with a symbol of the additional sets are
+//   recomputed. Return NULL if base has no data for ax_filter.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+DRelation_p DRelBaseGetDRelation(DRelBase_p base, GenDistrib_p generality,
+                                 AxFilter_p ax_filter,
+                                 PStack_p clause_sets,
+                                 PStack_p formula_sets)
+{
+   DRelSyms_p    syms = d_rel_syms_find(base, ax_filter);
+   DRelation_p   drel;
+   PStack_p      symbols, occ;
+   PStackPointer i, j, conj = 0;
+   long          clause_no, axiom_no;
+   bool          *affected, was_conj;
+   ClauseSet_p   cset;
+   FormulaSet_p  fset;
+   Clause_p      clause;
+   WFormula_p    form;
+   FunCode       f;
+
+   if(!syms)
+   {
+      return NULL;
+   }
+   assert(base->sets <= PStackGetSP(clause_sets));
+   assert(base->sets <= PStackGetSP(formula_sets));
+
+   /* Find the axioms whose symbols may have changed generality */
+   clause_no = PStackGetSP(base->clauses);
+   axiom_no  = clause_no+PStackGetSP(base->formulas);
+   affected  = SizeMalloc(sizeof(bool)*MAX(axiom_no, 1));
+   memset(affected, 0, sizeof(bool)*MAX(axiom_no, 1));
+   symbols   = PStackAlloc();
+   for(i=base->sets; i<PStackGetSP(clause_sets); i++)
+   {
+      cset = PStackElementP(clause_sets, i);
+      for(clause = cset->anchor->succ;
+          clause != cset->anchor;
+          clause = clause->succ)
+      {
+         ClauseAddSymbolDistExist(clause, generality->f_distrib, symbols);
+      }
+      fset = PStackElementP(formula_sets, i);
+      for(form = fset->anchor->succ;
+          form != fset->anchor;
+          form = form->succ)
+      {
+         TermAddSymbolDistExist(form->tformula, generality->f_distrib,
+                                symbols);
+      }
+   }
+   while(!PStackEmpty(symbols))
+   {
+      f = PStackPopInt(symbols);
+      generality->f_distrib[f] = 0;
+      occ = f<syms->d_occ->size?
+         PDArrayElementP(syms->d_occ, f):NULL;
+      for(j=0; occ && j<PStackGetSP(occ); j++)
+      {
+         affected[PStackElementInt(occ, j)] = true;
+      }
+   }
+
+   /* Build the relation in the same order as DRelationAdd*Sets() */
+   drel = DRelationAlloc();
+   for(i=0; i<axiom_no; i++)
+   {
+      if(i >= clause_no && syms->trim_implications)
+      {
+         /* Conjectures are trimmed, so their type has to match */
+         was_conj = conj < PStackGetSP(syms->conjectures) &&
+            PStackElementInt(syms->conjectures, conj) == i;
+         if(was_conj)
+         {
+            conj++;
+         }
+         if(was_conj != FormulaIsConjecture(
+               (WFormula_p)PStackElementP(base->formulas, i-clause_no)))
+         {
+            affected[i] = true;
+         }
+      }
+      if(i == clause_no)
+      {
+         for(j=base->sets; j<PStackGetSP(clause_sets); j++)
+         {
+            DRelationAddClauseSet(drel, generality,
+                                  ax_filter->gen_measure,
+                                  ax_filter->benevolence,
+                                  ax_filter->generosity,
+                                  PStackElementP(clause_sets, j));
+         }
+      }
+      if(affected[i])
+      {
+         if(i < clause_no)
+         {
+            ClauseComputeDRel(generality,
+                              ax_filter->gen_measure,
+                              ax_filter->benevolence,
+                              ax_filter->generosity,
+                              PStackElementP(base->clauses, i),
+                              symbols);
+         }
+         else
+         {
+            formula_compute_d_syms(generality,
+                                   ax_filter->gen_measure,
+                                   ax_filter->benevolence,
+                                   ax_filter->generosity,
+                                   ax_filter->trim_implications,
+                                   ax_filter->defined_symbols_in_drel,
+                                   PStackElementP(base->formulas,
+                                                  i-clause_no),
+                                   symbols);
+         }
+      }
+      else
+      {
+         for(j=PStackElementInt(syms->d_start, i);
+             j<PStackElementInt(syms->d_start, i+1);
+             j++)
+         {
+            PStackPushInt(symbols, PStackElementInt(syms->d_syms, j));
+         }
+      }
+      if(i < clause_no)
+      {
+         drel_add_clause_syms(drel, PStackElementP(base->clauses, i),
+                              symbols);
+      }
+      else
+      {
+         drel_add_formula_syms(drel, PStackElementP(base->formulas,
+                                                    i-clause_no),
+                               symbols);
+      }
+   }
+   if(clause_no == axiom_no)
+   {
+      for(j=base->sets; j<PStackGetSP(clause_sets); j++)
+      {
+         DRelationAddClauseSet(drel, generality,
+                               ax_filter->gen_measure,
+                               ax_filter->benevolence,
+                               ax_filter->generosity,
+                               PStackElementP(clause_sets, j));
+      }
+   }
+   for(j=base->sets; j<PStackGetSP(formula_sets); j++)
+   {
+      DRelationAddFormulaSet(drel, generality,
+                             ax_filter->gen_measure,
+                             ax_filter->benevolence,
+                             ax_filter->generosity,
+                             ax_filter->trim_implications,
+                             ax_filter->defined_symbols_in_drel,
+                             PStackElementP(formula_sets, j));
+   }
+   PStackFree(symbols);
+   SizeFree(affected, sizeof(bool)*MAX(axiom_no, 1));
+
+   return drel;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: DRelBaseWrite()
+//
+//   Write the distribution and all filters of base to file, tagged
+//   with key (which has to identify the axioms covered by
+//   base). generality has to describe exactly these axioms. Return
+//   success.
+//
+// Global Variables: -
+//
+// Side Effects    : File operations, memory operations
+//
+/----------------------------------------------------------------------*/
+
+bool DRelBaseWrite(DRelBase_p base, GenDistrib_p generality,
+                   char* file, uint64_t key)
+{
+   DRCHeader     header;
+   DRCFilter     filter;
+   DRCGen        *gen;
+   DRelSyms_p    syms;
+   PStackPointer i, j;
+   long          axioms = PStackGetSP(base->clauses)+PStackGetSP(base->formulas);
+   FunCode       f, f_count = generality->sig->f_count;
+   int64_t       size, pos;
+   int32_t       *arr;
+   char          *body;
+   DStr_p        tmp_name;
+   FILE          *out;
+   bool          res;
+
+   assert(generality->size > f_count);
+
+   size = DRC_ALIGN(sizeof(DRCGen)*(f_count+1));
+   for(i=0; i<PStackGetSP(base->syms); i++)
+   {
+      syms = PStackElementP(base->syms, i);
+      size += sizeof(DRCFilter)+
+         DRC_ALIGN(sizeof(int32_t)*(axioms+1+
+                                    PStackGetSP(syms->d_syms)+
+                                    PStackGetSP(syms->conjectures)));
+   }
+   body = SecureMalloc(MAX(size, 1));
+   memset(body, 0, MAX(size, 1));
+
+   gen = (DRCGen*)body;
+   for(f=0; f<=f_count; f++)
+   {
+      gen[f].term_freq = generality->dist_array[f].term_freq;
+      gen[f].fc_freq   = generality->dist_array[f].fc_freq;
+   }
+   pos = DRC_ALIGN(sizeof(DRCGen)*(f_count+1));
+   for(i=0; i<PStackGetSP(base->syms); i++)
+   {
+      syms = PStackElementP(base->syms, i);
+      filter.gen_measure             = syms->gen_measure;
+      filter.benevolence             = syms->benevolence;
+      filter.generosity              = syms->generosity;
+      filter.trim_implications       = syms->trim_implications;
+      filter.defined_symbols_in_drel = syms->defined_symbols_in_drel;
+      filter.d_syms                  = PStackGetSP(syms->d_syms);
+      filter.conjectures             = PStackGetSP(syms->conjectures);
+      memcpy(body+pos, &filter, sizeof(DRCFilter));
+      pos += sizeof(DRCFilter);
+
+      arr = (int32_t*)(body+pos);
+      for(j=0; j<PStackGetSP(syms->d_start); j++)
+      {
+         *arr++ = PStackElementInt(syms->d_start, j);
+      }
+      for(j=0; j<PStackGetSP(syms->d_syms); j++)
+      {
+         *arr++ = PStackElementInt(syms->d_syms, j);
+      }
+      for(j=0; j<PStackGetSP(syms->conjectures); j++)
+      {
+         *arr++ = PStackElementInt(syms->conjectures, j);
+      }
+      pos += DRC_ALIGN(sizeof(int32_t)*(axioms+1+
+                                        PStackGetSP(syms->d_syms)+
+                                        PStackGetSP(syms->conjectures)));
+   }
+   assert(pos == size);
+
+   memset(&header, 0, sizeof(header));
+   memcpy(header.magic, DRC_MAGIC, sizeof(header.magic));
+   header.version    = DRC_VERSION;
+   header.byte_order = DRC_BYTE_ORDER;
+   header.key        = key;
+   header.f_count    = f_count;
+   header.clauses    = PStackGetSP(base->clauses);
+   header.formulas   = PStackGetSP(base->formulas);
+   header.filters    = PStackGetSP(base->syms);
+   header.body_size  = size;
+   header.body_hash  = MemHash64(body, size, DRC_HASH_SEED);
+
+   /* As for formula caches, never expose a partial file */
+   tmp_name = DStrAlloc();
+   DStrAppendStr(tmp_name, file);
+   DStrAppendStr(tmp_name, ".");
+   DStrAppendInt(tmp_name, getpid());
+   out = fopen(DStrView(tmp_name), "w");
+   res = out &&
+      fwrite(&header, sizeof(header), 1, out) == 1 &&
+      (size == 0 || fwrite(body, size, 1, out) == 1);
+   if(out && fclose(out))
+   {
+      res = false;
+   }
+   if(res && rename(DStrView(tmp_name), file))
+   {
+      res = false;
+   }
+   if(!res)
+   {
+      SysWarning("Cannot write SinE cache %s", file);
+      unlink(DStrView(tmp_name));
+   }
+   else
+   {
+      base->modified = false;
+   }
+   DStrFree(tmp_name);
+   FREE(body);
+
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: DRelBaseLoad()
+//
+//   Try to load the data written by DRelBaseWrite() with the same key
+//   into the (fresh) base and the (empty) distribution
+//   generality. Return true on success. If the file is missing or
+//   does not fit, nothing is changed and false is returned.
+//
+// Global Variables: -
+//
+// Side Effects    : File operations, memory operations
+//
+/----------------------------------------------------------------------*/
+
+bool DRelBaseLoad(DRelBase_p base, GenDistrib_p generality,
+                  char* file, uint64_t key)
+{
+   DRCHeader     header;
+   DRCFilter     filter;
+   DRCGen        *gen;
+   DRelSyms_p    syms;
+   PStack_p      loaded = PStackAlloc();
+   long          axioms = PStackGetSP(base->clauses)+PStackGetSP(base->formulas);
+   FunCode       f, f_count = generality->sig->f_count;
+   int64_t       pos, i, j, n;
+   int32_t       *arr;
+   char          *body = NULL;
+   FILE          *in;
+   bool          res;
+
+   assert(PStackEmpty(base->syms));
+   assert(generality->size > f_count);
+
+   in  = fopen(file, "r");
+   res = in && fread(&header, sizeof(header), 1, in) == 1 &&
+      memcmp(header.magic, DRC_MAGIC, sizeof(header.magic)) == 0 &&
+      header.version == DRC_VERSION &&
+      header.byte_order == DRC_BYTE_ORDER &&
+      header.key == key &&
+      header.f_count == f_count &&
+      header.clauses == PStackGetSP(base->clauses) &&
+      header.formulas == PStackGetSP(base->formulas) &&
+      header.body_size >= DRC_ALIGN(sizeof(DRCGen)*(f_count+1));
+   if(res)
+   {
+      body = SecureMalloc(header.body_size);
+      res = fread(body, header.body_size, 1, in) == 1 &&
+         MemHash64(body, header.body_size, DRC_HASH_SEED) == header.body_hash;
+   }
+   if(in)
+   {
+      fclose(in);
+   }
+
+   pos = DRC_ALIGN(sizeof(DRCGen)*(f_count+1));
+   for(i=0; res && i<header.filters; i++)
+   {
+      res = pos+(int64_t)sizeof(DRCFilter) <= header.body_size;
+      if(!res)
+      {
+         break;
+      }
+      memcpy(&filter, body+pos, sizeof(DRCFilter));
+      pos += sizeof(DRCFilter);
+      n    = axioms+1+filter.d_syms+filter.conjectures;
+      res  = filter.d_syms >= 0 && filter.conjectures >= 0 &&
+         pos+DRC_ALIGN(sizeof(int32_t)*n) <= header.body_size;
+      if(!res)
+      {
+         break;
+      }
+      syms = d_rel_syms_alloc(filter.gen_measure,
+                              filter.benevolence,
+                              filter.generosity,
+                              filter.trim_implications,
+                              filter.defined_symbols_in_drel);
+      PStackPushP(loaded, syms);
+      arr = (int32_t*)(body+pos);
+      for(j=0; res && j<=axioms; j++)
+      {
+         res = arr[j] >= (j?arr[j-1]:0) && arr[j] <= filter.d_syms;
+         PStackPushInt(syms->d_start, arr[j]);
+      }
+      res = res && arr[axioms] == filter.d_syms;
+      arr += axioms+1;
+      for(j=0; res && j<filter.d_syms; j++)
+      {
+         res = arr[j] >= 0 && arr[j] <= f_count;
+         PStackPushInt(syms->d_syms, arr[j]);
+      }
+      arr += filter.d_syms;
+      for(j=0; res && j<filter.conjectures; j++)
+      {
+         res = arr[j] >= 0 && arr[j] < axioms;
+         PStackPushInt(syms->conjectures, arr[j]);
+      }
+      pos += DRC_ALIGN(sizeof(int32_t)*n);
+   }
+
+   if(res)
+   {
+      gen = (DRCGen*)body;
+      for(f=0; f<=f_count; f++)
+      {
+         generality->dist_array[f].term_freq = gen[f].term_freq;
+         generality->dist_array[f].fc_freq   = gen[f].fc_freq;
+      }
+      for(i=0; i<PStackGetSP(loaded); i++)
+      {
+         syms = PStackElementP(loaded, i);
+         d_rel_syms_index(syms);
+         PStackPushP(base->syms, syms);
+      }
+      base->modified = false;
+   }
+   else
+   {
+      while(!PStackEmpty(loaded))
+      {
+         d_rel_syms_free(PStackPopP(loaded));
+      }
+   }
+   PStackFree(loaded);
+   if(body)
+   {
+      FREE(body);
+   }
+   return res;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: PQueueStoreClause()
@@ -670,7 +1506,9 @@ long SelectDefiningAxioms(DRelation_p drel,
 //   indicated by hyp_start), select axioms according to the
 //   D-Relation described by gen_measure and benevolence. Selected
 //   axioms are pushed onto res_clauses and res_formulas, the total
-//   number of selected axioms is returned.
+//   number of selected axioms is returned. If drel_base is given
+//   (and covers ax_filter), the D-relation is derived from it instead
+//   of being computed from scratch.
 //
 // Global Variables: -
 //
@@ -679,6 +1517,7 @@ long SelectDefiningAxioms(DRelation_p drel,
 /----------------------------------------------------------------------*/
 
 long SelectAxioms(GenDistrib_p      f_distrib,
+                  DRelBase_p        drel_base,
                   PStack_p          clause_sets,
                   PStack_p          formula_sets,
                   PStackPointer     seed_start,
@@ -688,7 +1527,7 @@ long SelectAxioms(GenDistrib_p      f_distrib,
 {
    long          res   = 0;
    long          seeds = 0;
-   DRelation_p   drel  = DRelationAlloc();
+   DRelation_p   drel  = NULL;
    PQueue_p      selq  = PQueueAlloc();
    PStackPointer i;
    long          ax_cardinality, max_result_size;
@@ -699,18 +1538,27 @@ long SelectAxioms(GenDistrib_p      f_distrib,
    //seed_start, GetSecTimeMod());
 
    //GenDistribPrint(stdout, f_distrib, 10);
-   DRelationAddClauseSets(drel, f_distrib,
-                          ax_filter->gen_measure,
-                          ax_filter->benevolence,
-                          ax_filter->generosity,
-                          clause_sets);
-   DRelationAddFormulaSets(drel, f_distrib,
-                           ax_filter->gen_measure,
-                           ax_filter->benevolence,
-                           ax_filter->generosity,
-                           ax_filter->trim_implications,
-                           ax_filter->defined_symbols_in_drel,
-                           formula_sets);
+   if(drel_base)
+   {
+      drel = DRelBaseGetDRelation(drel_base, f_distrib, ax_filter,
+                                  clause_sets, formula_sets);
+   }
+   if(!drel)
+   {
+      drel = DRelationAlloc();
+      DRelationAddClauseSets(drel, f_distrib,
+                             ax_filter->gen_measure,
+                             ax_filter->benevolence,
+                             ax_filter->generosity,
+                             clause_sets);
+      DRelationAddFormulaSets(drel, f_distrib,
+                              ax_filter->gen_measure,
+                              ax_filter->benevolence,
+                              ax_filter->generosity,
+                              ax_filter->trim_implications,
+                              ax_filter->defined_symbols_in_drel,
+                              formula_sets);
+   }
    /* fprintf(GlobalOut, COMCHAR" DRelation constructed (%lld)\n",
     * GetSecTimeMod()); */
    // DRelationPrintDebug(stderr, drel, f_distrib->sig);
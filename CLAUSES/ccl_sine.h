@@ -26,6 +26,7 @@ Changes
 
 #define CCL_SINE
 
+#include <stdint.h>
 #include <ccl_f_generality.h>
 
 
@@ -53,6 +54,45 @@ typedef struct d_relation_cell
 }DRelationCell, *DRelation_p;
 
 
+/* The D-relation symbols of all axioms of a DRelBase (see below) for
+ * one set of filter parameters. The symbols of axiom i are
+ * d_syms[d_start[i]] to d_syms[d_start[i+1]-1], d_occ maps each
+ * symbol to the axioms it is in D-relation with. If implications are
+ * trimmed, the result depends on which formulas are conjectures, so
+ * these are recorded. */
+
+typedef struct d_rel_syms_cell
+{
+   GeneralityMeasure gen_measure;
+   double            benevolence;
+   long              generosity;
+   bool              trim_implications;
+   bool              defined_symbols_in_drel;
+   PStack_p          d_syms;
+   PStack_p          d_start;
+   PStack_p          conjectures; /* Axiom numbers, ascending */
+   PDArray_p         d_occ;
+}DRelSymsCell, *DRelSyms_p;
+
+
+/* Precomputed data for the D-relations of a fixed initial segment of
+ * the clause and formula sets (typically the shared axioms of many
+ * problems). Adding a problem only increases the generality of the
+ * symbols occurring in it. This cannot change the D-relation symbols
+ * of an axiom unless one of them is such a symbol, so only these
+ * axioms have to be recomputed. Axioms are numbered in D-relation
+ * order, i.e. clauses first. */
+
+typedef struct d_rel_base_cell
+{
+   PStackPointer sets;        /* Number of clause/formula sets covered */
+   PStack_p      clauses;
+   PStack_p      formulas;
+   PStack_p      syms;        /* Of DRelSyms_p, one per filter */
+   bool          modified;    /* Filters added since load/write */
+}DRelBaseCell, *DRelBase_p;
+
+
 /* Types of axioms */
 
 typedef enum
@@ -129,6 +169,26 @@ void DRelationAddFormulaSets(DRelation_p drel,
                              bool force_def,
                              PStack_p sets);
 
+#define DRelSymsCellAlloc()    (DRelSymsCell*)SizeMalloc(sizeof(DRelSymsCell))
+#define DRelSymsCellFree(junk) SizeFree(junk, sizeof(DRelSymsCell))
+
+#define DRelBaseCellAlloc()    (DRelBaseCell*)SizeMalloc(sizeof(DRelBaseCell))
+#define DRelBaseCellFree(junk) SizeFree(junk, sizeof(DRelBaseCell))
+
+DRelBase_p  DRelBaseAlloc(PStack_p clause_sets, PStack_p formula_sets,
+                          PStackPointer sets);
+void        DRelBaseFree(DRelBase_p base);
+bool        DRelBaseAddFilter(DRelBase_p base, GenDistrib_p generality,
+                              AxFilter_p ax_filter);
+DRelation_p DRelBaseGetDRelation(DRelBase_p base, GenDistrib_p generality,
+                                 AxFilter_p ax_filter,
+                                 PStack_p clause_sets,
+                                 PStack_p formula_sets);
+bool        DRelBaseWrite(DRelBase_p base, GenDistrib_p generality,
+                          char* file, uint64_t key);
+bool        DRelBaseLoad(DRelBase_p base, GenDistrib_p generality,
+                         char* file, uint64_t key);
+
 void PQueueStoreClause(PQueue_p axioms, Clause_p clause);
 void PQueueStoreFormula(PQueue_p axioms, WFormula_p form);
 
@@ -150,6 +210,7 @@ long SelectDefiningAxioms(DRelation_p drel,
 
 
 long SelectAxioms(GenDistrib_p      f_distrib,
+                  DRelBase_p        drel_base,
                   PStack_p          clause_sets,
                   PStack_p          formula_sets,
                   PStackPointer     hyp_start,
@@ -21,6 +21,7 @@
   -----------------------------------------------------------------------*/
 
 #include "ccl_subsumption.h"
+#include <clb_profile.h>
 
 
 /*---------------------------------------------------------------------*/
@@ -154,6 +155,180 @@ Clause_p unit_clause_set_subsumes_clause(ClauseSet_p set,
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// The clause subsumption tests below are used by the sequential
+// code as well as (for first-order problems) by the workers in
+// ClauseSetFindFVSubsumedClauses(). A SubsumeCtrlCell selects how
+// matchers are represented: Either as a normal substitution
+// (binding the shared variable cells) or as a LocalSubst (private
+// bindings, no memory operations, thread-safe). It also collects
+// the statistics, so that workers never touch the global counters.
+//
+/----------------------------------------------------------------------*/
+
+typedef struct subsume_ctrl_cell
+{
+   Subst_p      subst;      /* Term bindings (allocated on demand)... */
+   LocalSubst_p local;      /* ...or private bindings, if set */
+   long         *pick_list; /* Preallocated and cleared, or NULL */
+   long         calls;      /* Local ClauseClauseSubsumptionCalls */
+   long         calls_rec;  /* ...ClauseClauseSubsumptionCallsRec */
+   long         successes;  /* ...ClauseClauseSubsumptionSuccesses */
+   long         unit_calls; /* ...UnitClauseClauseSubsumptionCalls */
+}SubsumeCtrlCell, *SubsumeCtrl_p;
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: subsume_ctrl_init()
+//
+//   Initialize ctrl. If local is NULL, term bindings are used.
+//   pick_list, if given, needs to have one (0-initialized) entry
+//   per literal of the largest clause tested.
+//
+// Global Variables: -
+//
+// Side Effects    : Initializes ctrl
+//
+/----------------------------------------------------------------------*/
+
+static void subsume_ctrl_init(SubsumeCtrl_p ctrl, LocalSubst_p local,
+                              long *pick_list)
+{
+   ctrl->subst      = NULL;
+   ctrl->local      = local;
+   ctrl->pick_list  = pick_list;
+   ctrl->calls      = 0;
+   ctrl->calls_rec  = 0;
+   ctrl->successes  = 0;
+   ctrl->unit_calls = 0;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: subsume_ctrl_exit()
+//
+//   Free the substitution allocated by ctrl (if any) and add the
+//   statistics to the global counters. Must not be called from a
+//   worker thread.
+//
+// Global Variables: ClauseClauseSubsumptionCalls,
+//                   ClauseClauseSubsumptionCallsRec,
+//                   ClauseClauseSubsumptionSuccesses,
+//                   UnitClauseClauseSubsumptionCalls
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void subsume_ctrl_exit(SubsumeCtrl_p ctrl)
+{
+   if(ctrl->subst)
+   {
+      SubstDelete(ctrl->subst);
+      ctrl->subst = NULL;
+   }
+   ClauseClauseSubsumptionCalls     += ctrl->calls;
+   ClauseClauseSubsumptionCallsRec  += ctrl->calls_rec;
+   ClauseClauseSubsumptionSuccesses += ctrl->successes;
+   UnitClauseClauseSubsumptionCalls += ctrl->unit_calls;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: subsume_ctrl_prepare()
+//
+//   Make sure that ctrl can be used for matching. Term bindings are
+//   only allocated when needed, as most candidates are rejected by
+//   the cheap tests.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static inline void subsume_ctrl_prepare(SubsumeCtrl_p ctrl)
+{
+   if(!ctrl->local && !ctrl->subst)
+   {
+      ctrl->subst = SubstAlloc();
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: subsume_get_sp()
+//
+//   Return the current backtrack position of the matcher in ctrl.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline PStackPointer subsume_get_sp(SubsumeCtrl_p ctrl)
+{
+   return ctrl->local?LocalSubstGetSP(ctrl->local):PStackGetSP(ctrl->subst);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: subsume_match()
+//
+//   Extend the matcher in ctrl so that it matches pattern onto
+//   target. Return true on success. Otherwise return false and leave
+//   the matcher unchanged.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes the matcher in ctrl
+//
+/----------------------------------------------------------------------*/
+
+static inline bool subsume_match(SubsumeCtrl_p ctrl, Term_p pattern,
+                                 Term_p target)
+{
+   if(ctrl->local)
+   {
+      return LocalSubstComputeMatch(ctrl->local, pattern, target);
+   }
+   return SubstMatchComplete(pattern, target, ctrl->subst);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: subsume_backtrack_to_pos()
+//
+//   Undo all bindings of the matcher in ctrl made after pos.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes the matcher in ctrl
+//
+/----------------------------------------------------------------------*/
+
+static inline void subsume_backtrack_to_pos(SubsumeCtrl_p ctrl,
+                                            PStackPointer pos)
+{
+   if(ctrl->local)
+   {
+      LocalSubstBacktrackToPos(ctrl->local, pos);
+   }
+   else
+   {
+      SubstBacktrackToPos(ctrl->subst, pos);
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: eqn_topsubsumes_termpair()
@@ -166,30 +341,31 @@ Clause_p unit_clause_set_subsumes_clause(ClauseSet_p set,
 //
 /----------------------------------------------------------------------*/
 
-static bool eqn_topsubsumes_termpair(Eqn_p eqn, Term_p t1, Term_p t2)
+static bool eqn_topsubsumes_termpair(SubsumeCtrl_p ctrl, Eqn_p eqn,
+                                     Term_p t1, Term_p t2)
 {
-   Subst_p subst = SubstAlloc();
-   bool    res = false;
+   PStackPointer pos = subsume_get_sp(ctrl);
+   bool          res = false;
 
    assert(eqn);
    assert(t1);
    assert(t2);
 
-   if(SubstMatchComplete(eqn->lterm, t1, subst))
+   if(subsume_match(ctrl, eqn->lterm, t1))
    {
-      if(SubstMatchComplete(eqn->rterm, t2, subst))
+      if(subsume_match(ctrl, eqn->rterm, t2))
       {
          res = true;
       }
    }
-   else if(SubstMatchComplete(eqn->lterm, t2, subst))
+   else if(subsume_match(ctrl, eqn->lterm, t2))
    {
-      if(SubstMatchComplete(eqn->rterm, t1, subst))
+      if(subsume_match(ctrl, eqn->rterm, t1))
       {
          res = true;
       }
    }
-   SubstDelete(subst);
+   subsume_backtrack_to_pos(ctrl, pos);
 
    return res;
 }
@@ -207,7 +383,8 @@ static bool eqn_topsubsumes_termpair(Eqn_p eqn, Term_p t1, Term_p t2)
 //
 /----------------------------------------------------------------------*/
 
-static bool eqn_subsumes_termpair(Eqn_p eqn, Term_p t1, Term_p t2)
+static bool eqn_subsumes_termpair(SubsumeCtrl_p ctrl, Eqn_p eqn,
+                                  Term_p t1, Term_p t2)
 {
    Term_p   tmp1, tmp2 = NULL;
    int      i;
@@ -217,7 +394,7 @@ static bool eqn_subsumes_termpair(Eqn_p eqn, Term_p t1, Term_p t2)
    assert(t2);
    assert(eqn);
 
-   while(!(res = eqn_topsubsumes_termpair(eqn, t1, t2)))
+   while(!(res = eqn_topsubsumes_termpair(ctrl, eqn, t1, t2)))
    {
       if(TermIsPhonyApp(t1) || TermIsPhonyApp(t2) ||
          t1->f_code != t2->f_code || !t1->arity)
@@ -259,6 +436,49 @@ static bool eqn_subsumes_termpair(Eqn_p eqn, Term_p t1, Term_p t2)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: literal_subsumes_clause()
+//
+//   Return true if literal subsumes one of the literals in clause
+//   (otherwise return false).
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool literal_subsumes_clause(SubsumeCtrl_p ctrl, Eqn_p literal,
+                                    Clause_p clause)
+{
+   Eqn_p handle;
+
+   for(handle = clause->literals; handle; handle = handle->next)
+   {
+      if(EqnIsPositive(literal))
+      {
+         if(EqnIsPositive(handle) &&
+            eqn_subsumes_termpair(ctrl, literal, handle->lterm,
+                                  handle->rterm))
+         {
+            return true;
+         }
+      }
+      else
+      {
+         if(EqnIsNegative(handle) &&
+            eqn_topsubsumes_termpair(ctrl, literal, handle->lterm,
+                                     handle->rterm))
+         {
+            return true;
+         }
+      }
+   }
+   return false;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: find_spec_literal()
@@ -311,9 +531,9 @@ Eqn_p find_spec_literal_old(Eqn_p lit, Eqn_p list)
 #endif
 
 /* New version using ordering */
-static Eqn_p find_spec_literal(Eqn_p lit, Eqn_p list)
+static Eqn_p find_spec_literal(SubsumeCtrl_p ctrl, Eqn_p lit, Eqn_p list)
 {
-   Subst_p subst = SubstAlloc();
+   PStackPointer pos = subsume_get_sp(ctrl);
    int cmpres;
 
    for(;list;list = list->next)
@@ -338,24 +558,24 @@ static Eqn_p find_spec_literal(Eqn_p lit, Eqn_p list)
       {
          continue;
       }
-      if(SubstMatchComplete(lit->lterm, list->lterm, subst)&&
-         SubstMatchComplete(lit->rterm, list->rterm, subst))
+      if(subsume_match(ctrl, lit->lterm, list->lterm)&&
+         subsume_match(ctrl, lit->rterm, list->rterm))
       {
          break;
       }
-      SubstBacktrack(subst);
+      subsume_backtrack_to_pos(ctrl, pos);
       if(EqnIsOriented(lit))
       {
          continue;
       }
-      if(SubstMatchComplete(lit->lterm, list->rterm, subst)&&
-         SubstMatchComplete(lit->rterm, list->lterm, subst))
+      if(subsume_match(ctrl, lit->lterm, list->rterm)&&
+         subsume_match(ctrl, lit->rterm, list->lterm))
       {
          break;
       }
-      SubstBacktrack(subst);
+      subsume_backtrack_to_pos(ctrl, pos);
    }
-   SubstDelete(subst);
+   subsume_backtrack_to_pos(ctrl, pos);
    return list;
 }
 
@@ -373,15 +593,16 @@ static Eqn_p find_spec_literal(Eqn_p lit, Eqn_p list)
 //
 /----------------------------------------------------------------------*/
 
-static bool check_subsumption_possibility(Clause_p subsumer, Clause_p
-                                          sub_candidate)
+static bool check_subsumption_possibility(SubsumeCtrl_p ctrl,
+                                          Clause_p subsumer,
+                                          Clause_p sub_candidate)
 {
    bool    res = true;
    Eqn_p   sub_eqn;
 
    for(sub_eqn = subsumer->literals; sub_eqn; sub_eqn = sub_eqn->next)
    {
-      if(!find_spec_literal(sub_eqn, sub_candidate->literals))
+      if(!find_spec_literal(ctrl, sub_eqn, sub_candidate->literals))
       {
          res = false;
          break;
@@ -398,7 +619,7 @@ static bool check_subsumption_possibility(Clause_p subsumer, Clause_p
    while(!PStackEmpty(lit_stack))
    {
       sub_eqn = PStackPopP(lit_stack);
-      if(!find_spec_literal(sub_eqn, sub_candidate->literals))
+      if(!find_spec_literal(ctrl, sub_eqn, sub_candidate->literals))
       {
          res = false;
          break;
@@ -507,8 +728,8 @@ bool eqn_list_rec_subsume_old(Eqn_p subsum_list, Eqn_p sub_cand_list,
 #endif
 
 static
-bool eqn_list_rec_subsume(Eqn_p subsum_list, Eqn_p sub_cand_list,
-                          Subst_p subst, long* pick_list)
+bool eqn_list_rec_subsume(SubsumeCtrl_p ctrl, Eqn_p subsum_list,
+                          Eqn_p sub_cand_list, long* pick_list)
 {
    Eqn_p         eqn;
    PStackPointer state;
@@ -552,34 +773,33 @@ bool eqn_list_rec_subsume(Eqn_p subsum_list, Eqn_p sub_cand_list,
       }
 
       pick_list[lcount]++;
-      state = PStackGetSP(subst);
+      state = subsume_get_sp(ctrl);
 
-      if(SubstMatchComplete(subsum_list->lterm, eqn->lterm, subst)&&
-         SubstMatchComplete(subsum_list->rterm, eqn->rterm, subst))
+      if(subsume_match(ctrl, subsum_list->lterm, eqn->lterm)&&
+         subsume_match(ctrl, subsum_list->rterm, eqn->rterm))
       {
-         if(eqn_list_rec_subsume(subsum_list->next, sub_cand_list,
-                                 subst, pick_list))
+         if(eqn_list_rec_subsume(ctrl, subsum_list->next, sub_cand_list,
+                                 pick_list))
          {
             return true;
          }
       }
-      SubstBacktrackToPos(subst, state);
+      subsume_backtrack_to_pos(ctrl, state);
       if(EqnIsOriented(subsum_list))
       {
-         state = PStackGetSP(subst);
          pick_list[lcount]--;
          continue;
       }
-      if(SubstMatchComplete(subsum_list->lterm, eqn->rterm, subst)&&
-         SubstMatchComplete(subsum_list->rterm, eqn->lterm, subst))
+      if(subsume_match(ctrl, subsum_list->lterm, eqn->rterm)&&
+         subsume_match(ctrl, subsum_list->rterm, eqn->lterm))
       {
-         if(eqn_list_rec_subsume(subsum_list->next, sub_cand_list,
-                                 subst, pick_list))
+         if(eqn_list_rec_subsume(ctrl, subsum_list->next, sub_cand_list,
+                                 pick_list))
          {
             return true;
          }
       }
-      SubstBacktrackToPos(subst, state);
+      subsume_backtrack_to_pos(ctrl, state);
       pick_list[lcount]--;
    }
    return false;
@@ -588,51 +808,39 @@ bool eqn_list_rec_subsume(Eqn_p subsum_list, Eqn_p sub_cand_list,
 
 /*-----------------------------------------------------------------------
 //
-// Function: clause_subsumes_clause()
+// Function: clause_subsumes_clause_ctrl()
 //
-//   Return true if subsumer subsumes sub_candidate. Assumes that
-//   weights are precomputed.
+//   Return true if subsumer subsumes sub_candidate, using the
+//   matcher in ctrl. Assumes that weights are precomputed.
 //
 // Global Variables: -
 //
-// Side Effects    : -
+// Side Effects    : Changes ctrl (statistics)
 //
 /----------------------------------------------------------------------*/
 
-static bool clause_subsumes_clause(Clause_p subsumer, Clause_p
-                                   sub_candidate)
+static bool clause_subsumes_clause_ctrl(SubsumeCtrl_p ctrl,
+                                        Clause_p subsumer,
+                                        Clause_p sub_candidate)
 {
-   Subst_p subst;
-   bool    res;
-   long* pick_list;
-
-   PERF_CTR_ENTRY(SubsumeTimer);
-
-   /* if(!ClauseIsSubsumeOrdered(sub_candidate)) */
-   /* { */
-   /*    printf(COMCHAR" sub_candidate %p: ", sub_candidate->set);ClausePrint(stdout, sub_candidate, true); */
-   /*    printf("\n"COMCHAR" subsumer     %p: ", subsumer->set);ClausePrint(stdout, subsumer, true); */
-   /*    printf("\n"); */
+   PStackPointer pos;
+   bool          res;
+   long*         pick_list;
+   int           i;
 
-   /*    printf(COMCHAR" %ld, %ld\n", EqnStandardWeight(sub_candidate->literals),EqnStandardWeight(sub_candidate->literals->next)); */
-   /*    printf(COMCHAR" EqnSubsumeInverseCompareRef()=%d\n", EqnSubsumeInverseCompareRef(&(sub_candidate->literals), &(sub_candidate->literals->next))); */
-   /*    printf(COMCHAR" EqnSubsumeQOrderCompare()=%d\n", EqnSubsumeQOrderCompare(sub_candidate->literals, sub_candidate->literals->next)); */
-   /*    ClauseSubsumeOrderSortLits(sub_candidate); */
-   /*    printf(COMCHAR" sub_candidate %p: ", sub_candidate->set);ClausePrint(stdout, sub_candidate, true); */
-   /*    printf("\n"); */
-   /* } */
    assert(ClauseIsSubsumeOrdered(subsumer));
    assert(ClauseIsSubsumeOrdered(sub_candidate));
 
    if(ClauseLiteralNumber(subsumer)==0)
    {
-      PERF_CTR_EXIT(SubsumeTimer);
       return true;
    }
    if(ClauseLiteralNumber(subsumer)==1)
    {
-      PERF_CTR_EXIT(SubsumeTimer);
-      return UnitClauseSubsumesClause(subsumer, sub_candidate);
+      ctrl->unit_calls++;
+      subsume_ctrl_prepare(ctrl);
+      return literal_subsumes_clause(ctrl, subsumer->literals,
+                                     sub_candidate);
    }
    /*fprintf(stderr, COMCHAR" sub_candidate:");ClausePrint(stderr, sub_candidate, true);
    fprintf(stderr, "\n"COMCHAR" subsumer:");ClausePrint(stderr, subsumer, true);
@@ -641,44 +849,96 @@ static bool clause_subsumes_clause(Clause_p subsumer, Clause_p
    assert(sub_candidate->weight == ClauseStandardWeight(sub_candidate));
    assert(subsumer->weight == ClauseStandardWeight(subsumer));
 
-   ClauseClauseSubsumptionCalls++;
+   ctrl->calls++;
 
    if((subsumer->pos_lit_no > sub_candidate->pos_lit_no) ||
       (subsumer->neg_lit_no > sub_candidate->neg_lit_no))
    {
-      PERF_CTR_EXIT(SubsumeTimer);
       return false;
    }
    if(subsumer->weight > sub_candidate->weight)
    {
-      PERF_CTR_EXIT(SubsumeTimer);
       return false;
    }
+   subsume_ctrl_prepare(ctrl);
    if(((sub_candidate->pos_lit_no >=3) ||
        (sub_candidate->neg_lit_no >=3))&&
-      !check_subsumption_possibility(subsumer, sub_candidate))
+      !check_subsumption_possibility(ctrl, subsumer, sub_candidate))
    {
-      PERF_CTR_EXIT(SubsumeTimer);
       return false;
    }
-   subst = SubstAlloc();
-   ClauseClauseSubsumptionCallsRec++;
+   ctrl->calls_rec++;
 
-   pick_list = IntArrayAlloc(ClauseLiteralNumber(sub_candidate));
+   pick_list = ctrl->pick_list?ctrl->pick_list:
+      IntArrayAlloc(ClauseLiteralNumber(sub_candidate));
+   pos = subsume_get_sp(ctrl);
 
-   res = eqn_list_rec_subsume(subsumer->literals,
-                              sub_candidate->literals, subst,
+   res = eqn_list_rec_subsume(ctrl, subsumer->literals,
+                              sub_candidate->literals,
                               pick_list);
-   IntArrayFree(pick_list, ClauseLiteralNumber(sub_candidate));
+   subsume_backtrack_to_pos(ctrl, pos);
+   if(ctrl->pick_list)
+   {
+      for(i=0; i<ClauseLiteralNumber(sub_candidate); i++)
+      {
+         pick_list[i] = 0;
+      }
+   }
+   else
+   {
+      IntArrayFree(pick_list, ClauseLiteralNumber(sub_candidate));
+   }
+   if(res)
+   {
+      ctrl->successes++;
+   }
+   return res;
+}
 
-   SubstDelete(subst);
+
+/*-----------------------------------------------------------------------
+//
+// Function: clause_subsumes_clause()
+//
+//   Return true if subsumer subsumes sub_candidate. Assumes that
+//   weights are precomputed.
+//
+// Global Variables: ClauseClauseSubsumptionCalls,
+//                   ClauseClauseSubsumptionCallsRec,
+//                   ClauseClauseSubsumptionSuccesses,
+//                   UnitClauseClauseSubsumptionCalls
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool clause_subsumes_clause(Clause_p subsumer, Clause_p
+                                   sub_candidate)
+{
+   SubsumeCtrlCell ctrl;
+   bool            res;
+
+   PERF_CTR_ENTRY(SubsumeTimer);
+
+   /* if(!ClauseIsSubsumeOrdered(sub_candidate)) */
+   /* { */
+   /*    printf(COMCHAR" sub_candidate %p: ", sub_candidate->set);ClausePrint(stdout, sub_candidate, true); */
+   /*    printf("\n"COMCHAR" subsumer     %p: ", subsumer->set);ClausePrint(stdout, subsumer, true); */
+   /*    printf("\n"); */
+
+   /*    printf(COMCHAR" %ld, %ld\n", EqnStandardWeight(sub_candidate->literals),EqnStandardWeight(sub_candidate->literals->next)); */
+   /*    printf(COMCHAR" EqnSubsumeInverseCompareRef()=%d\n", EqnSubsumeInverseCompareRef(&(sub_candidate->literals), &(sub_candidate->literals->next))); */
+   /*    printf(COMCHAR" EqnSubsumeQOrderCompare()=%d\n", EqnSubsumeQOrderCompare(sub_candidate->literals, sub_candidate->literals->next)); */
+   /*    ClauseSubsumeOrderSortLits(sub_candidate); */
+   /*    printf(COMCHAR" sub_candidate %p: ", sub_candidate->set);ClausePrint(stdout, sub_candidate, true); */
+   /*    printf("\n"); */
+   /* } */
+   subsume_ctrl_init(&ctrl, NULL, NULL);
+   res = clause_subsumes_clause_ctrl(&ctrl, subsumer, sub_candidate);
+   subsume_ctrl_exit(&ctrl);
 
    PERF_CTR_EXIT(SubsumeTimer);
 
-   if(res)
-   {
-      ClauseClauseSubsumptionSuccesses++;
-   }
    return res;
 }
 
@@ -780,6 +1040,7 @@ Clause_p clause_set_subsumes_clause_indexed(FVIndex_p index,
 {
 
    assert(vec->clause->weight == ClauseStandardWeight(vec->clause));
+   PROF_COUNT(ProfFVVisits);
 
    if(feature == vec->size)
    {
@@ -976,6 +1237,7 @@ void clauseset_find_subsumed_clauses_indexed(FVIndex_p index,
                                              long feature,
                                              PStack_p res)
 {
+   PROF_COUNT(ProfFVVisits);
    if(feature == vec->size)
    {
       clause_tree_find_subsumed_clauses(index->u1.clauses, vec->clause, res);
@@ -1021,6 +1283,7 @@ Clause_p clauseset_find_first_subsumed_clause_indexed(FVIndex_p index,
 {
    Clause_p res = NULL;
 
+   PROF_COUNT(ProfFVVisits);
    if(feature == vec->size)
    {
       res = clause_tree_find_first_subsumed_clause(index->u1.clauses, vec->clause);
@@ -1130,17 +1393,56 @@ Clause_p clauseset_find_variant_clause_indexed(FVIndex_p index,
 }
 
 
-/*---------------------------------------------------------------------*/
-/*                         Exported Functions                          */
-/*---------------------------------------------------------------------*/
+/*-----------------------------------------------------------------------
+//
+// Function: clause_set_subsumes_clause_flat()
+//
+//   Return a clause from the flat index that subsumes vec->clause, or
+//   NULL.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static
+Clause_p clause_set_subsumes_clause_flat(FVFlatIndex_p index,
+                                         FreqVector_p vec)
+{
+   PStack_p      cands = PStackAlloc();
+   PStackPointer i;
+   long          block = 0;
+   Clause_p      res = NULL, clause;
+
+   FVFlatIndexSetQuery(index, vec);
+   while(!res &&
+         FVFlatIndexNextCandidates(index, FVFSubsuming, &block, cands))
+   {
+      PROF_COUNT(ProfFVVisits);
+      for(i=0; i<PStackGetSP(cands); i++)
+      {
+         clause = PStackElementP(cands, i);
+         if(clause_subsumes_clause(clause, vec->clause))
+         {
+            res = clause;
+            break;
+         }
+      }
+      PStackReset(cands);
+   }
+   PStackFree(cands);
+   return res;
+}
 
 
 /*-----------------------------------------------------------------------
 //
-// Function: LiteralSubsumesClause()
+// Function: clauseset_find_subsumed_clauses_flat()
 //
-//   Return true if literal subsumes one of the literals in clause
-//   (otherwise return false).
+//   Push all clauses from the flat index that are subsumed by
+//   vec->clause onto res. If first_only is true, stop after the first
+//   one.
 //
 // Global Variables: -
 //
@@ -1148,34 +1450,347 @@ Clause_p clauseset_find_variant_clause_indexed(FVIndex_p index,
 //
 /----------------------------------------------------------------------*/
 
-bool LiteralSubsumesClause(Eqn_p literal, Clause_p clause)
+static
+void clauseset_find_subsumed_clauses_flat(FVFlatIndex_p index,
+                                          FreqVector_p vec,
+                                          bool first_only,
+                                          PStack_p res)
 {
-   Eqn_p handle;
+   PStack_p      cands = PStackAlloc();
+   PStackPointer i, old_sp = PStackGetSP(res);
+   long          block = 0;
+   Clause_p      clause;
+
+   FVFlatIndexSetQuery(index, vec);
+   while(!(first_only && PStackGetSP(res) > old_sp) &&
+         FVFlatIndexNextCandidates(index, FVFSubsumed, &block, cands))
+   {
+      PROF_COUNT(ProfFVVisits);
+      for(i=0; i<PStackGetSP(cands); i++)
+      {
+         clause = PStackElementP(cands, i);
+         if(clause_subsumes_clause(vec->clause, clause))
+         {
+            PStackPushP(res, clause);
+            if(first_only)
+            {
+               break;
+            }
+         }
+      }
+      PStackReset(cands);
+   }
+   PStackFree(cands);
+}
 
-   handle = clause->literals;
-   while(handle)
+
+/*-----------------------------------------------------------------------
+//
+// Function: clauseset_find_variant_clause_flat()
+//
+//   Return a variant of vec->clause from the flat index, or NULL.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static
+Clause_p clauseset_find_variant_clause_flat(FVFlatIndex_p index,
+                                            FreqVector_p vec)
+{
+   PStack_p      cands = PStackAlloc();
+   PStackPointer i;
+   long          block = 0;
+   Clause_p      res = NULL, clause;
+
+   FVFlatIndexSetQuery(index, vec);
+   while(!res &&
+         FVFlatIndexNextCandidates(index, FVFVariant, &block, cands))
    {
-      if(EqnIsPositive(literal))
+      for(i=0; i<PStackGetSP(cands); i++)
       {
-         if(EqnIsPositive(handle) &&
-            eqn_subsumes_termpair(literal, handle->lterm,
-                                  handle->rterm))
+         clause = PStackElementP(cands, i);
+         if(clause_subsumes_clause(clause, vec->clause) &&
+            clause_subsumes_clause(vec->clause, clause))
          {
-            return true;
+            res = clause;
+            break;
          }
       }
-      else
+      PStackReset(cands);
+   }
+   PStackFree(cands);
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Job description for the parallel search in
+// clauseset_find_subsumed_clauses_par(): Each worker tests its slice
+// of cands with its own LocalSubst-based SubsumeCtrlCell.
+//
+/----------------------------------------------------------------------*/
+
+typedef struct par_subsume_job_cell
+{
+   Clause_p        subsumer;
+   PStack_p        cands;
+   bool            *hits;
+   SubsumeCtrlCell workers[WORKPOOL_MAX_WORKERS];
+}ParSubsumeJobCell, *ParSubsumeJob_p;
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: par_subsume_slice()
+//
+//   Work function for the worker pool: Test candidates [first,last)
+//   of the job and record the results in job->hits.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes job->hits and the worker state
+//
+/----------------------------------------------------------------------*/
+
+static void par_subsume_slice(void* data, int worker, long first, long last)
+{
+   ParSubsumeJob_p job = data;
+   long i;
+
+   for(i=first; i<last; i++)
+   {
+      job->hits[i] =
+         clause_subsumes_clause_ctrl(&(job->workers[worker]),
+                                     job->subsumer,
+                                     PStackElementP(job->cands, i));
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: clause_tree_collect_clauses()
+//
+//   Push all clauses in tree onto res, in the order in which
+//   clause_tree_find_subsumed_clauses() visits them.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static void clause_tree_collect_clauses(PTree_p tree, PStack_p res)
+{
+   while(tree)
+   {
+      PStackPushP(res, tree->key);
+      clause_tree_collect_clauses(tree->lson, res);
+      tree = tree->rson;
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: clauseset_collect_subsumed_candidates()
+//
+//   Push all clauses from the FV index of set that may be subsumed by
+//   vec->clause onto res, in the order the sequential search tests
+//   them.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static void clauseset_collect_subsumed_candidates(FVIndex_p index,
+                                                  FreqVector_p vec,
+                                                  long feature,
+                                                  PStack_p res)
+{
+   PROF_COUNT(ProfFVVisits);
+   if(feature == vec->size)
+   {
+      clause_tree_collect_clauses(index->u1.clauses, res);
+   }
+   else if(index->u1.successors)
+   {
+      long i;
+      FVIndex_p next;
+      IntMapIter_p iter;
+
+      iter = IntMapIterAlloc(index->u1.successors, vec->array[feature], LONG_MAX);
+
+      while((next = IntMapIterNext(iter, &i)))
       {
-         if(EqnIsNegative(handle) &&
-            eqn_topsubsumes_termpair(literal, handle->lterm,
-                                     handle->rterm))
+         if(next->clause_count)
          {
-            return true;
+            clauseset_collect_subsumed_candidates(next, vec,
+                                                  feature+1, res);
          }
       }
-      handle = handle->next;
+      IntMapIterFree(iter);
    }
-   return false;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: clauseset_find_subsumed_clauses_par()
+//
+//   Find all clauses in the FV-indexed set subsumed by
+//   subsumer->clause and push them onto res. Candidates are
+//   retrieved from the index first. If there are enough of them,
+//   they are tested by the workers of pool. In any case, the result
+//   (including its order) is the same as for the sequential search.
+//
+// Global Variables: ClauseClauseSubsumptionCalls,
+//                   ClauseClauseSubsumptionCallsRec,
+//                   ClauseClauseSubsumptionSuccesses,
+//                   UnitClauseClauseSubsumptionCalls
+//
+// Side Effects    : Memory operations, uses pool
+//
+/----------------------------------------------------------------------*/
+
+static void clauseset_find_subsumed_clauses_par(ClauseSet_p set,
+                                                FVPackedClause_p subsumer,
+                                                WorkPool_p pool,
+                                                PStack_p res)
+{
+   PStack_p          cands = PStackAlloc();
+   ParSubsumeJobCell job;
+   SubsumeCtrl_p     worker;
+   LocalSubst_p      subst;
+   Clause_p          clause = subsumer->clause;
+   Eqn_p             eqn;
+   long              i, items, block = 0, max_lits = 1;
+   int               w;
+
+   if(set->fvindex->flat)
+   {
+      FVFlatIndexSetQuery(set->fvindex->flat, subsumer);
+      while(FVFlatIndexNextCandidates(set->fvindex->flat, FVFSubsumed,
+                                      &block, cands))
+      {
+         PROF_COUNT(ProfFVVisits);
+      }
+   }
+   else
+   {
+      clauseset_collect_subsumed_candidates(set->fvindex->index,
+                                            subsumer, 0, cands);
+   }
+   items = PStackGetSP(cands);
+
+   if(items < PAR_SUBSUMPTION_MIN_CANDIDATES)
+   {
+      for(i=0; i<items; i++)
+      {
+         if(clause_subsumes_clause(clause, PStackElementP(cands, i)))
+         {
+            PStackPushP(res, PStackElementP(cands, i));
+         }
+      }
+      PStackFree(cands);
+      return;
+   }
+
+   for(i=0; i<items; i++)
+   {
+      max_lits = MAX(max_lits,
+                     ClauseLiteralNumber((Clause_p)PStackElementP(cands, i)));
+   }
+   job.subsumer = clause;
+   job.cands    = cands;
+   job.hits     = SizeMalloc(sizeof(bool)*items);
+   for(w=0; w<WorkPoolWorkers(pool); w++)
+   {
+      subst = LocalSubstAlloc();
+      for(eqn = clause->literals; eqn; eqn = eqn->next)
+      {
+         LocalSubstReserveTerm(subst, eqn->lterm);
+         LocalSubstReserveTerm(subst, eqn->rterm);
+      }
+      subsume_ctrl_init(&(job.workers[w]), subst,
+                        IntArrayAlloc(max_lits));
+   }
+
+   WorkPoolRun(pool, par_subsume_slice, &job, items);
+
+#ifndef NDEBUG
+   {
+      /* Cross-check with term bindings, not counted in the
+         statistics */
+      SubsumeCtrlCell check;
+
+      subsume_ctrl_init(&check, NULL, NULL);
+      for(i=0; i<items; i++)
+      {
+         assert(job.hits[i] ==
+                clause_subsumes_clause_ctrl(&check, clause,
+                                            PStackElementP(cands, i)));
+      }
+      if(check.subst)
+      {
+         SubstDelete(check.subst);
+      }
+   }
+#endif
+   for(i=0; i<items; i++)
+   {
+      if(job.hits[i])
+      {
+         PStackPushP(res, PStackElementP(cands, i));
+      }
+   }
+   for(w=0; w<WorkPoolWorkers(pool); w++)
+   {
+      worker = &(job.workers[w]);
+      IntArrayFree(worker->pick_list, max_lits);
+      LocalSubstFree(worker->local);
+      subsume_ctrl_exit(worker);
+   }
+   SizeFree(job.hits, sizeof(bool)*items);
+   PStackFree(cands);
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: LiteralSubsumesClause()
+//
+//   Return true if literal subsumes one of the literals in clause
+//   (otherwise return false).
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+bool LiteralSubsumesClause(Eqn_p literal, Clause_p clause)
+{
+   SubsumeCtrlCell ctrl;
+   bool            res;
+
+   subsume_ctrl_init(&ctrl, NULL, NULL);
+   subsume_ctrl_prepare(&ctrl);
+   res = literal_subsumes_clause(&ctrl, literal, clause);
+   subsume_ctrl_exit(&ctrl);
+
+   return res;
 }
 
 
@@ -1426,8 +2041,12 @@ Clause_p ClauseSetSubsumesFVPackedClause(ClauseSet_p set,
 
    if(set->fvindex && sub_candidate->array)
    {
-      res = clause_set_subsumes_clause_indexed(set->fvindex->index,
-                                               sub_candidate, 0);
+      res = set->fvindex->flat?
+         clause_set_subsumes_clause_flat(set->fvindex->flat, sub_candidate):
+         clause_set_subsumes_clause_indexed(set->fvindex->index,
+                                            sub_candidate, 0);
+      PROF_COUNT(ProfFVSearches);
+      PROF_COUNT_ADD(ProfFVHits, res!=NULL);
       PERF_CTR_EXIT(SetSubsumeTimer);
       return res;
    }
@@ -1461,8 +2080,12 @@ Clause_p ClauseSetSubsumesClause(ClauseSet_p set, Clause_p sub_candidate)
       FreqVector_p vec = OptimizedVarFreqVectorCompute(sub_candidate,
                                                        set->fvindex->perm_vector,
                                                        set->fvindex->cspec);
-      res =  clause_set_subsumes_clause_indexed(set->fvindex->index, vec, 0);
+      res = set->fvindex->flat?
+         clause_set_subsumes_clause_flat(set->fvindex->flat, vec):
+         clause_set_subsumes_clause_indexed(set->fvindex->index, vec, 0);
       FreqVectorFree(vec);
+      PROF_COUNT(ProfFVSearches);
+      PROF_COUNT_ADD(ProfFVHits, res!=NULL);
       PERF_CTR_EXIT(SetSubsumeTimer);
       return res;
    }
@@ -1513,7 +2136,9 @@ Clause_p ClauseSetFindSubsumedClause(ClauseSet_p set, Clause_p
 // Function: ClauseSetFindFVSubsumedClauses()
 //
 //   Find all clauses in set that are subsumed by subsumer, and push
-//   them onto stack. Return number of clauses found.
+//   them onto stack. Return number of clauses found. If pool is not
+//   NULL, candidates from the FV index of a first-order problem are
+//   tested in parallel by its workers.
 //
 // Global Variables:
 //
@@ -1523,6 +2148,7 @@ Clause_p ClauseSetFindSubsumedClause(ClauseSet_p set, Clause_p
 
 long ClauseSetFindFVSubsumedClauses(ClauseSet_p set,
                                     FVPackedClause_p subsumer,
+                                    WorkPool_p pool,
                                     PStack_p res)
 {
    long old_sp = PStackGetSP(res);
@@ -1530,7 +2156,16 @@ long ClauseSetFindFVSubsumedClauses(ClauseSet_p set,
    PERF_CTR_ENTRY(SetSubsumeTimer);
    assert(subsumer->clause->weight == ClauseStandardWeight(subsumer->clause));
 
-   if(set->fvindex)
+   if(pool && set->fvindex && problemType == PROBLEM_FO)
+   {
+      clauseset_find_subsumed_clauses_par(set, subsumer, pool, res);
+   }
+   else if(set->fvindex && set->fvindex->flat)
+   {
+      clauseset_find_subsumed_clauses_flat(set->fvindex->flat,
+                                           subsumer, false, res);
+   }
+   else if(set->fvindex)
    {
       clauseset_find_subsumed_clauses_indexed(set->fvindex->index,
                                               subsumer, 0, res);
@@ -1539,6 +2174,11 @@ long ClauseSetFindFVSubsumedClauses(ClauseSet_p set,
    {
       clauseset_find_subsumed_clauses(set, subsumer->clause, res);
    }
+   if(set->fvindex)
+   {
+      PROF_COUNT(ProfFVSearches);
+      PROF_COUNT_ADD(ProfFVHits, PStackGetSP(res)-old_sp);
+   }
    PERF_CTR_EXIT(SetSubsumeTimer);
    return PStackGetSP(res)-old_sp;
 }
@@ -1566,7 +2206,16 @@ Clause_p ClauseSetFindFirstFVSubsumedClause(ClauseSet_p set,
    PERF_CTR_ENTRY(SetSubsumeTimer);
    assert(subsumer->clause->weight == ClauseStandardWeight(subsumer->clause));
 
-   if(set->fvindex)
+   if(set->fvindex && set->fvindex->flat)
+   {
+      PStack_p found = PStackAlloc();
+
+      clauseset_find_subsumed_clauses_flat(set->fvindex->flat,
+                                           subsumer, true, found);
+      res = PStackEmpty(found)?NULL:PStackTopP(found);
+      PStackFree(found);
+   }
+   else if(set->fvindex)
    {
       res = clauseset_find_first_subsumed_clause_indexed(set->fvindex->index,
                                                    subsumer, 0);
@@ -1575,6 +2224,11 @@ Clause_p ClauseSetFindFirstFVSubsumedClause(ClauseSet_p set,
    {
       res = clauseset_find_first_subsumed_clause(set, subsumer->clause);
    }
+   if(set->fvindex)
+   {
+      PROF_COUNT(ProfFVSearches);
+      PROF_COUNT_ADD(ProfFVHits, res!=NULL);
+   }
    PERF_CTR_EXIT(SetSubsumeTimer);
    return res;
 }
@@ -1605,7 +2259,7 @@ long ClauseSetFindSubsumedClauses(ClauseSet_p set,
 
    pclause = FVIndexPackClause(subsumer, set->fvindex);
 
-   found = ClauseSetFindFVSubsumedClauses(set, pclause, res);
+   found = ClauseSetFindFVSubsumedClauses(set, pclause, NULL, res);
 
    FVUnpackClause(pclause);
    ENSURE_NULL(pclause);
@@ -1665,6 +2319,10 @@ Clause_p ClauseSetFindFVVariantClause(ClauseSet_p set,
 {
    assert(set->fvindex);
 
+   if(set->fvindex->flat)
+   {
+      return clauseset_find_variant_clause_flat(set->fvindex->flat, clause);
+   }
    return clauseset_find_variant_clause_indexed(set->fvindex->index,
                                                 clause, 0);
 }
@@ -26,12 +26,18 @@
 #define CCL_SUBSUPTION
 
 #include <clb_os_wrapper.h>
+#include <clb_workpool.h>
+#include <cte_localsubst.h>
 #include <ccl_unit_simplify.h>
 
 /*---------------------------------------------------------------------*/
 /*                    Data type declarations                           */
 /*---------------------------------------------------------------------*/
 
+/* Backward subsumption with a worker pool only hands out the
+   candidates to the workers if there are at least this many. */
+
+#define PAR_SUBSUMPTION_MIN_CANDIDATES 256
 
 
 
@@ -71,6 +77,7 @@ Clause_p ClauseSetFindSubsumedClause(ClauseSet_p set, Clause_p
 
 long     ClauseSetFindFVSubsumedClauses(ClauseSet_p set,
                                         FVPackedClause_p subsumer,
+                                        WorkPool_p pool,
                                         PStack_p res);
 
 Clause_p ClauseSetFindFirstFVSubsumedClause(ClauseSet_p set,
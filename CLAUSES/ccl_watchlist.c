@@ -0,0 +1,643 @@
+/*-----------------------------------------------------------------------
+
+File  : ccl_watchlist.c
+
+Contents
+
+  Literal index and proof progress bookkeeping for the watchlist.
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+Changes
+
+<1> Sat Oct 17 22:41:17 CEST 2026
+    New
+
+-----------------------------------------------------------------------*/
+
+#include "ccl_watchlist.h"
+
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: wl_payload_free()
+//
+//   Free the clause tree at an index leaf.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void wl_payload_free(void* junk)
+{
+   NumTreeFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: wl_tree_update()
+//
+//   Insert clause into the tree (indexed by its ident) or delete
+//   the entry with its ident from it.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes tree
+//
+/----------------------------------------------------------------------*/
+
+static void wl_tree_update(NumTree_p *root, Clause_p clause, bool insert)
+{
+   IntOrP    val1, val2;
+   NumTree_p node;
+
+   if(!insert)
+   {
+      NumTreeDeleteEntry(root, clause->ident);
+      return;
+   }
+   val1.p_val = clause;
+   val2.i_val = 0;
+   if(!NumTreeStore(root, clause->ident, val1, val2))
+   {
+      node = NumTreeFind(root, clause->ident);
+      node->val1.p_val = clause;
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: wl_tree_collect()
+//
+//   Push all clauses from the tree onto stack.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static void wl_tree_collect(PStack_p stack, NumTree_p root)
+{
+   PStack_p  iter = NumTreeTraverseInit(root);
+   NumTree_p node;
+
+   while((node = NumTreeTraverseNext(iter)))
+   {
+      PStackPushP(stack, node->val1.p_val);
+   }
+   NumTreeTraverseExit(iter);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: wl_pair_update()
+//
+//   Insert clause into (insert is true) or delete it from the leaf
+//   for the term pair t1, t2 (and, if different, for t2, t1).
+//
+// Global Variables: -
+//
+// Side Effects    : Changes index
+//
+/----------------------------------------------------------------------*/
+
+static void wl_pair_update(WatchlistIndex_p index, Clause_p clause,
+                           bool positive, Term_p t1, Term_p t2,
+                           bool insert)
+{
+   Term_p   key = TermTopAlloc(SigGetEqnCode(index->sig, positive), 2);
+   FPTree_p leaf;
+   int      i;
+
+   for(i=0; i<2; i++)
+   {
+      key->args[0] = i?t2:t1;
+      key->args[1] = i?t1:t2;
+      if(insert)
+      {
+         leaf = FPIndexInsert(index->lit_index, key);
+         wl_tree_update((NumTree_p*)&(leaf->payload), clause, true);
+      }
+      else if((leaf = FPIndexFind(index->lit_index, key)))
+      {
+         wl_tree_update((NumTree_p*)&(leaf->payload), clause, false);
+         if(!leaf->payload)
+         {
+            FPIndexDelete(index->lit_index, key);
+         }
+      }
+      if(t1 == t2)
+      {
+         break;
+      }
+   }
+   TermTopFree(key);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: wl_clause_update()
+//
+//   Insert all term pairs of the clause that a unit clause may match
+//   into the index (or delete them). This follows
+//   LiteralSubsumesClause() closely.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes index
+//
+/----------------------------------------------------------------------*/
+
+static void wl_clause_update(WatchlistIndex_p index, Clause_p clause,
+                             bool insert)
+{
+   Eqn_p  handle;
+   Term_p t1, t2, diff1, diff2;
+   int    i;
+
+   for(handle = clause->literals; handle; handle = handle->next)
+   {
+      t1 = handle->lterm;
+      t2 = handle->rterm;
+      if(EqnIsNegative(handle))
+      {
+         wl_pair_update(index, clause, false, t1, t2, insert);
+         continue;
+      }
+      while(true)
+      {
+         wl_pair_update(index, clause, true, t1, t2, insert);
+         if(TermIsPhonyApp(t1) || TermIsPhonyApp(t2) ||
+            t1->f_code != t2->f_code || !t1->arity ||
+            t1->arity != t2->arity)
+         {
+            break;
+         }
+         diff1 = NULL;
+         diff2 = NULL;
+         for(i=0; i<t1->arity; i++)
+         {
+            if(t1->args[i] != t2->args[i])
+            {
+               if(diff1)
+               {
+                  break;
+               }
+               diff1 = t1->args[i];
+               diff2 = t2->args[i];
+            }
+         }
+         if(!diff1)
+         {
+            wl_tree_update(&(index->trivial), clause, insert);
+            break;
+         }
+         if(i<t1->arity)
+         {
+            break;
+         }
+         t1 = diff1;
+         t2 = diff2;
+      }
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: wl_proofs_free()
+//
+//   Free the proof bookkeeping of the index.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void wl_proofs_free(WatchlistIndex_p index)
+{
+   char* name;
+
+   NumTreeFree(index->hints);
+   index->hints = NULL;
+   while(!PStackEmpty(index->proof_names))
+   {
+      name = PStackPopP(index->proof_names);
+      if(name)
+      {
+         FREE(name);
+      }
+   }
+   PDArrayFree(index->proof_size);
+   PDArrayFree(index->proof_matched);
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: WatchlistIndexAlloc()
+//
+//   Allocate an empty watchlist index. The literal index is only
+//   created by WatchlistIndexInit().
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+WatchlistIndex_p WatchlistIndexAlloc(Sig_p sig)
+{
+   WatchlistIndex_p handle = WatchlistIndexCellAlloc();
+
+   handle->sig             = sig;
+   handle->lit_index       = NULL;
+   handle->trivial         = NULL;
+   handle->hints           = NULL;
+   handle->proof_no        = 0;
+   handle->proof_names     = PStackAlloc();
+   handle->proof_size      = PDIntArrayAlloc(8, 0);
+   handle->proof_matched   = PDIntArrayAlloc(8, 0);
+   handle->matched         = 0;
+   handle->unit_queries    = 0;
+   handle->unit_candidates = 0;
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: WatchlistIndexFree()
+//
+//   Free a watchlist index (but not the clauses).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void WatchlistIndexFree(WatchlistIndex_p junk)
+{
+   assert(junk);
+
+   if(junk->lit_index)
+   {
+      FPIndexFree(junk->lit_index);
+   }
+   NumTreeFree(junk->trivial);
+   wl_proofs_free(junk);
+   PStackFree(junk->proof_names);
+   WatchlistIndexCellFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: WatchlistIndexReset()
+//
+//   Forget all clauses and proofs.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void WatchlistIndexReset(WatchlistIndex_p index)
+{
+   if(index->lit_index)
+   {
+      FPIndexFree(index->lit_index);
+      index->lit_index = NULL;
+   }
+   NumTreeFree(index->trivial);
+   index->trivial = NULL;
+   wl_proofs_free(index);
+   index->proof_no        = 0;
+   index->proof_size      = PDIntArrayAlloc(8, 0);
+   index->proof_matched   = PDIntArrayAlloc(8, 0);
+   index->matched         = 0;
+   index->unit_queries    = 0;
+   index->unit_candidates = 0;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: WatchlistIndexAddProof()
+//
+//   Register all clauses from hints that are not yet known as the
+//   hints of a new proof. Return the number of the proof, or -1 if
+//   there were no new clauses. name is copied (and may be NULL).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+long WatchlistIndexAddProof(WatchlistIndex_p index,
+                            ClauseSet_p hints, char* name)
+{
+   Clause_p handle;
+   IntOrP   proof, matched;
+   long     count = 0;
+
+   proof.i_val   = index->proof_no;
+   matched.i_val = 0;
+   for(handle = hints->anchor->succ;
+       handle != hints->anchor;
+       handle = handle->succ)
+   {
+      if(NumTreeStore(&(index->hints), handle->ident, proof, matched))
+      {
+         count++;
+      }
+   }
+   if(!count)
+   {
+      return -1;
+   }
+   PStackPushP(index->proof_names, name?SecureStrdup(name):NULL);
+   PDArrayAssignInt(index->proof_size, index->proof_no, count);
+   PDArrayAssignInt(index->proof_matched, index->proof_no, 0);
+   return index->proof_no++;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: WatchlistIndexInit()
+//
+//   Index the watchlist. Clauses not read as part of a proof form
+//   one more (anonymous) proof. If use_lit_index is false, only
+//   progress is tracked.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void WatchlistIndexInit(WatchlistIndex_p index,
+                        ClauseSet_p watchlist,
+                        bool use_lit_index)
+{
+   Clause_p handle;
+
+   WatchlistIndexAddProof(index, watchlist, NULL);
+   if(use_lit_index && !index->lit_index)
+   {
+      index->lit_index = FPIndexAlloc(IndexDTCreate, index->sig,
+                                      wl_payload_free);
+      for(handle = watchlist->anchor->succ;
+          handle != watchlist->anchor;
+          handle = handle->succ)
+      {
+         WatchlistIndexInsertClause(index, handle);
+      }
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: WatchlistIndexInsertClause()
+//
+//   Insert a watchlist clause into the literal index (if any).
+//
+// Global Variables: -
+//
+// Side Effects    : Changes index
+//
+/----------------------------------------------------------------------*/
+
+void WatchlistIndexInsertClause(WatchlistIndex_p index, Clause_p clause)
+{
+   if(index->lit_index)
+   {
+      wl_clause_update(index, clause, true);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: WatchlistIndexDeleteClause()
+//
+//   Delete a watchlist clause from the literal index (if any). The
+//   clause has to be unchanged since its insertion.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes index
+//
+/----------------------------------------------------------------------*/
+
+void WatchlistIndexDeleteClause(WatchlistIndex_p index, Clause_p clause)
+{
+   if(index->lit_index)
+   {
+      wl_clause_update(index, clause, false);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: WatchlistIndexFindSubsumed()
+//
+//   Push all watchlist clauses subsumed by unit onto res (in order
+//   of their idents), return their number. Requires
+//   WatchlistIndexCoversClause(index, unit).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+long WatchlistIndexFindSubsumed(WatchlistIndex_p index,
+                                Clause_p unit,
+                                PStack_p res)
+{
+   Eqn_p         lit = unit->literals;
+   Term_p        key;
+   PStack_p      leaves = PStackAlloc(), cands = PStackAlloc();
+   Clause_p      handle, last = NULL;
+   PStackPointer i;
+   long          count = 0;
+
+   assert(WatchlistIndexCoversClause(index, unit));
+
+   key = TermTopAlloc(SigGetEqnCode(index->sig, EqnIsPositive(lit)), 2);
+   key->args[0] = lit->lterm;
+   key->args[1] = lit->rterm;
+   FPIndexFindMatchable(index->lit_index, key, leaves);
+   TermTopFree(key);
+
+   while(!PStackEmpty(leaves))
+   {
+      wl_tree_collect(cands, PStackPopP(leaves));
+   }
+   if(EqnIsPositive(lit))
+   {
+      wl_tree_collect(cands, index->trivial);
+   }
+   PStackSort(cands, ClauseCmpById);
+
+   index->unit_queries++;
+   for(i=0; i<PStackGetSP(cands); i++)
+   {
+      handle = PStackElementP(cands, i);
+      if(handle == last)
+      {
+         continue;
+      }
+      last = handle;
+      index->unit_candidates++;
+      if(UnitClauseSubsumesClause(unit, handle))
+      {
+         PStackPushP(res, handle);
+         count++;
+      }
+   }
+   PStackFree(cands);
+   PStackFree(leaves);
+   return count;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: WatchlistIndexNoteMatches()
+//
+//   Record that the hint clauses on matched have been matched (by
+//   the same clause). Return the largest progress (in percent of
+//   matched hints) of any of the proofs these hints belong to.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes progress counters
+//
+/----------------------------------------------------------------------*/
+
+int WatchlistIndexNoteMatches(WatchlistIndex_p index, PStack_p matched)
+{
+   PStackPointer i;
+   Clause_p      handle;
+   NumTree_p     hint;
+   long          proof, progress;
+   int           res = 0;
+
+   for(i=0; i<PStackGetSP(matched); i++)
+   {
+      handle = PStackElementP(matched, i);
+      hint = NumTreeFind(&(index->hints), handle->ident);
+      if(!hint)
+      {
+         continue;
+      }
+      proof = hint->val1.i_val;
+      if(!hint->val2.i_val)
+      {
+         hint->val2.i_val = 1;
+         PDArrayElementIncInt(index->proof_matched, proof, 1);
+         index->matched++;
+      }
+      progress = PDArrayElementInt(index->proof_matched, proof)*
+         WATCHLIST_PROGRESS_MAX/
+         PDArrayElementInt(index->proof_size, proof);
+      res = MAX(res, progress);
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: WatchlistIndexStatisticsPrint()
+//
+//   Print matched hints and the most advanced proof.
+//
+// Global Variables: -
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+void WatchlistIndexStatisticsPrint(FILE* out, WatchlistIndex_p index)
+{
+   long  i, best = -1, size, hints = 0;
+   long  best_matched = 0, best_size = 1;
+   char* name;
+
+   for(i=0; i<index->proof_no; i++)
+   {
+      size = PDArrayElementInt(index->proof_size, i);
+      hints += size;
+      if(best == -1 ||
+         PDArrayElementInt(index->proof_matched, i)*best_size >
+         best_matched*size)
+      {
+         best         = i;
+         best_matched = PDArrayElementInt(index->proof_matched, i);
+         best_size    = size;
+      }
+   }
+   fprintf(out,
+           COMCHAR" Watchlist proofs                     : %ld\n"
+           COMCHAR" Watchlist hints matched              : %ld of %ld\n",
+           index->proof_no, index->matched, hints);
+   if(best != -1)
+   {
+      name = PStackElementP(index->proof_names, best);
+      fprintf(out,
+              COMCHAR" ...best proof progress               : %ld of %ld (%s)\n",
+              best_matched, best_size, name?name:"unnamed");
+   }
+   if(index->lit_index)
+   {
+      fprintf(out,
+              COMCHAR" Unit watchlist index queries         : %ld\n"
+              COMCHAR" ...candidates checked                : %ld\n",
+              index->unit_queries, index->unit_candidates);
+   }
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -0,0 +1,116 @@
+/*-----------------------------------------------------------------------
+
+File  : ccl_watchlist.h
+
+Contents
+
+  Support for watchlist guidance: A discrimination tree over literal
+  term pairs of the watchlist clauses that finds all watchlist
+  clauses a unit clause may subsume, and bookkeeping for how far
+  each of the proofs the watchlist hints were taken from has been
+  matched.
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+Changes
+
+<1> Sat Oct 17 22:41:17 CEST 2026
+    New
+
+-----------------------------------------------------------------------*/
+
+#ifndef CCL_WATCHLIST
+
+#define CCL_WATCHLIST
+
+#include <clb_numtrees.h>
+#include <cte_fp_index.h>
+#include <ccl_subsumption.h>
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+/* A unit clause s=t subsumes a clause iff it matches one of its
+   positive literals u=v either at the top or, descending into u and
+   v while they differ in exactly one argument, at the differing
+   arguments (see LiteralSubsumesClause()). lit_index stores all of
+   these term pairs (as $eq(u,v) or $neq(u,v), in both orientations)
+   with the watchlist clauses they occur in, so that all
+   candidates for a unit subsumer are found by a single search for
+   instances of $eq(s,t). Clauses with a literal that every positive
+   unit subsumes (f(..)=f(..) with identical arguments) are kept in
+   trivial. lit_index is only used for first-order problems, non-unit
+   subsumers and higher-order problems fall back to the feature
+   vector index of the watchlist. Clauses are stored in NumTrees
+   keyed by their ident, so that a clause can be deleted via the
+   copy ClauseMoveSimplified() leaves when it archives the original.
+
+   Each hint clause belongs to one proof (the watchlist file it was
+   read from). hints maps the clause ident to the proof (val1) and
+   to whether it has been matched already (val2). */
+
+typedef struct watchlist_index_cell
+{
+   Sig_p     sig;
+   FPIndex_p lit_index;     /* Term pairs -> clauses by ident */
+   NumTree_p trivial;       /* Clauses subsumed by any positive unit */
+   NumTree_p hints;         /* Clause ident -> proof, matched */
+   long      proof_no;      /* Number of proofs */
+   PStack_p  proof_names;   /* Names of the proofs (or NULL) */
+   PDArray_p proof_size;    /* Hints per proof */
+   PDArray_p proof_matched; /* Matched hints per proof */
+   long      matched;       /* Total of the above */
+   long      unit_queries;
+   long      unit_candidates;
+}WatchlistIndexCell, *WatchlistIndex_p;
+
+/* Watchlist progress is reported in percent */
+
+#define WATCHLIST_PROGRESS_MAX 100
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+#define WatchlistIndexCellAlloc() \
+   (WatchlistIndexCell*)SizeMalloc(sizeof(WatchlistIndexCell))
+#define WatchlistIndexCellFree(junk) \
+   SizeFree(junk, sizeof(WatchlistIndexCell))
+
+WatchlistIndex_p WatchlistIndexAlloc(Sig_p sig);
+void             WatchlistIndexFree(WatchlistIndex_p junk);
+void             WatchlistIndexReset(WatchlistIndex_p index);
+
+long             WatchlistIndexAddProof(WatchlistIndex_p index,
+                                        ClauseSet_p hints, char* name);
+void             WatchlistIndexInit(WatchlistIndex_p index,
+                                    ClauseSet_p watchlist,
+                                    bool use_lit_index);
+
+void             WatchlistIndexInsertClause(WatchlistIndex_p index,
+                                            Clause_p clause);
+void             WatchlistIndexDeleteClause(WatchlistIndex_p index,
+                                            Clause_p clause);
+
+#define WatchlistIndexCoversClause(index, clause) \
+   ((index)->lit_index && ClauseLiteralNumber(clause)==1)
+
+long             WatchlistIndexFindSubsumed(WatchlistIndex_p index,
+                                            Clause_p unit,
+                                            PStack_p res);
+int              WatchlistIndexNoteMatches(WatchlistIndex_p index,
+                                           PStack_p matched);
+void             WatchlistIndexStatisticsPrint(FILE* out,
+                                               WatchlistIndex_p index);
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -0,0 +1,3 @@
+#define PICOSAT_CC "gcc"
+#define PICOSAT_CFLAGS "-DTRACE -Wall -Wextra -Wno-unused-but-set-variable -DNDEBUG -O3"
+#define PICOSAT_VERSION "965"
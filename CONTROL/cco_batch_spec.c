@@ -576,6 +576,37 @@ long BatchStructFOFSpecInit(BatchSpec_p spec,
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: BatchStructFOFSpecPrepareFilters()
+//
+//   Precompute the SinE data of the shared axioms for all filters
+//   used by BatchProcessProblem(), so that it is done once instead of
+//   once per problem and filter (and, in a server, inherited by the
+//   forked processes). Saves it with the axiom cache, if any.
+//
+// Global Variables: BatchFilters
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void BatchStructFOFSpecPrepareFilters(StructFOFSpec_p ctrl)
+{
+   AxFilterSet_p filters = AxFilterSetCreateInternal(AxFilterDefaultSet);
+   int i;
+
+   for(i=0; BatchFilters[i]; i++)
+   {
+      StructFOFSpecAddDRelFilter(ctrl,
+                                 AxFilterSetFindFilter(filters,
+                                                       BatchFilters[i]));
+   }
+   StructFOFSpecSaveDRelBase(ctrl);
+   AxFilterSetFree(filters);
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: StructFOFSpecAddProblem()
@@ -671,6 +702,7 @@ long StructFOFSpecGetProblem(StructFOFSpec_p ctrl,
    {
    case AFGSinE:
          res = SelectAxioms(ctrl->f_distrib,
+                            ctrl->drel_base,
                             ctrl->clause_sets,
                             ctrl->formula_sets,
                             ctrl->shared_ax_sp,
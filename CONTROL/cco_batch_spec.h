@@ -88,6 +88,7 @@ void        BatchSpecPrint(FILE* out, BatchSpec_p spec);
 long        BatchStructFOFSpecInit(BatchSpec_p spec,
                                    StructFOFSpec_p ctrl,
                                    char *default_dir);
+void        BatchStructFOFSpecPrepareFilters(StructFOFSpec_p ctrl);
 
 BatchSpec_p BatchSpecParse(Scanner_p in, char* executable,
                            char* category, char* train_dir,
@@ -130,6 +130,11 @@ char* run_command(InteractiveSpec_p interactive,
    long wct_limit=30;
    int pid;
 
+   /* Done here, so that the data is shared by all later jobs */
+   if(!interactive->ctrl->drel_base)
+   {
+      BatchStructFOFSpecPrepareFilters(interactive->ctrl);
+   }
    if ((pid = fork()) == -1)
    {
       return ERR_ERROR_MESSAGE;
@@ -283,6 +288,7 @@ char* stage_command(InteractiveSpec_p interactive, DStr_p axiom_set)
          }
          else
          {
+            StructFOFSpecResetDRelBase(interactive->ctrl);
             StructFOFSpecAddProblem(interactive->ctrl, handle->cset, handle->fset, false);
             handle->staged = 1;
             interactive->ctrl->shared_ax_sp = PStackGetSP(interactive->ctrl->clause_sets);
@@ -563,6 +569,7 @@ char* unstage_command(InteractiveSpec_p interactive, DStr_p axiom_set)
    assert( PStackGetSP(interactive->ctrl->clause_sets) ==
            PStackGetSP(interactive->ctrl->formula_sets) );
    found = 0;
+   StructFOFSpecResetDRelBase(interactive->ctrl);
 
    while(!PStackEmpty(interactive->ctrl->clause_sets))
    {
@@ -837,7 +844,8 @@ InteractiveSpec_p InteractiveSpecAlloc(BatchSpec_p spec,
 //
 // Function: InteractiveSpecFree()
 //
-//   Free an interactive spec structure. The BatchSpec struct and StructFOFSpec are not freed.
+//   Free an interactive spec structure (unstaging all staged axiom
+//   sets first). The BatchSpec struct and StructFOFSpec are not freed.
 //
 // Global Variables: -
 //
@@ -850,6 +858,9 @@ void InteractiveSpecFree(InteractiveSpec_p spec)
    PStackPointer i;
    AxiomSet_p   handle;
 
+   /* Staged sets are also referenced from spec->ctrl */
+   quit_command(spec);
+
    for(i=0; i<PStackGetSP(spec->axiom_sets); i++)
    {
       handle = PStackElementP(spec->axiom_sets, i);
@@ -911,10 +922,41 @@ void AxiomSetFree(AxiomSet_p axiom_set)
 
 /*-----------------------------------------------------------------------
 //
-// Function: StartDeductionServer()
+// Function: InteractiveSpecPreload()
 //
-//   Run the deduction server on the specified socked. Read commands and
-//   react to them.
+//   Load the axiom set name from the server library and stage it, as
+//   the LOAD and STAGE commands would. Intended to be used before
+//   serving connections, so that all sessions share the parsed
+//   axioms. Returns the server message for the last step.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, reads the axiom set
+//
+/----------------------------------------------------------------------*/
+
+char* InteractiveSpecPreload(InteractiveSpec_p interactive, char* name)
+{
+   DStr_p set_name = DStrAlloc();
+   char*  ret;
+
+   DStrAppendStr(set_name, name);
+   ret = load_command(interactive, set_name);
+   if(strcmp(ret, OK_LOADED_MESSAGE) == 0)
+   {
+      ret = stage_command(interactive, set_name);
+   }
+   DStrFree(set_name);
+   return ret;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: InteractiveSpecServe()
+//
+//   Serve one session on interactive->sock_fd (or fp). Read commands
+//   and react to them until QUIT.
 //
 // Global Variables: -
 //
@@ -922,27 +964,18 @@ void AxiomSetFree(AxiomSet_p axiom_set)
 //
 /----------------------------------------------------------------------*/
 
-void StartDeductionServer(BatchSpec_p spec,
-                          StructFOFSpec_p ctrl,
-                          char* server_lib,
-                          FILE* fp,
-                          int sock_fd)
+void InteractiveSpecServe(InteractiveSpec_p interactive)
 {
    DStr_p input   = DStrAlloc();
    DStr_p dummyStr = DStrAlloc();
-   InteractiveSpec_p interactive;
+   FILE*  fp      = interactive->fp;
+   int    sock_fd = interactive->sock_fd;
    bool done = false;
    Scanner_p in;
 
    char* dummy;
    DStr_p input_command = DStrAlloc();
 
-   interactive = InteractiveSpecAlloc(spec, ctrl, fp, sock_fd);
-   if(server_lib)
-   {
-      DStrAppendStr(interactive->server_lib,server_lib);
-   }
-
    while(!done)
    {
       DStrReset(input);
@@ -1066,6 +1099,36 @@ void StartDeductionServer(BatchSpec_p spec,
    DStrFree(dummyStr);
    DStrFree(input);
    DStrFree(input_command);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: StartDeductionServer()
+//
+//   Run the deduction server on the specified socked. Read commands and
+//   react to them.
+//
+// Global Variables: -
+//
+// Side Effects    : I/O, blocks on reading fp, initiates processing.
+//
+/----------------------------------------------------------------------*/
+
+void StartDeductionServer(BatchSpec_p spec,
+                          StructFOFSpec_p ctrl,
+                          char* server_lib,
+                          FILE* fp,
+                          int sock_fd)
+{
+   InteractiveSpec_p interactive;
+
+   interactive = InteractiveSpecAlloc(spec, ctrl, fp, sock_fd);
+   if(server_lib)
+   {
+      DStrAppendStr(interactive->server_lib,server_lib);
+   }
+   InteractiveSpecServe(interactive);
    InteractiveSpecFree(interactive);
 }
 
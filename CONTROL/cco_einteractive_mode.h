@@ -82,6 +82,9 @@ AxiomSet_p AxiomSetAlloc(ClauseSet_p cset,
 
 void AxiomSetFree(AxiomSet_p axiomset);
 
+char* InteractiveSpecPreload(InteractiveSpec_p interactive, char* name);
+void  InteractiveSpecServe(InteractiveSpec_p interactive);
+
 void StartDeductionServer(BatchSpec_p spec,
                           StructFOFSpec_p ctrl,
                           char* server_lib,
@@ -180,6 +180,126 @@ static void update_clause_info(Clause_p child,
 
 
 
+/* Parallel filtering of overlap partners: The overlap term is checked
+   for unifiability with each of the partner term occurrences, one
+   LocalSubst per worker. */
+
+typedef struct par_unif_job_cell
+{
+   Term_p       olterm;
+   PStack_p     occs;
+   bool         *hits;
+   LocalSubst_p substs[WORKPOOL_MAX_WORKERS];
+}ParUnifJobCell, *ParUnifJob_p;
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: par_unif_slice()
+//
+//   Work function for the worker pool: Check which of the term
+//   occurrences [first,last) of the job may unify with the overlap
+//   term and record the result in job->hits.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes job->hits
+//
+/----------------------------------------------------------------------*/
+
+static void par_unif_slice(void* data, int worker, long first, long last)
+{
+   ParUnifJob_p job   = data;
+   LocalSubst_p subst = job->substs[worker];
+   SubtermOcc_p occ;
+   long         i;
+
+   for(i=first; i<last; i++)
+   {
+      occ = PStackElementP(job->occs, i);
+      job->hits[i] = LocalSubstMayUnify(subst, job->olterm, occ->term);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: par_find_unifiable_occs()
+//
+//   Push the term occurrences from the termtrees (which are consumed)
+//   onto res, in the order in which the sequential code visits
+//   them. If there are enough of them, the workers of pool first
+//   find out which cannot unify with olterm, and these are left
+//   out. As they do not yield any paramodulants, the result of
+//   processing res in order is the same as for the full set.
+//
+// Global Variables: -
+//
+// Side Effects    : Uses pool
+//
+/----------------------------------------------------------------------*/
+
+static void par_find_unifiable_occs(WorkPool_p pool,
+                                    TB_p bank,
+                                    Term_p olterm,
+                                    PStack_p termtrees,
+                                    PStack_p res)
+{
+   long           i, items, max_var;
+   PStack_p       occs = PStackAlloc(), iterstack;
+   PObjTree_p     cell;
+   ParUnifJobCell job;
+   int            w;
+
+   while(!PStackEmpty(termtrees))
+   {
+      iterstack = PTreeTraverseInit(PStackPopP(termtrees));
+      while((cell = PTreeTraverseNext(iterstack)))
+      {
+         PStackPushP(occs, cell->key);
+      }
+      PTreeTraverseExit(iterstack);
+   }
+   items = PStackGetSP(occs);
+
+   if(items < PAR_PM_MIN_TERMS)
+   {
+      PStackPushStack(res, occs);
+      PStackFree(occs);
+      return;
+   }
+
+   max_var = MAX(bank->vars->max_var, -TermFindMaxVarCode(olterm));
+   job.olterm = olterm;
+   job.occs   = occs;
+   job.hits   = SizeMalloc(sizeof(bool)*items);
+   for(w=0; w<WorkPoolWorkers(pool); w++)
+   {
+      job.substs[w] = LocalSubstAlloc();
+      /* Partners can be larger, LocalSubstMayUnify() gives up
+         (conservatively) if they are much larger. */
+      LocalSubstReserve(job.substs[w], max_var,
+                        2*TermWeight(olterm, 1, 1));
+   }
+
+   WorkPoolRun(pool, par_unif_slice, &job, items);
+
+   for(i=0; i<items; i++)
+   {
+      if(job.hits[i])
+      {
+         PStackPushP(res, PStackElementP(occs, i));
+      }
+   }
+   for(w=0; w<WorkPoolWorkers(pool); w++)
+   {
+      LocalSubstFree(job.substs[w]);
+   }
+   SizeFree(job.hits, sizeof(bool)*items);
+   PStackFree(occs);
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: compute_into_pm_pos_clause()
@@ -376,7 +496,9 @@ static long compute_pos_into_pm_termtree(ParamodInfo_p pminfo,
 // Function: compute_pos_into_pm()
 //
 //   Compute all paramodulations from clause with clause|pos = term,
-//   term is the LHS for the overlap, into clauses in into_index.
+//   term is the LHS for the overlap, into clauses in into_index. If
+//   pminfo->workers is set, candidates are filtered in parallel
+//   (first-order only).
 //
 // Global Variables: -
 //
@@ -390,12 +512,24 @@ static long compute_pos_into_pm(ParamodInfo_p pminfo,
                                 OverlapIndex_p into_index,
                                 ClauseSet_p store)
 {
-   long          res = 0;
+   long          res = 0, i;
    SubtermTree_p termtree;
-   PStack_p      candidates = PStackAlloc();
+   PStack_p      candidates = PStackAlloc(), occs;
 
    FPIndexFindUnifiable(into_index, olterm, candidates);
 
+   if(pminfo->workers && problemType == PROBLEM_FO)
+   {
+      occs = PStackAlloc();
+      par_find_unifiable_occs(pminfo->workers, pminfo->bank,
+                              olterm, candidates, occs);
+      for(i=0; i<PStackGetSP(occs); i++)
+      {
+         res += compute_pos_into_pm_term(pminfo, type, olterm,
+                                         PStackElementP(occs, i), store);
+      }
+      PStackFree(occs);
+   }
    while(!PStackEmpty(candidates))
    {
       termtree = PStackPopP(candidates);
@@ -608,7 +742,8 @@ static long compute_pos_from_pm_termtree(ParamodInfo_p pminfo,
 //
 //   Compute all paramodulations into clause with pminfo->into|pos =
 //   term, term is the LHS for the overlap, from clauses in
-//   from_index.
+//   from_index. If pminfo->workers is set, candidates are filtered
+//   in parallel (first-order only).
 //
 // Global Variables: -
 //
@@ -622,12 +757,24 @@ static long compute_pos_from_pm(ParamodInfo_p pminfo,
                                 OverlapIndex_p from_index,
                                 ClauseSet_p store)
 {
-   long          res = 0;
+   long          res = 0, i;
    SubtermTree_p termtree;
-   PStack_p      candidates = PStackAlloc();
+   PStack_p      candidates = PStackAlloc(), occs;
 
    FPIndexFindUnifiable(from_index, olterm, candidates);
 
+   if(pminfo->workers && problemType == PROBLEM_FO)
+   {
+      occs = PStackAlloc();
+      par_find_unifiable_occs(pminfo->workers, pminfo->bank,
+                              olterm, candidates, occs);
+      for(i=0; i<PStackGetSP(occs); i++)
+      {
+         res += compute_pos_from_pm_term(pminfo, type, olterm,
+                                         PStackElementP(occs, i), store);
+      }
+      PStackFree(occs);
+   }
    while(!PStackEmpty(candidates))
    {
       termtree = PStackPopP(candidates);
@@ -971,7 +1118,9 @@ long ComputeFromSimParamodulants(ParamodInfo_p pminfo,
 //
 //   Compute all paramodulants (of the right pm_type) between clause
 //   and clauses in the indices. Put them into store. Return number of
-//   clauses generated.
+//   clauses generated. If workers is given, the unification
+//   partners are filtered in parallel. The paramodulants themselves
+//   are always constructed sequentially (and in the same order).
 //
 // Global Variables: -
 //
@@ -987,7 +1136,8 @@ long ComputeAllParamodulantsIndexed(TB_p bank, OCB_p ocb,
                                     OverlapIndex_p negp_index,
                                     OverlapIndex_p from_index,
                                     ClauseSet_p store,
-                                    ParamodulationType pm_type)
+                                    ParamodulationType pm_type,
+                                    WorkPool_p workers)
 {
    long res = 0;
    ParamodInfoCell pminfo;
@@ -996,6 +1146,7 @@ long ComputeAllParamodulantsIndexed(TB_p bank, OCB_p ocb,
    pminfo.freshvars = freshvars;
    pminfo.ocb       = ocb;
    pminfo.new_orig  = parent_alias;
+   pminfo.workers   = workers;
 
    res += ComputeIntoParamodulants(&pminfo,
                                    pm_type,
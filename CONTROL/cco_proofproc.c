@@ -19,6 +19,7 @@
 -----------------------------------------------------------------------*/
 
 #include "cco_proofproc.h"
+#include <clb_profile.h>
 #include <picosat.h>
 #include <cco_ho_inferences.h>
 #include <cte_ho_csu.h>
@@ -108,7 +109,8 @@ static void check_ac_status(ProofState_p state, ProofControl_p
 // Function: remove_subsumed()
 //
 //   Remove all clauses subsumed by subsumer from set, kill their
-//   children. Return number of removed clauses.
+//   children. Return number of removed clauses. If pool is not NULL,
+//   it is used to find the subsumed clauses.
 //
 // Global Variables: -
 //
@@ -120,13 +122,14 @@ static long remove_subsumed(GlobalIndices_p indices,
                             FVPackedClause_p subsumer,
                             ClauseSet_p set,
                             ClauseSet_p archive,
-                            bool lambda_demod)
+                            bool lambda_demod,
+                            WorkPool_p pool)
 {
    Clause_p handle;
    long     res;
    PStack_p stack = PStackAlloc();
 
-   res = ClauseSetFindFVSubsumedClauses(set, subsumer, stack);
+   res = ClauseSetFindFVSubsumedClauses(set, subsumer, pool, stack);
 
    while(!PStackEmpty(stack))
    {
@@ -185,7 +188,8 @@ eliminate_backward_rewritten_clauses(ProofState_p
                                                  state->tmp_store,
                                                  state->archive,
                                                  clause, *date, &(state->gindices),
-                                                 control->heuristic_parms.lambda_demod);
+                                                 control->heuristic_parms.lambda_demod,
+                                                 control->bw_workers);
 
       }
       else
@@ -241,7 +245,7 @@ eliminate_backward_rewritten_clauses(ProofState_p
 // Function: eliminate_backward_subsumed_clauses()
 //
 //   Eliminate subsumed processed clauses, return number of clauses
-//   deleted.
+//   deleted. The workers of pool (if any) help finding them.
 //
 // Global Variables: -
 //
@@ -251,7 +255,8 @@ eliminate_backward_rewritten_clauses(ProofState_p
 
 static long eliminate_backward_subsumed_clauses(ProofState_p state,
                                                 FVPackedClause_p pclause,
-                                                bool lambda_demod)
+                                                bool lambda_demod,
+                                                WorkPool_p pool)
 {
    long res = 0;
 
@@ -267,30 +272,30 @@ static long eliminate_backward_subsumed_clauses(ProofState_p state,
          {
             res += remove_subsumed(&(state->gindices), pclause,
                                    state->processed_pos_rules,
-                                   state->archive, lambda_demod);
+                                   state->archive, lambda_demod, pool);
             res += remove_subsumed(&(state->gindices), pclause,
                                    state->processed_pos_eqns,
-                                   state->archive, lambda_demod);
+                                   state->archive, lambda_demod, pool);
          }
          res += remove_subsumed(&(state->gindices), pclause,
                                 state->processed_non_units,
-                                state->archive, lambda_demod);
+                                state->archive, lambda_demod, pool);
       }
       else
       {
          res += remove_subsumed(&(state->gindices), pclause,
                                 state->processed_neg_units,
-                                state->archive, lambda_demod);
+                                state->archive, lambda_demod, pool);
          res += remove_subsumed(&(state->gindices), pclause,
                                 state->processed_non_units,
-                                state->archive, lambda_demod);
+                                state->archive, lambda_demod, pool);
       }
    }
    else
    {
       res += remove_subsumed(&(state->gindices), pclause,
                              state->processed_non_units,
-                             state->archive, lambda_demod);
+                             state->archive, lambda_demod, pool);
    }
    state->backward_subsumed_count+=res;
    return res;
@@ -382,7 +387,10 @@ static long eliminate_context_sr_clauses(ProofState_p state,
 // Function: check_watchlist()
 //
 //   Check if a clause subsumes one or more watchlist clauses, if yes,
-//   set appropriate property in clause and remove subsumed clauses.
+//   set appropriate property and progress in clause and remove
+//   subsumed clauses (unless the watchlist is static). Candidates
+//   for unit clauses are taken from the literal index in wlindex,
+//   all other clauses use the feature vector index.
 //
 // Global Variables: -
 //
@@ -392,46 +400,65 @@ static long eliminate_context_sr_clauses(ProofState_p state,
 
 
 void check_watchlist(GlobalIndices_p indices, ClauseSet_p watchlist,
-                     Clause_p clause, ClauseSet_p archive,
-                     bool static_watchlist, bool lambda_demod)
+                     WatchlistIndex_p wlindex, Clause_p clause,
+                     ClauseSet_p archive, bool static_watchlist,
+                     bool lambda_demod)
 {
    FVPackedClause_p pclause;
-   long removed;
+   PStack_p         subsumed;
+   Clause_p         handle;
+   PStackPointer    i;
+   int              progress;
 
    if(watchlist)
    {
-      pclause = FVIndexPackClause(clause, watchlist->fvindex);
       // printf(COMCHAR" check_watchlist(%p)...\n", indices);
       ClauseSubsumeOrderSortLits(clause);
       // assert(ClauseIsSubsumeOrdered(clause));
 
       clause->weight = ClauseStandardWeight(clause);
 
-      if(static_watchlist)
+      subsumed = PStackAlloc();
+      if(WatchlistIndexCoversClause(wlindex, clause))
       {
-         Clause_p subsumed;
-
-         subsumed = ClauseSetFindFirstSubsumedClause(watchlist, clause);
-         if(subsumed)
-         {
-            ClauseSetProp(clause, CPSubsumesWatch);
-         }
+         WatchlistIndexFindSubsumed(wlindex, clause, subsumed);
       }
       else
       {
-         if((removed = remove_subsumed(indices, pclause, watchlist, archive, lambda_demod)))
+         pclause = FVIndexPackClause(clause, watchlist->fvindex);
+         ClauseSetFindFVSubsumedClauses(watchlist, pclause, NULL, subsumed);
+         FVUnpackClause(pclause);
+      }
+      if(!PStackEmpty(subsumed))
+      {
+         ClauseSetProp(clause, CPSubsumesWatch);
+         progress = WatchlistIndexNoteMatches(wlindex, subsumed);
+         clause->watch_progress = MAX(clause->watch_progress, progress);
+      }
+      if(!static_watchlist && !PStackEmpty(subsumed))
+      {
+         for(i=0; i<PStackGetSP(subsumed); i++)
          {
-            ClauseSetProp(clause, CPSubsumesWatch);
-            if(OutputLevel == 1)
-            {
-               fprintf(GlobalOut,COMCHAR" Watchlist reduced by %ld clause%s\n",
-                       removed,removed==1?"":"s");
-            }
-            // ClausePrint(GlobalOut, clause, true); printf("\n");
-            DocClauseQuote(GlobalOut, OutputLevel, 6, clause,
-                           "extract_subsumed_watched", NULL);   }
+            handle = PStackElementP(subsumed, i);
+            DocClauseQuote(GlobalOut, OutputLevel, 6, handle,
+                           "extract_wl_subsumed", clause);
+            GlobalIndicesDeleteClause(indices, handle, lambda_demod);
+            WatchlistIndexDeleteClause(wlindex, handle);
+            ClauseSetExtractEntry(handle);
+            ClauseSetProp(handle, CPIsDead);
+            ClauseSetInsert(archive, handle);
+         }
+         if(OutputLevel == 1)
+         {
+            fprintf(GlobalOut,COMCHAR" Watchlist reduced by %ld clause%s\n",
+                    (long)PStackGetSP(subsumed),
+                    PStackGetSP(subsumed)==1?"":"s");
+         }
+         // ClausePrint(GlobalOut, clause, true); printf("\n");
+         DocClauseQuote(GlobalOut, OutputLevel, 6, clause,
+                        "extract_subsumed_watched", NULL);
       }
-      FVUnpackClause(pclause);
+      PStackFree(subsumed);
       // printf(COMCHAR" ...check_watchlist()\n");
    }
 }
@@ -473,7 +500,8 @@ void simplify_watchlist(ProofState_p state, ProofControl_p control,
                                      tmp_set, state->archive,
                                      clause, clause->date,
                                      &(state->wlindices),
-                                     control->heuristic_parms.lambda_demod);
+                                     control->heuristic_parms.lambda_demod,
+                                     control->bw_workers);
       // printf(COMCHAR" Simpclause done\n");
    }
    else
@@ -488,6 +516,7 @@ void simplify_watchlist(ProofState_p state, ProofControl_p control,
    {
       // printf(COMCHAR" WL simplify: "); ClausePrint(stdout, handle, true);
       // printf("\n");
+      WatchlistIndexDeleteClause(state->wlindex, handle);
       state->rw_count +=
          ClauseComputeLINormalform(control->ocb,
                                    state->terms,
@@ -510,6 +539,7 @@ void simplify_watchlist(ProofState_p state, ProofControl_p control,
       ClauseSetIndexedInsertClause(state->watchlist, handle);
       // printf(COMCHAR" WL Inserting: "); ClausePrint(stdout, handle, true); printf("\n");
       GlobalIndicesInsertClause(&(state->wlindices), handle, control->heuristic_parms.lambda_demod);
+      WatchlistIndexInsertClause(state->wlindex, handle);
    }
    ClauseSetFree(tmp_set);
    // printf(COMCHAR" ...simplify_watchlist()\n");
@@ -568,7 +598,8 @@ static void generate_new_clauses(ProofState_p state, ProofControl_p
                                            state->gindices.pm_negp_index,
                                            state->gindices.pm_from_index,
                                            state->tmp_store,
-                                           control->heuristic_parms.pm_type);
+                                           control->heuristic_parms.pm_type,
+                                           control->pm_workers);
       }
       else
       {
@@ -620,28 +651,115 @@ static void generate_new_clauses(ProofState_p state, ProofControl_p
 //
 /----------------------------------------------------------------------*/
 
-void eval_clause_set(ProofState_p state, ProofControl_p control)
+static void eval_clause_set(ProofState_p state, ProofControl_p control)
 {
-   Clause_p handle;
+   Clause_p handle, *batch;
+   long     count = 0, size;
    assert(state);
    assert(control);
 
+   size = state->eval_store->members;
+   if(!size)
+   {
+      return;
+   }
+   batch = SizeMalloc(size*sizeof(Clause_p));
    for(handle = state->eval_store->anchor->succ;
        handle != state->eval_store->anchor;
        handle = handle->succ)
    {
-      HCBClauseEvaluate(control->hcb, handle);
+      batch[count++] = handle;
    }
+   assert(count == size);
+   HCBClauseBatchEvaluate(control->hcb, batch, count);
+   SizeFree(batch, size*sizeof(Clause_p));
 }
 
 
 /*-----------------------------------------------------------------------
 //
-// Function: insert_new_clauses()
+// Function: hold_new_clauses()
+//
+//   Move the new clauses from state->tmp_store into
+//   state->lazy_store without simplifying, literal-selecting or
+//   evaluating them. There they are only ordered by two cheap keys,
+//   symbol count and age (see promote_held_clauses()). Empty clauses
+//   and interreduction victims stay in tmp_store for immediate
+//   processing.
+//
+// Global Variables: -
+//
+// Side Effects    : Moves clauses, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void hold_new_clauses(ProofState_p state)
+{
+   Clause_p handle, next;
+   Eval_p   eval;
+
+   for(handle = state->tmp_store->anchor->succ;
+       handle != state->tmp_store->anchor;
+       handle = next)
+   {
+      next = handle->succ;
+      if(ClauseIsEmpty(handle) || ClauseQueryProp(handle, CPIsIRVictim))
+      {
+         continue;
+      }
+      ClauseSetExtractEntry(handle);
+      handle->create_date = state->proc_non_trivial_count;
+      eval = EvalsAlloc(2);
+      eval->evals[0].priority  = PrioNormal;
+      eval->evals[0].heuristic = ClauseStandardWeight(handle);
+      eval->evals[1].priority  = PrioNormal;
+      eval->evals[1].heuristic = 0;
+      ClauseAddEvalCell(handle, eval);
+      ClauseSetInsert(state->lazy_store, handle);
+      state->lazy_held_count++;
+      state->lazy_held_lits += ClauseLiteralNumber(handle);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: find_next_given()
+//
+//   Return the clause the next call to hcb_select() will pick (or
+//   NULL), without changing the selection state. Orphans are
+//   discarded on the way as in HCBStandardClauseSelect().
+//
+// Global Variables: -
+//
+// Side Effects    : May free orphaned clauses.
+//
+/----------------------------------------------------------------------*/
+
+static Clause_p find_next_given(ProofState_p state, ProofControl_p control)
+{
+   Clause_p handle;
+
+   handle = ClauseSetFindBest(state->unprocessed, control->hcb->current_eval);
+   while(handle && ClauseIsOrphaned(handle))
+   {
+      ClauseSetExtractEntry(handle);
+      ClauseFree(handle);
+      handle = ClauseSetFindBest(state->unprocessed, control->hcb->current_eval);
+   }
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: process_new_clauses()
 //
 //   Rewrite clauses in state->tmp_store, remove superfluous literals,
-//   insert them into state->unprocessed. If an empty clause is
-//   detected, return it, otherwise return NULL.
+//   select literals, evaluate them and insert them into
+//   state->unprocessed. If an empty clause is detected, return it,
+//   otherwise return NULL. If keep_date is true, the clauses keep
+//   their creation date (clauses promoted from state->lazy_store).
 //
 // Global Variables: -
 //
@@ -649,13 +767,13 @@ void eval_clause_set(ProofState_p state, ProofControl_p control)
 //
 /----------------------------------------------------------------------*/
 
-static Clause_p insert_new_clauses(ProofState_p state, ProofControl_p control)
+static Clause_p process_new_clauses(ProofState_p state,
+                                    ProofControl_p control,
+                                    bool keep_date)
 {
    Clause_p handle;
    long     clause_count;
 
-   state->generated_count+=state->tmp_store->members;
-   state->generated_lit_count+=state->tmp_store->literals;
    while((handle = ClauseSetExtractFirst(state->tmp_store)))
    {
       // printf("Inserting: ");
@@ -690,7 +808,7 @@ static Clause_p insert_new_clauses(ProofState_p state, ProofControl_p control)
 
 
       check_watchlist(&(state->wlindices), state->watchlist,
-                      handle, state->archive,
+                      state->wlindex, handle, state->archive,
                       control->heuristic_parms.watchlist_is_static,
                       control->heuristic_parms.lambda_demod);
       if(ClauseIsEmpty(handle))
@@ -753,7 +871,10 @@ static Clause_p insert_new_clauses(ProofState_p state, ProofControl_p control)
       {
          EqnListDelProp(handle->literals, EPIsSelected);
       }
-      handle->create_date = state->proc_non_trivial_count;
+      if(!keep_date)
+      {
+         handle->create_date = state->proc_non_trivial_count;
+      }
       if(ProofObjectRecordsGCSelection)
       {
          ClausePushDerivation(handle, DCCnfEvalGC, NULL, NULL);
@@ -762,19 +883,122 @@ static Clause_p insert_new_clauses(ProofState_p state, ProofControl_p control)
 
       ClauseSetInsert(state->eval_store, handle);
    }
+   PROF_SCOPE_ENTER(ProfEvaluate);
    eval_clause_set(state, control);
+   PROF_SCOPE_EXIT(ProfEvaluate);
 
    while((handle = ClauseSetExtractFirst(state->eval_store)))
    {
       ClauseDelProp(handle, CPIsOriented);
       DocClauseQuoteDefault(6, handle, "eval");
 
+      if(control->heuristic_parms.pack_unprocessed)
+      {
+         ClausePack(handle);
+      }
       ClauseSetInsert(state->unprocessed, handle);
    }
    return NULL;
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: promote_held_clauses()
+//
+//   Take clauses out of state->lazy_store and process and evaluate
+//   them fully. A held clause is promoted if its symbol count is not
+//   larger than that of the clause the heuristic would pick next
+//   (i.e. it might well be picked first once it is evaluated).
+//   Independent of this, at least lazy_eval_batch clauses are
+//   promoted per call, every LAZY_EVAL_FIFO_RATIO'th of them the
+//   oldest one, so that all held clauses are eventually
+//   considered. Orphans are discarded on the way. Return the empty
+//   clause if one is found, NULL otherwise.
+//
+// Global Variables: -
+//
+// Side Effects    : Moves and simplifies clauses, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static Clause_p promote_held_clauses(ProofState_p state,
+                                     ProofControl_p control)
+{
+   Clause_p handle;
+   long     count = 0;
+   int      idx;
+   double   limit = -1.0;
+
+   handle = find_next_given(state, control);
+   if(handle)
+   {
+      limit = ClauseStandardWeight(handle);
+   }
+   while(!ClauseSetEmpty(state->lazy_store))
+   {
+      idx = 0;
+      if(count < control->heuristic_parms.lazy_eval_batch)
+      {
+         idx = ((state->lazy_promoted_count+state->lazy_orphan_count)%
+                LAZY_EVAL_FIFO_RATIO) == LAZY_EVAL_FIFO_RATIO-1;
+      }
+      handle = ClauseSetFindBest(state->lazy_store, idx);
+      assert(handle);
+      if(count >= control->heuristic_parms.lazy_eval_batch &&
+         handle->evaluations->evals[0].heuristic > limit)
+      {
+         break;
+      }
+      ClauseSetExtractEntry(handle);
+      ClauseRemoveEvaluations(handle);
+      if(ClauseIsOrphaned(handle))
+      {
+         state->lazy_orphan_count++;
+         state->other_redundant_count++;
+         ClauseFree(handle);
+      }
+      else
+      {
+         state->lazy_promoted_count++;
+         state->lazy_promoted_lits += ClauseLiteralNumber(handle);
+         ClauseSetInsert(state->tmp_store, handle);
+         count++;
+      }
+   }
+   return process_new_clauses(state, control, true);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: insert_new_clauses()
+//
+//   Rewrite clauses in state->tmp_store, remove superfluous literals,
+//   insert them into state->unprocessed. If an empty clause is
+//   detected, return it, otherwise return NULL. In lazy mode
+//   (lazy_eval_batch > 0), the new clauses are parked in
+//   state->lazy_store instead (see hold_new_clauses()), and are only
+//   processed when promote_held_clauses() picks them.
+//
+// Global Variables: -
+//
+// Side Effects    : As described.
+//
+/----------------------------------------------------------------------*/
+
+static Clause_p insert_new_clauses(ProofState_p state, ProofControl_p control)
+{
+   state->generated_count+=state->tmp_store->members;
+   state->generated_lit_count+=state->tmp_store->literals;
+   if(control->heuristic_parms.lazy_eval_batch)
+   {
+      hold_new_clauses(state);
+   }
+   return process_new_clauses(state, control, false);
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: replacing_inferences()
@@ -829,7 +1053,9 @@ Clause_p replacing_inferences(ProofState_p state, ProofControl_p
        * which may have put some clauses into tmp_store. */
       FVUnpackClause(pclause);
 
+      PROF_SCOPE_ENTER(ProfInsert);
       res = insert_new_clauses(state, control);
+      PROF_SCOPE_EXIT(ProfInsert);
    }
    return res;
 }
@@ -877,6 +1103,9 @@ static Clause_p cleanup_unprocessed_clauses(ProofState_p state,
                  COMCHAR" Deleted %ld orphaned clauses (remaining: %ld)\n",
                  tmp, state->unprocessed->members);
       }
+      tmp2 = ClauseSetDeleteOrphans(state->lazy_store);
+      state->lazy_orphan_count += tmp2;
+      tmp += tmp2;
       state->other_redundant_count += tmp;
       state->filter_orphans_base = back_simplified;
    }
@@ -886,6 +1115,7 @@ static Clause_p cleanup_unprocessed_clauses(ProofState_p state,
       > control->heuristic_parms.forward_contract_limit)
    {
       tmp = state->unprocessed->members;
+      ClauseSetUnpackClauses(state->unprocessed);
       unsatisfiable =
          ForwardContractSet(state, control,
                             state->unprocessed, false, FullRewrite,
@@ -910,6 +1140,10 @@ static Clause_p cleanup_unprocessed_clauses(ProofState_p state,
       state->forward_contract_base = state->processed_count;
       OUTPRINT(1, COMCHAR" Reweighting unprocessed clauses...\n");
       ClauseSetReweight(control->hcb,  state->unprocessed);
+      if(control->heuristic_parms.pack_unprocessed)
+      {
+         ClauseSetPackClauses(state->unprocessed);
+      }
    }
 
    current_storage  = ProofStateStorage(state);
@@ -938,12 +1172,69 @@ static Clause_p cleanup_unprocessed_clauses(ProofState_p state,
    return unsatisfiable;
 }
 
+/*-----------------------------------------------------------------------
+//
+// Function: collect_term_garbage()
+//
+//   If enough new term cells have been created, collect garbage in
+//   the main term bank. This is called between two given clauses,
+//   when all live terms are reachable from the registered sets. For
+//   first-order problems, mostly only the young cells are collected
+//   (see TBGCCollectMinor()). In higher-order mode, cached
+//   beta-normal forms can link old cells to young ones unnoticed, so
+//   only full collections are used.
+//
+// Global Variables: problemType
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void collect_term_garbage(ProofState_p state, ProofControl_p control)
+{
+   TB_p bank  = state->terms;
+   long limit = control->heuristic_parms.term_gc_limit;
+   long old_cells;
+
+   if(!limit)
+   {
+      return;
+   }
+   if(problemType == PROBLEM_HO)
+   {
+      if(TBNonVarTermNodes(bank)-bank->full_survivors > limit)
+      {
+         TBGCCollect(bank);
+      }
+      return;
+   }
+   if(!bank->young)
+   {
+      TBGCEnableGenerations(bank);
+   }
+   if(TBGCYoungCells(bank) > limit)
+   {
+      old_cells = TBNonVarTermNodes(bank)-TBGCYoungCells(bank);
+      if(old_cells > TERMBANK_FULL_GC_FACTOR*bank->full_survivors)
+      {
+         TBGCCollect(bank);
+      }
+      else
+      {
+         TBGCCollectMinor(bank);
+      }
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: SATCheck()
 //
 //   Create ground (or pseudo-ground) instances of the clause set,
 //   hand them to a SAT solver, and check then for unsatisfiability.
+//   In incremental mode, the solver and the encoding survive between
+//   calls, and only the changes to the proof state are passed on.
 //
 // Global Variables:
 //
@@ -961,6 +1252,7 @@ Clause_p SATCheck(ProofState_p state, ProofControl_p control)
       enc_time     = 0.0,
       solver_time  = 0.0;
 
+   ClauseSetUnpackClauses(state->unprocessed);
    if(control->heuristic_parms.sat_check_normalize)
    {
       //printf(COMCHAR" Cardinality of unprocessed: %ld\n",
@@ -972,7 +1264,49 @@ Clause_p SATCheck(ProofState_p state, ProofControl_p control)
       // printf(COMCHAR" ForwardContraction done\n");
       preproc_time = (GetTotalCPUTime()-base_time);
    }
-   if(!empty)
+   if(!empty && control->heuristic_parms.sat_check_incremental)
+   {
+      if(!control->sat_state || SatIncStateNeedsRebuild(control->sat_state))
+      {
+         if(control->sat_state)
+         {
+            SatIncStateFree(control->sat_state);
+         }
+         ProofControlResetSATSolver(control);
+         control->sat_state = SatIncStateAlloc(state->terms);
+      }
+      base_time = GetTotalCPUTime();
+      SatIncStateImportProofState(control->sat_state, control->solver, state,
+                                  control->heuristic_parms.sat_check_grounding,
+                                  control->heuristic_parms.sat_check_normconst);
+      enc_time = (GetTotalCPUTime()-base_time);
+
+      base_time = GetTotalCPUTime();
+      res = SatIncStateCheckUnsat(control->sat_state, &empty, control->solver,
+                                  control->heuristic_parms.sat_check_decision_limit);
+      solver_time = (GetTotalCPUTime()-base_time);
+      state->satcheck_count++;
+
+      state->satcheck_preproc_time  += preproc_time;
+      state->satcheck_encoding_time += enc_time;
+      state->satcheck_solver_time   += solver_time;
+      if(res == PRUnsatisfiable)
+      {
+         state->satcheck_success++;
+         state->satcheck_full_size = control->sat_state->active;
+         state->satcheck_actual_size = control->sat_state->active;
+         state->satcheck_core_size = control->sat_state->core_size;
+
+         state->satcheck_preproc_stime  += preproc_time;
+         state->satcheck_encoding_stime += enc_time;
+         state->satcheck_solver_stime   += solver_time;
+      }
+      else if(res == PRSatisfiable)
+      {
+         state->satcheck_satisfiable++;
+      }
+   }
+   else if(!empty)
    {
       SatClauseSet_p set = SatClauseSetAlloc();
 
@@ -1015,7 +1349,10 @@ Clause_p SATCheck(ProofState_p state, ProofControl_p control)
       }
       SatClauseSetFree(set);
    }
-
+   if(!empty && control->heuristic_parms.pack_unprocessed)
+   {
+      ClauseSetPackClauses(state->unprocessed);
+   }
    return empty;
 }
 
@@ -1127,6 +1464,8 @@ void ProofControlInit(ProofState_p state, ProofControl_p control,
 
    control->ocb = TOSelectOrdering(state, params,
                                    &(control->problem_specs));
+   OCBEnableResultCache(control->ocb, state->terms,
+                        params->ord_res_cache_size);
 
    in = CreateScanner(StreamTypeInternalString,
                       DefaultWeightFunctions,
@@ -1423,6 +1762,17 @@ void fvi_param_init(ProofState_p state, ProofControl_p control)
             FVIAnchorAlloc(cspec, PermVectorCopy(perm));
          //ClauseSetNewTerms(state->watchlist, state->terms);
       }
+      if(control->fvi_parms.flat_index)
+      {
+         FVIAnchorUseFlatIndex(state->processed_non_units->fvindex);
+         FVIAnchorUseFlatIndex(state->processed_pos_rules->fvindex);
+         FVIAnchorUseFlatIndex(state->processed_pos_eqns->fvindex);
+         FVIAnchorUseFlatIndex(state->processed_neg_units->fvindex);
+         if(state->watchlist)
+         {
+            FVIAnchorUseFlatIndex(state->watchlist->fvindex);
+         }
+      }
    }
    state->def_store_cspec = FVCollectAlloc(FVICollectFeatures,
                                            true,
@@ -1475,24 +1825,33 @@ void ProofStateInit(ProofState_p state, ProofControl_p control)
    {
       fvi_param_init(state, control);
    }
+   if(control->heuristic_parms.bw_simplify_workers > 1 && !control->bw_workers)
+   {
+      control->bw_workers =
+         WorkPoolAlloc(control->heuristic_parms.bw_simplify_workers);
+   }
+   if(control->heuristic_parms.paramod_workers > 1 && !control->pm_workers)
+   {
+      control->pm_workers =
+         WorkPoolAlloc(control->heuristic_parms.paramod_workers);
+   }
    ProofStateInitWatchlist(state, control->ocb);
 
    tmphcb = GetHeuristic("Uniq", state, control, &(control->heuristic_parms));
    assert(tmphcb);
    ClauseSetReweight(tmphcb, state->axioms);
 
-   traverse =
-      EvalTreeTraverseInit(PDArrayElementP(state->axioms->eval_indices,0),0);
+   traverse = ClauseSetEvalTraverseInit(state->axioms, 0);
 
    //OUTPRINT(1, COMCHAR" Initializing proof state (2)\n");
-   while((cell = EvalTreeTraverseNext(traverse, 0)))
+   while((cell = ClauseSetEvalTraverseNext(state->axioms, traverse, 0)))
    {
       handle = cell->object;
       new = ClauseCopy(handle, state->terms);
 
       ClauseSetProp(new, CPInitial);
       check_watchlist(&(state->wlindices), state->watchlist,
-                      new, state->archive,
+                      state->wlindex, new, state->archive,
                       control->heuristic_parms.watchlist_is_static,
                       control->heuristic_parms.lambda_demod);
       //OUTPRINT(1, COMCHAR" Initializing proof state (2a)\n");
@@ -1513,7 +1872,7 @@ void ProofStateInit(ProofState_p state, ProofControl_p control)
    }
    //OUTPRINT(1, COMCHAR" Initializing proof state (3)\n");
    ClauseSetMarkSOS(state->unprocessed, control->heuristic_parms.use_tptp_sos);
-   EvalTreeTraverseExit(traverse);
+   ClauseSetEvalTraverseExit(traverse);
 
    if(control->heuristic_parms.ac_handling!=NoACHandling)
    {
@@ -1564,8 +1923,25 @@ Clause_p ProcessClause(ProofState_p state, ProofControl_p control,
    FVPackedClause_p pclause;
    SysDate          clausedate;
 
+   if(control->heuristic_parms.lazy_eval_batch)
+   {
+      do
+      {
+         PROF_SCOPE_ENTER(ProfInsert);
+         empty = promote_held_clauses(state, control);
+         PROF_SCOPE_EXIT(ProfInsert);
+         if(empty)
+         {
+            PStackPushP(state->extract_roots, empty);
+            return empty;
+         }
+      }while(ClauseSetEmpty(state->unprocessed) &&
+             !ClauseSetEmpty(state->lazy_store));
+   }
+   PROF_SCOPE_ENTER(ProfSelect);
    clause = control->hcb->hcb_select(control->hcb,
                                      state->unprocessed);
+   PROF_SCOPE_EXIT(ProfSelect);
    if(!clause)
    {
       return NULL;
@@ -1579,6 +1955,7 @@ Clause_p ProcessClause(ProofState_p state, ProofControl_p control,
    assert(clause);
 
    ClauseSetExtractEntry(clause);
+   ClauseUnpack(clause);
    ClauseRemoveEvaluations(clause);
    // Orphans have been excluded during selection now
 
@@ -1592,11 +1969,14 @@ Clause_p ProcessClause(ProofState_p state, ProofControl_p control,
       arch_copy = ClauseArchiveCopy(state->archive, clause);
    }
 
-   if(!(pclause = ForwardContractClause(state, control,
-                                        clause, true,
-                                        control->heuristic_parms.forward_context_sr,
-                                        control->heuristic_parms.condensing,
-                                        FullRewrite)))
+   PROF_SCOPE_ENTER(ProfForwardContract);
+   pclause = ForwardContractClause(state, control,
+                                   clause, true,
+                                   control->heuristic_parms.forward_context_sr,
+                                   control->heuristic_parms.condensing,
+                                   FullRewrite);
+   PROF_SCOPE_EXIT(ProfForwardContract);
+   if(!pclause)
    {
       if(arch_copy)
       {
@@ -1635,21 +2015,24 @@ Clause_p ProcessClause(ProofState_p state, ProofControl_p control,
    }
 
    check_watchlist(&(state->wlindices), state->watchlist,
-                      pclause->clause, state->archive,
+                      state->wlindex, pclause->clause, state->archive,
                       control->heuristic_parms.watchlist_is_static,
                       control->heuristic_parms.lambda_demod);
 
    /* Now on to backward simplification. */
+   PROF_SCOPE_ENTER(ProfBackwardSimplify);
    clausedate = ClauseSetListGetMaxDate(state->demods, FullRewrite);
 
    eliminate_backward_rewritten_clauses(state, control, pclause->clause, &clausedate);
    eliminate_backward_subsumed_clauses(state, pclause,
-                                       control->heuristic_parms.lambda_demod);
+                                       control->heuristic_parms.lambda_demod,
+                                       control->bw_workers);
    eliminate_unit_simplified_clauses(state, pclause->clause,
                                     control->heuristic_parms.lambda_demod);
    eliminate_context_sr_clauses(state, control, pclause->clause,
                                 control->heuristic_parms.lambda_demod);
    ClauseSetSetProp(state->tmp_store, CPIsIRVictim);
+   PROF_SCOPE_EXIT(ProfBackwardSimplify);
 
    clause = pclause->clause;
 
@@ -1695,7 +2078,9 @@ Clause_p ProcessClause(ProofState_p state, ProofControl_p control,
    }
    if(control->heuristic_parms.selection_strategy != SelectNoGeneration)
    {
+      PROF_SCOPE_ENTER(ProfGenerate);
       generate_new_clauses(state, control, clause, tmp_copy);
+      PROF_SCOPE_EXIT(ProfGenerate);
    }
    ClauseFree(tmp_copy);
    if(TermCellStoreNodes(&(state->tmp_terms->term_store))>TMPBANK_GC_LIMIT)
@@ -1712,7 +2097,10 @@ Clause_p ProcessClause(ProofState_p state, ProofControl_p control,
    {
       ClauseSetSort(state->tmp_store, ClauseCmpByStructWeight);
    }
-   if((empty = insert_new_clauses(state, control)))
+   PROF_SCOPE_ENTER(ProfInsert);
+   empty = insert_new_clauses(state, control);
+   PROF_SCOPE_EXIT(ProfInsert);
+   if(empty)
    {
       PStackPushP(state->extract_roots, empty);
       return empty;
@@ -1747,9 +2135,9 @@ Clause_p Saturate(ProofState_p state, ProofControl_p control, long
       sat_check_step_limit = control->heuristic_parms.sat_check_step_limit,
       sat_check_ttinsert_limit = control->heuristic_parms.sat_check_ttinsert_limit;
 
-
+   PROF_SCOPE_ENTER(ProfSaturate);
    while(!TimeIsUp &&
-         !ClauseSetEmpty(state->unprocessed) &&
+         !ProofStateUnprocEmpty(state) &&
          step_limit   > count &&
          proc_limit   > ProofStateProcCardinality(state) &&
          unproc_limit > ProofStateUnprocCardinality(state) &&
@@ -1770,6 +2158,7 @@ Clause_p Saturate(ProofState_p state, ProofControl_p control, long
       {
          break;
       }
+      collect_term_garbage(state, control);
       if(control->heuristic_parms.sat_check_grounding != GMNoGrounding)
       {
          if(ProofStateCardinality(state) >= sat_check_size_limit)
@@ -1797,6 +2186,7 @@ Clause_p Saturate(ProofState_p state, ProofControl_p control, long
          }
       }
    }
+   PROF_SCOPE_EXIT(ProfSaturate);
    return unsatisfiable;
 }
 
@@ -55,6 +55,16 @@ PERF_CTR_DECL(BWRWTimer);
    small enough. */
 #define TMPBANK_GC_LIMIT 256
 
+/* With --term-gc-limit, a minor collection of the main term bank is
+   replaced by a full one once the old cells have grown by this factor
+   since the last full collection. */
+#define TERMBANK_FULL_GC_FACTOR 2
+
+/* In lazy mode, every LAZY_EVAL_FIFO_RATIO'th clause promoted from
+   the holding queue in a batch is the oldest one, the others are the
+   ones with the smallest symbol count. */
+#define LAZY_EVAL_FIFO_RATIO 5
+
 void     ProofControlInit(ProofState_p state, ProofControl_p control,
            HeuristicParms_p params,
                           FVIndexParms_p fvi_params,
@@ -250,7 +250,7 @@ int ExecuteScheduleMultiCore(ScheduleCell strats[],
                              int max_cores,
                              bool serialize)
 {
-   int i;
+   int i, exit_status;
    double run_time = GetTotalCPUTime();
    EGPCtrl_p handle;
    EGPCtrlSet_p procs = EGPCtrlSetAlloc();
@@ -301,8 +301,10 @@ int ExecuteScheduleMultiCore(ScheduleCell strats[],
          {
             PrintRusage(GlobalOut);
          }
+         /* handle is freed with procs */
+         exit_status = handle->exit_status;
          EGPCtrlSetFree(procs, true);
-         exit(handle->exit_status);
+         exit(exit_status);
       }
       if(SigTermCaught)
       {
@@ -116,7 +116,8 @@ bool RemoveRewritableClauses(OCB_p ocb, ClauseSet_p from, ClauseSet_p into,
 // Function: RemoveRewritableClausesIndexed()
 //
 //   Remove all clauses in gindices->bw_rw_index which can be
-//   rewritten with new_demod.
+//   rewritten with new_demod. If pool is not NULL, use it to find
+//   the rewritable clauses.
 //
 // Global Variables: -
 //
@@ -127,14 +128,15 @@ bool RemoveRewritableClauses(OCB_p ocb, ClauseSet_p from, ClauseSet_p into,
 bool RemoveRewritableClausesIndexed(OCB_p ocb, ClauseSet_p into,
                                     ClauseSet_p archive,
                                     Clause_p new_demod, SysDate nf_date,
-                                    GlobalIndices_p gindices, bool lambda_demod)
+                                    GlobalIndices_p gindices, bool lambda_demod,
+                                    WorkPool_p pool)
 {
    PStack_p stack = PStackAlloc();
    Clause_p handle;
    bool     res;
 
    res = FindRewritableClausesIndexed(ocb, gindices->bw_rw_index,
-                                      stack, new_demod, nf_date);
+                                      stack, new_demod, nf_date, pool);
    while(!PStackEmpty(stack))
    {
       handle = PStackPopP(stack);
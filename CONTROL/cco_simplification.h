@@ -56,7 +56,8 @@ bool     RemoveRewritableClausesIndexed(OCB_p ocb, ClauseSet_p into,
                                         ClauseSet_p archive,
                                         Clause_p new_demod, SysDate nf_date,
                                         GlobalIndices_p gindices,
-                                        bool lambda_demod);
+                                        bool lambda_demod,
+                                        WorkPool_p pool);
 
 long ClauseSetUnitSimplify(ClauseSet_p set, Clause_p simplifier,
                            ClauseSet_p tmp_set, ClauseSet_p archive,
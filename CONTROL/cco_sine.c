@@ -353,6 +353,10 @@ StructFOFSpec_p StructFOFSpecCreate(TB_p terms)
    handle->parsed_includes = NULL;
    handle->f_distrib       = GenDistribAlloc(handle->terms->sig);
    handle->shared_ax_sp    = 0;
+   handle->cache_dir       = NULL;
+   handle->drel_base       = NULL;
+   handle->sine_cache      = NULL;
+   handle->sine_cache_key  = 0;
 
    return handle;
 }
@@ -430,6 +434,11 @@ void StructFOFSpecDestroy(StructFOFSpec_p ctrl)
    PStackFree(ctrl->formula_sets);
    StrTreeFree(ctrl->parsed_includes);
    GenDistribFree(ctrl->f_distrib);
+   StructFOFSpecResetDRelBase(ctrl);
+   if(ctrl->sine_cache)
+   {
+      DStrFree(ctrl->sine_cache);
+   }
 
    StructFOFSpecCellFree(ctrl);
 }
@@ -462,6 +471,89 @@ void StructFOFSpecFree(StructFOFSpec_p ctrl)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: StructFOFSpecAddDRelFilter()
+//
+//   Precompute the D-relation data of the axioms currently in ctrl
+//   for filter (if it is a SinE filter), so that
+//   StructFOFSpecGetProblem() can reuse it for all later selections
+//   and only needs to update it for problems added later.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void StructFOFSpecAddDRelFilter(StructFOFSpec_p ctrl, AxFilter_p filter)
+{
+   if(filter->type != AFGSinE)
+   {
+      return;
+   }
+   if(!ctrl->drel_base)
+   {
+      ctrl->drel_base = DRelBaseAlloc(ctrl->clause_sets,
+                                      ctrl->formula_sets,
+                                      PStackGetSP(ctrl->clause_sets));
+   }
+   if(ctrl->drel_base->sets == PStackGetSP(ctrl->clause_sets))
+   {
+      DRelBaseAddFilter(ctrl->drel_base, ctrl->f_distrib, filter);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: StructFOFSpecSaveDRelBase()
+//
+//   If ctrl has a SinE cache and filters have been added to the
+//   precomputed D-relation data since it was loaded, write it.
+//
+// Global Variables: -
+//
+// Side Effects    : I/O
+//
+/----------------------------------------------------------------------*/
+
+void StructFOFSpecSaveDRelBase(StructFOFSpec_p ctrl)
+{
+   if(ctrl->sine_cache && ctrl->drel_base && ctrl->drel_base->modified &&
+      ctrl->drel_base->sets == PStackGetSP(ctrl->clause_sets) &&
+      DRelBaseWrite(ctrl->drel_base, ctrl->f_distrib,
+                    DStrView(ctrl->sine_cache), ctrl->sine_cache_key))
+   {
+      fprintf(GlobalOut, COMCHAR" Wrote SinE cache %s\n",
+              DStrView(ctrl->sine_cache));
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: StructFOFSpecResetDRelBase()
+//
+//   Drop the precomputed D-relation data (necessary whenever the
+//   shared axioms change).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void StructFOFSpecResetDRelBase(StructFOFSpec_p ctrl)
+{
+   if(ctrl->drel_base)
+   {
+      DRelBaseFree(ctrl->drel_base);
+      ctrl->drel_base = NULL;
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: StructFOFSpecCollectFCode()
@@ -494,12 +586,138 @@ long StructFOFSpecCollectFCode(StructFOFSpec_p ctrl,
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: ax_cache_name()
+//
+//   Compute the key of the cache for the given axiom files, and
+//   return the name of the cache file in ctrl->cache_dir (as a DStr
+//   that has to be freed by the caller).
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static DStr_p ax_cache_name(StructFOFSpec_p ctrl, PStack_p axfiles,
+                            IOFormat parse_format, char* default_dir,
+                            uint64_t *key)
+{
+   DStr_p        res = DStrAlloc();
+   PStackPointer i;
+   char          buf[32];
+
+   DStrAppendInt(res, parse_format);
+   DStrAppendChar(res, '\n');
+   DStrAppendStr(res, default_dir?default_dir:"");
+   for(i=0; i<PStackGetSP(axfiles); i++)
+   {
+      DStrAppendChar(res, '\n');
+      DStrAppendStr(res, PStackElementP(axfiles, i));
+   }
+   *key = MemHash64(DStrView(res), DStrLen(res), FORMULA_CACHE_VERSION);
+
+   DStrSet(res, ctrl->cache_dir);
+   if(DStrLen(res) && DStrLastChar(res) != '/')
+   {
+      DStrAppendChar(res, '/');
+   }
+   sprintf(buf, "axioms_%016llx.ecache", (unsigned long long)*key);
+   DStrAppendStr(res, buf);
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: sine_cache_set()
+//
+//   Record the SinE cache belonging to the axiom cache cache_name
+//   (with contents identified by hash) in ctrl.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void sine_cache_set(StructFOFSpec_p ctrl, DStr_p cache_name,
+                           uint64_t hash)
+{
+   if(!ctrl->sine_cache)
+   {
+      ctrl->sine_cache = DStrAlloc();
+   }
+   DStrSet(ctrl->sine_cache, DStrView(cache_name));
+   while(DStrLen(ctrl->sine_cache) && DStrLastChar(ctrl->sine_cache) != '.')
+   {
+      DStrDeleteLastChar(ctrl->sine_cache);
+   }
+   DStrAppendStr(ctrl->sine_cache, "esine");
+   ctrl->sine_cache_key = hash;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ax_cache_load()
+//
+//   Try to initialize ctrl from the axiom cache. Return the number of
+//   formulas loaded (and the hash of the cache in *body_hash), or -1
+//   if there is no valid cache.
+//
+// Global Variables: -
+//
+// Side Effects    : I/O, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static long ax_cache_load(StructFOFSpec_p ctrl, char* cache_name,
+                          uint64_t key, uint64_t *body_hash)
+{
+   PStack_p     fsets = PStackAlloc();
+   PStack_p     names = PStackAlloc();
+   FormulaSet_p fset;
+   ClauseSet_p  cset;
+   char*        name;
+   long         res;
+   PStackPointer i;
+   static IntOrP dummy = {0};
+
+   res = FormulaCacheLoad(cache_name, key, ctrl->terms, fsets, names,
+                          body_hash);
+   for(i=0; i<PStackGetSP(fsets); i++)
+   {
+      fset = PStackElementP(fsets, i);
+      name = PStackElementP(names, i);
+      cset = ClauseSetAlloc();
+      TBGCRegisterFormulaSet(ctrl->terms, fset);
+      TBGCRegisterClauseSet(ctrl->terms, cset);
+      PStackPushP(ctrl->clause_sets, cset);
+      PStackPushP(ctrl->formula_sets, fset);
+      StrTreeStore(&(ctrl->parsed_includes), name, dummy, dummy);
+      FREE(name);
+   }
+   if(res >= 0)
+   {
+      fprintf(GlobalOut, COMCHAR" Loaded %ld formulas from %s\n",
+              res, cache_name);
+   }
+   PStackFree(fsets);
+   PStackFree(names);
+   return res;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: StructFOFSpecParseAxioms()
 //
 //   Initialize a StructFOFSpeclCell by parsing all the include files
-//   in axfiles.
+//   in axfiles. If ctrl->cache_dir is set and nothing has been parsed
+//   into ctrl yet, try to load the result from a cache first, and
+//   write the cache after parsing otherwise.
 //
 // Global Variables: -
 //
@@ -517,6 +735,31 @@ long StructFOFSpecParseAxioms(StructFOFSpec_p ctrl, PStack_p axfiles,
    Scanner_p    in;
    long         res = 0;
    static IntOrP dummy = {0};
+   DStr_p       cache_name = NULL;
+   uint64_t     cache_key = 0, cache_hash = 0;
+   FormulaCacheStateCell cache_state;
+   PStack_p     cache_names = NULL;
+   bool         cacheable = true;
+
+   if(ctrl->cache_dir && PStackEmpty(ctrl->formula_sets))
+   {
+      cache_name = ax_cache_name(ctrl, axfiles, parse_format, default_dir,
+                                 &cache_key);
+      res = ax_cache_load(ctrl, DStrView(cache_name), cache_key,
+                          &cache_hash);
+      if(res >= 0)
+      {
+         sine_cache_set(ctrl, cache_name, cache_hash);
+         DStrFree(cache_name);
+         ctrl->shared_ax_sp = PStackGetSP(ctrl->clause_sets);
+         ctrl->shared_ax_f_count = SigGetFCount(ctrl->terms->sig);
+         return res;
+      }
+      res = 0;
+      FormulaCacheGetState(ctrl->terms, &cache_state);
+      cache_names   = PStackAlloc();
+      StreamFileLog = PStackAlloc();
+   }
 
    //printf(COMCHAR" XXX Called with %ld axiom files\n", PStackGetSP(axfiles));
    for(i=0; i<PStackGetSP(axfiles); i++)
@@ -540,8 +783,13 @@ long StructFOFSpecParseAxioms(StructFOFSpec_p ctrl, PStack_p axfiles,
                                             NULL,
                                             &(ctrl->parsed_includes));
             assert(ClauseSetCardinality(cset)==0);
+            cacheable = cacheable && ClauseSetEmpty(cset);
             PStackPushP(ctrl->clause_sets, cset);
             PStackPushP(ctrl->formula_sets, fset);
+            if(cache_names)
+            {
+               PStackPushP(cache_names, iname);
+            }
             // printf(COMCHAR" %s has %ld formulas\n", iname, FormulaSetCardinality(fset));
             StrTreeStore(&(ctrl->parsed_includes), iname, dummy, dummy);
 
@@ -553,12 +801,34 @@ long StructFOFSpecParseAxioms(StructFOFSpec_p ctrl, PStack_p axfiles,
          else
          {
             fprintf(GlobalOut, COMCHAR" Could not find %s\n", iname);
+            cacheable = false;
          }
       }
    }
    ctrl->shared_ax_sp = PStackGetSP(ctrl->clause_sets);
    ctrl->shared_ax_f_count = SigGetFCount(ctrl->terms->sig);
 
+   if(cache_name)
+   {
+      if(cacheable &&
+         FormulaCacheWrite(DStrView(cache_name), cache_key, &cache_state,
+                           ctrl->terms, ctrl->formula_sets, cache_names,
+                           StreamFileLog, &cache_hash))
+      {
+         fprintf(GlobalOut, COMCHAR" Wrote axiom cache %s\n",
+                 DStrView(cache_name));
+         sine_cache_set(ctrl, cache_name, cache_hash);
+      }
+      while(!PStackEmpty(StreamFileLog))
+      {
+         iname = PStackPopP(StreamFileLog);
+         FREE(iname);
+      }
+      PStackFree(StreamFileLog);
+      StreamFileLog = NULL;
+      PStackFree(cache_names);
+      DStrFree(cache_name);
+   }
    return res;
 }
 
@@ -568,17 +838,31 @@ long StructFOFSpecParseAxioms(StructFOFSpec_p ctrl, PStack_p axfiles,
 // Function: StructFOFSpecInitDistrib()
 //
 //   Initialize the f_distrib element of an otherwise initialized
-//   structured problem cell.
+//   structured problem cell. If there is a valid SinE cache, take
+//   the distribution (and the precomputed D-relation data) from it.
 //
 // Global Variables: -
 //
-// Side Effects    : Memory operations
+// Side Effects    : Memory operations, I/O
 //
 /----------------------------------------------------------------------*/
 
 void StructFOFSpecInitDistrib(StructFOFSpec_p ctrl, bool trim)
 {
    GenDistribSizeAdjust(ctrl->f_distrib, ctrl->terms->sig);
+   if(ctrl->sine_cache && !trim && !ctrl->drel_base)
+   {
+      ctrl->drel_base = DRelBaseAlloc(ctrl->clause_sets,
+                                      ctrl->formula_sets,
+                                      PStackGetSP(ctrl->clause_sets));
+      if(DRelBaseLoad(ctrl->drel_base, ctrl->f_distrib,
+                      DStrView(ctrl->sine_cache), ctrl->sine_cache_key))
+      {
+         fprintf(GlobalOut, COMCHAR" Loaded SinE cache %s\n",
+                 DStrView(ctrl->sine_cache));
+         return;
+      }
+   }
    GenDistribAddClauseSets(ctrl->f_distrib, ctrl->clause_sets);
    GenDistribAddFormulaSets(ctrl->f_distrib, ctrl->formula_sets, trim);
 }
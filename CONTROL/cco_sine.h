@@ -28,6 +28,7 @@ Changes
 #include <ccl_proofstate.h>
 #include <ccl_formulafunc.h>
 #include <ccl_sine.h>
+#include <ccl_formula_cache.h>
 #include <che_rawspecfeatures.h>
 
 /*---------------------------------------------------------------------*/
@@ -49,6 +50,13 @@ typedef struct structured_FOF_spec_cell
    PStackPointer shared_ax_sp;
    FunCode       shared_ax_f_count;
    GenDistrib_p  f_distrib;
+   char*         cache_dir;    /* Directory for parsed axiom caches
+                                  (or NULL). Not owned. */
+   DRelBase_p    drel_base;    /* Precomputed SinE data for the shared
+                                  axioms (or NULL) */
+   DStr_p        sine_cache;   /* File for drel_base and f_distrib, if
+                                  the axioms come from a cache */
+   uint64_t      sine_cache_key;
 }StructFOFSpecCell, *StructFOFSpec_p;
 
 
@@ -80,6 +88,10 @@ void StructFOFSpecAddProblem(StructFOFSpec_p ctrl,
 
 void StructFOFSpecBacktrackToSpec(StructFOFSpec_p ctrl);
 
+void StructFOFSpecAddDRelFilter(StructFOFSpec_p ctrl, AxFilter_p filter);
+void StructFOFSpecSaveDRelBase(StructFOFSpec_p ctrl);
+void StructFOFSpecResetDRelBase(StructFOFSpec_p ctrl);
+
 long StructFOFSpecCollectFCode(StructFOFSpec_p ctrl,
                                FunCode f_code,
                                PStack_p res_formulas);
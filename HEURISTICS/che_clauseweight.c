@@ -116,8 +116,11 @@ WFCB_p ClauseWeightInit(ClausePrioFun prio_fun, int fweight, int
    data->pos_multiplier         = pos_multiplier;
    data->app_var_mult           = app_var_mult;
 
-   return WFCBAlloc(ClauseWeightCompute, prio_fun,
-                    ClauseWeightExit, data);
+   WFCB_p res = WFCBAlloc(ClauseWeightCompute, prio_fun,
+                          ClauseWeightExit, data);
+   WFCBSetBatchEval(res, ClauseWeightBatchCompute);
+
+   return res;
 }
 
 
@@ -182,6 +185,36 @@ double ClauseWeightCompute(void* data, Clause_p clause)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseWeightBatchCompute()
+//
+//   Compute evaluations for count clauses.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void ClauseWeightBatchCompute(void* data, Clause_p *clauses, long count,
+                              double *evals)
+{
+   WeightParam_p local = data;
+   double pos_multiplier = local->pos_multiplier;
+   double app_var_mult   = local->app_var_mult;
+   long   vweight        = local->vweight;
+   long   fweight        = local->fweight;
+   long   i;
+
+   for(i=0; i<count; i++)
+   {
+      evals[i] = ClauseWeight(clauses[i], 1, 1, pos_multiplier,
+                              vweight, fweight, app_var_mult, false);
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: ClauseWeightExit()
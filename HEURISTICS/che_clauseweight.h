@@ -59,6 +59,8 @@ WFCB_p ClauseWeightInit(ClausePrioFun prio_fun, int fweight, int
 WFCB_p ClauseWeightParse(Scanner_p in, OCB_p ocb, ProofState_p state);
 
 double ClauseWeightCompute(void* data, Clause_p clause);
+void   ClauseWeightBatchCompute(void* data, Clause_p *clauses,
+                                long count, double *evals);
 
 void   ClauseWeightExit(void* data);
 
@@ -564,6 +564,7 @@ WFCB_p ConjectureSymbolWeightInit(ClausePrioFun prio_fun,
                                   void   (*init_fun)(struct funweightparamcell*))
 {
    FunWeightParam_p data = FunWeightParamAlloc();
+   WFCB_p           res;
 
    data->init_fun               = init_fun;
    data->ocb                    = ocb;
@@ -587,8 +588,11 @@ WFCB_p ConjectureSymbolWeightInit(ClausePrioFun prio_fun,
    /* Weight vector is computed on first call of weight function to
       avoid overhead if many funweigh-based functions are predefined
       */
-   return WFCBAlloc(GenericFunWeightCompute, prio_fun,
-                    GenericFunWeightExit, data);
+   res = WFCBAlloc(GenericFunWeightCompute, prio_fun,
+                   GenericFunWeightExit, data);
+   WFCBSetBatchEval(res, GenericFunWeightBatchCompute);
+
+   return res;
 }
 
 
@@ -625,6 +629,7 @@ WFCB_p RelevanceLevelWeightInit(ClausePrioFun prio_fun,
 
 {
    FunWeightParam_p data = FunWeightParamAlloc();
+   WFCB_p           res;
 
    data->init_fun               = init_relevance_vector;
    data->ocb                    = ocb;
@@ -649,8 +654,11 @@ WFCB_p RelevanceLevelWeightInit(ClausePrioFun prio_fun,
    /* Weight vector is computed on first call of weight function to
       avoid overhead is many funweigh-based functions are predefined
       */
-   return WFCBAlloc(GenericFunWeightCompute, prio_fun,
-                    GenericFunWeightExit, data);
+   res = WFCBAlloc(GenericFunWeightCompute, prio_fun,
+                   GenericFunWeightExit, data);
+   WFCBSetBatchEval(res, GenericFunWeightBatchCompute);
+
+   return res;
 }
 
 /*-----------------------------------------------------------------------
@@ -683,6 +691,7 @@ WFCB_p RelevanceLevelWeightInit2(ClausePrioFun prio_fun,
                                  double app_var_mult)
 {
    FunWeightParam_p data = FunWeightParamAlloc();
+   WFCB_p           res;
 
    data->init_fun               = init_relevance_vector2;
    data->ocb                    = ocb;
@@ -706,8 +715,11 @@ WFCB_p RelevanceLevelWeightInit2(ClausePrioFun prio_fun,
    /* Weight vector is computed on first call of weight function to
       avoid overhead if many funweigh-based functions are predefined
       */
-   return WFCBAlloc(GenericFunWeightCompute, prio_fun,
-                    GenericFunWeightExit, data);
+   res = WFCBAlloc(GenericFunWeightCompute, prio_fun,
+                   GenericFunWeightExit, data);
+   WFCBSetBatchEval(res, GenericFunWeightBatchCompute);
+
+   return res;
 }
 
 
@@ -1231,6 +1243,7 @@ WFCB_p FunWeightInit(ClausePrioFun prio_fun,
                      double app_var_mult)
 {
    FunWeightParam_p data = FunWeightParamAlloc();
+   WFCB_p           res;
 
    data->init_fun               = init_fun_weights;
    data->ocb                    = ocb;
@@ -1245,8 +1258,11 @@ WFCB_p FunWeightInit(ClausePrioFun prio_fun,
 
    data->app_var_mult        = app_var_mult;
 
-   return WFCBAlloc(GenericFunWeightCompute, prio_fun,
-                    GenericFunWeightExit, data);
+   res = WFCBAlloc(GenericFunWeightCompute, prio_fun,
+                   GenericFunWeightExit, data);
+   WFCBSetBatchEval(res, GenericFunWeightBatchCompute);
+
+   return res;
 
 }
 
@@ -1464,6 +1480,59 @@ double GenericFunWeightCompute(void* data, Clause_p clause)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: GenericFunWeightBatchCompute()
+//
+//   Compute evaluations for count clauses. The weight vector is
+//   initialized (if necessary) only once for the whole batch.
+//
+// Global Variables: -
+//
+// Side Effects    : Marks maximal terms, may initialize the weight
+//                   vector.
+//
+/----------------------------------------------------------------------*/
+
+void GenericFunWeightBatchCompute(void* data, Clause_p *clauses,
+                                  long count, double *evals)
+{
+   FunWeightParam_p local = data;
+   OCB_p  ocb;
+   double max_term_multiplier, max_literal_multiplier, pos_multiplier;
+   double app_var_mult;
+   long   vweight, flimit, fweight, *fweights;
+   long   i;
+
+   local->init_fun(data);
+
+   ocb                    = local->ocb;
+   max_term_multiplier    = local->max_term_multiplier;
+   max_literal_multiplier = local->max_literal_multiplier;
+   pos_multiplier         = local->pos_multiplier;
+   vweight                = local->vweight;
+   flimit                 = local->flimit;
+   fweights               = local->fweights;
+   fweight                = local->fweight;
+   app_var_mult           = local->app_var_mult;
+
+   for(i=0; i<count; i++)
+   {
+      ClauseCondMarkMaximalTerms(ocb, clauses[i]);
+      evals[i] = ClauseFunWeight(clauses[i],
+                                 max_term_multiplier,
+                                 max_literal_multiplier,
+                                 pos_multiplier,
+                                 vweight,
+                                 flimit,
+                                 fweights,
+                                 fweight,
+                                 app_var_mult,
+                                 local->type_freqs);
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: SymOffsetWeightCompute()
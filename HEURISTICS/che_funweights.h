@@ -162,6 +162,8 @@ WFCB_p SymOffsetWeightParse(Scanner_p in, OCB_p ocb,
                             ProofState_p state);
 
 double GenericFunWeightCompute(void* data, Clause_p clause);
+void   GenericFunWeightBatchCompute(void* data, Clause_p *clauses,
+                                    long count, double *evals);
 
 double SymOffsetWeightCompute(void* data, Clause_p clause);
 
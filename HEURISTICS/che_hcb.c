@@ -116,7 +116,7 @@ UnifMode str2um(char* value)
 //
 // Function: get_next_clause()
 //
-//   Return the next clause from the selected EvalTreeTraverse-Stack,
+//   Return the next clause from the selected traversal stack of set,
 //   or NULL if the stack is empty.
 //
 // Global Variables: -
@@ -125,11 +125,11 @@ UnifMode str2um(char* value)
 //
 /----------------------------------------------------------------------*/
 
-static Clause_p get_next_clause(PStack_p *stacks, int pos)
+static Clause_p get_next_clause(ClauseSet_p set, PStack_p *stacks, int pos)
 {
    Eval_p current;
 
-   current = EvalTreeTraverseNext(stacks[pos], pos);
+   current = ClauseSetEvalTraverseNext(set, stacks[pos], pos);
    if(current)
    {
       return current->object;
@@ -245,6 +245,7 @@ void HeuristicParmsInitialize(HeuristicParms_p handle)
    handle->sat_check_normconst           = false;
    handle->sat_check_normalize           = false;
    handle->sat_check_decision_limit      = 10000;
+   handle->sat_check_incremental         = false;
    handle->filter_orphans_limit          = DEFAULT_FILTER_ORPHANS_LIMIT;
    handle->forward_contract_limit        = DEFAULT_FORWARD_CONTRACT_LIMIT;
    handle->delete_bad_limit              = DEFAULT_DELETE_BAD_LIMIT;
@@ -255,6 +256,12 @@ void HeuristicParmsInitialize(HeuristicParms_p handle)
    handle->presat_interreduction         = false;
    handle->detsort_bw_rw                 = false;
    handle->detsort_tmpset                = false;
+   handle->bw_simplify_workers           = 0;
+   handle->paramod_workers               = 0;
+   handle->lazy_eval_batch               = 0;
+   handle->pack_unprocessed              = false;
+   handle->term_gc_limit                 = 0;
+   handle->ord_res_cache_size            = 0;
 
    handle->arg_cong                      = AllLits;
    handle->neg_ext                       = NoLits;
@@ -459,6 +466,8 @@ void HeuristicParmsPrint(FILE* out, HeuristicParms_p handle)
            BOOL2STR(handle->sat_check_normalize));
    fprintf(out, "   sat_check_decision_limit:       %d\n",
            handle->sat_check_decision_limit);
+   fprintf(out, "   sat_check_incremental:          %s\n",
+           BOOL2STR(handle->sat_check_incremental));
 
    fprintf(out, "   filter_orphans_limit:           %ld\n", handle->filter_orphans_limit);
    fprintf(out, "   forward_contract_limit:         %ld\n", handle->forward_contract_limit);
@@ -479,6 +488,18 @@ void HeuristicParmsPrint(FILE* out, HeuristicParms_p handle)
            BOOL2STR(handle->detsort_bw_rw));
    fprintf(out, "   detsort_tmpset:                 %s\n",
            BOOL2STR(handle->detsort_tmpset));
+   fprintf(out, "   bw_simplify_workers:            %d\n",
+           handle->bw_simplify_workers);
+   fprintf(out, "   paramod_workers:                %d\n",
+           handle->paramod_workers);
+   fprintf(out, "   lazy_eval_batch:                %ld\n",
+           handle->lazy_eval_batch);
+   fprintf(out, "   pack_unprocessed:               %s\n",
+           BOOL2STR(handle->pack_unprocessed));
+   fprintf(out, "   term_gc_limit:                  %ld\n",
+           handle->term_gc_limit);
+   fprintf(out, "   ord_res_cache_size:             %ld\n",
+           handle->ord_res_cache_size);
 
    fprintf(out, "   arg_cong:                       %s\n",
            EIT2STR(handle->arg_cong));
@@ -697,6 +718,7 @@ bool HeuristicParmsParseInto(Scanner_p in,
    PARSE_BOOL(sat_check_normconst);
    PARSE_BOOL(sat_check_normalize);
    PARSE_INT(sat_check_decision_limit);
+   PARSE_BOOL(sat_check_incremental);
 
    PARSE_INT(filter_orphans_limit);
    PARSE_INT(forward_contract_limit);
@@ -709,6 +731,12 @@ bool HeuristicParmsParseInto(Scanner_p in,
    PARSE_BOOL(presat_interreduction);
    PARSE_BOOL(detsort_bw_rw);
    PARSE_BOOL(detsort_tmpset);
+   PARSE_INT(bw_simplify_workers);
+   PARSE_INT(paramod_workers);
+   PARSE_INT(lazy_eval_batch);
+   PARSE_BOOL(pack_unprocessed);
+   PARSE_INT(term_gc_limit);
+   PARSE_INT(ord_res_cache_size);
 
 
    PARSE_STRING_AND_CONVERT(arg_cong, str2eit);
@@ -887,6 +915,46 @@ void HCBClauseEvaluate(HCB_p hcb, Clause_p clause)
    PERF_CTR_EXIT(ClauseEvalTimer);
 }
 
+/*-----------------------------------------------------------------------
+//
+// Function: HCBClauseBatchEvaluate()
+//
+//   Add evaluations to all count clauses in clauses. The same as
+//   calling HCBClauseEvaluate() on each of them, but evaluates the
+//   whole batch with one WFCB before moving to the next, so that
+//   weight functions with batch support can share their setup.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory, adds evaluations, by eval functions
+//
+/----------------------------------------------------------------------*/
+
+void HCBClauseBatchEvaluate(HCB_p hcb, Clause_p *clauses, long count)
+{
+   long   i;
+   double *evals;
+
+   if(!count)
+   {
+      return;
+   }
+   PERF_CTR_ENTRY(ClauseEvalTimer);
+   for(i=0; i<count; i++)
+   {
+      assert(clauses[i]->evaluations == NULL);
+      ClauseAddEvalCell(clauses[i], EvalsAlloc(hcb->wfcb_no));
+   }
+   evals = SizeMalloc(count*sizeof(double));
+   for(i=0; i< hcb->wfcb_no; i++)
+   {
+      ClauseBatchAddEvaluation(PDArrayElementP(hcb->wfcb_list, i),
+                               clauses, count, i, evals);
+   }
+   SizeFree(evals, count*sizeof(double));
+   PERF_CTR_EXIT(ClauseEvalTimer);
+}
+
 /*-----------------------------------------------------------------------
 //
 // Function: HCBStandardClauseSelect()
@@ -979,8 +1047,7 @@ long HCBClauseSetDelProp(HCB_p hcb, ClauseSet_p set, long number,
 
    for(i=0; i< hcb->wfcb_no; i++)
    {
-      stacks[i]=
-         EvalTreeTraverseInit(PDArrayElementP(set->eval_indices, i),i);
+      stacks[i]= ClauseSetEvalTraverseInit(set, i);
    }
    while(number)
    {
@@ -989,7 +1056,7 @@ long HCBClauseSetDelProp(HCB_p hcb, ClauseSet_p set, long number,
          for(j=0; j < PDArrayElementInt(hcb->select_switch, j); j++)
          {
             while((clause =
-                   get_next_clause(stacks,i)))
+                   get_next_clause(set, stacks, i)))
             {
                if(ClauseQueryProp(clause, prop))
                {
@@ -1013,7 +1080,7 @@ long HCBClauseSetDelProp(HCB_p hcb, ClauseSet_p set, long number,
    }
    for(i=0; i< hcb->wfcb_no; i++)
    {
-      EvalTreeTraverseExit(stacks[i]);
+      ClauseSetEvalTraverseExit(stacks[i]);
    }
    SizeFree(stacks, hcb->wfcb_no*sizeof(PStack_p));
 
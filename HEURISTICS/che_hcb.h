@@ -198,6 +198,7 @@ typedef struct heuristic_parms_cell
    bool                sat_check_normconst;
    bool                sat_check_normalize;
    int                 sat_check_decision_limit;
+   bool                sat_check_incremental;
 
    /* Various things */
    long                filter_orphans_limit;
@@ -211,6 +212,22 @@ typedef struct heuristic_parms_cell
 
    bool                detsort_bw_rw;
    bool                detsort_tmpset;
+   int                 bw_simplify_workers; /* <=1: Backward
+                                               simplification is
+                                               sequential */
+   int                 paramod_workers; /* <=1: Paramodulation
+                                           partners are found
+                                           sequentially */
+   long                lazy_eval_batch; /* 0: Process new clauses
+                                           eagerly */
+   bool                pack_unprocessed; /* Store unprocessed clauses
+                                            in packed form */
+   long                term_gc_limit;   /* Collect the term bank after
+                                           this many new cells, 0:
+                                           only when deleting clauses */
+   long                ord_res_cache_size; /* 0: Do not cache ordering
+                                              comparisons of ground
+                                              terms */
 
    /* Higher-order settings */
    ExtInferenceType    arg_cong;
@@ -320,6 +337,7 @@ void             HeuristicParmsPrint(FILE* out, HeuristicParms_p handle);
 bool             HeuristicParmsParseInto(Scanner_p in, HeuristicParms_p handle,
                                          bool warn_missing);
 HeuristicParms_p HeuristicParmsParse(Scanner_p in, bool warn_missing);
+ExtInferenceType str2eit(char* value);
 
 
 #define HCBCellAlloc() (HCBCell*)SizeMalloc(sizeof(HCBCell))
@@ -329,6 +347,7 @@ HCB_p    HCBAlloc(void);
 void     HCBFree(HCB_p junk);
 long     HCBAddWFCB(HCB_p hcb, WFCB_p wfcb, long steps);
 void     HCBClauseEvaluate(HCB_p hcb, Clause_p clause);
+void     HCBClauseBatchEvaluate(HCB_p hcb, Clause_p *clauses, long count);
 Clause_p HCBStandardClauseSelect(HCB_p hcb, ClauseSet_p set);
 Clause_p HCBSingleWeightClauseSelect(HCB_p hcb, ClauseSet_p set);
 
@@ -19,9 +19,232 @@
 
   -----------------------------------------------------------------------*/
 
+#include <limits.h>
+#include <stdint.h>
 #include "che_new_autoschedule.h"
 
 #include "schedule.vars"
+#include "schedule_parms.vars"
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+#if PREPARSED_ARR_LEN != MAX_PM_INDEX_NAME_LEN
+#error "PREPARSED_ARR_LEN in che_preparsed.h is out of date"
+#endif
+
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: pp_conv_*()
+//
+//   Translate the name of a value of a named parameter (as found in
+//   the strategy text) into the value as the parser does. Return
+//   false if the name is unknown (the parser would report an error).
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool pp_conv_ordertype(char* name, TermOrdering *res)
+{
+   *res = StringIndex(name, TONames);
+   return *res != -1;
+}
+
+static bool pp_conv_weight_gen(char* name, TOWeightGenMethod *res)
+{
+   *res = StringIndex(name, TOWeightGenNames);
+   return *res != -1;
+}
+
+static bool pp_conv_prec_gen(char* name, TOPrecGenMethod *res)
+{
+   *res = StringIndex(name, TOPrecGenNames);
+   return *res != -1;
+}
+
+static bool pp_conv_hok(char* name, HoOrderKind *res)
+{
+   *res = STR2HOK(name);
+   return *res != -1;
+}
+
+static bool pp_conv_selection(char* name, LiteralSelectionFun *res)
+{
+   *res = GetLitSelFun(name);
+   return *res != NULL;
+}
+
+static bool pp_conv_pm_type(char* name, ParamodulationType *res)
+{
+   *res = ParamodType(name);
+   return *res != -1;
+}
+
+static bool pp_conv_grounding(char* name, GroundingStrategy *res)
+{
+   *res = StringIndex(name, GroundingStratNames);
+   return *res != -1;
+}
+
+static bool pp_conv_eit(char* name, ExtInferenceType *res)
+{
+   /* Like the parser, fails with an error for unknown names */
+   *res = str2eit(name);
+   return true;
+}
+
+static bool pp_conv_pem(char* name, PrimEnumMode *res)
+{
+   *res = STR2PEM(name);
+   return *res != -1;
+}
+
+static bool pp_conv_um(char* name, UnifMode *res)
+{
+   *res = STR2UM(name);
+   return *res != -1;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: preparsed_find()
+//
+//   Return the preparsed record for the strategy name, or NULL if
+//   there is none or if it does not match the text in conf_map.
+//
+// Global Variables: preparsed_confs, preparsed_seeds,
+//                   preparsed_slots, conf_map
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static PreparsedConf_p preparsed_find(const char* name)
+{
+   unsigned long long seed;
+   long               idx;
+   PreparsedConf_p    conf;
+
+   seed = preparsed_seeds[PreparsedHash(name, 0)%PREPARSED_HASH_BUCKETS];
+   idx  = preparsed_slots[PreparsedHash(name, seed)%PREPARSED_HASH_SIZE];
+   if(idx < 0)
+   {
+      return NULL;
+   }
+   conf = &(preparsed_confs[idx]);
+   if(strcmp(conf->key, name)!=0 ||
+      conf->conf_idx >= num_confs ||
+      strcmp(conf_map[conf->conf_idx].key, name)!=0 ||
+      PreparsedHash(conf_map[conf->conf_idx].value, 0) != conf->conf_hash)
+   {
+      /* schedule_parms.vars is older than schedule.vars */
+      return NULL;
+   }
+   return conf;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: preparsed_apply()
+//
+//   Set the parameters of target as parsing the text of conf would
+//   have done. Return false (and leave target unchanged) if a named
+//   value is unknown in this configuration of E.
+//
+// Global Variables: preparsed_field_sets
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool preparsed_apply(PreparsedConf_p conf, HeuristicParms_p target)
+{
+   PreparsedFieldCell *fields = preparsed_field_sets[conf->field_set];
+   HeuristicParmsCell res = *target;
+   int i;
+
+   for(i=0; fields[i].size; i++)
+   {
+      memcpy((char*)&res+fields[i].offset,
+             (char*)&(conf->parms)+fields[i].offset,
+             fields[i].size);
+   }
+   i = 0;
+#define PP_CONVERT(field, conv)                         \
+   if(conf->enums[i] && !conv(conf->enums[i], &(res.field)))    \
+   {                                                    \
+      return false;                                     \
+   }                                                    \
+   i++;
+   PREPARSED_ENUMS(PP_CONVERT)
+#undef PP_CONVERT
+   *target = res;
+   return true;
+}
+
+
+#ifndef NDEBUG
+
+/*-----------------------------------------------------------------------
+//
+// Function: preparsed_check()
+//
+//   Check that the preparsed parms equal the ones parsed from the
+//   text of the strategy.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+#define PP_EQUAL_BOOL(field)  (h1->field == h2->field)
+#define PP_EQUAL_INT(field)   (h1->field == h2->field)
+#define PP_EQUAL_INT02(field) (h1->field == h2->field)
+#define PP_EQUAL_IMAX(field)  (h1->field == h2->field)
+#define PP_EQUAL_STR(field)   pp_str_equal(h1->field, h2->field)
+#define PP_EQUAL_NSTR(field)  pp_str_equal(h1->field, h2->field)
+#define PP_EQUAL_IDENT(field) pp_str_equal(h1->field, h2->field)
+#define PP_EQUAL_ARR(field)   pp_str_equal(h1->field, h2->field)
+
+static bool pp_str_equal(const char* s1, const char* s2)
+{
+   return (s1 == s2) || (s1 && s2 && strcmp(s1, s2)==0);
+}
+
+static void preparsed_check(HeuristicParms_p h1, HeuristicParms_p h2)
+{
+#define PP_CHECK_PARAM(kind, field)     assert(PP_EQUAL_##kind(field));
+#define PP_CHECK_ENUM(field, conv)      assert(h1->field == h2->field);
+   PREPARSED_PARAMS(PP_CHECK_PARAM)
+   PREPARSED_ENUMS(PP_CHECK_ENUM)
+#undef PP_CHECK_PARAM
+#undef PP_CHECK_ENUM
+}
+
+#endif
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
 
 
 /*-----------------------------------------------------------------------
@@ -145,9 +368,12 @@ ScheduleCell* GetSearchSchedule(const char* problem_category)
 //
 // Function: GetHeuristicWithName()
 //
-//   Given a name, find and parse a heuristic into the provided cell.
+//   Given a name, find and parse a heuristic into the provided
+//   cell. Uses the preparsed record if possible (and, without
+//   NDEBUG, checks it against the parsed text).
 //
-// Global Variables: conf_map (from schedule.vars)
+// Global Variables: conf_map (from schedule.vars), preparsed_confs
+//                   (from schedule_parms.vars)
 //
 // Side Effects    : Memory management
 //
@@ -155,6 +381,24 @@ ScheduleCell* GetSearchSchedule(const char* problem_category)
 
 void GetHeuristicWithName(const char* name, HeuristicParms_p target)
 {
+   PreparsedConf_p conf = preparsed_find(name);
+
+#ifndef NDEBUG
+   HeuristicParmsCell orig = *target;
+#endif
+
+   if(conf && preparsed_apply(conf, target))
+   {
+#ifndef NDEBUG
+      Scanner_p in = CreateScanner(StreamTypeInternalString,
+                                   (char*)conf_map[conf->conf_idx].value,
+                                   true, NULL, true);
+      HeuristicParmsParseInto(in, &orig, false);
+      DestroyScanner(in);
+      preparsed_check(&orig, target);
+#endif
+      return;
+   }
    for(int i=0; conf_map[i].key; i++)
    {
       if(!strcmp(name, conf_map[i].key))
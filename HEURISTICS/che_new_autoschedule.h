@@ -22,6 +22,7 @@
 #define CHE_NEW_AUTOSCHEDULE
 
 #include "che_hcb.h"
+#include "che_preparsed.h"
 #include <cco_scheduling.h>
 
 #define DEFAULT_MASK "aaaaa-aaaaaa-aaaaaaaaa"
@@ -38,6 +39,34 @@ typedef struct
   char* value;
 } StrStrPair;
 
+/* A built-in strategy, preparsed at build time (see
+   schedule_parms.vars, created by gen_schedule_parms). parms is only
+   valid for the fields the strategy sets, which are listed in
+   preparsed_field_sets[field_set]. The parameters in PREPARSED_ENUMS
+   are stored by name in enums (NULL if not set). conf_idx and
+   conf_hash identify the text in conf_map the record was created
+   from, so that outdated records are recognized and ignored. */
+
+typedef struct
+{
+   char               *key;
+   long               conf_idx;
+   unsigned long long conf_hash;
+   int                field_set;
+   char               *enums[PREPARSED_ENUM_NO];
+   HeuristicParmsCell parms;
+}PreparsedConfCell, *PreparsedConf_p;
+
+typedef struct
+{
+   size_t offset;
+   size_t size;
+}PreparsedFieldCell;
+
+#define PREPARSED_FIELD(field)                                  \
+   {offsetof(HeuristicParmsCell, field),                        \
+    sizeof(((HeuristicParms_p)NULL)->field)}
+
 typedef struct
 {
   char* key;
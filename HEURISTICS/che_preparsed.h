@@ -0,0 +1,240 @@
+/*-----------------------------------------------------------------------
+
+  File  : che_preparsed.h
+
+  Contents
+
+  Description of the preparsed table of built-in strategies
+  (schedule_parms.vars): The search parameters a strategy text can
+  set, and the hash function for the strategy names.
+
+  This file is shared between che_new_autoschedule.c and the
+  stand-alone generator gen_schedule_parms.c, which is built with the
+  host compiler and knows nothing about the rest of E. It must only
+  contain macros and plain C.
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 23:12:40 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#ifndef CHE_PREPARSED
+
+#define CHE_PREPARSED
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+/* The parameters HeuristicParmsParseInto() (and
+   OrderParmsParseInto() for the order_params) can set, in parse
+   order, with the way they are parsed:
+
+   BOOL  - true or false (ParseBool())
+   INT   - Optional "-" and digits (ParseInt())
+   INT02 - The same, limited to 0..2 (ParseIntLimited())
+   IMAX  - The same (ParseIntMax(), which negates the value)
+   STR   - String in double quotes, without the quotes
+   NSTR  - The same, but the empty string becomes NULL
+   IDENT - Identifier, stored as a string
+   ARR   - Identifier, copied into a char array of
+           PREPARSED_ARR_LEN characters (truncated)
+
+   The record for a strategy contains the values of the parameters it
+   sets, which are copied into the target cell. */
+
+#define PREPARSED_PARAMS(P)                             \
+   P(BOOL,  order_params.rewrite_strong_rhs_inst)       \
+   P(NSTR,  order_params.to_pre_prec)                   \
+   P(INT,   order_params.conj_only_mod)                 \
+   P(INT,   order_params.conj_axiom_mod)                \
+   P(INT,   order_params.axiom_only_mod)                \
+   P(INT,   order_params.skolem_mod)                    \
+   P(INT,   order_params.defpred_mod)                   \
+   P(BOOL,  order_params.force_kbo_var_weight)          \
+   P(NSTR,  order_params.to_pre_weights)                \
+   P(INT,   order_params.to_const_weight)               \
+   P(BOOL,  order_params.to_defs_min)                   \
+   P(INT,   order_params.lit_cmp)                       \
+   P(INT,   order_params.lam_w)                         \
+   P(INT,   order_params.db_w)                          \
+   P(BOOL,  no_preproc)                                 \
+   P(INT,   eqdef_maxclauses)                           \
+   P(INT,   eqdef_incrlimit)                            \
+   P(INT,   formula_def_limit)                          \
+   P(INT,   miniscope_limit)                            \
+   P(STR,   sine)                                       \
+   P(BOOL,  add_goal_defs_pos)                          \
+   P(BOOL,  add_goal_defs_neg)                          \
+   P(BOOL,  add_goal_defs_subterms)                     \
+   P(IDENT, heuristic_name)                             \
+   P(STR,   heuristic_def)                              \
+   P(BOOL,  prefer_initial_clauses)                     \
+   P(INT,   pos_lit_sel_min)                            \
+   P(INT,   pos_lit_sel_max)                            \
+   P(INT,   neg_lit_sel_min)                            \
+   P(INT,   neg_lit_sel_max)                            \
+   P(INT,   all_lit_sel_min)                            \
+   P(INT,   all_lit_sel_max)                            \
+   P(INT,   weight_sel_min)                             \
+   P(BOOL,  select_on_proc_only)                        \
+   P(BOOL,  inherit_paramod_lit)                        \
+   P(BOOL,  inherit_goal_pm_lit)                        \
+   P(BOOL,  inherit_conj_pm_lit)                        \
+   P(BOOL,  enable_eq_factoring)                        \
+   P(BOOL,  enable_neg_unit_paramod)                    \
+   P(BOOL,  enable_given_forward_simpl)                 \
+   P(INT,   ac_handling)                                \
+   P(BOOL,  ac_res_aggressive)                          \
+   P(BOOL,  forward_context_sr)                         \
+   P(BOOL,  forward_context_sr_aggressive)              \
+   P(BOOL,  backward_context_sr)                        \
+   P(BOOL,  forward_subsumption_aggressive)             \
+   P(INT02, forward_demod)                              \
+   P(BOOL,  prefer_general)                             \
+   P(BOOL,  condensing)                                 \
+   P(BOOL,  condensing_aggressive)                      \
+   P(BOOL,  er_varlit_destructive)                      \
+   P(BOOL,  er_strong_destructive)                      \
+   P(BOOL,  er_aggressive)                              \
+   P(INT,   split_clauses)                              \
+   P(INT02, split_method)                               \
+   P(BOOL,  split_aggressive)                           \
+   P(BOOL,  split_fresh_defs)                           \
+   P(INT,   diseq_decomposition)                        \
+   P(INT,   diseq_decomp_maxarity)                      \
+   P(ARR,   rw_bw_index_type)                           \
+   P(ARR,   pm_from_index_type)                         \
+   P(ARR,   pm_into_index_type)                         \
+   P(INT,   sat_check_step_limit)                       \
+   P(INT,   sat_check_size_limit)                       \
+   P(INT,   sat_check_ttinsert_limit)                   \
+   P(BOOL,  sat_check_normconst)                        \
+   P(BOOL,  sat_check_normalize)                        \
+   P(INT,   sat_check_decision_limit)                   \
+   P(BOOL,  sat_check_incremental)                      \
+   P(INT,   filter_orphans_limit)                       \
+   P(INT,   forward_contract_limit)                     \
+   P(INT,   delete_bad_limit)                           \
+   P(IMAX,  mem_limit)                                  \
+   P(BOOL,  watchlist_simplify)                         \
+   P(BOOL,  watchlist_is_static)                        \
+   P(BOOL,  use_tptp_sos)                               \
+   P(BOOL,  presat_interreduction)                      \
+   P(BOOL,  detsort_bw_rw)                              \
+   P(BOOL,  detsort_tmpset)                             \
+   P(INT,   bw_simplify_workers)                        \
+   P(INT,   paramod_workers)                            \
+   P(INT,   lazy_eval_batch)                            \
+   P(BOOL,  pack_unprocessed)                           \
+   P(INT,   term_gc_limit)                              \
+   P(INT,   ord_res_cache_size)                         \
+   P(INT,   ext_rules_max_depth)                        \
+   P(BOOL,  inverse_recognition)                        \
+   P(BOOL,  replace_inj_defs)                           \
+   P(BOOL,  lift_lambdas)                               \
+   P(BOOL,  lambda_to_forall)                           \
+   P(BOOL,  unroll_only_formulas)                       \
+   P(INT,   elim_leibniz_max_depth)                     \
+   P(INT,   prim_enum_max_depth)                        \
+   P(INT,   inst_choice_max_depth)                      \
+   P(BOOL,  local_rw)                                   \
+   P(BOOL,  prune_args)                                 \
+   P(BOOL,  preinstantiate_induction)                   \
+   P(BOOL,  fool_unroll)                                \
+   P(INT,   func_proj_limit)                            \
+   P(INT,   imit_limit)                                 \
+   P(INT,   ident_limit)                                \
+   P(INT,   elim_limit)                                 \
+   P(BOOL,  pattern_oracle)                             \
+   P(BOOL,  fixpoint_oracle)                            \
+   P(INT,   max_unifiers)                               \
+   P(INT,   max_unif_steps)
+
+/* Parameters given by name (identifier, or string with the quotes)
+   and translated by E (converter, see che_new_autoschedule.c). Their
+   values depend on the configuration, so the records store the names
+   and the translation is done when a record is used. */
+
+#define PREPARSED_ENUMS(E)                              \
+   E(order_params.ordertype,     pp_conv_ordertype)     \
+   E(order_params.to_weight_gen, pp_conv_weight_gen)    \
+   E(order_params.to_prec_gen,   pp_conv_prec_gen)      \
+   E(order_params.ho_order_kind, pp_conv_hok)           \
+   E(selection_strategy,         pp_conv_selection)     \
+   E(pm_type,                    pp_conv_pm_type)       \
+   E(sat_check_grounding,        pp_conv_grounding)     \
+   E(arg_cong,                   pp_conv_eit)           \
+   E(neg_ext,                    pp_conv_eit)           \
+   E(pos_ext,                    pp_conv_eit)           \
+   E(prim_enum_mode,             pp_conv_pem)           \
+   E(unif_mode,                  pp_conv_um)
+
+#define PREPARSED_COUNT_P(kind, field) +1
+#define PREPARSED_COUNT_E(field, conv) +1
+
+#define PREPARSED_PARAM_NO (0 PREPARSED_PARAMS(PREPARSED_COUNT_P))
+#define PREPARSED_ENUM_NO  (0 PREPARSED_ENUMS(PREPARSED_COUNT_E))
+
+/* Size of the ARR parameters (MAX_PM_INDEX_NAME_LEN) */
+#define PREPARSED_ARR_LEN 20
+
+/* Number of keys per bucket for the perfect hash over the strategy
+   names, and how hard to try to find a displacement for a bucket. */
+#define PREPARSED_BUCKET_LOAD 4
+#define PREPARSED_MAX_SEED    (1<<24)
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+static inline unsigned long long PreparsedHash(const char* str,
+                                               unsigned long long seed);
+
+
+/*---------------------------------------------------------------------*/
+/*                     Inline Functions                                */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: PreparsedHash()
+//
+//   Seeded hash function (FNV-1a with a final mix) for strategy names
+//   and texts.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline unsigned long long PreparsedHash(const char* str,
+                                               unsigned long long seed)
+{
+   unsigned long long res = 14695981039346656037ULL^(seed*0x9e3779b97f4a7c15ULL);
+
+   for(; *str; str++)
+   {
+      res ^= (unsigned char)*str;
+      res *= 1099511628211ULL;
+   }
+   res ^= res >> 33;
+   res *= 0xff51afd7ed558ccdULL;
+   res ^= res >> 33;
+   return res;
+}
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -75,6 +75,7 @@ char* PrioFunNames[]=
    "DeferFormulas",
    "PreferEasyHO",
    "PreferFO",
+   "ByWatchlistProgress",
    NULL
 };
 
@@ -123,6 +124,7 @@ static ClausePrioFun prio_fun_array[]=
    PrioFunDeferFormulas,
    PrioFunPreferEasyHO,
    PrioFunPreferFO,
+   PrioFunByWatchlistProgress,
    NULL
 };
 
@@ -988,6 +990,31 @@ EvalPriority PrioFunDeferWatchlist(Clause_p clause)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: PrioFunByWatchlistProgress()
+//
+//   Prefer clauses that have subsumed a watchlist clause, and among
+//   those the ones that have advanced their proof the most.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+EvalPriority PrioFunByWatchlistProgress(Clause_p clause)
+{
+   assert(clause);
+
+   if(ClauseQueryProp(clause, CPSubsumesWatch))
+   {
+      return PrioPrefer - clause->watch_progress/10;
+   }
+   return PrioNormal;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: PrioFunByPosLitNo()
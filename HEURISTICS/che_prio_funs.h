@@ -76,6 +76,7 @@ EvalPriority PrioFunByPosLitNo(Clause_p clause);
 EvalPriority PrioFunByHornDist(Clause_p clause);
 EvalPriority PrioFunPreferWatchlist(Clause_p clause);
 EvalPriority PrioFunDeferWatchlist(Clause_p clause);
+EvalPriority PrioFunByWatchlistProgress(Clause_p clause);
 
 
 EvalPriority PrioFunByAppVarNum(Clause_p clause);
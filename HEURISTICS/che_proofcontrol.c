@@ -156,11 +156,16 @@ static bool select_inherited_literal(Clause_p clause)
 void sat_solver_init(ProofControl_p ctrl)
 {
    ctrl->solver = picosat_init();
+   if(!ctrl->heuristic_parms.sat_check_incremental)
+   {
+      /* The incremental mode gets its cores from failed assumptions
+         and does not need the (growing) trace. */
 #ifndef NDEBUG
-   int status =
+      int status =
 #endif
-   picosat_enable_trace_generation(ctrl->solver);
-   assert(status);
+      picosat_enable_trace_generation(ctrl->solver);
+      assert(status);
+   }
 }
 
 
@@ -191,6 +196,9 @@ ProofControl_p ProofControlAlloc(void)
    HeuristicParmsInitialize(&handle->heuristic_parms);
 
    sat_solver_init(handle);
+   handle->sat_state                     = NULL;
+   handle->bw_workers                    = NULL;
+   handle->pm_workers                    = NULL;
 
    return handle;
 }
@@ -219,10 +227,22 @@ void ProofControlFree(ProofControl_p junk)
    HCBAdminFree(junk->hcbs);
    /* hcb is always freed in junk->hcbs */
 
+   if(junk->sat_state)
+   {
+      SatIncStateFree(junk->sat_state);
+   }
    if(junk->solver)
    {
       picosat_reset(junk->solver);
    }
+   if(junk->bw_workers)
+   {
+      WorkPoolFree(junk->bw_workers);
+   }
+   if(junk->pm_workers)
+   {
+      WorkPoolFree(junk->pm_workers);
+   }
    ProofControlCellFree(junk);
 }
 
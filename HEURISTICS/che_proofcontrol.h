@@ -49,6 +49,12 @@ typedef struct proofcontrolcell
    SpecFeatureCell     problem_specs;
    /* Sat solver object. */
    SatSolver_p         solver;
+   /* ...and what it knows in incremental mode (lazily created) */
+   SatIncState_p       sat_state;
+   /* Worker threads for backward simplification (or NULL) */
+   WorkPool_p          bw_workers;
+   /* Worker threads for finding paramodulation partners (or NULL) */
+   WorkPool_p          pm_workers;
 }ProofControlCell, *ProofControl_p;
 
 #define HCBARGUMENTS ProofState_p state, ProofControl_p control, \
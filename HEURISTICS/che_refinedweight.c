@@ -38,6 +38,47 @@ Changes
 /*                         Internal Functions                          */
 /*---------------------------------------------------------------------*/
 
+/*-----------------------------------------------------------------------
+//
+// Function: refined_weight_batch()
+//
+//   Compute refined weights of count clauses, with or without
+//   counting the equational encoding.
+//
+// Global Variables: -
+//
+// Side Effects    : Marks maximal terms
+//
+/----------------------------------------------------------------------*/
+
+static void refined_weight_batch(RefinedWeightParam_p local,
+                                 Clause_p *clauses, long count,
+                                 double *evals, bool count_eq_encoding)
+{
+   OCB_p  ocb                    = local->ocb;
+   double max_term_multiplier    = local->max_term_multiplier;
+   double max_literal_multiplier = local->max_literal_multiplier;
+   double pos_multiplier         = local->pos_multiplier;
+   double app_var_mult           = local->app_var_mult;
+   long   vweight                = local->vweight;
+   long   fweight                = local->fweight;
+   long   i;
+
+   for(i=0; i<count; i++)
+   {
+      ClauseCondMarkMaximalTerms(ocb, clauses[i]);
+      evals[i] = ClauseWeight(clauses[i],
+                              max_term_multiplier,
+                              max_literal_multiplier,
+                              pos_multiplier,
+                              vweight,
+                              fweight,
+                              app_var_mult,
+                              count_eq_encoding);
+   }
+}
+
+
 
 /*---------------------------------------------------------------------*/
 /*                         Exported Functions                          */
@@ -72,8 +113,11 @@ WFCB_p ClauseRefinedWeightInit(ClausePrioFun prio_fun, int fweight,
    data->ocb                    = ocb;
    data->app_var_mult           = app_var_mult;
 
-   return WFCBAlloc(ClauseRefinedWeightCompute, prio_fun,
-          ClauseRefinedWeightExit, data);
+   WFCB_p res = WFCBAlloc(ClauseRefinedWeightCompute, prio_fun,
+                          ClauseRefinedWeightExit, data);
+   WFCBSetBatchEval(res, ClauseRefinedWeightBatchCompute);
+
+   return res;
 }
 
 
@@ -151,6 +195,25 @@ double ClauseRefinedWeightCompute(void* data, Clause_p clause)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseRefinedWeightBatchCompute()
+//
+//   Compute evaluations for count clauses.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+void ClauseRefinedWeightBatchCompute(void* data, Clause_p *clauses,
+                                     long count, double *evals)
+{
+   refined_weight_batch(data, clauses, count, evals, false);
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: ClauseRefinedWeight2Parse()
@@ -170,6 +233,7 @@ WFCB_p ClauseRefinedWeight2Parse(Scanner_p in, OCB_p ocb, ProofState_p
 
    tmp = ClauseRefinedWeightParse(in, ocb, state);
    tmp->wfcb_eval = ClauseRefinedWeight2Compute;
+   WFCBSetBatchEval(tmp, ClauseRefinedWeight2BatchCompute);
 
    return tmp;
 }
@@ -202,6 +266,25 @@ double ClauseRefinedWeight2Compute(void* data, Clause_p clause)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseRefinedWeight2BatchCompute()
+//
+//   Compute evaluations for count clauses.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+void ClauseRefinedWeight2BatchCompute(void* data, Clause_p *clauses,
+                                      long count, double *evals)
+{
+   refined_weight_batch(data, clauses, count, evals, true);
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: ClauseRefinedWeightExit()
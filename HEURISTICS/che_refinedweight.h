@@ -66,11 +66,15 @@ WFCB_p ClauseRefinedWeightParse(Scanner_p in, OCB_p ocb, ProofState_p
             state);
 
 double ClauseRefinedWeightCompute(void* data, Clause_p clause);
+void   ClauseRefinedWeightBatchCompute(void* data, Clause_p *clauses,
+                                       long count, double *evals);
 
 WFCB_p ClauseRefinedWeight2Parse(Scanner_p in, OCB_p ocb, ProofState_p
             state);
 
 double ClauseRefinedWeight2Compute(void* data, Clause_p clause);
+void   ClauseRefinedWeight2BatchCompute(void* data, Clause_p *clauses,
+                                        long count, double *evals);
 
 void   ClauseRefinedWeightExit(void* data);
 
@@ -446,30 +446,17 @@ void TBIncSubtermsFreqs(Term_p term, NumTree_p* freqs)
 
 NumTree_p TBCountTermFreqs(TB_p bank)
 {
-   PStack_p stack = PStackAlloc();
    Term_p term;
-   int i;
+   long pos = 0;
    NumTree_p freqs = NULL;
 
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
-   {      
-      PStackPushP(stack, bank->term_store.store[i]);
-      while(!PStackEmpty(stack))
+   while((term = TermCellStoreTraverseNext(&(bank->term_store), &pos)))
+   {
+      if(TermCellQueryProp(term,TPTopPos))
       {
-         term = PStackPopP(stack);
-         if ((!term) || (!TermCellQueryProp(term,TPTopPos)))
-         {
-            continue;
-         }
          TBIncSubtermsFreqs(term, &freqs);
-         if(term)
-         {
-            PStackPushP(stack, term->lson);
-            PStackPushP(stack, term->rson);
-         }
       }
    }
-   PStackFree(stack);
 
    return freqs;
 }
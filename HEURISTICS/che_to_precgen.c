@@ -88,7 +88,7 @@ void print_prec_array(FILE* out, Sig_p sig, FCodeFeatureArray_p array)
 static void compute_precedence_from_array(OCB_p ocb, FCodeFeatureArray_p
                                           array)
 {
-   FunCode i, last;
+   FunCode i, last, *order;
 
    assert(ocb->sig_size == array->size-1);
    if(ocb->prec_weights)
@@ -107,12 +107,26 @@ static void compute_precedence_from_array(OCB_p ocb, FCodeFeatureArray_p
    }
    else
    {
-      last = SIG_TRUE_CODE;
-      for(i = SIG_TRUE_CODE+1; i<=ocb->sig_size; i++)
+      /* Extend the user-defined precedence, following the generated
+         order where it is compatible. If this does not give a total
+         precedence (the user precedence conflicts with the generated
+         one), the remaining partial precedence is kept. */
+      order = SizeMalloc(sizeof(FunCode)*ocb->sig_size);
+      for(i = SIG_TRUE_CODE; i<=ocb->sig_size; i++)
+      {
+         order[i-SIG_TRUE_CODE] = array->array[i].symbol;
+      }
+      if(!OCBPrecedenceLinearize(ocb, order, ocb->sig_size))
       {
-         OCBPrecedenceAddTuple(ocb, last, array->array[i].symbol, to_lesser);
-         last = array->array[i].symbol;
+         last = SIG_TRUE_CODE;
+         for(i = SIG_TRUE_CODE+1; i<=ocb->sig_size; i++)
+         {
+            OCBPrecedenceAddTuple(ocb, last, array->array[i].symbol,
+                                  to_lesser);
+            last = array->array[i].symbol;
+         }
       }
+      SizeFree(order, sizeof(FunCode)*ocb->sig_size);
    }
 #ifdef PRINT_PRECEDENCE
    print_prec_array(GlobalOut, ocb->sig, array);
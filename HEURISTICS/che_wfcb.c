@@ -60,6 +60,7 @@ WFCB_p WFCBAlloc(ClauseEvalFun wfcb_eval, ClausePrioFun prio_fun,
    WFCB_p handle = WFCBCellAlloc();
 
    handle->wfcb_eval = wfcb_eval;
+   handle->wfcb_batch_eval = NULL;
    handle->wfcb_priority = prio_fun;
    handle->wfcb_exit = wfcb_exit;
    handle->data = data;
@@ -117,6 +118,55 @@ void ClauseAddEvaluation(WFCB_p wfcb, Clause_p clause, int pos, bool empty)
    }
 }
 
+
+/*-----------------------------------------------------------------------
+//
+// Function: ClauseBatchAddEvaluation()
+//
+//   Add the evaluation by wfcb at position pos to all count clauses
+//   in clauses (which already have their evaluation cells). Uses the
+//   batch function of wfcb if there is one. evals is scratch space
+//   for count values.
+//
+// Global Variables: -
+//
+// Side Effects    : Adds evaluations, by calling the wfcb functions
+//
+/----------------------------------------------------------------------*/
+
+void ClauseBatchAddEvaluation(WFCB_p wfcb, Clause_p *clauses, long count,
+                              int pos, double *evals)
+{
+   long i;
+   Clause_p clause;
+
+   if(wfcb->wfcb_batch_eval)
+   {
+      wfcb->wfcb_batch_eval(wfcb->data, clauses, count, evals);
+   }
+   else
+   {
+      for(i=0; i<count; i++)
+      {
+         evals[i] = wfcb->wfcb_eval(wfcb->data, clauses[i]);
+      }
+   }
+   for(i=0; i<count; i++)
+   {
+      clause = clauses[i];
+      assert(clause->evaluations);
+      clause->evaluations->evals[pos].heuristic = evals[i];
+      if(ClauseIsSemFalse(clause))
+      {
+         clause->evaluations->evals[pos].priority = PrioBest;
+      }
+      else
+      {
+         clause->evaluations->evals[pos].priority = wfcb->wfcb_priority(clause);
+      }
+   }
+}
+
 /*---------------------------------------------------------------------*/
 /*                        End of File                                  */
 /*---------------------------------------------------------------------*/
@@ -32,6 +32,14 @@
   Given a clause and a data block, return an evaluation for the
   clause.
 
+  void <eval>BatchCompute(void *data, Clause_p *clauses, long count,
+                          double *evals)
+
+  Optional. Store the evaluations of clauses[0..count-1] in
+  evals[0..count-1]. The results have to be the same as for
+  <eval>Compute(), but per-batch setup can be shared. Installed with
+  WFCBSetBatchEval().
+
   void <Eval>Exit(void* data)
 
   This function is responsible for freeing data, before the WFCB is
@@ -67,10 +75,14 @@
 
 typedef double (*ClauseEvalFun)(void* data, Clause_p
                                 clause);
+typedef void   (*ClauseBatchEvalFun)(void* data, Clause_p *clauses,
+                                     long count, double *evals);
 
 typedef struct wfcb_cell
 {
    ClauseEvalFun     wfcb_eval;     /* Compute a clauses evaluation */
+   ClauseBatchEvalFun wfcb_batch_eval; /* Evaluate many clauses at
+                                          once, may be NULL */
    GenericExitFun    wfcb_exit;     /* Clean up - in particular, free
                                        data */
    ClausePrioFun     wfcb_priority; /* Compute the priority */
@@ -93,8 +105,11 @@ typedef WFCB_p (*WeightFunParseFun)(Scanner_p in, OCB_p ocb,
 WFCB_p WFCBAlloc(ClauseEvalFun wfcb_eval, ClausePrioFun prio_fun,
                  GenericExitFun wfcb_exit, void* data);
 void   WFCBFree(WFCB_p junk);
+#define WFCBSetBatchEval(wfcb, fun) ((wfcb)->wfcb_batch_eval = (fun))
 
 void   ClauseAddEvaluation(WFCB_p wfcb, Clause_p clause, int pos, bool empty);
+void   ClauseBatchAddEvaluation(WFCB_p wfcb, Clause_p *clauses, long count,
+                                int pos, double *evals);
 
 #endif
 
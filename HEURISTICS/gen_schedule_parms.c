@@ -0,0 +1,1182 @@
+/*-----------------------------------------------------------------------
+
+  File  : gen_schedule_parms.c
+
+  Contents
+
+  Stand-alone generator for the preparsed table of built-in
+  strategies (schedule_parms.vars) from the strategy texts in
+  schedule.vars. Usage:
+
+    gen_schedule_parms schedule.vars > schedule_parms.vars
+
+  This program is run during the build and compiled with the host
+  compiler, so it does not use any other part of E. It reads the
+  strategy texts the way HeuristicParmsParseInto() does, for the
+  parameters listed in che_preparsed.h. Values are written as C
+  initializers, named values (enumerations, literal selection) as
+  strings that che_new_autoschedule.c translates when it uses a
+  record. Strategies that cannot be read are left out with a
+  warning (E parses them at run time). A parameter not listed in
+  che_preparsed.h is an error.
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 23:31:05 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdbool.h>
+#include <errno.h>
+#include "che_preparsed.h"
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+typedef enum
+{
+   KBOOL,
+   KINT,
+   KINT02,
+   KIMAX,
+   KSTR,
+   KNSTR,
+   KIDENT,
+   KARR,
+   KENUM
+}ParamKind;
+
+typedef struct
+{
+   const char *field;  /* As in che_preparsed.h */
+   const char *name;   /* Name in the strategy text */
+   bool       order;   /* Parsed by OrderParmsParseInto() */
+   ParamKind  kind;
+}ParamDescCell, *ParamDesc_p;
+
+typedef enum
+{
+   TNone,
+   TIdent,
+   TInt,
+   TString,
+   TSQString,
+   TChar
+}TokType;
+
+typedef struct
+{
+   const char *pos;    /* Rest of the text */
+   TokType    type;
+   const char *start;  /* Current token */
+   long       len;
+}ScanCell, *Scan_p;
+
+typedef struct
+{
+   char *key;
+   char *value;
+}ConfCell, *Conf_p;
+
+/* Values of one strategy, as C source. NULL if not set. */
+
+typedef struct
+{
+   long idx;
+   char *values[PREPARSED_PARAM_NO+PREPARSED_ENUM_NO];
+   int  field_set;
+}RecordCell, *Record_p;
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+#define GEN_PARAM(kind, field) {#field, NULL, false, K##kind},
+#define GEN_ENUM(field, conv)  {#field, NULL, false, KENUM},
+
+static ParamDescCell params[] =
+{
+   PREPARSED_PARAMS(GEN_PARAM)
+   PREPARSED_ENUMS(GEN_ENUM)
+};
+
+#define PARAM_NO (PREPARSED_PARAM_NO+PREPARSED_ENUM_NO)
+
+#define MIN(x, y) ((x)<(y)?(x):(y))
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: fail()
+//
+//   Print an error message and terminate.
+//
+// Global Variables: -
+//
+// Side Effects    : Terminates the program
+//
+/----------------------------------------------------------------------*/
+
+static void fail(const char* msg, const char* arg)
+{
+   fprintf(stderr, "gen_schedule_parms: %s%s\n", msg, arg?arg:"");
+   exit(EXIT_FAILURE);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: secure_malloc()
+//
+//   malloc() that terminates if no memory is available.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void* secure_malloc(size_t size)
+{
+   void* res = malloc(size?size:1);
+
+   if(!res)
+   {
+      fail("Out of memory", NULL);
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: str_ncopy()
+//
+//   Return a malloc()ed copy of the first len characters of str.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static char* str_ncopy(const char* str, long len)
+{
+   char* res = secure_malloc(len+1);
+
+   memcpy(res, str, len);
+   res[len] = '\0';
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: init_params()
+//
+//   Set the names of the parameters in params.
+//
+// Global Variables: params
+//
+// Side Effects    : Changes params
+//
+/----------------------------------------------------------------------*/
+
+static void init_params(void)
+{
+   const char *dot;
+   int i;
+
+   for(i=0; i<PARAM_NO; i++)
+   {
+      dot = strrchr(params[i].field, '.');
+      params[i].name  = dot?dot+1:params[i].field;
+      params[i].order = (strncmp(params[i].field, "order_params.",
+                                 strlen("order_params."))==0);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: read_file()
+//
+//   Read the file name into a 0-terminated, malloc()ed string.
+//
+// Global Variables: -
+//
+// Side Effects    : Input, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static char* read_file(const char* name)
+{
+   FILE   *in = fopen(name, "r");
+   char   *res;
+   size_t size = 0, cap = 65536, n;
+
+   if(!in)
+   {
+      fail("Cannot open ", name);
+   }
+   res = secure_malloc(cap);
+   while((n = fread(res+size, 1, cap-size-1, in)) > 0)
+   {
+      size += n;
+      if(size+1 == cap)
+      {
+         cap = cap*2;
+         res = realloc(res, cap);
+         if(!res)
+         {
+            fail("Out of memory", NULL);
+         }
+      }
+   }
+   if(ferror(in))
+   {
+      fail("Cannot read ", name);
+   }
+   fclose(in);
+   res[size] = '\0';
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: skip_c_space()
+//
+//   Skip white space and comments in C source.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static const char* skip_c_space(const char* pos)
+{
+   while(true)
+   {
+      if(isspace((unsigned char)*pos))
+      {
+         pos++;
+      }
+      else if(pos[0]=='/' && pos[1]=='/')
+      {
+         while(*pos && *pos!='\n')
+         {
+            pos++;
+         }
+      }
+      else if(pos[0]=='/' && pos[1]=='*')
+      {
+         pos = strstr(pos+2, "*/");
+         if(!pos)
+         {
+            fail("Unterminated comment in schedule.vars", NULL);
+         }
+         pos += 2;
+      }
+      else
+      {
+         return pos;
+      }
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: parse_c_string()
+//
+//   Parse a C string literal (or a sequence of them) starting at
+//   *pos and return its value as a malloc()ed string. *pos is moved
+//   behind it.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static char* parse_c_string(const char** pos)
+{
+   const char *p = skip_c_space(*pos);
+   size_t     len = 0, cap = 256;
+   char       *res = secure_malloc(cap);
+   int        c, i;
+
+   if(*p != '"')
+   {
+      fail("String literal expected in schedule.vars", NULL);
+   }
+   while(*p == '"')
+   {
+      p++;
+      while(*p != '"')
+      {
+         if(!*p || *p=='\n')
+         {
+            fail("Unterminated string literal in schedule.vars", NULL);
+         }
+         c = *p++;
+         if(c == '\\')
+         {
+            c = *p++;
+            switch(c)
+            {
+            case 'n':
+                  c = '\n';
+                  break;
+            case 't':
+                  c = '\t';
+                  break;
+            case 'r':
+                  c = '\r';
+                  break;
+            case '\\':
+            case '"':
+            case '\'':
+            case '?':
+                  break;
+            default:
+                  if(c >= '0' && c <= '7')
+                  {
+                     c = c-'0';
+                     for(i=0; i<2 && *p>='0' && *p<='7'; i++)
+                     {
+                        c = 8*c+(*p++-'0');
+                     }
+                  }
+                  else
+                  {
+                     fail("Unsupported escape sequence in schedule.vars",
+                          NULL);
+                  }
+                  break;
+            }
+         }
+         if(len+1 == cap)
+         {
+            cap = cap*2;
+            res = realloc(res, cap);
+            if(!res)
+            {
+               fail("Out of memory", NULL);
+            }
+         }
+         res[len++] = c;
+      }
+      p = skip_c_space(p+1);
+   }
+   res[len] = '\0';
+   *pos = p;
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: expect_c_char()
+//
+//   Skip space and the character c, which has to be there.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static const char* expect_c_char(const char* pos, char c)
+{
+   char msg[] = "' ' expected in schedule.vars";
+
+   pos = skip_c_space(pos);
+   if(*pos != c)
+   {
+      msg[1] = c;
+      fail(msg, NULL);
+   }
+   return pos+1;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: read_confs()
+//
+//   Find the initializer of conf_map in the source text and return
+//   its entries (up to the {NULL, NULL} terminator) in a malloc()ed
+//   array. *n receives the number of entries.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static Conf_p read_confs(const char* text, long *n)
+{
+   const char *pos = strstr(text, "conf_map[]");
+   long       cap = 512;
+   Conf_p     res = secure_malloc(cap*sizeof(ConfCell));
+
+   if(!pos)
+   {
+      fail("No conf_map in schedule.vars", NULL);
+   }
+   pos = expect_c_char(pos+strlen("conf_map[]"), '=');
+   pos = expect_c_char(pos, '{');
+   *n = 0;
+   while(true)
+   {
+      pos = expect_c_char(pos, '{');
+      pos = skip_c_space(pos);
+      if(strncmp(pos, "NULL", 4)==0)
+      {
+         break;
+      }
+      if(*n == cap)
+      {
+         cap = cap*2;
+         res = realloc(res, cap*sizeof(ConfCell));
+         if(!res)
+         {
+            fail("Out of memory", NULL);
+         }
+      }
+      res[*n].key = parse_c_string(&pos);
+      pos = expect_c_char(pos, ',');
+      res[*n].value = parse_c_string(&pos);
+      pos = expect_c_char(pos, '}');
+      pos = expect_c_char(pos, ',');
+      (*n)++;
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: next_token()
+//
+//   Scan the next token of a strategy text, as E's scanner
+//   (cio_scanner.c) does. Return its type.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes scan
+//
+/----------------------------------------------------------------------*/
+
+static TokType next_token(Scan_p scan)
+{
+   const char *p = scan->pos;
+   bool       escape = false;
+   char       delim;
+
+   while(true)
+   {
+      if(isspace((unsigned char)*p))
+      {
+         p++;
+      }
+      else if(*p=='#' || *p=='%')
+      {
+         while(*p && *p!='\n')
+         {
+            p++;
+         }
+      }
+      else if(p[0]=='/' && p[1]=='*')
+      {
+         const char *end = strstr(p+2, "*/");
+
+         p = end?end+2:p+strlen(p);
+      }
+      else
+      {
+         break;
+      }
+   }
+   scan->start = p;
+   if(!*p)
+   {
+      scan->type = TNone;
+   }
+   else if(isalpha((unsigned char)*p) || *p=='_')
+   {
+      while(isalnum((unsigned char)*p) || *p=='_')
+      {
+         p++;
+      }
+      scan->type = TIdent;
+   }
+   else if(isdigit((unsigned char)*p))
+   {
+      while(isdigit((unsigned char)*p))
+      {
+         p++;
+      }
+      scan->type = TInt;
+   }
+   else if(*p=='"' || *p=='\'')
+   {
+      delim = *p++;
+      while(*p && (escape || *p!=delim))
+      {
+         escape = (*p=='\\')?!escape:false;
+         p++;
+      }
+      if(!*p)
+      {
+         scan->type = TNone;
+         scan->pos  = p;
+         scan->len  = 0;
+         return TNone;
+      }
+      p++;
+      scan->type = (delim=='"')?TString:TSQString;
+   }
+   else
+   {
+      p++;
+      scan->type = TChar;
+   }
+   scan->len = p-scan->start;
+   scan->pos = p;
+   return scan->type;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: test_char()
+//
+//   Return true if the current token is the single character c.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool test_char(Scan_p scan, char c)
+{
+   return scan->type==TChar && scan->start[0]==c;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: c_literal()
+//
+//   Return a malloc()ed C string literal with the len characters at
+//   str.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static char* c_literal(const char* str, long len)
+{
+   char *res = secure_malloc(4*len+3), *p = res;
+   long i;
+
+   *p++ = '"';
+   for(i=0; i<len; i++)
+   {
+      unsigned char c = str[i];
+
+      if(c=='\\' || c=='"')
+      {
+         *p++ = '\\';
+         *p++ = c;
+      }
+      else if(c=='\n')
+      {
+         *p++ = '\\';
+         *p++ = 'n';
+      }
+      else if(isprint(c))
+      {
+         *p++ = c;
+      }
+      else
+      {
+         p += sprintf(p, "\\%03o", c);
+      }
+   }
+   *p++ = '"';
+   *p   = '\0';
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: parse_value()
+//
+//   Parse the value of a parameter of the given kind at the current
+//   token and return it as a malloc()ed C initializer. Return NULL
+//   if the value is malformed (E would reject it).
+//
+// Global Variables: -
+//
+// Side Effects    : Changes scan, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static char* parse_value(Scan_p scan, ParamKind kind)
+{
+   char               *res = NULL, *digits;
+   bool               neg = false;
+   unsigned long long val;
+
+   switch(kind)
+   {
+   case KBOOL:
+         if(scan->type==TIdent &&
+            ((scan->len==4 && strncmp(scan->start, "true", 4)==0)||
+             (scan->len==5 && strncmp(scan->start, "false", 5)==0)))
+         {
+            res = str_ncopy(scan->start, scan->len);
+         }
+         break;
+   case KINT:
+   case KINT02:
+   case KIMAX:
+         /* No space between the sign and the digits */
+         if(test_char(scan, '-') && isdigit((unsigned char)*scan->pos))
+         {
+            neg = true;
+            next_token(scan);
+         }
+         if(scan->type != TInt)
+         {
+            break;
+         }
+         digits = str_ncopy(scan->start, scan->len);
+         errno = 0;
+         val = strtoull(digits, NULL, 10);
+         if(errno || val > 9223372036854775808ULL ||
+            (val == 9223372036854775808ULL && (!neg || kind == KIMAX)))
+         {
+            /* Does not fit into a (64 bit) long or intmax_t */
+         }
+         else if(kind == KINT02 && (val > 2 || (neg && val)))
+         {
+            /* ParseIntLimited() rejects it */
+         }
+         else if(kind == KIMAX)
+         {
+            /* ParseIntMax() negates positive values as well */
+            res = secure_malloc(strlen(digits)+16);
+            sprintf(res, "-INTMAX_C(%s)", digits);
+         }
+         else if(neg && val == 9223372036854775808ULL)
+         {
+            res = str_ncopy("LONG_MIN", 8);
+         }
+         else
+         {
+            res = secure_malloc(strlen(digits)+2);
+            sprintf(res, "%s%s", (neg && val)?"-":"", digits);
+         }
+         free(digits);
+         break;
+   case KSTR:
+   case KNSTR:
+         if(scan->type == TString)
+         {
+            if(kind == KNSTR && scan->len == 2)
+            {
+               res = str_ncopy("NULL", 4);
+            }
+            else
+            {
+               res = c_literal(scan->start+1, scan->len-2);
+            }
+         }
+         break;
+   case KIDENT:
+         if(scan->type == TIdent)
+         {
+            res = c_literal(scan->start, scan->len);
+         }
+         break;
+   case KARR:
+         if(scan->type == TIdent)
+         {
+            res = c_literal(scan->start,
+                            MIN(scan->len, PREPARSED_ARR_LEN-1));
+         }
+         break;
+   case KENUM:
+         /* Passed to the converter as E's scanner has read it */
+         if(scan->type == TIdent || scan->type == TString)
+         {
+            res = c_literal(scan->start, scan->len);
+         }
+         break;
+   default:
+         break;
+   }
+   if(res)
+   {
+      next_token(scan);
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: find_param()
+//
+//   Return the index of the parameter with the name at the current
+//   token, or -1. order selects the parameters inside the order
+//   parameter block.
+//
+// Global Variables: params
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static int find_param(Scan_p scan, bool order)
+{
+   int i;
+
+   for(i=0; i<PARAM_NO; i++)
+   {
+      if(params[i].order == order &&
+         (long)strlen(params[i].name) == scan->len &&
+         strncmp(params[i].name, scan->start, scan->len)==0)
+      {
+         return i;
+      }
+   }
+   return -1;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: parse_block()
+//
+//   Parse a sequence of "name: value" pairs into rec, up to (not
+//   including) the closing curly brace. Return false if the input is
+//   malformed. Unknown parameters are fatal.
+//
+// Global Variables: params
+//
+// Side Effects    : Changes scan and rec, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static bool parse_block(Scan_p scan, Record_p rec, bool order,
+                        const char* key)
+{
+   int  i;
+   char *name;
+
+   while(scan->type == TIdent)
+   {
+      i = find_param(scan, order);
+      if(i < 0)
+      {
+         name = str_ncopy(scan->start, scan->len);
+         fprintf(stderr, "gen_schedule_parms: Strategy %s sets %s, "
+                 "which is not listed in che_preparsed.h\n", key, name);
+         exit(EXIT_FAILURE);
+      }
+      if(rec->values[i])
+      {
+         return false;
+      }
+      next_token(scan);
+      if(!test_char(scan, ':'))
+      {
+         return false;
+      }
+      next_token(scan);
+      rec->values[i] = parse_value(scan, params[i].kind);
+      if(!rec->values[i])
+      {
+         return false;
+      }
+   }
+   return test_char(scan, '}');
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: parse_conf()
+//
+//   Parse the text of a strategy into rec. Return false if it is
+//   malformed.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes rec, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static bool parse_conf(Conf_p conf, Record_p rec)
+{
+   ScanCell scan;
+
+   scan.pos = conf->value;
+   next_token(&scan);
+   if(!test_char(&scan, '{'))
+   {
+      return false;
+   }
+   next_token(&scan);
+   if(test_char(&scan, '{'))
+   {
+      next_token(&scan);
+      if(!parse_block(&scan, rec, true, conf->key))
+      {
+         return false;
+      }
+      next_token(&scan);
+   }
+   return parse_block(&scan, rec, false, conf->key);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: build_hash()
+//
+//   Build a perfect hash (hash and displace) for the n keys: Keys
+//   are distributed to buckets by PreparsedHash(key, 0), then,
+//   largest bucket first, a seed is searched that maps all keys of
+//   the bucket to distinct free slots. Return false if no seed is
+//   found.
+//
+// Global Variables: -
+//
+// Side Effects    : Fills seeds and slots
+//
+/----------------------------------------------------------------------*/
+
+static bool build_hash(char **keys, long n,
+                       unsigned long long *seeds, long buckets,
+                       long *slots, long size)
+{
+   long *bucket = secure_malloc(n*sizeof(long));
+   long *count  = secure_malloc(buckets*sizeof(long));
+   long *order  = secure_malloc(buckets*sizeof(long));
+   long *members = secure_malloc(n*sizeof(long));
+   long *hashes  = secure_malloc(n*sizeof(long));
+   long i, j, b, m, k, tmp;
+   unsigned long long seed;
+   bool res = true, ok;
+
+   for(b=0; b<buckets; b++)
+   {
+      count[b] = 0;
+      order[b] = b;
+      seeds[b] = 0;
+   }
+   for(i=0; i<size; i++)
+   {
+      slots[i] = -1;
+   }
+   for(i=0; i<n; i++)
+   {
+      bucket[i] = PreparsedHash(keys[i], 0)%buckets;
+      count[bucket[i]]++;
+   }
+   /* Sort buckets by decreasing size (insertion sort is enough) */
+   for(i=1; i<buckets; i++)
+   {
+      tmp = order[i];
+      for(j=i; j>0 && count[order[j-1]] < count[tmp]; j--)
+      {
+         order[j] = order[j-1];
+      }
+      order[j] = tmp;
+   }
+   for(i=0; res && i<buckets; i++)
+   {
+      b = order[i];
+      if(!count[b])
+      {
+         break;
+      }
+      for(m=0, k=0; k<n; k++)
+      {
+         if(bucket[k] == b)
+         {
+            members[m++] = k;
+         }
+      }
+      ok = false;
+      for(seed=1; !ok && seed<PREPARSED_MAX_SEED; seed++)
+      {
+         ok = true;
+         for(k=0; ok && k<m; k++)
+         {
+            hashes[k] = PreparsedHash(keys[members[k]], seed)%size;
+            if(slots[hashes[k]] != -1)
+            {
+               ok = false;
+            }
+            for(j=0; ok && j<k; j++)
+            {
+               if(hashes[j] == hashes[k])
+               {
+                  ok = false;
+               }
+            }
+         }
+         if(ok)
+         {
+            seeds[b] = seed;
+            for(k=0; k<m; k++)
+            {
+               slots[hashes[k]] = members[k];
+            }
+         }
+      }
+      res = ok;
+   }
+   free(hashes);
+   free(members);
+   free(order);
+   free(count);
+   free(bucket);
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: same_field_set()
+//
+//   Return true if the two records set the same non-enum
+//   parameters.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool same_field_set(Record_p r1, Record_p r2)
+{
+   int i;
+
+   for(i=0; i<PREPARSED_PARAM_NO; i++)
+   {
+      if(!r1->values[i] != !r2->values[i])
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: print_record()
+//
+//   Print the record for a strategy as a C initializer.
+//
+// Global Variables: params
+//
+// Side Effects    : Output
+//
+/----------------------------------------------------------------------*/
+
+static void print_record(FILE* out, Conf_p conf, Record_p rec)
+{
+   int  i, col;
+   char *key = c_literal(conf->key, strlen(conf->key));
+
+   fprintf(out, "   {%s, %ld, 0x%llxULL, %d,\n    {",
+           key, rec->idx, PreparsedHash(conf->value, 0), rec->field_set);
+   free(key);
+   col = 5;
+   for(i=PREPARSED_PARAM_NO; i<PARAM_NO; i++)
+   {
+      if(col > 64)
+      {
+         fprintf(out, "\n     ");
+         col = 5;
+      }
+      col += fprintf(out, "%s%s", rec->values[i]?rec->values[i]:"NULL",
+                     (i<PARAM_NO-1)?", ":"");
+   }
+   fprintf(out, "},\n    {");
+   col = 5;
+   for(i=0; i<PREPARSED_PARAM_NO; i++)
+   {
+      if(rec->values[i])
+      {
+         if(col > 64)
+         {
+            fprintf(out, "\n     ");
+            col = 5;
+         }
+         col += fprintf(out, ".%s=%s, ", params[i].field,
+                        rec->values[i]);
+      }
+   }
+   fprintf(out, "}},\n");
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                          Main Function                              */
+/*---------------------------------------------------------------------*/
+
+int main(int argc, char* argv[])
+{
+   char               *text, **keys;
+   Conf_p             confs;
+   Record_p           recs;
+   long               i, j, n, n_confs, size, buckets, *slots;
+   int                sets = 0;
+   unsigned long long *seeds;
+   FILE               *out = stdout;
+
+   if(argc != 2)
+   {
+      fail("Usage: gen_schedule_parms schedule.vars", NULL);
+   }
+   init_params();
+   text  = read_file(argv[1]);
+   confs = read_confs(text, &n_confs);
+   recs  = secure_malloc(n_confs*sizeof(RecordCell));
+
+   n = 0;
+   for(i=0; i<n_confs; i++)
+   {
+      memset(&recs[n], 0, sizeof(RecordCell));
+      recs[n].idx = i;
+      if(!parse_conf(&confs[i], &recs[n]))
+      {
+         fprintf(stderr, "gen_schedule_parms: Warning: Strategy %s "
+                 "cannot be parsed and is left out\n", confs[i].key);
+         continue;
+      }
+      for(j=0; j<n; j++)
+      {
+         if(same_field_set(&recs[j], &recs[n]))
+         {
+            break;
+         }
+      }
+      recs[n].field_set = (j<n)?recs[j].field_set:sets++;
+      n++;
+   }
+
+   size = 1;
+   while(size < n)
+   {
+      size = size*2;
+   }
+   buckets = size/PREPARSED_BUCKET_LOAD;
+   buckets = buckets?buckets:1;
+   keys  = secure_malloc(n*sizeof(char*));
+   seeds = secure_malloc(buckets*sizeof(unsigned long long));
+   slots = secure_malloc(size*sizeof(long));
+   for(i=0; i<n; i++)
+   {
+      keys[i] = confs[recs[i].idx].key;
+   }
+   if(!build_hash(keys, n, seeds, buckets, slots, size))
+   {
+      fail("Cannot find a perfect hash for the strategy names", NULL);
+   }
+
+   fprintf(out,
+           "/* Preparsed built-in strategies, see che_preparsed.h.\n"
+           "   Generated by gen_schedule_parms from schedule.vars - "
+           "do not edit. */\n\n");
+   fprintf(out, "#define PREPARSED_HASH_SIZE    %ld\n", size);
+   fprintf(out, "#define PREPARSED_HASH_BUCKETS %ld\n\n", buckets);
+
+   for(j=0; j<sets; j++)
+   {
+      for(i=0; recs[i].field_set != j; i++)
+      {
+         /* Find first record with this field set */
+      }
+      fprintf(out,
+              "static PreparsedFieldCell preparsed_fields_%ld[] =\n{\n", j);
+      for(int k=0; k<PREPARSED_PARAM_NO; k++)
+      {
+         if(recs[i].values[k])
+         {
+            fprintf(out, "   PREPARSED_FIELD(%s),\n", params[k].field);
+         }
+      }
+      fprintf(out, "   {0, 0}\n};\n\n");
+   }
+   fprintf(out, "static PreparsedFieldCell *preparsed_field_sets[] =\n{\n");
+   for(j=0; j<sets; j++)
+   {
+      fprintf(out, "   preparsed_fields_%ld,\n", j);
+   }
+   fprintf(out, "   NULL\n};\n\n");
+
+   fprintf(out, "static PreparsedConfCell preparsed_confs[] =\n{\n");
+   for(i=0; i<n; i++)
+   {
+      print_record(out, &confs[recs[i].idx], &recs[i]);
+   }
+   fprintf(out, "   {NULL, 0, 0, 0, {NULL}, {.sine=NULL}}\n};\n\n");
+
+   fprintf(out, "static unsigned long long preparsed_seeds[] =\n{");
+   for(i=0; i<buckets; i++)
+   {
+      fprintf(out, "%s%llu,", (i%8)?" ":"\n   ", seeds[i]);
+   }
+   fprintf(out, "\n};\n\n");
+
+   fprintf(out, "static long preparsed_slots[] =\n{");
+   for(i=0; i<size; i++)
+   {
+      fprintf(out, "%s%ld,", (i%12)?" ":"\n   ", slots[i]);
+   }
+   fprintf(out, "\n};\n");
+
+   if(fflush(out) != 0 || ferror(out))
+   {
+      fail("Cannot write output", NULL);
+   }
+   return EXIT_SUCCESS;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -87,6 +87,32 @@ static TokenRepCell token_print_rep[] =
 /*---------------------------------------------------------------------*/
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: scan_take_text()
+//
+//   Append the next len characters from the text of the input stream
+//   to the current token and skip them. This is the fast path for
+//   streams reading from memory.
+//
+// Global Variables: -
+//
+// Side Effects    : Reads input, changes the scanner state, memory
+//                   operations.
+//
+/----------------------------------------------------------------------*/
+
+static void scan_take_text(Scanner_p in, long len)
+{
+   if(len)
+   {
+      DStrAppendBuffer(AktToken(in)->literal,
+                       StreamCurrText(in->source), len);
+      StreamSkipChars(in->source, len);
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: scan_white()
@@ -103,6 +129,17 @@ static TokenRepCell token_print_rep[] =
 static void scan_white(Scanner_p in)
 {
    AktToken(in)->tok = WhiteSpace;
+   if(StreamHasText(in->source))
+   {
+      char *start = StreamCurrText(in->source), *p = start,
+         *end = StreamTextEnd(in->source);
+
+      while(p<end && isspace((unsigned char)*p))
+      {
+         p++;
+      }
+      scan_take_text(in, p-start);
+   }
    while(isspace(CurrChar(in)))
    {
       DStrAppendChar(AktToken(in)->literal, CurrChar(in));
@@ -129,6 +166,24 @@ static void scan_ident(Scanner_p in)
    long numstart = 0,
       i;
 
+   if(StreamHasText(in->source))
+   {
+      char *start = StreamCurrText(in->source),
+         *end = StreamTextEnd(in->source);
+
+      for(i=0; start+i<end && isidchar((unsigned char)start[i]); i++)
+      {
+         if(!numstart && isdigit((unsigned char)start[i]))
+         {
+            numstart = i;
+         }
+         else if(!isdigit((unsigned char)start[i]))
+         {
+            numstart = 0;
+         }
+      }
+      scan_take_text(in, i);
+   }
    for(i=0; isidchar(CurrChar(in)); i++)
    {
       if(!numstart && isdigit(CurrChar(in)))
@@ -177,6 +232,17 @@ static void scan_int(Scanner_p in)
 {
    AktToken(in)->tok = PosInt;
 
+   if(StreamHasText(in->source))
+   {
+      char *start = StreamCurrText(in->source), *p = start,
+         *end = StreamTextEnd(in->source);
+
+      while(p<end && isdigit((unsigned char)*p))
+      {
+         p++;
+      }
+      scan_take_text(in, p-start);
+   }
    while(isdigit(CurrChar(in)))
    {
       DStrAppendChar(AktToken(in)->literal, CurrChar(in));
@@ -213,6 +279,14 @@ static void scan_line_comment(Scanner_p in)
 {
    AktToken(in)->tok = Comment;
 
+   if(StreamHasText(in->source))
+   {
+      char *start = StreamCurrText(in->source),
+         *end = StreamTextEnd(in->source),
+         *p = memchr(start, '\n', end-start);
+
+      scan_take_text(in, (p?p:end)-start);
+   }
    while((CurrChar(in)) != '\n' && (CurrChar(in)!=EOF))
    {
       DStrAppendChar(AktToken(in)->literal, CurrChar(in));
@@ -20,6 +20,7 @@
 
   -----------------------------------------------------------------------*/
 
+#include <sys/mman.h>
 #include "cio_streams.h"
 
 
@@ -41,6 +42,11 @@ const StreamType StreamTypeUserString =
 const StreamType StreamTypeOptionString =
    "Parsing a user given option argument";
 
+/* If set, the names of all files opened as streams (excluding
+   stdin) are pushed here (as copies, to be freed by the owner). */
+
+PStack_p StreamFileLog = NULL;
+
 /*---------------------------------------------------------------------*/
 /*                      Forward Declarations                           */
 /*---------------------------------------------------------------------*/
@@ -87,6 +93,18 @@ static int read_char(Stream_p stream)
             stream->eof_seen = true;
          }
       }
+      else if(stream->text)
+      {
+         if(stream->text_pos < stream->text_len)
+         {
+            ch = (unsigned char)stream->text[stream->text_pos++];
+         }
+         else
+         {
+            ch = EOF;
+            stream->eof_seen = true;
+         }
+      }
       else
       {
          ch = getc(stream->file);
@@ -99,6 +117,65 @@ static int read_char(Stream_p stream)
    return ch;
 }
 
+
+/*-----------------------------------------------------------------------
+//
+// Function: stream_load_text()
+//
+//   If the stream's file is a non-empty regular file (other than
+//   stdin, which may already have been read from), map it into
+//   memory, or, if this is not possible, read it into a buffer in one
+//   go. Otherwise leave the stream reading via getc().
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, file operations
+//
+/----------------------------------------------------------------------*/
+
+static void stream_load_text(Stream_p stream)
+{
+   struct stat stat_buf;
+   void*       map;
+   size_t      got;
+
+   stream->text        = NULL;
+   stream->text_len    = 0;
+   stream->text_pos    = 0;
+   stream->text_curr   = 0;
+   stream->text_mapped = false;
+
+   if(stream->file == stdin ||
+      fstat(fileno(stream->file), &stat_buf) ||
+      !S_ISREG(stat_buf.st_mode) ||
+      stat_buf.st_size <= 0 ||
+      (unsigned long long)stat_buf.st_size > (unsigned long long)LONG_MAX)
+   {
+      return;
+   }
+   map = mmap(NULL, stat_buf.st_size, PROT_READ, MAP_PRIVATE,
+              fileno(stream->file), 0);
+   if(map != MAP_FAILED)
+   {
+#ifdef MADV_SEQUENTIAL
+      madvise(map, stat_buf.st_size, MADV_SEQUENTIAL);
+#endif
+      stream->text        = map;
+      stream->text_len    = stat_buf.st_size;
+      stream->text_mapped = true;
+      return;
+   }
+   stream->text = SecureMalloc(stat_buf.st_size);
+   got = fread(stream->text, 1, stat_buf.st_size, stream->file);
+   if(ferror(stream->file))
+   {
+      TmpErrno = errno;
+      SysError("Cannot read file %s", FILE_ERROR, DStrView(stream->source));
+   }
+   stream->text_len = got;
+}
+
+
 /*---------------------------------------------------------------------*/
 /*                         Exported Functions                          */
 /*---------------------------------------------------------------------*/
@@ -147,7 +224,12 @@ Stream_p CreateStream(StreamType type, char* source, bool fail)
             StreamCellFree(handle);
             return NULL;
          }
+         if(StreamFileLog)
+         {
+            PStackPushP(StreamFileLog, SecureStrdup(source));
+         }
       }
+      stream_load_text(handle);
       VERBOUTARG("Opened ", DStrView(handle->source));
    }
    else
@@ -155,7 +237,12 @@ Stream_p CreateStream(StreamType type, char* source, bool fail)
       /* Interprete source as a string to read from! */
 
       DStrSet(handle->source, source);
-      handle->string_pos = 0;
+      handle->string_pos  = 0;
+      handle->text        = NULL;
+      handle->text_len    = 0;
+      handle->text_pos    = 0;
+      handle->text_curr   = 0;
+      handle->text_mapped = false;
    }
    handle->next       = NULL;
    handle->eof_seen   = false;
@@ -189,6 +276,14 @@ void DestroyStream(Stream_p stream)
 {
    if(stream->stream_type == StreamTypeFile)
    {
+      if(stream->text_mapped)
+      {
+         munmap(stream->text, stream->text_len);
+      }
+      else if(stream->text)
+      {
+         FREE(stream->text);
+      }
       if(stream->file != stdin)
       {
          if(fclose(stream->file) != 0)
@@ -233,11 +328,68 @@ int StreamNextChar(Stream_p stream)
    stream->current=STREAMREALPOS(stream->current+1);
    stream->buffer[STREAMREALPOS(stream->current+MAXLOOKAHEAD-1)]
       = read_char(stream);
+   stream->text_curr++;
 
    return StreamCurrChar(stream);
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: StreamSkipChars()
+//
+//   Move the current window on a stream with text count characters
+//   forward. This is equivalent to count calls to StreamNextChar(),
+//   but is meant to be used after the caller has consumed a run of
+//   characters directly from StreamCurrText(). The characters must
+//   exist (i.e. not go beyond StreamTextEnd()).
+//
+// Global Variables: -
+//
+// Side Effects    : Reads input, updates the position information
+//
+/----------------------------------------------------------------------*/
+
+void StreamSkipChars(Stream_p stream, long count)
+{
+   char* text = stream->text;
+   long  i, line = stream->line, column = stream->column;
+   int   *slot;
+
+   assert(StreamHasText(stream));
+   assert(stream->text_curr+count <= stream->text_len);
+
+   for(i=stream->text_curr; i<stream->text_curr+count; i++)
+   {
+      if(text[i] == '\n')
+      {
+         line++;
+         column = 1;
+      }
+      else
+      {
+         column++;
+      }
+      /* The slot of the current character receives the one
+         MAXLOOKAHEAD positions further on. */
+      slot = &(stream->buffer[stream->current]);
+      if(stream->text_pos < stream->text_len)
+      {
+         *slot = (unsigned char)text[stream->text_pos++];
+      }
+      else
+      {
+         *slot = EOF;
+         stream->eof_seen = true;
+      }
+      stream->current = STREAMREALPOS(stream->current+1);
+   }
+   stream->text_curr += count;
+   stream->line       = line;
+   stream->column     = column;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: OpenStackedInput()
@@ -11,6 +11,12 @@ Contents
   arbitrary look-aheads, and maintaining line and column numbers for
   error messages.
 
+  Regular files are mapped into memory (or, if that fails, read in
+  one block) instead of being read character by character. For these
+  streams, the scanner can access runs of characters directly in the
+  buffer (see StreamHasText() and StreamSkipChars()). Other files
+  (stdin, pipes) and strings use the character-wise interface only.
+
   Copyright 1998, 1999 by the author.
   This code is released under the GNU General Public Licence and
   the GNU Lesser General Public License.
@@ -21,6 +27,8 @@ Changes
 
 <1> Wed Aug 20 00:02:32 MET DST 1997
     New
+<2> Sat Oct 17 2026
+    Memory-mapped file input
 
 -----------------------------------------------------------------------*/
 
@@ -30,6 +38,7 @@ Changes
 
 #include <cio_initio.h>
 #include <cio_fileops.h>
+#include <clb_pstacks.h>
 
 /*---------------------------------------------------------------------*/
 /*                    Data type declarations                           */
@@ -60,6 +69,11 @@ typedef struct streamcell
                                       here! */
    long               string_pos;
    FILE*              file;
+   char*              text;        /* Contents of regular files or NULL */
+   long               text_len;
+   long               text_pos;    /* Next character to be buffered */
+   long               text_curr;   /* Position of the current character */
+   bool               text_mapped; /* text is mmap()ed, not malloc()ed */
    bool               eof_seen;
    long               line;
    long               column;
@@ -77,6 +91,8 @@ extern const StreamType StreamTypeInternalString;
 extern const StreamType StreamTypeUserString;
 extern const StreamType StreamTypeOptionString;
 
+extern PStack_p StreamFileLog;
+
 
 #define StreamCellAlloc() (StreamCell*)SizeMalloc(sizeof(StreamCell))
 #define StreamCellFree(junk)         SizeFree(junk, sizeof(StreamCell))
@@ -95,6 +111,11 @@ void     DestroyStream(Stream_p stream);
 
 int      StreamNextChar(Stream_p stream);
 
+#define  StreamHasText(stream)  ((stream)->text!=NULL)
+#define  StreamCurrText(stream) ((stream)->text+(stream)->text_curr)
+#define  StreamTextEnd(stream)  ((stream)->text+(stream)->text_len)
+void     StreamSkipChars(Stream_p stream, long count);
+
 Stream_p OpenStackedInput(Inpstack_p stack, StreamType type,
            char* source, bool fail);
 void     CloseStackedInput(Inpstack_p stack);
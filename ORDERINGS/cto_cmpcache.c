@@ -6,7 +6,8 @@ Author: Stephan Schulz
 
 Contents
 
-  Cache for LPO-like comparisons.
+  Cache for LPO-like comparisons, and the persistent result cache
+  for shared ground terms.
 
   Copyright 1998, 1999 by the author.
   This code is released under the GNU General Public Licence and
@@ -18,6 +19,8 @@ Changes
 
 <1> Wed Jan  5 20:21:36 MET 2000
     New
+<2> Sat Oct 17 14:05:12 CEST 2026
+    Added OrdResCache
 
 -----------------------------------------------------------------------*/
 
@@ -71,6 +74,51 @@ static bool prepare_key(Term_p t1, DerefType d1, Term_p t2, DerefType
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: ord_res_hash()
+//
+//   Return the start of the probe window for the (ordered) pair
+//   t1, t2 in a table of the given size (a power of 2).
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline long ord_res_hash(Term_p t1, Term_p t2, long size)
+{
+   uint64_t h;
+
+   h = ((uint64_t)(uintptr_t)t1>>4)*0x9E3779B97F4A7C15ULL;
+   h ^= ((uint64_t)(uintptr_t)t2>>4);
+   h *= 0xC2B2AE3D27D4EB4FULL;
+
+   return (long)((h>>32)&(size-1));
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: ord_res_entry_valid()
+//
+//   Return true if the entry is in use and has been made after the
+//   last release of term cells of the bank of the cache.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline bool ord_res_entry_valid(OrdResCache_p cache,
+                                       OrdResEntry_p entry)
+{
+   return entry->t1 && entry->epoch == cache->bank->gc_epoch;
+}
+
+
 /*---------------------------------------------------------------------*/
 /*                         Exported Functions                          */
 /*---------------------------------------------------------------------*/
@@ -210,6 +258,174 @@ bool CmpCacheInsert(CmpCache_p *cache, Term_p t1, DerefType d1, Term_p
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: OrdResCacheAlloc()
+//
+//   Allocate an empty result cache with size entries (rounded up to a
+//   power of 2) for comparisons of terms from bank.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+OrdResCache_p OrdResCacheAlloc(TB_p bank, long size)
+{
+   OrdResCache_p handle = OrdResCacheCellAlloc();
+   long          i;
+
+   handle->bank = bank;
+   handle->size = ORD_RES_PROBE;
+   while(handle->size < size)
+   {
+      handle->size *= 2;
+   }
+   handle->table = SizeMalloc(handle->size*sizeof(OrdResEntry));
+   for(i=0; i<handle->size; i++)
+   {
+      handle->table[i].t1  = NULL;
+      handle->table[i].t2  = NULL;
+      handle->table[i].ref = false;
+   }
+   handle->lookups   = 0;
+   handle->hits      = 0;
+   handle->evictions = 0;
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: OrdResCacheFree()
+//
+//   Free a result cache.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void OrdResCacheFree(OrdResCache_p junk)
+{
+   SizeFree(junk->table, junk->size*sizeof(OrdResEntry));
+   OrdResCacheCellFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: OrdResCacheFind()
+//
+//   Return the cached result of comparing t1 and t2, or to_unknown
+//   if there is none. Both terms have to be shared and ground (the
+//   caller checks this).
+//
+// Global Variables: -
+//
+// Side Effects    : Marks the entry as recently used.
+//
+/----------------------------------------------------------------------*/
+
+CompareResult OrdResCacheFind(OrdResCache_p cache, Term_p t1, Term_p t2)
+{
+   Term_p        tmp;
+   bool          swapped = false;
+   long          i, pos;
+   OrdResEntry_p entry;
+
+   assert(t1 != t2);
+
+   if(t1 > t2)
+   {
+      tmp = t1; t1 = t2; t2 = tmp;
+      swapped = true;
+   }
+   cache->lookups++;
+   pos = ord_res_hash(t1, t2, cache->size);
+   for(i=0; i<ORD_RES_PROBE; i++)
+   {
+      entry = &(cache->table[(pos+i)&(cache->size-1)]);
+      if(entry->t1 == t1 && entry->t2 == t2 && ord_res_entry_valid(cache, entry))
+      {
+         cache->hits++;
+         entry->ref = true;
+         return swapped?POInverseRelation(entry->res):entry->res;
+      }
+   }
+   return to_unknown;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: OrdResCacheInsert()
+//
+//   Record the result of comparing t1 and t2. Uses a free or stale
+//   slot in the probe window if there is one, otherwise evicts an
+//   entry with the clock strategy.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes the cache
+//
+/----------------------------------------------------------------------*/
+
+void OrdResCacheInsert(OrdResCache_p cache, Term_p t1, Term_p t2,
+                       CompareResult res)
+{
+   Term_p        tmp;
+   long          i, pos;
+   OrdResEntry_p entry, victim = NULL;
+
+   assert(t1 != t2);
+   assert(res != to_unknown);
+
+   if(t1 > t2)
+   {
+      tmp = t1; t1 = t2; t2 = tmp;
+      res = POInverseRelation(res);
+   }
+   pos = ord_res_hash(t1, t2, cache->size);
+   for(i=0; i<ORD_RES_PROBE; i++)
+   {
+      entry = &(cache->table[(pos+i)&(cache->size-1)]);
+      if(!ord_res_entry_valid(cache, entry))
+      {
+         victim = entry;
+         break;
+      }
+   }
+   if(!victim)
+   {
+      /* Second chance: Starting at the (global) clock hand, clear
+         reference bits until an unreferenced entry is found. This
+         terminates after at most two rounds. */
+      for(i=cache->evictions; !victim; i++)
+      {
+         entry = &(cache->table[(pos+i%ORD_RES_PROBE)&(cache->size-1)]);
+         if(entry->ref)
+         {
+            entry->ref = false;
+         }
+         else
+         {
+            victim = entry;
+         }
+      }
+      cache->evictions++;
+   }
+   victim->t1    = t1;
+   victim->t2    = t2;
+   victim->res   = res;
+   victim->epoch = cache->bank->gc_epoch;
+   victim->ref   = false;
+}
+
+
 /*---------------------------------------------------------------------*/
 /*                        End of File                                  */
 /*---------------------------------------------------------------------*/
@@ -7,7 +7,8 @@ Author: Stephan Schulz
 Contents
 
   Cache structure for the local caching of ordering results for LPO
-  (and potentially RPO and other mainly recursive orderings).
+  (and potentially RPO and other mainly recursive orderings), and a
+  persistent, bounded cache for comparisons of shared ground terms.
 
   Copyright 1998, 1999 by the author.
   This code is released under the GNU General Public Licence and
@@ -19,6 +20,8 @@ Changes
 
 <1> Sat Dec 25 00:50:42 MET 1999
     New
+<2> Sat Oct 17 14:05:12 CEST 2026
+    Added OrdResCache
 
 -----------------------------------------------------------------------*/
 
@@ -42,6 +45,37 @@ Changes
 
 typedef QuadTree_p CmpCache_p;
 
+
+/* The persistent result cache is an open-addressing table of fixed
+   size. A pair of shared ground terms is stored in one of the
+   ORD_RES_PROBE slots following its hash position, with the smaller
+   pointer first. If all of these are taken, a victim is chosen with
+   the clock (second chance) strategy over the probe window. Entries
+   are only valid if no cells of the term bank have been released
+   since they were made, see TBCell->gc_epoch. All terms compared
+   through the cache have to come from this bank. */
+
+#define ORD_RES_PROBE              4
+
+typedef struct ord_res_entry
+{
+   Term_p        t1;
+   Term_p        t2;
+   unsigned long epoch;
+   CompareResult res;   /* t1 compared to t2 */
+   bool          ref;   /* Used since the clock hand passed */
+}OrdResEntry, *OrdResEntry_p;
+
+typedef struct ord_res_cache
+{
+   TB_p          bank;
+   long          size;
+   OrdResEntry_p table;
+   long          lookups;
+   long          hits;
+   long          evictions;
+}OrdResCacheCell, *OrdResCache_p;
+
 /*---------------------------------------------------------------------*/
 /*                Exported Functions and Variables                     */
 /*---------------------------------------------------------------------*/
@@ -54,6 +88,15 @@ CompareResult CmpCacheFind(CmpCache_p *cache, Term_p t1, DerefType d1,
 bool CmpCacheInsert(CmpCache_p *cache, Term_p t1, DerefType d1, Term_p
           t2, DerefType d2, CompareResult insert);
 
+#define OrdResCacheCellAlloc() (OrdResCacheCell*)SizeMalloc(sizeof(OrdResCacheCell))
+#define OrdResCacheCellFree(junk) SizeFree(junk, sizeof(OrdResCacheCell))
+
+OrdResCache_p OrdResCacheAlloc(TB_p bank, long size);
+void          OrdResCacheFree(OrdResCache_p junk);
+CompareResult OrdResCacheFind(OrdResCache_p cache, Term_p t1, Term_p t2);
+void          OrdResCacheInsert(OrdResCache_p cache, Term_p t1, Term_p t2,
+                                CompareResult res);
+
 
 #endif
 
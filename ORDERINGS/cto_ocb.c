@@ -15,6 +15,8 @@
   Run "eprover -h" for contact information.
 
   Created: Thu Apr 30 03:11:31 MET DST 1998
+  <1> Sat Oct 17 16:20:41 CEST 2026
+      Precedence matrix replaced by compact Precedence_p
 
   -----------------------------------------------------------------------*/
 
@@ -69,57 +71,6 @@ void free_val(void* key, void* val)
    SizeFree(val, sizeof(long));
 }
 
-/*-----------------------------------------------------------------------
-//
-// Function: ocb_trans_compute()
-//
-//   Given the relations between f1 and f2, and f2 and f3, compute the
-//   relation between f1 and f3. Return true, if it can be set, false
-//   otherwise.
-//
-// Global Variables: -
-//
-// Side Effects    : Changes ocb->precedences
-//
-/----------------------------------------------------------------------*/
-
-bool ocb_trans_compute(OCB_p ocb, FunCode f1, FunCode f2, FunCode f3)
-{
-   CompareResult rel12, rel23;
-   bool          res = true;
-
-   rel12 = OCBFunCompare(ocb, f1, f2);
-   rel23 = OCBFunCompare(ocb, f2, f3);
-
-   switch(rel12)
-   {
-   case to_uncomparable:
-         break;
-   case to_equal:
-         if(rel23 != to_uncomparable)
-         {
-            res = OCBPrecedenceAddTuple(ocb, f1, f3, rel23);
-         }
-         break;
-   case to_greater:
-         if(rel23 == to_equal || rel23 == to_greater)
-         {
-            res = OCBPrecedenceAddTuple(ocb, f1, f3, to_greater);
-         }
-         break;
-   case to_lesser:
-         if(rel23 == to_equal || rel23 == to_lesser)
-         {
-            res = OCBPrecedenceAddTuple(ocb, f1, f3, to_lesser);
-         }
-         break;
-   default:
-         assert(false);
-         break;
-   }
-   return res;
-}
-
 /*-----------------------------------------------------------------------
 //
 // Function: alloc_precedence()
@@ -143,9 +94,7 @@ static void alloc_precedence(OCB_p handle, bool prec_by_weight)
    }
    else
    {
-      handle->precedence = SizeMalloc(sizeof(CompareResult)
-                                      *handle->sig_size
-                                      *handle->sig_size);
+      handle->precedence = PrecedenceAlloc(handle->sig_size);
       handle->prec_weights = NULL;
    }
 }
@@ -171,7 +120,6 @@ static void alloc_precedence(OCB_p handle, bool prec_by_weight)
 OCB_p OCBAlloc(TermOrdering type, bool prec_by_weight, Sig_p sig, HoOrderKind ho_order_kind)
 {
    OCB_p handle;
-   int   i,j;
 
    handle = OCBCellAlloc();
 
@@ -194,6 +142,7 @@ OCB_p OCBAlloc(TermOrdering type, bool prec_by_weight, Sig_p sig, HoOrderKind ho
    handle->db_weight = DEFAULT_DB_WEIGHT;
    handle->lam_weight = DEFAULT_LAMBDA_WEIGHT;
    handle->ho_vb   = NULL;
+   handle->res_cache = NULL;
    for(size_t i=0; i<handle->vb_size; i++)
    {
       handle->vb[i] = 0;
@@ -230,18 +179,6 @@ OCB_p OCBAlloc(TermOrdering type, bool prec_by_weight, Sig_p sig, HoOrderKind ho
       }
    }
 
-   if(handle->precedence)
-   {
-      for(i=1; i<=handle->sig_size; i++)
-      {
-         for(j=1; j<=handle->sig_size; j++)
-         {
-            *OCBFunComparePos(handle, i,j) =
-               ((i==j) ? to_equal : to_uncomparable);
-         }
-      }
-   }
-
    return handle;
 }
 
@@ -279,8 +216,7 @@ void OCBFree(OCB_p junk)
              junk->type == LPO4 ||
              junk->type == LPO4Copy ||
              junk->type == RPO);
-      SizeFree(junk->precedence, sizeof(CompareResult)
-               * junk->sig_size * junk->sig_size);
+      PrecedenceFree(junk->precedence);
       junk->precedence = NULL;
    }
    if(junk->prec_weights)
@@ -304,10 +240,38 @@ void OCBFree(OCB_p junk)
    }
    PStackFree(junk->statestack);
    PObjMapFreeWDeleter(junk->ho_vb, free_val);
+   if(junk->res_cache)
+   {
+      OrdResCacheFree(junk->res_cache);
+   }
    OCBCellFree(junk);
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: OCBEnableResultCache()
+//
+//   Start caching comparisons of shared ground terms from bank in a
+//   cache with size entries (see OrdResCache). Cached results are
+//   never revised, so this must only be called once weights and
+//   precedence are final.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void OCBEnableResultCache(OCB_p ocb, TB_p bank, long size)
+{
+   if(!ocb->res_cache && size)
+   {
+      ocb->res_cache = OrdResCacheAlloc(bank, size);
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: OCBDebugPrint()
@@ -363,7 +327,8 @@ void OCBDebugPrint(FILE* out, OCB_p ocb)
    fprintf(out, COMCHAR" -----------------------------------------------\n");
    if(ocb->precedence)
    {
-      fprintf(out, COMCHAR" Precedence Matrix:\n"COMCHAR"       ");
+      fprintf(out, COMCHAR" Precedence%s:\n"COMCHAR"       ",
+              PrecedenceIsTotal(ocb->precedence)?" (total)":"");
       for(j=1; j<=ocb->sig_size; j++)
       {
          fprintf(out, " %2ld ", j);
@@ -398,99 +363,109 @@ void OCBDebugPrint(FILE* out, OCB_p ocb)
 //
 //   Add a new binary relation to the precedence stored in the ocb and
 //   compute the new transitive closure of the to_greater, to_smaller
-//   and to_equal. Store updated cell in ocb->statestackcell. Return
-//   the new stackpointer if everything went fine, undo all changes
-//   and return 0 otherwise.
+//   and to_equal. Record the tuple in ocb->statestack. Return the new
+//   stackpointer if everything went fine, leave the precedence
+//   unchanged and return 0 otherwise.
 //
-// Global Variables:
+// Global Variables: -
 //
-// Side Effects    :
+// Side Effects    : Changes the precedence
 //
 /----------------------------------------------------------------------*/
 
 PStackPointer OCBPrecedenceAddTuple(OCB_p ocb, FunCode f1, FunCode f2,
                                     CompareResult relation)
 {
-   FunCode       i;
-   PStackPointer res = 0, old;
-
    assert(ocb);
    assert(ocb->precedence);
+   assert(!PrecedenceIsTotal(ocb->precedence));
    assert(f1<=ocb->sig_size);
    assert(f2<=ocb->sig_size);
    assert(relation!=to_uncomparable);
 
-   old = PStackGetSP(ocb->statestack);
-
    if(OCBFunCompare(ocb, f1, f2)==relation)
    {
-      res = old;
+      return PStackGetSP(ocb->statestack);
    }
-   else if(OCBFunCompare(ocb, f1, f2)!=to_uncomparable)
+   if(!PrecedenceAddTuple(ocb->precedence, f1, f2, relation))
    {
-      res = 0;
+      return 0;
    }
-   else
-   {
-      PStackPushInt(ocb->statestack, f1);
-      PStackPushInt(ocb->statestack, f2);
-      *OCBFunComparePos(ocb, f1, f2) = relation;
-      *OCBFunComparePos(ocb, f2, f1) = POInverseRelation(relation);
+   PStackPushInt(ocb->statestack, f1);
+   PStackPushInt(ocb->statestack, f2);
+   PStackPushInt(ocb->statestack, relation);
 
-      for(i=1; i<=ocb->sig_size; i++)
+   return PStackGetSP(ocb->statestack);
+}
+
+/*-----------------------------------------------------------------------
+//
+// Function: OCBPrecedenceBacktrack()
+//
+//   Backtrack the precedence to a given state by rebuilding it from
+//   the tuples added before. Return true if the stack is non-empty
+//   afterwards, false otherwise.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes the precedence
+//
+/----------------------------------------------------------------------*/
+
+bool OCBPrecedenceBacktrack(OCB_p ocb, PStackPointer state)
+{
+   PStackPointer i;
+
+   assert(!PrecedenceIsTotal(ocb->precedence));
+   assert(state<=PStackGetSP(ocb->statestack));
+   assert(state%3 == 0);
+
+   if(state!=PStackGetSP(ocb->statestack))
+   {
+      while(PStackGetSP(ocb->statestack)!=state)
       {
-         res = ocb_trans_compute(ocb, f1, f2, i);
-         if(!res)
-         {
-            break;
-         }
-         res = ocb_trans_compute(ocb, i, f1, f2);
-         if(!res)
-         {
-            break;
-         }
+         PStackDiscardTop(ocb->statestack);
       }
-      if(!res)
-      { /* Error case, undo changes */
-         f2 = PStackPopInt(ocb->statestack);
-         f1 = PStackPopInt(ocb->statestack);
-         *OCBFunComparePos(ocb, f1, f2) = to_uncomparable;
-         *OCBFunComparePos(ocb, f2, f1) = to_uncomparable;
+      PrecedenceReset(ocb->precedence);
+      for(i=0; i<state; i+=3)
+      {
+         PrecedenceAddTuple(ocb->precedence,
+                            PStackElementInt(ocb->statestack, i),
+                            PStackElementInt(ocb->statestack, i+1),
+                            PStackElementInt(ocb->statestack, i+2));
       }
    }
-   return res;
+   return !PStackEmpty(ocb->statestack);
 }
 
+
 /*-----------------------------------------------------------------------
 //
-// Function: OCBPrecedenceBacktrack()
+// Function: OCBPrecedenceLinearize()
 //
-//   Backtrack the precedence matrix to a given state. Return true if
-//   the stack is non-empty afterwards, false otherwise.
+//   Add the chain given by order (smallest symbol first) to the
+//   precedence wherever the existing precedence allows it, as
+//   PrecedenceLinearize(). If this makes the precedence total, symbol
+//   comparisons are simple rank comparisons afterwards, no tuples can
+//   be added any more, and true is returned. Otherwise, the
+//   precedence is unchanged and false is returned.
 //
 // Global Variables: -
 //
-// Side Effects    : Changes the matrix
+// Side Effects    : Changes the precedence
 //
 /----------------------------------------------------------------------*/
 
-bool OCBPrecedenceBacktrack(OCB_p ocb, PStackPointer state)
+bool OCBPrecedenceLinearize(OCB_p ocb, FunCode *order, long len)
 {
-   FunCode f1,f2;
+   assert(ocb->precedence);
 
-   while(state!=PStackGetSP(ocb->statestack))
+   if(PrecedenceLinearize(ocb->precedence, order, len))
    {
-      assert(!PStackEmpty(ocb->statestack));
-      f2 = PStackPopInt(ocb->statestack);
-      assert(!PStackEmpty(ocb->statestack));
-      f1 = PStackPopInt(ocb->statestack);
-
-      assert(OCBFunCompare(ocb, f1, f2) != to_uncomparable);
-      *OCBFunComparePos(ocb, f1, f2) = to_uncomparable;
-      assert(OCBFunCompare(ocb, f2, f1) != to_uncomparable);
-      *OCBFunComparePos(ocb, f2, f1) = to_uncomparable;
+      PStackReset(ocb->statestack);
+      return true;
    }
-   return !PStackEmpty(ocb->statestack);
+   return false;
 }
 
 
@@ -633,12 +608,13 @@ FunCode OCBTermMaxFunCode(OCB_p ocb, Term_p term)
 
 /*-----------------------------------------------------------------------
 //
-// Function: OCBFunCompareMatrix()
+// Function: OCBFunCompareUncovered()
 //
-//   Return comparison result of two symbols in precedence via the
-//   full precedence matrix. Symbols
-//   not covered by the ocb are smaller than all others. Equal symbols
-//   are not allowed (captured at OCBFunCompare).
+//   Return comparison result of two symbols in precedence if at
+//   least one of them is not covered by the ocb. Symbols not covered
+//   by the ocb are smaller than all others, and older symbols are
+//   smaller than new ones. Equal symbols are not allowed (captured
+//   at OCBFunCompare).
 //
 // Global Variables: -
 //
@@ -646,24 +622,20 @@ FunCode OCBTermMaxFunCode(OCB_p ocb, Term_p term)
 //
 /----------------------------------------------------------------------*/
 
-CompareResult OCBFunCompareMatrix(OCB_p ocb, FunCode f1, FunCode f2)
+CompareResult OCBFunCompareUncovered(OCB_p ocb, FunCode f1, FunCode f2)
 {
    assert(ocb->precedence);
    assert(f1!=f2);
+   assert((f1>ocb->sig_size) || (f2>ocb->sig_size));
 
    if(f1<=ocb->sig_size)
    {
-      if(f2<=ocb->sig_size)
-      {
-         return *(OCBFunComparePos(ocb, f1, f2));
-      }
       return to_greater;
    }
    if(f2<=ocb->sig_size)
    {
       return to_lesser;
    }
-   assert((f1>ocb->sig_size) && (f1>ocb->sig_size));
    return Q_TO_PART(f2-f1);
 }
 
@@ -18,6 +18,8 @@
   Changes
 
   Created: Wed Apr 29 02:51:28 MET DST 1998
+  <1> Sat Oct 17 16:20:41 CEST 2026
+      Precedence matrix replaced by compact Precedence_p
 
   -----------------------------------------------------------------------*/
 
@@ -27,6 +29,8 @@
 
 #include <cte_termbanks.h>
 #include <clb_objmaps.h>
+#include <cto_cmpcache.h>
+#include <cto_precedence.h>
 
 /*---------------------------------------------------------------------*/
 /*                    Data type declarations                           */
@@ -73,14 +77,15 @@ typedef struct ocb_cell
    long          db_weight;   /* Variable Weight */
    long          *prec_weights;/* Precedence defined by weight - only
                                   for total precedences */
-   CompareResult *precedence;  /* The most general case, interpreted
-                                  as two-dimensional array, indexed by
-                                  two symbols */
+   Precedence_p  precedence;   /* The most general case, built from
+                                  explicit tuples (and possibly
+                                  extended to a total precedence) */
    LiteralCmp    lit_cmp;      /* Incomparable, as terms, or with
                                   fake transfinite KBO on predicate
                                   symbols. */
    bool          rewrite_strong_rhs_inst;
-   PStack_p      statestack;   /* Contains backtrack information */
+   PStack_p      statestack;   /* Tuples added to precedence, for
+                                  backtracking */
    long          wb;
    long          pos_bal;
    long          neg_bal;
@@ -89,6 +94,8 @@ typedef struct ocb_cell
    int           *vb;
    PObjMap_p     ho_vb; // mapping (applied) vars to num of occurrences
    HoOrderKind   ho_order_kind;
+   OrdResCache_p res_cache;    /* Results for shared ground terms,
+                                  only once the ordering is final */
 }OCBCell, *OCB_p;
 
 #define OCB_FUN_DEFAULT_WEIGHT 1
@@ -114,6 +121,7 @@ extern char*  TONames[];
 
 OCB_p         OCBAlloc(TermOrdering type, bool prec_by_weight, Sig_p sig, HoOrderKind ho_order_kind);
 void          OCBFree(OCB_p junk);
+void          OCBEnableResultCache(OCB_p ocb, TB_p bank, long size);
 
 void          OCBDebugPrint(FILE* out, OCB_p ocb);
 
@@ -121,6 +129,7 @@ PStackPointer OCBPrecedenceAddTuple(OCB_p ocb, FunCode f1, FunCode f2,
                                     CompareResult relation);
 
 bool          OCBPrecedenceBacktrack(OCB_p ocb, PStackPointer state);
+bool          OCBPrecedenceLinearize(OCB_p ocb, FunCode *order, long len);
 #define OCBPrecedenceGetState(ocb)              \
    PStackGetSP((ocb)->statestack)
 
@@ -129,14 +138,9 @@ bool          OCBPrecedenceBacktrack(OCB_p ocb, PStackPointer state);
 /*
   #define OCBFunWeightPos(ocb, f)                                       \
   (assert((f)>0), assert((f)<=(ocb)->sig_size), &((ocb)->weights[(f)]))
-  #define OCBFunComparePos(ocb, f1, f2)                                 \
-  (assert((f1)>0), assert((f2)>0), assert((f1)<=(ocb)->sig_size),       \
-  assert((f2)<=(ocb)->sig_size),                                        \
-  (&((ocb)->precedence[((f2)-1)*(ocb)->sig_size+((f1)-1)])))
 */
 
 #define OCBFunWeightPos(ocb, f) &((ocb)->weights[(f)])
-#define OCBFunComparePos(ocb, f1, f2) (&((ocb)->precedence[((f2)-1)*(ocb)->sig_size+((f1)-1)]))
 
 
 void    OCBCondSetMinConst(OCB_p ocb, Type_p type, FunCode cand);
@@ -153,7 +157,7 @@ static inline long OCBFunWeight(OCB_p ocb, FunCode f);
 static inline long OCBFunPrecWeight(OCB_p ocb, FunCode f);
 static inline CompareResult OCBFunCompare(OCB_p ocb, FunCode f1, FunCode f2);
 
-CompareResult OCBFunCompareMatrix(OCB_p ocb, FunCode f1, FunCode f2);
+CompareResult OCBFunCompareUncovered(OCB_p ocb, FunCode f1, FunCode f2);
 FunCode       OCBTermMaxFunCode(OCB_p ocb, Term_p term);
 void OCBResetHOVarMap(OCB_p ocb);
 
@@ -256,7 +260,11 @@ static inline CompareResult OCBFunCompare(OCB_p ocb, FunCode f1, FunCode f2)
       long w2 = (f2<=ocb->sig_size) ? ocb->prec_weights[f2] : -f2;
       return Q_TO_PART(w1-w2);
    }
-   return OCBFunCompareMatrix(ocb, f1, f2);
+   if((f1<=ocb->sig_size) && (f2<=ocb->sig_size))
+   {
+      return PrecedenceCompare(ocb->precedence, f1, f2);
+   }
+   return OCBFunCompareUncovered(ocb, f1, f2);
 }
 
 
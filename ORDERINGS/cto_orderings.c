@@ -37,18 +37,12 @@
 /*---------------------------------------------------------------------*/
 
 
-
-/*---------------------------------------------------------------------*/
-/*                         Exported Functions                          */
-/*---------------------------------------------------------------------*/
-
-
 /*-----------------------------------------------------------------------
 //
-// Function: TOGreater()
+// Function: term_greater()
 //
 //   Test wether t1 is greater that t2 in the ordering described by
-//   the ocb.
+//   the ocb (without consulting the result cache).
 //
 // Global Variables: -
 //
@@ -56,8 +50,8 @@
 //
 /----------------------------------------------------------------------*/
 
-bool TOGreater(OCB_p ocb, Term_p s, Term_p t, DerefType deref_s,
-               DerefType deref_t)
+static bool term_greater(OCB_p ocb, Term_p s, Term_p t, DerefType deref_s,
+                         DerefType deref_t)
 {
    bool res = false;
    /* Term_p tmp; */
@@ -105,9 +99,10 @@ bool TOGreater(OCB_p ocb, Term_p s, Term_p t, DerefType deref_s,
 
 /*-----------------------------------------------------------------------
 //
-// Function: TOCompare()
+// Function: term_compare()
 //
-//   Compare t1 and t2 in the ordering described by the ocb.
+//   Compare t1 and t2 in the ordering described by the ocb (without
+//   consulting the result cache).
 //
 // Global Variables: -
 //
@@ -115,8 +110,8 @@ bool TOGreater(OCB_p ocb, Term_p s, Term_p t, DerefType deref_s,
 //
 /----------------------------------------------------------------------*/
 
-CompareResult TOCompare(OCB_p ocb, Term_p s, Term_p t, DerefType deref_s,
-                        DerefType deref_t)
+static CompareResult term_compare(OCB_p ocb, Term_p s, Term_p t,
+                                  DerefType deref_s, DerefType deref_t)
 {
    CompareResult res = to_uncomparable /* , res1 = to_uncomparable*/;
    /* Term_p tmp; */
@@ -166,6 +161,103 @@ CompareResult TOCompare(OCB_p ocb, Term_p s, Term_p t, DerefType deref_s,
    return res;
 }
 
+/*-----------------------------------------------------------------------
+//
+// Function: res_cacheable()
+//
+//   Return true if the comparison of s and t can be answered from
+//   (and stored in) the result cache of ocb. This is the case for
+//   distinct shared ground terms. Since these contain no variables,
+//   the dereferencing modes do not matter.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline bool res_cacheable(OCB_p ocb, Term_p s, Term_p t)
+{
+   return ocb->res_cache && (s!=t) &&
+      TermIsShared(s) && TermIsShared(t) &&
+      TBTermIsGround(s) && TBTermIsGround(t);
+}
+
+
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: TOGreater()
+//
+//   Test wether t1 is greater that t2 in the ordering described by
+//   the ocb. For shared ground terms, the full comparison result is
+//   computed and cached, so that later calls (with either argument
+//   order) are answered from the cache.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes the result cache
+//
+/----------------------------------------------------------------------*/
+
+bool TOGreater(OCB_p ocb, Term_p s, Term_p t, DerefType deref_s,
+               DerefType deref_t)
+{
+   CompareResult res;
+
+   if(res_cacheable(ocb, s, t))
+   {
+      res = OrdResCacheFind(ocb->res_cache, s, t);
+      if(res == to_unknown)
+      {
+         res = term_compare(ocb, s, t, deref_s, deref_t);
+         OrdResCacheInsert(ocb->res_cache, s, t, res);
+      }
+      assert(res == term_compare(ocb, s, t, deref_s, deref_t));
+      return res == to_greater;
+   }
+   return term_greater(ocb, s, t, deref_s, deref_t);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: TOCompare()
+//
+//   Compare t1 and t2 in the ordering described by the ocb, using
+//   the result cache for shared ground terms.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes the result cache
+//
+/----------------------------------------------------------------------*/
+
+CompareResult TOCompare(OCB_p ocb, Term_p s, Term_p t, DerefType deref_s,
+                        DerefType deref_t)
+{
+   CompareResult res;
+
+   if(res_cacheable(ocb, s, t))
+   {
+      res = OrdResCacheFind(ocb->res_cache, s, t);
+      if(res == to_unknown)
+      {
+         res = term_compare(ocb, s, t, deref_s, deref_t);
+         OrdResCacheInsert(ocb->res_cache, s, t, res);
+      }
+      assert(res == term_compare(ocb, s, t, deref_s, deref_t));
+      return res;
+   }
+   return term_compare(ocb, s, t, deref_s, deref_t);
+}
+
 /*-----------------------------------------------------------------------
 //
 // Function: TOCompareSymbolParse()
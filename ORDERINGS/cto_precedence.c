@@ -0,0 +1,730 @@
+/*-----------------------------------------------------------------------
+
+File  : cto_precedence.c
+
+Contents
+
+  Compact (partial) precedences with transitive closure over
+  equivalence classes, and their extension to total precedences.
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+Changes
+
+<1> Sat Oct 17 16:20:41 CEST 2026
+    New
+
+-----------------------------------------------------------------------*/
+
+#include "cto_precedence.h"
+#include <clb_min_heap.h>
+
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: classes_lesser()
+//
+//   Return true if class c1 is known to be smaller than class c2.
+//
+// Global Variables: -
+//
+// Side Effects    : Reorganizes the relation tree
+//
+/----------------------------------------------------------------------*/
+
+static bool classes_lesser(Precedence_p prec, FunCode c1, FunCode c2)
+{
+   return NumTreeFind(&(prec->relation), PREC_KEY(prec, c1, c2))!=NULL;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: stack_delete_int()
+//
+//   Delete the (single) occurrence of val from stack.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes stack
+//
+/----------------------------------------------------------------------*/
+
+static void stack_delete_int(PStack_p stack, long val)
+{
+   PStackPointer i;
+
+   for(i=0; i<PStackGetSP(stack); i++)
+   {
+      if(PStackElementInt(stack, i) == val)
+      {
+         PStackDiscardElement(stack, i);
+         return;
+      }
+   }
+   assert(false);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: add_class_pair()
+//
+//   Record c1 < c2 for two class representatives.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void add_class_pair(Precedence_p prec, FunCode c1, FunCode c2)
+{
+   IntOrP dummy;
+
+   dummy.i_val = 0;
+   NumTreeStore(&(prec->relation), PREC_KEY(prec, c1, c2), dummy, dummy);
+   if(!prec->greater[c1])
+   {
+      prec->greater[c1] = PStackAlloc();
+   }
+   PStackPushInt(prec->greater[c1], c2);
+   if(!prec->lesser[c2])
+   {
+      prec->lesser[c2] = PStackAlloc();
+   }
+   PStackPushInt(prec->lesser[c2], c1);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: add_lesser()
+//
+//   Add c1 < c2 for two currently uncomparable classes and restore
+//   transitive closure, i.e. relate everything below or at c1 to
+//   everything above or at c2.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void add_lesser(Precedence_p prec, FunCode c1, FunCode c2)
+{
+   PStack_p      below = prec->lesser[c1], above = prec->greater[c2];
+   PStackPointer i, j, n1, n2;
+   FunCode       x, y;
+
+   /* Neither stack changes in the loop: Only classes above c2 gain
+      lesser classes, and only classes below c1 gain greater ones. */
+   n1 = below?PStackGetSP(below):0;
+   n2 = above?PStackGetSP(above):0;
+   for(i=-1; i<n1; i++)
+   {
+      x = (i<0)?c1:PStackElementInt(below, i);
+      for(j=-1; j<n2; j++)
+      {
+         y = (j<0)?c2:PStackElementInt(above, j);
+         if(!classes_lesser(prec, x, y))
+         {
+            add_class_pair(prec, x, y);
+         }
+      }
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: merge_classes()
+//
+//   Merge two uncomparable classes, keeping c1 as the
+//   representative, and restore transitive closure.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void merge_classes(Precedence_p prec, FunCode c1, FunCode c2)
+{
+   PStack_p      above = prec->greater[c2], below = prec->lesser[c2];
+   PStackPointer i;
+   FunCode       f, tmp;
+
+   f = c2;
+   do
+   {
+      prec->eq_class[f] = c1;
+      f = prec->eq_next[f];
+   }while(f!=c2);
+   tmp = prec->eq_next[c1];
+   prec->eq_next[c1] = prec->eq_next[c2];
+   prec->eq_next[c2] = tmp;
+
+   /* Detach c2... */
+   prec->greater[c2] = NULL;
+   prec->lesser[c2]  = NULL;
+   for(i=0; above && i<PStackGetSP(above); i++)
+   {
+      f = PStackElementInt(above, i);
+      NumTreeDeleteEntry(&(prec->relation), PREC_KEY(prec, c2, f));
+      stack_delete_int(prec->lesser[f], c2);
+   }
+   for(i=0; below && i<PStackGetSP(below); i++)
+   {
+      f = PStackElementInt(below, i);
+      NumTreeDeleteEntry(&(prec->relation), PREC_KEY(prec, f, c2));
+      stack_delete_int(prec->greater[f], c2);
+   }
+   /* ...and re-add its relations for c1. Nothing below c2 can be
+      above c1, otherwise c1 and c2 would have been comparable. */
+   for(i=0; above && i<PStackGetSP(above); i++)
+   {
+      f = PStackElementInt(above, i);
+      if(!classes_lesser(prec, c1, f))
+      {
+         add_lesser(prec, c1, f);
+      }
+   }
+   for(i=0; below && i<PStackGetSP(below); i++)
+   {
+      f = PStackElementInt(below, i);
+      if(!classes_lesser(prec, f, c1))
+      {
+         add_lesser(prec, f, c1);
+      }
+   }
+   if(above)
+   {
+      PStackFree(above);
+   }
+   if(below)
+   {
+      PStackFree(below);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: free_relation()
+//
+//   Free the strict relation between classes.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void free_relation(Precedence_p prec)
+{
+   FunCode i;
+
+   for(i=1; i<=prec->size; i++)
+   {
+      if(prec->greater[i])
+      {
+         PStackFree(prec->greater[i]);
+         prec->greater[i] = NULL;
+      }
+      if(prec->lesser[i])
+      {
+         PStackFree(prec->lesser[i]);
+         prec->lesser[i] = NULL;
+      }
+   }
+   NumTreeFree(prec->relation);
+   prec->relation = NULL;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: cmp_heap_keys()
+//
+//   Comparison function for integer heap entries.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static int cmp_heap_keys(IntOrP *k1, IntOrP *k2)
+{
+   return (k1->i_val > k2->i_val) - (k1->i_val < k2->i_val);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prec_user_symbol()
+//
+//   Return true if f takes part in the explicitly given precedence.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool prec_user_symbol(Precedence_p prec, FunCode f)
+{
+   FunCode c = prec->eq_class[f];
+
+   return prec->eq_next[f]!=f || prec->greater[c] || prec->lesser[c];
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prec_below()
+//
+//   Return true if src is smaller than or equal to dst in the closure
+//   of prec and the links order[j-1] < order[j] accepted so far (for
+//   j < limit, with seg[j] giving the first position of the run of
+//   links containing j). src is at position limit and thus not
+//   linked yet. Searches over the user symbols only, as every other
+//   symbol can only be left along a run of links.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool prec_below(Precedence_p prec, PStack_p users, long *pos,
+                       long *seg, long limit, FunCode src, FunCode dst)
+{
+   PStack_p      open = PStackAlloc(), seen = PStackAlloc();
+   PStackPointer i;
+   FunCode       u, v, cu, cv;
+   bool          res = false;
+
+   PStackPushInt(open, src);
+   PStackPushInt(seen, src);
+   while(!res && !PStackEmpty(open))
+   {
+      u  = PStackPopInt(open);
+      cu = prec->eq_class[u];
+      if(pos[u]<limit && seg[pos[u]]==seg[pos[dst]] && pos[u]<=pos[dst])
+      {
+         res = true;
+         break;
+      }
+      for(i=0; i<PStackGetSP(users); i++)
+      {
+         v  = PStackElementInt(users, i);
+         cv = prec->eq_class[v];
+         if(PStackFindInt(seen, v))
+         {
+            continue;
+         }
+         if((cv==cu) ||
+            (prec->greater[cu] && classes_lesser(prec, cu, cv)) ||
+            (pos[u]<limit && pos[v]<limit &&
+             seg[pos[v]]==seg[pos[u]] && pos[v]>pos[u]))
+         {
+            if(v == dst)
+            {
+               res = true;
+               break;
+            }
+            PStackPushInt(open, v);
+            PStackPushInt(seen, v);
+         }
+      }
+   }
+   PStackFree(open);
+   PStackFree(seen);
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: prec_release()
+//
+//   Decrease the number of unplaced predecessors of the class of f,
+//   and queue it (by the position of its first member) if none are
+//   left.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes indeg, queue
+//
+/----------------------------------------------------------------------*/
+
+static void prec_release(Precedence_p prec, MinHeap_p queue, long *indeg,
+                         long *pos, FunCode f)
+{
+   FunCode c = prec->eq_class[f], g;
+   long    first;
+
+   assert(indeg[c]>0);
+   indeg[c]--;
+   if(!indeg[c])
+   {
+      indeg[c] = -1;
+      first = pos[c];
+      g = prec->eq_next[c];
+      while(g!=c)
+      {
+         first = MIN(first, pos[g]);
+         g = prec->eq_next[g];
+      }
+      MinHeapAddInt(queue, first);
+   }
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: PrecedenceAlloc()
+//
+//   Allocate an empty precedence (all distinct symbols uncomparable)
+//   for symbols 1...size.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+Precedence_p PrecedenceAlloc(long size)
+{
+   Precedence_p handle = PrecedenceCellAlloc();
+   FunCode      i;
+
+   handle->size     = size;
+   handle->eq_class = SizeMalloc(sizeof(FunCode)*(size+1));
+   handle->eq_next  = SizeMalloc(sizeof(FunCode)*(size+1));
+   handle->greater  = SizeMalloc(sizeof(PStack_p)*(size+1));
+   handle->lesser   = SizeMalloc(sizeof(PStack_p)*(size+1));
+   handle->relation = NULL;
+   handle->ranks    = NULL;
+   for(i=0; i<=size; i++)
+   {
+      handle->eq_class[i] = i;
+      handle->eq_next[i]  = i;
+      handle->greater[i]  = NULL;
+      handle->lesser[i]   = NULL;
+   }
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: PrecedenceFree()
+//
+//   Free a precedence.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void PrecedenceFree(Precedence_p junk)
+{
+   long size = junk->size;
+
+   PrecedenceReset(junk);
+   SizeFree(junk->eq_class, sizeof(FunCode)*(size+1));
+   SizeFree(junk->eq_next, sizeof(FunCode)*(size+1));
+   SizeFree(junk->greater, sizeof(PStack_p)*(size+1));
+   SizeFree(junk->lesser, sizeof(PStack_p)*(size+1));
+   PrecedenceCellFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: PrecedenceReset()
+//
+//   Return prec to the empty precedence.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void PrecedenceReset(Precedence_p prec)
+{
+   FunCode i;
+
+   free_relation(prec);
+   if(prec->ranks)
+   {
+      SizeFree(prec->ranks, sizeof(long)*(prec->size+1));
+      prec->ranks = NULL;
+   }
+   for(i=0; i<=prec->size; i++)
+   {
+      prec->eq_class[i] = i;
+      prec->eq_next[i]  = i;
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: PrecedenceCompareClasses()
+//
+//   Compare two distinct class representatives in a partial
+//   precedence.
+//
+// Global Variables: -
+//
+// Side Effects    : Reorganizes the relation tree
+//
+/----------------------------------------------------------------------*/
+
+CompareResult PrecedenceCompareClasses(Precedence_p prec,
+                                       FunCode c1, FunCode c2)
+{
+   assert(!prec->ranks);
+   assert(c1 != c2);
+
+   if(!prec->greater[c1] && !prec->lesser[c1])
+   {
+      return to_uncomparable;
+   }
+   if(classes_lesser(prec, c1, c2))
+   {
+      return to_lesser;
+   }
+   if(classes_lesser(prec, c2, c1))
+   {
+      return to_greater;
+   }
+   return to_uncomparable;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: PrecedenceAddTuple()
+//
+//   Add "f1 relation f2" to a partial precedence and compute the new
+//   transitive closure. Return false (without changes) if the tuple
+//   contradicts the precedence, true otherwise. Since the precedence
+//   is always closed, this happens exactly if f1 and f2 are already
+//   related differently.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+bool PrecedenceAddTuple(Precedence_p prec, FunCode f1, FunCode f2,
+                        CompareResult relation)
+{
+   CompareResult current;
+   FunCode       c1, c2;
+
+   assert(!prec->ranks);
+   assert(relation != to_uncomparable);
+
+   current = PrecedenceCompare(prec, f1, f2);
+   if(current == relation)
+   {
+      return true;
+   }
+   if(current != to_uncomparable)
+   {
+      return false;
+   }
+   c1 = prec->eq_class[f1];
+   c2 = prec->eq_class[f2];
+   switch(relation)
+   {
+   case to_equal:
+         merge_classes(prec, c1, c2);
+         break;
+   case to_lesser:
+         add_lesser(prec, c1, c2);
+         break;
+   case to_greater:
+         add_lesser(prec, c2, c1);
+         break;
+   default:
+         assert(false);
+         break;
+   }
+   return true;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: PrecedenceLinearize()
+//
+//   Try to turn prec into a total precedence. order is a permutation
+//   of all symbols (smallest first). The links order[i-1] < order[i]
+//   are added in sequence as far as they do not contradict the
+//   precedence so far (i.e. with the same result as adding them with
+//   PrecedenceAddTuple() and ignoring failures). If the result is
+//   total, only the equivalence classes and the ranks are kept and
+//   true is returned. Otherwise, prec is left unchanged and false is
+//   returned. The result is total if order is compatible with prec,
+//   and then it is order with the classes of prec collapsed.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+bool PrecedenceLinearize(Precedence_p prec, FunCode *order, long len)
+{
+   long      *pos, *seg, *indeg, i, j, rank = 0;
+   bool      *link, total = true;
+   FunCode   c, f;
+   PStack_p  users = PStackAlloc(), above;
+   MinHeap_p queue;
+
+   assert(!prec->ranks);
+   assert(len == prec->size);
+
+   pos   = SizeMalloc(sizeof(long)*(prec->size+1));
+   seg   = SizeMalloc(sizeof(long)*len);
+   indeg = SizeMalloc(sizeof(long)*(prec->size+1));
+   link  = SizeMalloc(sizeof(bool)*len);
+   for(i=0; i<len; i++)
+   {
+      pos[order[i]] = i;
+   }
+   for(f=1; f<=prec->size; f++)
+   {
+      if(prec_user_symbol(prec, f))
+      {
+         PStackPushInt(users, f);
+      }
+   }
+
+   /* Add the links of order. Only a user symbol can already be
+      below its predecessor, as all other symbols are still
+      isolated. */
+   link[0] = false;
+   seg[0]  = 0;
+   for(i=1; i<len; i++)
+   {
+      link[i] = !prec_user_symbol(prec, order[i]) ||
+         !prec_below(prec, users, pos, seg, i, order[i], order[i-1]);
+      seg[i] = link[i]?seg[i-1]:i;
+   }
+
+   /* Sort the closure of prec and the links topologically. It is
+      total iff there is never more than one candidate. Classes are
+      represented by their representative, found via the position of
+      their first member. */
+   for(f=1; f<=prec->size; f++)
+   {
+      indeg[f] = 0;
+   }
+   for(i=0; i<len; i++)
+   {
+      f = order[i];
+      c = prec->eq_class[f];
+      if(link[i])
+      {
+         indeg[c]++;
+      }
+      if(c == f)
+      {
+         indeg[c] += prec->lesser[c]?PStackGetSP(prec->lesser[c]):0;
+      }
+   }
+   queue = MinHeapAlloc(cmp_heap_keys);
+   for(i=0; i<len; i++)
+   {
+      c = prec->eq_class[order[i]];
+      if(!indeg[c])
+      {
+         indeg[c] = -1; /* Queued */
+         MinHeapAddInt(queue, i);
+      }
+   }
+
+   prec->ranks = SizeMalloc(sizeof(long)*(prec->size+1));
+   prec->ranks[0] = 0;
+   while(MinHeapSize(queue))
+   {
+      if(MinHeapSize(queue) > 1)
+      {
+         total = false;
+         break;
+      }
+      c = prec->eq_class[order[MinHeapPopMinInt(queue)]];
+      rank++;
+      f = c;
+      do
+      {
+         prec->ranks[f] = rank;
+         j = pos[f]+1;
+         if(j<len && link[j])
+         {
+            prec_release(prec, queue, indeg, pos, order[j]);
+         }
+         f = prec->eq_next[f];
+      }while(f!=c);
+
+      above = prec->greater[c];
+      for(i=0; above && i<PStackGetSP(above); i++)
+      {
+         prec_release(prec, queue, indeg, pos,
+                      PStackElementInt(above, i));
+      }
+   }
+   MinHeapFree(queue);
+   PStackFree(users);
+   SizeFree(pos, sizeof(long)*(prec->size+1));
+   SizeFree(seg, sizeof(long)*len);
+   SizeFree(indeg, sizeof(long)*(prec->size+1));
+   SizeFree(link, sizeof(bool)*len);
+   if(!total)
+   {
+      SizeFree(prec->ranks, sizeof(long)*(prec->size+1));
+      prec->ranks = NULL;
+      return false;
+   }
+   assert(rank);
+   free_relation(prec);
+   return true;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -0,0 +1,128 @@
+/*-----------------------------------------------------------------------
+
+File  : cto_precedence.h
+
+Contents
+
+  Compact representation of (partial) precedences on function
+  symbols: Equivalence classes plus a sparse, transitively closed
+  table of strict relations between classes, and a rank array once
+  the precedence has been made total.
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+Changes
+
+<1> Sat Oct 17 16:20:41 CEST 2026
+    New
+
+-----------------------------------------------------------------------*/
+
+#ifndef CTO_PRECEDENCE
+
+#define CTO_PRECEDENCE
+
+#include <clb_partial_orderings.h>
+#include <clb_numtrees.h>
+#include <cte_functypes.h>
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+/* Symbols 1...size are covered. Every symbol points directly to the
+   representative of its equivalence class, members of a class are
+   linked in a circular list. Strict relations are only stored
+   between class representatives, and only for classes that actually
+   take part in a relation, so a user precedence over a handful of
+   symbols costs next to nothing even for huge signatures. Once the
+   precedence has been extended to a total one (see
+   PrecedenceLinearize()), comparisons only look at the rank
+   array. */
+
+typedef struct precedence_cell
+{
+   long      size;
+   FunCode   *eq_class; /* Representative of the class of f */
+   FunCode   *eq_next;  /* Next member of the class of f */
+   PStack_p  *greater;  /* Strictly greater classes, or NULL */
+   PStack_p  *lesser;   /* Strictly smaller classes, or NULL */
+   NumTree_p relation;  /* Contains PREC_KEY(c1,c2) iff c1 < c2 */
+   long      *ranks;    /* Rank of each symbol if total, else NULL */
+}PrecedenceCell, *Precedence_p;
+
+#define PREC_KEY(prec, c1, c2) ((c1)*((prec)->size+1)+(c2))
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+#define PrecedenceCellAlloc() (PrecedenceCell*)SizeMalloc(sizeof(PrecedenceCell))
+#define PrecedenceCellFree(junk) SizeFree(junk, sizeof(PrecedenceCell))
+
+Precedence_p  PrecedenceAlloc(long size);
+void          PrecedenceFree(Precedence_p junk);
+void          PrecedenceReset(Precedence_p prec);
+
+CompareResult PrecedenceCompareClasses(Precedence_p prec,
+                                       FunCode c1, FunCode c2);
+static inline CompareResult PrecedenceCompare(Precedence_p prec,
+                                              FunCode f1, FunCode f2);
+
+bool          PrecedenceAddTuple(Precedence_p prec, FunCode f1, FunCode f2,
+                                 CompareResult relation);
+bool          PrecedenceLinearize(Precedence_p prec, FunCode *order,
+                                  long len);
+
+#define PrecedenceIsTotal(prec) ((prec)->ranks!=NULL)
+
+
+/*---------------------------------------------------------------------*/
+/*                        Inline Functions                             */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: PrecedenceCompare()
+//
+//   Compare two symbols covered by prec. This is O(1) for total
+//   precedences and for symbols not mentioned in any relation.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline CompareResult PrecedenceCompare(Precedence_p prec,
+                                              FunCode f1, FunCode f2)
+{
+   FunCode c1, c2;
+
+   assert(f1>0 && f1<=prec->size);
+   assert(f2>0 && f2<=prec->size);
+
+   if(prec->ranks)
+   {
+      return Q_TO_PART(prec->ranks[f1]-prec->ranks[f2]);
+   }
+   c1 = prec->eq_class[f1];
+   c2 = prec->eq_class[f2];
+   if(c1 == c2)
+   {
+      return to_equal;
+   }
+   return PrecedenceCompareClasses(prec, c1, c2);
+}
+
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -861,6 +861,11 @@ int main(int argc, char* argv[])
 
    if(seed_preds || seed_funs || seed_consts || seedstr)
    {
+      /* Many seeds over the same axioms - share the D-relations */
+      for(i=0; i<AxFilterSetElements(filters); i++)
+      {
+         StructFOFSpecAddDRelFilter(ctrl, AxFilterSetGetFilter(filters,i));
+      }
       seeded_filters(ctrl, filters, DStrView(corename));
    }
    else
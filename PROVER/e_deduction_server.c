@@ -49,6 +49,7 @@ typedef enum
    OPT_OUTPUTLEVEL,
    OPT_GLOBAL_WTCLIMIT,
    OPT_SERVER_LIB,
+   OPT_PRELOAD,
    OPT_DUMMY
 }OptionCodes;
 
@@ -113,6 +114,14 @@ OptCell opts[] =
     ReqArg, NULL,
     "Set the axioms library directory of the server."},
 
+   {OPT_PRELOAD,
+    'P', "preload",
+    ReqArg, NULL,
+    "Load and stage the named axiom set from the server library (see "
+    "--lib) before accepting connections. The axioms are parsed and "
+    "prepared for axiom selection once, and all sessions start with "
+    "them staged. This option can be repeated."},
+
    {OPT_NOOPT,
     '\0', NULL,
     NoArg, NULL,
@@ -124,6 +133,7 @@ char              *server_lib     = NULL;
 long              total_wtc_limit = 0;
 int               port            = -1;
 bool              app_encode      = false;
+PStack_p          preload_sets    = NULL;
 
 /*---------------------------------------------------------------------*/
 /*                      Forward Declarations                           */
@@ -141,7 +151,10 @@ int main(int argc, char* argv[])
    CLState_p        state;
    BatchSpec_p      spec;
    StructFOFSpec_p   ctrl;
+   InteractiveSpec_p interactive;
    char             *prover    = "eprover";
+   char             *message;
+   PStackPointer    i;
    int oldsock,sock_fd,pid;
 
    assert(argv[0]);
@@ -154,6 +167,7 @@ int main(int argc, char* argv[])
    InitIO(NAME);
    DocOutputFormat = tstp_format;
    OutputFormat = TSTPFormat;
+   preload_sets = PStackAlloc();
 
    state = process_options(argc, argv);
 
@@ -172,6 +186,22 @@ int main(int argc, char* argv[])
    ctrl = StructFOFSpecAlloc();
    BatchStructFOFSpecInit(spec, ctrl, NULL);
 
+   /* Everything done here is inherited by the forked sessions */
+   interactive = InteractiveSpecAlloc(spec, ctrl, stdout, -1);
+   if(server_lib)
+   {
+      DStrAppendStr(interactive->server_lib, server_lib);
+   }
+   for(i=0; i<PStackGetSP(preload_sets); i++)
+   {
+      message = InteractiveSpecPreload(interactive,
+                                       PStackElementP(preload_sets, i));
+      fprintf(stdout, "%s: %s", (char*)PStackElementP(preload_sets, i),
+              message);
+   }
+   BatchStructFOFSpecPrepareFilters(ctrl);
+   fflush(stdout);
+
    //Creating Socket Server
    if(port != -1)
    {
@@ -204,7 +234,9 @@ int main(int argc, char* argv[])
          }
          else if(pid == 0)
          {
-            StartDeductionServer(spec, ctrl, server_lib, NULL, sock_fd);
+            interactive->fp      = NULL;
+            interactive->sock_fd = sock_fd;
+            InteractiveSpecServe(interactive);
             close(sock_fd);
             break;
          }
@@ -212,9 +244,11 @@ int main(int argc, char* argv[])
    }
    else
    {
-      StartDeductionServer(spec, ctrl, server_lib, stdout, -1);
+      InteractiveSpecServe(interactive);
    }
 
+   InteractiveSpecFree(interactive);
+   PStackFree(preload_sets);
    StructFOFSpecFree(ctrl);
    BatchSpecFree(spec);
 
@@ -283,6 +317,9 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_SERVER_LIB:
             server_lib = arg;
             break;
+      case OPT_PRELOAD:
+            PStackPushP(preload_sets, arg);
+            break;
       default:
             assert(false && "Unknown option");
             break;
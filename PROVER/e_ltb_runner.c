@@ -58,6 +58,7 @@ typedef enum
    OPT_SILENT,
    OPT_OUTPUTLEVEL,
    OPT_GLOBAL_WTCLIMIT,
+   OPT_AXIOM_CACHE,
    OPT_DUMMY
 }OptionCodes;
 
@@ -164,6 +165,15 @@ OptCell opts[] =
     ReqArg, NULL,
     "Set the global wall-clock limit for each batch (if any)."},
 
+   {OPT_AXIOM_CACHE,
+    '\0', "axiom-cache",
+    ReqArg, NULL,
+    "Keep binary caches of the parsed axiom files of each batch in the "
+    "given directory. A batch whose axiom files (and their contents) "
+    "are unchanged since the cache was written loads the cache instead "
+    "of parsing them again. Caches are only written for first-order "
+    "axiom sets."},
+
    {OPT_NOOPT,
     '\0', NULL,
     NoArg, NULL,
@@ -174,6 +184,7 @@ char              *outname        = NULL;
 char              *outdir         = NULL;
 long              total_wtc_limit = 0;
 bool              interactive     = false;
+char              *axiom_cache    = NULL;
 bool              app_encode      = false;
 char**            use_variants    = NULL;
 char**            provers         = NULL;
@@ -273,7 +284,9 @@ int main(int argc, char* argv[])
       if(!use_variants)
       {
          ctrl = StructFOFSpecAlloc();
+         ctrl->cache_dir = axiom_cache;
          BatchStructFOFSpecInit(spec, ctrl, ScannerGetDefaultDir(in));
+         BatchStructFOFSpecPrepareFilters(ctrl);
          now = GetSecTime();
          res = BatchProcessProblems(spec, ctrl,
                                     MAX(0,spec->total_wtc_limit-(now-start)),
@@ -395,6 +408,9 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_GLOBAL_WTCLIMIT:
        total_wtc_limit = CLStateGetIntArg(handle, arg);
        break;
+      case OPT_AXIOM_CACHE:
+       axiom_cache = arg;
+       break;
       default:
        assert(false && "Unknown option");
        break;
@@ -66,6 +66,8 @@ typedef enum
    OPT_CPU_LIMIT,
    OPT_SOFTCPU_LIMIT,
    OPT_RUSAGE_INFO,
+   OPT_PROFILE_OUT,
+   OPT_PROFILE_SAMPLE,
    OPT_SELECT_STRATEGY,
    OPT_PRINT_STRATEGY,
    OPT_PARSE_STRATEGY,
@@ -120,6 +122,10 @@ typedef enum
    OPT_FILTER_ORPHANS_LIMIT,
    OPT_FORWARD_CONTRACT_LIMIT,
    OPT_DELETE_BAD_LIMIT,
+   OPT_LAZY_EVAL_BATCH,
+   OPT_PACK_UNPROCESSED,
+   OPT_TERM_GC_LIMIT,
+   OPT_ORDERING_CACHE,
    OPT_ASSUME_COMPLETENESS,
    OPT_ASSUME_INCOMPLETENESS,
    OPT_DISABLE_EQ_FACTORING,
@@ -170,6 +176,7 @@ typedef enum
    OPT_SAT_NORMCONST,
    OPT_SAT_NORMALIZE,
    OPT_SAT_DEC_LIMIT,
+   OPT_SAT_INCREMENTAL,
    OPT_WATCHLIST,
    OPT_STATIC_WATCHLIST,
    OPT_WATCHLIST_NO_SIMPLIFY,
@@ -179,6 +186,7 @@ typedef enum
    OPT_FVINDEX_FEATURETYPES,
    OPT_FVINDEX_MAXFEATURES,
    OPT_FVINDEX_SLACK,
+   OPT_FVINDEX_BACKEND,
    OPT_RW_BW_INDEX,
    OPT_PM_FROM_INDEX,
    OPT_PM_INTO_INDEX,
@@ -188,6 +196,8 @@ typedef enum
    OPT_PDT_NO_AGECONSTR,
    OPT_DETSORT_RW,
    OPT_DETSORT_NEW,
+   OPT_BW_SIMPLIFY_WORKERS,
+   OPT_PARAMOD_WORKERS,
    OPT_DEFINE_WFUN,
    OPT_DEFINE_HEURISTIC,
    OPT_HEURISTIC,
@@ -237,6 +247,7 @@ typedef enum
    OPT_CNF_TIMEOUT_PORTION,
    OPT_PREINSTANTIATE_INDUCTION,
    OPT_SERIALIZE_SCHEDULE,
+   OPT_SHARED_TERM_BANK,
    OPT_DUMMY
 }OptionCodes;
 
@@ -519,6 +530,23 @@ OptCell opts[] =
     "more information with the rusage() system call, you will also "
     "get information about memory consumption."},
 
+   {OPT_PROFILE_OUT,
+    '\0', "profile-out",
+    ReqArg, NULL,
+    "Write a profile of the proof search to the named file (- for "
+    "stdout) at the end of the run. The file is written as CSV if its "
+    "name ends in \".csv\", and as JSON otherwise. It contains the "
+    "time spent in the phases of the given-clause loop (if the prover "
+    "was compiled with INSTRUMENT_PROFILE, which also adds index "
+    "operation counters) and the samples taken with --profile-sample."},
+
+   {OPT_PROFILE_SAMPLE,
+    '\0', "profile-sample",
+    OptArg, "1000",
+    "Sample the phase of the given-clause loop the prover is in every "
+    "given number of microseconds of CPU time. This is cheap enough to "
+    "be used in normal runs. Results are written with --profile-out."},
+
    {OPT_SELECT_STRATEGY,
     '\0', "select-strategy",
     ReqArg, NULL,
@@ -718,6 +746,15 @@ OptCell opts[] =
     ReqArg, NULL,
     "Convert parallel auto-schedule into serialized one."},
 
+    {OPT_SHARED_TERM_BANK,
+    '\0', "shared-term-bank",
+    NoArg, NULL,
+    "When strategy scheduling, freeze the term bank before starting the "
+    "strategies, so that they share it with the parent process and only "
+    "put new terms into a private overlay. Frozen terms are never "
+    "collected. This reduces the memory used per strategy. Ignored "
+    "for higher-order problems."},
+
    {OPT_SATAUTO_SCHED,
     '\0', "satauto-schedule",
     OptArg, "1",
@@ -941,6 +978,47 @@ OptCell opts[] =
     " memory limit, the prover will determine a good value"
     " automatically."},
 
+   {OPT_LAZY_EVAL_BATCH,
+    '\0', "lazy-eval-batch",
+    OptArg, "64",
+    "Do not simplify, literal-select and evaluate newly generated "
+    "clauses right away, but keep them in a holding queue ordered only "
+    "by symbol count (and, for fairness, age). Before each given clause "
+    "is picked, held clauses not larger than the clause the heuristic "
+    "would pick next, and at least the given number of further ones, "
+    "are fully processed and join the unprocessed clauses. The default "
+    "of 0 (if the option is not given) processes all new clauses "
+    "eagerly."},
+
+   {OPT_PACK_UNPROCESSED,
+    '\0', "pack-unprocessed",
+    NoArg, NULL,
+    "Store unprocessed clauses in a compact form (one flat array of "
+    "literals per clause) and only restore the full literal list when "
+    "a clause is selected for processing. This reduces the memory "
+    "used by large sets of unprocessed clauses at the cost of some "
+    "conversion overhead."},
+
+   {OPT_TERM_GC_LIMIT,
+    '\0', "term-gc-limit",
+    OptArg, "100000",
+    "Collect unused term cells during the proof search whenever the "
+    "given number of new term cells has been created since the last "
+    "collection. Usually only the new cells are examined (minor "
+    "collection), all cells are only examined once the older part of "
+    "the term bank has doubled since the last full collection. The "
+    "default of 0 (if the option is not given) only collects term "
+    "cells when bad clauses are deleted (see --delete-bad-limit)."},
+
+   {OPT_ORDERING_CACHE,
+    '\0', "ordering-cache",
+    OptArg, "32768",
+    "Remember the results of term ordering comparisons between ground "
+    "terms in a table with the given number of entries (rounded up to "
+    "a power of 2). Results stay valid until unused term cells are "
+    "collected. The default of 0 (if the option is not given) does not "
+    "cache comparisons."},
+
    {OPT_ASSUME_COMPLETENESS,
     '\0', "assume-completeness",
     NoArg, NULL,
@@ -1330,6 +1408,14 @@ OptCell opts[] =
     "Enable re-simplification (heuristic re-revaluation) of unprocessed "
     "clauses before grounding for SAT checking."},
 
+   {OPT_SAT_INCREMENTAL,
+    '\0', "satcheck-incremental",
+    NoArg, NULL,
+    "Keep the SAT solver alive between SAT checks. Only clauses that "
+    "are new or changed since the last check are grounded and added, "
+    "clauses that have left the proof state are switched off via "
+    "selector literals."},
+
    {OPT_WATCHLIST,
     '\0', "watchlist",
     OptArg, WATCHLIST_INLINE_QSTRING,
@@ -1345,7 +1431,11 @@ OptCell opts[] =
     " Use the argument " WATCHLIST_INLINE_QSTRING " (or no argument)"
     " and the special clause type "
     "'watchlist' if you want to put watchlist clauses into the normal input"
-    " stream. This is only supported for TPTP input formats."},
+    " stream. This is only supported for TPTP input formats. If the"
+    " argument is a directory, every file in it is read as the"
+    " watchlist clauses taken from one proof, and the priority function"
+    " 'ByWatchlistProgress' prefers clauses advancing the proof with"
+    " most matched clauses."},
 
    {OPT_STATIC_WATCHLIST,
     '\0', "static-watchlist",
@@ -1418,6 +1508,16 @@ OptCell opts[] =
     "be deleted from the index anyways, but will still waste "
     "(a little) time in computing feature vectors."},
 
+   {OPT_FVINDEX_BACKEND,
+    '\0', "fvindex-backend",
+    ReqArg, NULL,
+    "Select the data structure for FV-indexed subsumption. 'Trie' "
+    "(the default) uses the feature vector trie, 'Flat' stores the "
+    "feature vectors in a flat table that is scanned with SIMD "
+    "instructions if the CPU supports them. 'Flat' is only used for "
+    "feature vectors of moderate length, and is often faster for small "
+    "and medium sized clause sets."},
+
    {OPT_RW_BW_INDEX,
     '\0', "rw-bw-index",
     OptArg, "FP7",
@@ -1482,6 +1582,28 @@ OptCell opts[] =
     "Sort set of newly generated and backward simplified clauses using "
     "a total syntactic ordering."},
 
+   {OPT_BW_SIMPLIFY_WORKERS,
+    '\0', "bw-simplify-workers",
+    OptArg, "4",
+    "Use the given number of threads (including the main thread) to "
+    "find the processed clauses that are backward subsumed or backward "
+    "rewritable by a newly processed clause. The clauses are only "
+    "removed after all workers are done, in the same order as in "
+    "sequential search, so the proof search does not change. This is "
+    "only used for first-order problems and only for large candidate "
+    "sets. Note that CPU time limits count the time of all threads."},
+
+   {OPT_PARAMOD_WORKERS,
+    '\0', "paramod-workers",
+    OptArg, "4",
+    "Use the given number of threads (including the main thread) to "
+    "check which of the candidate partners from the indices unify with "
+    "the given clause in paramodulation. Only the unifiable ones are "
+    "then processed, sequentially and in the original order, so the "
+    "generated clauses do not change. This is only used for first-order "
+    "problems and only for large candidate sets. Note that CPU time "
+    "limits count the time of all threads."},
+
    {OPT_DEFINE_WFUN,
     'D', "define-weight-function",
     ReqArg, NULL,
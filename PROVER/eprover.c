@@ -20,6 +20,7 @@
 
 #include <clb_defines.h>
 #include <clb_regmem.h>
+#include <clb_profile.h>
 #include <cio_commandline.h>
 #include <cio_output.h>
 #include <ccl_relevance.h>
@@ -54,6 +55,7 @@ PERF_CTR_DEFINE(SatTimer);
 /*---------------------------------------------------------------------*/
 
 char              *outname = NULL;
+char              *profile_out = NULL;
 char              *watchlist_filename = NULL;
 char              *parse_strategy_filename = NULL;
 char              *select_strategy = NULL;
@@ -83,6 +85,7 @@ bool              print_sat = false,
    app_encode = false,
    strategy_scheduling = false,
    serialize_schedule = false,
+   share_term_bank = false,
    force_pre_schedule = true;
 ProofOutput       print_derivation = PONone;
 long              proc_training_data;
@@ -95,7 +98,8 @@ long              step_limit = LONG_MAX,
    total_limit = LONG_MAX,
    cores       = 1,
    generated_limit = LONG_MAX,
-   relevance_prune_level = 0;
+   relevance_prune_level = 0,
+   profile_sample = 0;
 long long tb_insert_limit = LLONG_MAX;
 bool lift_lambdas = true;
 int num_cpus = 1;
@@ -322,6 +326,28 @@ void strategy_io(HeuristicParms_p h_parms, PStack_p hcb_definitions)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: freeze_term_bank()
+//
+//   If requested, freeze the term bank of the proof state before
+//   the strategies of a schedule are forked off (see TBFreeze()).
+//
+// Global Variables: share_term_bank, problemType
+//
+// Side Effects    : Changes the term bank
+//
+/----------------------------------------------------------------------*/
+
+static void freeze_term_bank(ProofState_p proofstate)
+{
+   if(share_term_bank && problemType != PROBLEM_HO)
+   {
+      TBFreeze(proofstate->terms);
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: handle_auto_mode_preproc()
@@ -354,6 +380,7 @@ int handle_auto_modes_preproc(ProofState_p proofstate,
    fprintf(stdout, COMCHAR" Preprocessing class: %s.\n", raw_features->class);
    if(strategy_scheduling)
    {
+      freeze_term_bank(proofstate);
       sched_idx = ExecuteScheduleMultiCore(*preproc_schedule, h_parms,
                                            print_rusage,
                                            wc_sched_limit,
@@ -422,6 +449,7 @@ int handle_auto_modes_preproc(ProofState_p proofstate,
 /----------------------------------------------------------------------*/
 
 static void print_proof_stats(ProofState_p proofstate,
+                              OCB_p ocb,
                               long parsed_ax_no,
                               long relevancy_pruned,
                               long raw_clause_no,
@@ -457,6 +485,15 @@ static void print_proof_stats(ProofState_p proofstate,
               CondensationAttempts);
       fprintf(GlobalOut, COMCHAR" Condensation successes               : %ld\n",
               CondensationSuccesses);
+      if(ocb->res_cache)
+      {
+         fprintf(GlobalOut, COMCHAR" Ordering cache lookups (ground)      : %ld\n",
+                 ocb->res_cache->lookups);
+         fprintf(GlobalOut, COMCHAR" Ordering cache hits                  : %ld\n",
+                 ocb->res_cache->hits);
+         fprintf(GlobalOut, COMCHAR" Ordering cache evictions             : %ld\n",
+                 ocb->res_cache->evictions);
+      }
 
 #ifdef MEASURE_UNIFICATION
       fprintf(GlobalOut, COMCHAR" Unification attempts                 : %ld\n",
@@ -467,11 +504,20 @@ static void print_proof_stats(ProofState_p proofstate,
 #ifdef PDT_COUNT_NODES
       fprintf(GlobalOut, COMCHAR" PDT nodes visited                    : %ld\n",
               PDTNodeCounter);
+#endif
+#ifdef USE_ARENAMEM
+      MemArenaPrintStats(GlobalOut, NULL);
 #endif
       fprintf(GlobalOut, COMCHAR" Termbank termtop insertions          : %lld\n",
               proofstate->terms->insertions);
       fprintf(GlobalOut, COMCHAR" Search garbage collected termcells   : %lld\n",
               proofstate->terms->recovered);
+      if(proofstate->terms->minor_gcs)
+      {
+         fprintf(GlobalOut, COMCHAR" Term bank collections (minor/full)   : %ld/%ld\n",
+                 proofstate->terms->minor_gcs,
+                 proofstate->terms->full_gcs);
+      }
       if(TBPrintDetails)
       {
          TBGCCollect(proofstate->terms);
@@ -568,6 +614,7 @@ int main(int argc, char* argv[])
 #endif
 
    InitIO(NAME);
+   ProfInit();
    pid = getpid();
    //setpgid(0, 0);
 
@@ -705,6 +752,7 @@ int main(int argc, char* argv[])
          ScheduleCell* search_sched = GetSearchSchedule(class);
          InitializePlaceholderSearchSchedule(search_sched, preproc_schedule+sched_idx,
                                              force_pre_schedule);
+         freeze_term_bank(proofstate);
          int status =
             ExecuteScheduleMultiCore(search_sched,
                                      h_parms, print_rusage,
@@ -779,6 +827,10 @@ int main(int argc, char* argv[])
 
    ProofStateInit(proofstate, proofcontrol);
    //printf("Alive (2)!\n");
+   if(profile_sample && !ProfSamplingStart(profile_sample))
+   {
+      Warning("Cannot start profile sampling");
+   }
 
    VERBOUT2("Prover state initialized\n");
    preproc_time = GetTotalCPUTime();
@@ -822,8 +874,16 @@ int main(int argc, char* argv[])
                          generated_limit, tb_insert_limit, answer_limit);
    }
    PERF_CTR_EXIT(SatTimer);
+   /* Filtering, printing and proof output below need plain
+      unprocessed clauses. Unpacking all of them at once is expensive,
+      so only do it if they are actually used. */
+   if(filter_sat || print_sat || print_full_deriv || cnf_only ||
+      force_deriv_output || OutputLevel >= 2)
+   {
+      ClauseSetUnpackClauses(proofstate->unprocessed);
+   }
 
-   out_of_clauses = ClauseSetEmpty(proofstate->unprocessed);
+   out_of_clauses = ProofStateUnprocEmpty(proofstate);
    if(filter_sat)
    {
       filter_success = ProofStateFilterUnprocessed(proofstate,
@@ -1031,10 +1091,19 @@ int main(int argc, char* argv[])
    fflush(GlobalOut);
 
    print_proof_stats(proofstate,
+                     proofcontrol->ocb,
                      parsed_ax_no,
                      relevancy_pruned,
                      raw_clause_no,
                      preproc_removed);
+   if(profile_out)
+   {
+      FILE* out = OutOpen(profile_out);
+      size_t len = strlen(profile_out);
+
+      ProfDump(out, len>=4 && strcmp(profile_out+len-4, ".csv")==0);
+      OutClose(out);
+   }
 #ifndef FAST_EXIT
 #ifdef FULL_MEM_STATS
    fprintf(GlobalOut,
@@ -1305,6 +1374,12 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_RUSAGE_INFO:
             print_rusage = true;
             break;
+      case OPT_PROFILE_OUT:
+            profile_out = arg;
+            break;
+      case OPT_PROFILE_SAMPLE:
+            profile_sample = CLStateGetIntArgCheckRange(handle, arg, 1, LONG_MAX);
+            break;
       case OPT_SELECT_STRATEGY:
             select_strategy = arg;
             break;
@@ -1403,6 +1478,9 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_SERIALIZE_SCHEDULE:
             serialize_schedule = CLStateGetBoolArg(handle, arg);
             break;
+      case OPT_SHARED_TERM_BANK:
+            share_term_bank = true;
+            break;
       case OPT_FORCE_PREPROC_SCHED:
             force_pre_schedule = CLStateGetBoolArg(handle, arg);
             break;
@@ -1560,6 +1638,18 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_DELETE_BAD_LIMIT:
             h_parms->delete_bad_limit = CLStateGetIntArg(handle, arg);
             break;
+      case OPT_LAZY_EVAL_BATCH:
+            h_parms->lazy_eval_batch = CLStateGetIntArg(handle, arg);
+            break;
+      case OPT_PACK_UNPROCESSED:
+            h_parms->pack_unprocessed = true;
+            break;
+      case OPT_TERM_GC_LIMIT:
+            h_parms->term_gc_limit = CLStateGetIntArg(handle, arg);
+            break;
+      case OPT_ORDERING_CACHE:
+            h_parms->ord_res_cache_size = CLStateGetIntArg(handle, arg);
+            break;
       case OPT_ASSUME_COMPLETENESS:
             assume_inf_sys_complete = true;
             break;
@@ -1829,6 +1919,9 @@ CLState_p process_options(int argc, char* argv[])
             h_parms->sat_check_decision_limit =
                CLStateGetIntArgCheckRange(handle, arg, -1, INT_MAX);
             break;
+      case OPT_SAT_INCREMENTAL:
+            h_parms->sat_check_incremental = true;
+            break;
       case OPT_STATIC_WATCHLIST:
             h_parms->watchlist_is_static = true;
             //intentional fall-through
@@ -1929,6 +2022,21 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_FVINDEX_SLACK:
             fvi_parms->symbol_slack = CLStateGetIntArgCheckRange(handle, arg, 0, LONG_MAX);
             break;
+      case OPT_FVINDEX_BACKEND:
+            if(strcmp(arg, "Trie")==0)
+            {
+               fvi_parms->flat_index = false;
+            }
+            else if(strcmp(arg, "Flat")==0)
+            {
+               fvi_parms->flat_index = true;
+            }
+            else
+            {
+               Error("Option --fvindex-backend requires "
+                     "'Trie' or 'Flat'.", USAGE_ERROR);
+            }
+            break;
       case OPT_RW_BW_INDEX:
             check_fp_index_arg(arg, "--rw-bw-index");
             strcpy(h_parms->rw_bw_index_type, arg);
@@ -1959,6 +2067,14 @@ CLState_p process_options(int argc, char* argv[])
       case OPT_DETSORT_NEW:
             h_parms->detsort_tmpset = true;
             break;
+      case OPT_BW_SIMPLIFY_WORKERS:
+            h_parms->bw_simplify_workers =
+               CLStateGetIntArgCheckRange(handle, arg, 1, WORKPOOL_MAX_WORKERS);
+            break;
+      case OPT_PARAMOD_WORKERS:
+            h_parms->paramod_workers =
+               CLStateGetIntArgCheckRange(handle, arg, 1, WORKPOOL_MAX_WORKERS);
+            break;
       case OPT_DEFINE_WFUN:
             PStackPushP(wfcb_definitions, arg);
             break;
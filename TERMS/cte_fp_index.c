@@ -23,6 +23,7 @@ Changes
 
 #include "cte_fp_index.h"
 #include "cte_termfunc.h"
+#include <clb_profile.h>
 
 
 
@@ -201,6 +202,7 @@ static long fp_index_rek_find_unif(FPTree_p index, IndexFP_p key,
    {
       return 0;
    }
+   PROF_COUNT(ProfFPVisits);
    if(current == key[0])
    {
       PStackPushP(collect, index->payload);
@@ -316,6 +318,7 @@ static long fp_index_rek_find_matchable(FPTree_p index, IndexFP_p key,
    {
       return 0;
    }
+   PROF_COUNT(ProfFPVisits);
    if(current == key[0])
    {
       PStackPushP(collect, index->payload);
@@ -755,6 +758,7 @@ long dt_index_rek_find_matchable(FPTree_p index,
    {
       return 0;
    }
+   PROF_COUNT(ProfFPVisits);
    if(skip_term)
    {
       iter = IntMapIterAlloc(index->f_alternatives, BELOW_VAR, LONG_MAX);
@@ -839,6 +843,7 @@ static long dt_index_rek_find_unifiable(FPTree_p index,
    {
       return 0;
    }
+   PROF_COUNT(ProfFPVisits);
    if(skip_term)
    {
       iter = IntMapIterAlloc(index->f_alternatives, BELOW_VAR, LONG_MAX);
@@ -1258,6 +1263,8 @@ long FPIndexFindUnifiable(FPIndex_p index, Term_p term, PStack_p collect)
       res = FPTreeFindUnifiable(index->index, key, index->sig, collect);
    }
    IndexFPFree(key);
+   PROF_COUNT(ProfFPSearches);
+   PROF_COUNT_ADD(ProfFPHits, res);
    PERF_CTR_EXIT(IndexUnifTimer);
    return res;
 }
@@ -1303,6 +1310,8 @@ long FPIndexFindMatchable(FPIndex_p index, Term_p term, PStack_p collect)
 
    }
    IndexFPFree(key);
+   PROF_COUNT(ProfFPSearches);
+   PROF_COUNT_ADD(ProfFPHits, res);
    PERF_CTR_EXIT(IndexMatchTimer);
    return res;
 }
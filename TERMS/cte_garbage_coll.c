@@ -60,6 +60,7 @@ GCAdmin_p GCAdminAlloc()
 
    handle->clause_sets  = NULL;
    handle->formula_sets = NULL;
+   handle->term_stacks  = NULL;
 
    return handle;
 }
@@ -83,6 +84,7 @@ void GCAdminFree(GCAdmin_p junk)
 
    PTreeFree(junk->clause_sets);
    PTreeFree(junk->formula_sets);
+   PTreeFree(junk->term_stacks);
 
    GCAdminCellFree(junk);
 }
@@ -173,6 +175,47 @@ void GCDeregisterClauseSet(GCAdmin_p gc, void* set)
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: GCRegisterTermStack()
+//
+//   Register a stack of terms that have to survive garbage
+//   collection even if no clause or formula refers to them.
+//
+// Global Variables: -
+//
+// Side Effects    : Via PTReeStore()
+//
+/----------------------------------------------------------------------*/
+
+void GCRegisterTermStack(GCAdmin_p gc, PStack_p stack)
+{
+   assert(gc);
+   assert(stack);
+   PTreeStore(&(gc->term_stacks), stack);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: GCDeregisterTermStack()
+//
+//   Unregister a term stack.
+//
+// Global Variables: -
+//
+// Side Effects    : Via PTreeDeleteEntry()
+//
+/----------------------------------------------------------------------*/
+
+void GCDeregisterTermStack(GCAdmin_p gc, PStack_p stack)
+{
+   assert(gc);
+   assert(stack);
+   PTreeDeleteEntry(&(gc->term_stacks), stack);
+}
+
+
 /*---------------------------------------------------------------------*/
 /*                        End of File                                  */
 /*---------------------------------------------------------------------*/
@@ -27,6 +27,7 @@
 
 
 #include <clb_ptrees.h>
+#include <clb_pstacks.h>
 
 
 /*---------------------------------------------------------------------*/
@@ -38,6 +39,7 @@ typedef struct gc_admin_cell
 {
    PTree_p clause_sets;
    PTree_p formula_sets;
+   PTree_p term_stacks;  /* PStacks of terms that are kept alive */
 }GCAdminCell, *GCAdmin_p;
 
 
@@ -56,6 +58,8 @@ void      GCRegisterFormulaSet(GCAdmin_p gc, void* set);
 void      GCRegisterClauseSet(GCAdmin_p gc, void* set);
 void      GCDeregisterFormulaSet(GCAdmin_p gc, void *set);
 void      GCDeregisterClauseSet(GCAdmin_p gc, void* set);
+void      GCRegisterTermStack(GCAdmin_p gc, PStack_p stack);
+void      GCDeregisterTermStack(GCAdmin_p gc, PStack_p stack);
 
 //long      GCCollect(GCAdmin_p gc);
 
@@ -0,0 +1,410 @@
+/*-----------------------------------------------------------------------
+
+  File  : cte_localsubst.c
+
+  Contents
+
+  Substitutions with private binding tables, for matching in worker
+  threads.
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 18:40:27 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#include "cte_localsubst.h"
+#include <cte_termbanks.h>
+
+
+
+/*---------------------------------------------------------------------*/
+/*                        Global Variables                             */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                      Forward Declarations                           */
+/*---------------------------------------------------------------------*/
+
+
+/*---------------------------------------------------------------------*/
+/*                         Internal Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: local_deref()
+//
+//   Follow the bindings of variables in subst.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline Term_p local_deref(LocalSubst_p subst, Term_p term)
+{
+   while(TermIsFreeVar(term) && subst->bindings[-term->f_code])
+   {
+      term = subst->bindings[-term->f_code];
+   }
+   return term;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: local_occur_check()
+//
+//   Return true if var occurs in term instantiated with subst (as
+//   OccurCheck()).
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static bool local_occur_check(LocalSubst_p subst, Term_p term, Term_p var)
+{
+   int i;
+
+   term = local_deref(subst, term);
+   if(term == var)
+   {
+      return true;
+   }
+   if(TermIsGround(term))
+   {
+      return false;
+   }
+   for(i=0; i < term->arity; i++)
+   {
+      if(local_occur_check(subst, term->args[i], var))
+      {
+         return true;
+      }
+   }
+   return false;
+}
+
+
+
+/*---------------------------------------------------------------------*/
+/*                         Exported Functions                          */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: LocalSubstAlloc()
+//
+//   Allocate an empty local substitution without any space for
+//   bindings.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+LocalSubst_p LocalSubstAlloc(void)
+{
+   LocalSubst_p handle = LocalSubstCellAlloc();
+
+   handle->max_var   = 0;
+   handle->bindings  = NULL;
+   handle->trail_top = 0;
+   handle->trail     = NULL;
+   handle->jobs_size = 0;
+   handle->jobs      = NULL;
+
+   return handle;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: LocalSubstFree()
+//
+//   Free a local substitution.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void LocalSubstFree(LocalSubst_p junk)
+{
+   if(junk->bindings)
+   {
+      FREE(junk->bindings);
+      FREE(junk->trail);
+   }
+   if(junk->jobs)
+   {
+      FREE(junk->jobs);
+   }
+   LocalSubstCellFree(junk);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: LocalSubstReserve()
+//
+//   Make sure that subst can handle patterns with variables up to
+//   -max_var and with up to max_size symbols. The substitution must
+//   be empty.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void LocalSubstReserve(LocalSubst_p subst, long max_var, long max_size)
+{
+   long i;
+
+   assert(subst->trail_top == 0);
+
+   if(max_var > subst->max_var)
+   {
+      subst->bindings = SecureRealloc(subst->bindings,
+                                      sizeof(Term_p)*(max_var+1));
+      subst->trail    = SecureRealloc(subst->trail,
+                                      sizeof(long)*(max_var+1));
+      for(i=subst->max_var; i<=max_var; i++)
+      {
+         subst->bindings[i] = NULL;
+      }
+      subst->max_var = max_var;
+   }
+   if(2*max_size+2 > subst->jobs_size)
+   {
+      subst->jobs_size = 2*max_size+2;
+      subst->jobs = SecureRealloc(subst->jobs,
+                                  sizeof(Term_p)*subst->jobs_size);
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: LocalSubstReserveTerm()
+//
+//   Make sure that subst can handle pattern.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void LocalSubstReserveTerm(LocalSubst_p subst, Term_p pattern)
+{
+   LocalSubstReserve(subst, -TermFindMaxVarCode(pattern),
+                     TermWeight(pattern, 1, 1));
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: LocalSubstComputeMatch()
+//
+//   Try to compute a match from matcher onto to_match and record it
+//   in subst. This follows SubstComputeMatch() (and has to find the
+//   same matches), but bindings are only stored in subst. Return
+//   true if a match exists (subst needs to be backtracked by the
+//   caller), false otherwise (subst is unchanged). The space for
+//   matcher must have been reserved.
+//
+//   This neither changes terms nor allocates memory and can be used
+//   in worker threads.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes subst
+//
+/----------------------------------------------------------------------*/
+
+bool LocalSubstComputeMatch(LocalSubst_p subst, Term_p matcher,
+                            Term_p to_match)
+{
+   long   matcher_weight  = TermStandardWeight(matcher);
+   long   to_match_weight = TermStandardWeight(to_match);
+   long   backtrack       = LocalSubstGetSP(subst);
+   long   sp = 0;
+   Term_p *jobs = subst->jobs;
+   Term_p binding;
+   bool   res = true;
+   int    i;
+
+   assert(problemType == PROBLEM_FO);
+
+   if((matcher_weight > to_match_weight) ||
+      (TermCellQueryProp(to_match, TPPredPos) && TermIsFreeVar(matcher)))
+   {
+      return false;
+   }
+
+   jobs[sp++] = matcher;
+   jobs[sp++] = to_match;
+
+   while(sp)
+   {
+      to_match = jobs[--sp];
+      matcher  = jobs[--sp];
+
+      if(TermIsFreeVar(matcher))
+      {
+         assert(-matcher->f_code <= subst->max_var);
+         if(matcher->type != to_match->type)
+         {
+            res = false;
+            break;
+         }
+         binding = subst->bindings[-matcher->f_code];
+         if(binding)
+         {
+            if(binding != to_match)
+            {
+               res = false;
+               break;
+            }
+         }
+         else
+         {
+            subst->bindings[-matcher->f_code] = to_match;
+            subst->trail[subst->trail_top++] = -matcher->f_code;
+         }
+
+         matcher_weight += TermStandardWeight(to_match) - DEFAULT_VWEIGHT;
+
+         if(matcher_weight > to_match_weight)
+         {
+            res = false;
+            break;
+         }
+      }
+      else
+      {
+         if(matcher->f_code != to_match->f_code)
+         {
+            res = false;
+            break;
+         }
+         assert(sp+2*matcher->arity <= subst->jobs_size);
+         for(i=matcher->arity-1; i>=0; i--)
+         {
+            jobs[sp++] = matcher->args[i];
+            jobs[sp++] = to_match->args[i];
+         }
+      }
+   }
+   if(!res)
+   {
+      LocalSubstBacktrackToPos(subst, backtrack);
+   }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: LocalSubstMayUnify()
+//
+//   Decide if t1 and t2 are unifiable, with the same result as
+//   SubstComputeMgu(), but without touching the terms. Return false
+//   if they are not, true if they are or if the reserved space of
+//   subst is not sufficient to find out. subst is empty again
+//   afterwards.
+//
+//   This neither changes terms nor allocates memory and can be used
+//   in worker threads.
+//
+// Global Variables: -
+//
+// Side Effects    : Uses subst
+//
+/----------------------------------------------------------------------*/
+
+bool LocalSubstMayUnify(LocalSubst_p subst, Term_p t1, Term_p t2)
+{
+   long   sp = 0;
+   Term_p *jobs = subst->jobs;
+   bool   res = true;
+   int    i;
+
+   assert(problemType == PROBLEM_FO);
+   assert(subst->trail_top == 0);
+
+   if((TermCellQueryProp(t1, TPPredPos) && TermIsFreeVar(t2))||
+      (TermCellQueryProp(t2, TPPredPos) && TermIsFreeVar(t1)))
+   {
+      return false;
+   }
+
+   jobs[sp++] = t1;
+   jobs[sp++] = t2;
+
+   while(sp)
+   {
+      t2 = local_deref(subst, jobs[--sp]);
+      t1 = local_deref(subst, jobs[--sp]);
+
+      if(TermIsFreeVar(t2))
+      {
+         SWAP(t1, t2);
+      }
+      if(TermIsFreeVar(t1))
+      {
+         if(t1 != t2)
+         {
+            if(-t1->f_code > subst->max_var)
+            {  /* Not reserved, be conservative */
+               break;
+            }
+            if((t1->type != t2->type) || local_occur_check(subst, t2, t1))
+            {
+               res = false;
+               break;
+            }
+            subst->bindings[-t1->f_code] = t2;
+            subst->trail[subst->trail_top++] = -t1->f_code;
+         }
+      }
+      else
+      {
+         if(t1->f_code != t2->f_code)
+         {
+            res = false;
+            break;
+         }
+         if(sp+2*t1->arity > subst->jobs_size)
+         {  /* Out of space, be conservative */
+            break;
+         }
+         for(i=t1->arity-1; i>=0; i--)
+         {
+            jobs[sp++] = t1->args[i];
+            jobs[sp++] = t2->args[i];
+         }
+      }
+   }
+   LocalSubstBacktrack(subst);
+   return res;
+}
+
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -0,0 +1,103 @@
+/*-----------------------------------------------------------------------
+
+  File  : cte_localsubst.h
+
+  Contents
+
+  Substitutions that keep their bindings in a private table indexed
+  by variable code instead of in the binding fields of the (shared)
+  variable cells. Matching with these never writes to term cells or
+  allocates memory, so independent matching problems over the same
+  terms can be solved in parallel by worker threads, each with its
+  own LocalSubst. The caller has to reserve enough space for the
+  pattern terms beforehand. In the same way, unifiability of two
+  terms can be checked (without computing the unifier for later
+  use).
+
+  Only first-order terms are supported.
+
+  This code is released under the GNU General Public Licence and
+  the GNU Lesser General Public License.
+  See the file COPYING in the main E directory for details..
+  Run "eprover -h" for contact information.
+
+  Changes
+
+  Created: Sat Oct 17 18:40:27 CEST 2026
+
+  -----------------------------------------------------------------------*/
+
+#ifndef CTE_LOCALSUBST
+
+#define CTE_LOCALSUBST
+
+#include <cte_termfunc.h>
+
+
+/*---------------------------------------------------------------------*/
+/*                    Data type declarations                           */
+/*---------------------------------------------------------------------*/
+
+typedef struct local_subst_cell
+{
+   long    max_var;    /* Variables -1...-max_var can be bound */
+   Term_p  *bindings;  /* Indexed by -f_code */
+   long    trail_top;
+   long    *trail;     /* Bound variables (as -f_code), max_var many */
+   long    jobs_size;  /* Enough for patterns of jobs_size/2 symbols */
+   Term_p  *jobs;
+}LocalSubstCell, *LocalSubst_p;
+
+
+/*---------------------------------------------------------------------*/
+/*                Exported Functions and Variables                     */
+/*---------------------------------------------------------------------*/
+
+#define LocalSubstCellAlloc()    (LocalSubstCell*)SizeMalloc(sizeof(LocalSubstCell))
+#define LocalSubstCellFree(junk) SizeFree(junk, sizeof(LocalSubstCell))
+
+LocalSubst_p LocalSubstAlloc(void);
+void         LocalSubstFree(LocalSubst_p junk);
+
+void         LocalSubstReserve(LocalSubst_p subst, long max_var,
+                               long max_size);
+void         LocalSubstReserveTerm(LocalSubst_p subst, Term_p pattern);
+
+#define      LocalSubstGetSP(subst) ((subst)->trail_top)
+static inline void LocalSubstBacktrackToPos(LocalSubst_p subst, long pos);
+#define      LocalSubstBacktrack(subst) LocalSubstBacktrackToPos((subst), 0)
+
+bool         LocalSubstComputeMatch(LocalSubst_p subst, Term_p matcher,
+                                    Term_p to_match);
+bool         LocalSubstMayUnify(LocalSubst_p subst, Term_p t1, Term_p t2);
+
+
+/*---------------------------------------------------------------------*/
+/*                     Inline Functions                                */
+/*---------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------
+//
+// Function: LocalSubstBacktrackToPos()
+//
+//   Undo all bindings made after the trail position pos.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes subst
+//
+/----------------------------------------------------------------------*/
+
+static inline void LocalSubstBacktrackToPos(LocalSubst_p subst, long pos)
+{
+   while(subst->trail_top > pos)
+   {
+      subst->bindings[subst->trail[--subst->trail_top]] = NULL;
+   }
+}
+
+#endif
+
+/*---------------------------------------------------------------------*/
+/*                        End of File                                  */
+/*---------------------------------------------------------------------*/
@@ -77,8 +77,8 @@ void TermAddRWLink(Term_p term, Term_p replace, struct clause_cell *demod,
       TermCellSetProp(term, TPIsRRewritten);
    }
 
-   TermRWReplaceField(term) = replace;
-   TermRWDemodField(term)   = demod;
+   TermRWDescRef(term)->replace = replace;
+   TermRWDescRef(term)->demod   = demod;
 
    if(sos)
    {
@@ -105,8 +105,12 @@ void TermDeleteRWLink(Term_p term)
 
    TermCellDelProp(term, TPIsRewritten|TPIsRRewritten|TPIsSOSRewritten);
 
-   TermRWReplaceField(term) = NULL;
-   TermRWDemodField(term)   = 0;
+#ifdef COMPACT_TERMCELLS
+   TermColdDelete(term);
+#else
+   TermRWDescRef(term)->replace = NULL;
+   TermRWDescRef(term)->demod   = 0;
+#endif
 }
 
 
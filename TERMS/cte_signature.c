@@ -662,7 +662,6 @@ void SigSetAllSpecial(Sig_p sig, bool value)
 FunCode SigInsertId(Sig_p sig, const char* name, int arity, bool special_id)
 {
    long      pos;
-   StrTree_p new, test;
    DStr_p    raw_name = DStrAlloc(), fix_name = DStrAlloc();
    const char *rawname, *prtname;
 
@@ -710,7 +709,38 @@ FunCode SigInsertId(Sig_p sig, const char* name, int arity, bool special_id)
       DStrFree(fix_name);
       return pos; /* all is fine... */
    }
-   /* Now insert the new name...ensure that there is space */
+   /* Now insert the new name */
+   pos = SigAppendId(sig, rawname, prtname, arity);
+   SigSetSpecial(sig, pos, special_id);
+   DStrFree(raw_name);
+   DStrFree(fix_name);
+   return pos;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: SigAppendId()
+//
+//   Add a new symbol with the given internal name, print name and
+//   arity to the signature, without any of the checks and renaming of
+//   SigInsertId(). name must not be in the signature yet. Return the
+//   new f_code.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+FunCode SigAppendId(Sig_p sig, const char* name, const char* pname,
+                    int arity)
+{
+   StrTree_p new, test;
+
+   assert(!SigFindFCode(sig, name));
+
+   /* Ensure that there is space */
    if(sig->f_count == sig->size-1)
    {
       /* sig->size+= DEFAULT_SIGNATURE_SIZE; */
@@ -722,9 +752,9 @@ FunCode SigInsertId(Sig_p sig, const char* name, int arity, bool special_id)
    /* Insert the element in f_index and f_info */
    sig->f_count++;
    sig->f_info[sig->f_count].name
-      = SecureStrdup(rawname);
+      = SecureStrdup(name);
    sig->f_info[sig->f_count].pname
-      = SecureStrdup(prtname);
+      = SecureStrdup(pname);
    sig->f_info[sig->f_count].arity = arity;
    sig->f_info[sig->f_count].properties = FPIgnoreProps;
    sig->f_info[sig->f_count].type = NULL;
@@ -736,10 +766,7 @@ FunCode SigInsertId(Sig_p sig, const char* name, int arity, bool special_id)
 
    test = StrTreeInsert(&(sig->f_index), new);
    UNUSED(test); assert(test == NULL);
-   SigSetSpecial(sig,sig->f_count,special_id);
    sig->alpha_ranks_valid = false;
-   DStrFree(raw_name);
-   DStrFree(fix_name);
    return sig->f_count;
 }
 
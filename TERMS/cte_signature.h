@@ -267,6 +267,8 @@ int     SigGetAlphaRank(Sig_p sig, FunCode f_code);
 
 FunCode SigInsertId(Sig_p sig, const char* name, int arity, bool
           special_id);
+FunCode SigAppendId(Sig_p sig, const char* name, const char* pname,
+                    int arity);
 FunCode SigPopId(Sig_p sig);
 long    SigBacktrack(Sig_p sig, FunCode f_count);
 
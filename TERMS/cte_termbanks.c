@@ -161,8 +161,15 @@ static Term_p tb_termtop_insert(TB_p bank, Term_p t)
 
    if(new) /* Term node already existed, just add properties */
    {
+      TermProperties props = t->properties & ~TPHasColdData;
+
       assert(!TermIsShared(t));
-      new->properties = (new->properties | t->properties)/*& bank->prop_mask*/;
+      /* Only write if necessary, the cell may be frozen. Side table
+         entries belong to the cell, not to the term. */
+      if((new->properties | props) != new->properties)
+      {
+         new->properties = (new->properties | props)/*& bank->prop_mask*/;
+      }
       TermTopFree(t);
       TermSetBank(t, bank);
       t = new;
@@ -171,6 +178,10 @@ static Term_p tb_termtop_insert(TB_p bank, Term_p t)
    {
       t->entry_no     = ++(bank->in_count);
       TermSetBank(t, bank);
+      if(bank->young)
+      {
+         PStackPushP(bank->young, t);
+      }
       TermCellAssignProp(t,TPGarbageFlag, bank->garbage_state);
       TermCellSetProp(t, TPIsShared); /* Groundness may change below */
       if(TermIsDBVar(t))
@@ -603,8 +614,8 @@ Term_p do_tb_insert_no_props_cached(TB_p bank, Term_p term,
          t = TermTopCopyWithoutArgs(term); /* This is an unshared term cell at the moment */
          t->properties = TPIgnoreProps;
 
-         assert(SysDateIsCreationDate(t->rw_data.nf_date[0]));
-         assert(SysDateIsCreationDate(t->rw_data.nf_date[1]));
+         assert(SysDateIsCreationDate(TermNFDates(t)[0]));
+         assert(SysDateIsCreationDate(TermNFDates(t)[1]));
 
          for(i=0; i<t->arity; i++)
          {
@@ -749,8 +760,18 @@ TB_p TBAlloc(Sig_p sig)
    handle->in_count = 0;
    handle->insertions = 0;
    handle->recovered = 0;
+   handle->gc_epoch = 0;
    handle->ext_index = PDIntArrayAlloc(1,100000);
    handle->garbage_state = TPIgnoreProps;
+   handle->young = NULL;
+   handle->remembered = NULL;
+   handle->old_limit = 0;
+   handle->gc_minor = false;
+   handle->full_survivors = 0;
+   handle->minor_gcs = 0;
+   handle->full_gcs = 0;
+   handle->frozen_limit = 0;
+   handle->frozen_links = NULL;
    handle->gc = GCAdminAlloc();
    handle->sig = sig;
    handle->vars = VarBankAlloc(sig->type_bank);
@@ -795,6 +816,15 @@ void TBFree(TB_p junk)
     */
    TermCellStoreExit(&(junk->term_store));
    PDArrayFree(junk->ext_index);
+   if(junk->young)
+   {
+      PStackFree(junk->young);
+      PStackFree(junk->remembered);
+   }
+   if(junk->frozen_links)
+   {
+      PStackFree(junk->frozen_links);
+   }
    GCAdminFree(junk->gc);
    VarBankFree(junk->vars);
    PDArrayFree(junk->min_terms);
@@ -882,8 +912,8 @@ Term_p TBInsert(TB_p bank, Term_p term, DerefType deref)
    {
       t = TermTopCopyWithoutArgs(term); /* This is an unshared term cell at the moment */
 
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[0]));
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[1]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[0]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[1]));
 
       for(i=0; i<t->arity; i++)
       {
@@ -975,8 +1005,8 @@ Term_p TBInsertIgnoreVar(TB_p bank, Term_p term, DerefType deref)
    {
       t = TermTopCopyWithoutArgs(term); /* This is an unshared term cell at the moment */
 
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[0]));
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[1]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[0]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[1]));
 
       for(i=0; i<t->arity; i++)
       {
@@ -1041,8 +1071,8 @@ Term_p TBInsertNoProps(TB_p bank, Term_p term, DerefType deref)
       t = TermTopCopyWithoutArgs(term); /* This is an unshared term cell at the moment */
       t->properties = TPIgnoreProps;
 
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[0]));
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[1]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[0]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[1]));
 
       for(i=0; i<t->arity; i++)
       {
@@ -1128,8 +1158,8 @@ Term_p  TBInsertRepl(TB_p bank, Term_p term, DerefType deref, Term_p old, Term_p
       t = TermTopCopyWithoutArgs(term); /* This is an unshared term cell at the moment */
       t->properties = TPIgnoreProps;
 
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[0]));
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[1]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[0]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[1]));
 
       for(i=0; i<t->arity; i++)
       {
@@ -1179,8 +1209,8 @@ Term_p TBInsertReplPlain(TB_p bank, Term_p term, Term_p old, Term_p repl)
       t = TermTopCopyWithoutArgs(term); /* This is an unshared term cell at the moment */
       t->properties = TPIgnoreProps;
 
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[0]));
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[1]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[0]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[1]));
 
       for(i=0; i<t->arity; i++)
       {
@@ -1256,8 +1286,8 @@ Term_p TBInsertInstantiatedFO(TB_p bank, Term_p term)
       t = TermTopCopyWithoutArgs(term); /* This is an unshared term cell at the moment */
       t->properties    = TPIgnoreProps;
 
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[0]));
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[1]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[0]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[1]));
 
       for(i=0; i<t->arity; i++)
       {
@@ -1325,8 +1355,8 @@ Term_p TBInsertInstantiatedHO(TB_p bank, Term_p term, bool follow_bind)
       t = TermTopCopyWithoutArgs(term); /* This is an unshared term cell at the moment */
       t->properties    = TPIgnoreProps;
 
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[0]));
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[1]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[0]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[1]));
 
       for(i=0; i<t->arity; i++)
       {
@@ -1406,8 +1436,8 @@ Term_p TBInsertOpt(TB_p bank, Term_p term, DerefType deref)
    {
       t = TermTopCopyWithoutArgs(term); /* This is an unshared term cell at the moment */
 
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[0]));
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[1]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[0]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[1]));
 
       for(i=0; i<t->arity; i++)
       {
@@ -1459,8 +1489,8 @@ Term_p  TBInsertDisjoint(TB_p bank, Term_p term)
    {
       t = TermTopCopyWithoutArgs(term); /* This is an unshared term cell at the moment */
 
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[0]));
-      assert(SysDateIsCreationDate(t->rw_data.nf_date[1]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[0]));
+      assert(SysDateIsCreationDate(TermNFDates(t)[1]));
 
       for(i=0; i<t->arity; i++)
       {
@@ -1558,20 +1588,14 @@ Term_p TBFind(TB_p bank, Term_p term)
 void TBPrintBankInOrder(FILE* out, TB_p bank)
 {
    NumTree_p tree = NULL;
-   long i;
-   PStack_p stack;
+   long     pos = 0;
    Term_p   cell;
    IntOrP   dummy;
 
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   while((cell = TermCellStoreTraverseNext(&(bank->term_store), &pos)))
    {
-      stack = TermTreeTraverseInit(bank->term_store.store[i]);
-      while((cell = TermTreeTraverseNext(stack)))
-      {
-         dummy.p_val = cell;
-         NumTreeStore(&tree, cell->entry_no,dummy, dummy);
-      }
-      TermTreeTraverseExit(stack);
+      dummy.p_val = cell;
+      NumTreeStore(&tree, cell->entry_no,dummy, dummy);
    }
    tb_print_dag(out, tree, bank->sig);
    NumTreeFree(tree);
@@ -1670,30 +1694,17 @@ void TBPrintTerm(FILE* out, TB_p bank, Term_p term, bool fullterms)
 
 void TBPrintBankTerms(FILE* out, TB_p bank)
 {
-   PStack_p stack = PStackAlloc();
    Term_p term;
-   int i;
+   long   pos = 0;
 
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   while((term = TermCellStoreTraverseNext(&(bank->term_store), &pos)))
    {
-      PStackPushP(stack, bank->term_store.store[i]);
-
-      while(!PStackEmpty(stack))
+      if(TermCellQueryProp(term, TPTopPos))
       {
-         term = PStackPopP(stack);
-         if(term)
-         {
-            PStackPushP(stack, term->lson);
-            PStackPushP(stack, term->rson);
-            if(TermCellQueryProp(term, TPTopPos))
-            {
-               TBPrintTermCompact(out, bank, term);
-               fprintf(out, "\n");
-            }
-         }
+         TBPrintTermCompact(out, bank, term);
+         fprintf(out, "\n");
       }
    }
-   PStackFree(stack);
 }
 
 
@@ -2086,11 +2097,48 @@ long TBTermSetPropCount(Term_p term, TermProperties prop)
 
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: tb_gc_mark_frozen_links()
+//
+//   Mark the targets of rewrite links from frozen cells. These cells
+//   are never marked themselves, so the links have to be treated as
+//   roots.
+//
+// Global Variables: -
+//
+// Side Effects    : Marks terms
+//
+/----------------------------------------------------------------------*/
+
+static void tb_gc_mark_frozen_links(TB_p bank)
+{
+   PStackPointer sp;
+   Term_p        t;
+
+   if(!bank->frozen_links)
+   {
+      return;
+   }
+   for(sp=0; sp<PStackGetSP(bank->frozen_links); sp++)
+   {
+      t = PStackElementP(bank->frozen_links, sp);
+      if(TermIsRewritten(t))
+      {
+         TBGCMarkTerm(bank, TermRWReplaceField(t));
+      }
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: TBGCMarkTerm()
 //
-//   Mark a term as used for the garbage collector.
+//   Mark a term as used for the garbage collector. During a minor
+//   collection, old cells (and variables) are neither marked nor
+//   descended into - their arguments are old as well. The same holds
+//   for frozen cells in all collections.
 //
 // Global Variables: -
 //
@@ -2110,6 +2158,15 @@ void TBGCMarkTerm(TB_p bank, Term_p term)
    while(!PStackEmpty(stack))
    {
       term = PStackPopP(stack);
+      if(bank->gc_minor &&
+         (TermIsAnyVar(term) || term->entry_no <= bank->old_limit))
+      {
+         continue;
+      }
+      if(TBTermIsFrozen(bank, term))
+      {
+         continue;
+      }
       if(!TBTermCellIsMarked(bank,term))
       {
          TermCellFlipProp(term, TPGarbageFlag);
@@ -2165,6 +2222,7 @@ long TBGCSweep(TB_p bank)
          TBGCMarkTerm(bank, t);
       }
    }
+   tb_gc_mark_frozen_links(bank);
    VERBOUT("Garbage collection started.\n");
    recovered = TermCellStoreGCSweep(&(bank->term_store),
                                     bank->garbage_state);
@@ -2181,10 +2239,161 @@ long TBGCSweep(TB_p bank)
    bank->garbage_state =
       bank->garbage_state?TPIgnoreProps:TPGarbageFlag;
    bank->recovered+=recovered;
+   if(recovered)
+   {
+      bank->gc_epoch++;
+   }
+   if(bank->young)
+   {
+      PStackReset(bank->young);
+      PStackReset(bank->remembered);
+      bank->old_limit = bank->in_count;
+   }
+   bank->full_survivors = TermCellStoreNodes(&(bank->term_store));
+   bank->full_gcs++;
    return recovered;
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: TBGCEnableGenerations()
+//
+//   Start keeping track of newly created term cells, so that they
+//   can be collected by TBGCSweepYoung() without looking at the rest
+//   of the bank. All existing cells are considered old.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void TBGCEnableGenerations(TB_p bank)
+{
+   if(!bank->young)
+   {
+      bank->young          = PStackAlloc();
+      bank->remembered     = PStackAlloc();
+      bank->old_limit      = bank->in_count;
+      bank->full_survivors = TermCellStoreNodes(&(bank->term_store));
+   }
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: TBGCSweepYoung()
+//
+//   Minor collection: Free all unmarked term cells created since the
+//   last collection and make the survivors old. The caller has to
+//   set bank->gc_minor and mark all external references to young
+//   cells before. Remembered rewrite links and the special terms are
+//   marked here. The cost is proportional to the number of young
+//   cells, the rest of the bank is not touched. Returns the number
+//   of term cells recovered.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, resets bank->gc_minor
+//
+/----------------------------------------------------------------------*/
+
+long TBGCSweepYoung(TB_p bank)
+{
+   long          recovered = 0, i;
+   PStackPointer sp;
+   Term_p        t;
+
+   assert(bank);
+   assert(bank->young);
+   assert(bank->gc_minor);
+
+   for(i=0; i< bank->min_terms->size; i++)
+   {
+      t = PDArrayElementP(bank->min_terms, i);
+
+      if(t)
+      {
+         TBGCMarkTerm(bank, t);
+      }
+   }
+   for(sp=0; sp<PStackGetSP(bank->remembered); sp++)
+   {
+      t = PStackElementP(bank->remembered, sp);
+      if(TermIsRewritten(t))
+      {
+         TBGCMarkTerm(bank, TermRWReplaceField(t));
+      }
+   }
+   tb_gc_mark_frozen_links(bank);
+   /* Younger cells point to older ones only, so superterms are
+      freed before their arguments. */
+   while(!PStackEmpty(bank->young))
+   {
+      t = PStackPopP(bank->young);
+      if(TBTermCellIsMarked(bank, t))
+      {
+         TermCellFlipProp(t, TPGarbageFlag);
+      }
+      else
+      {
+         TermCellStoreDelete(&(bank->term_store), t);
+         recovered++;
+      }
+   }
+   PStackReset(bank->remembered);
+   bank->old_limit = bank->in_count;
+   bank->gc_minor  = false;
+   bank->recovered+=recovered;
+   if(recovered)
+   {
+      bank->gc_epoch++;
+   }
+   bank->minor_gcs++;
+   return recovered;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: TBFreeze()
+//
+//   Make all term cells currently in the bank read-only as far as
+//   the bank is concerned: Lookups do not write to them or to their
+//   table, new cells go into a separate overlay, and garbage
+//   collection neither marks nor sweeps them. Call this right before
+//   fork()ing, so that children share the pages of the frozen
+//   part. Frozen cells are never freed before the bank is, and
+//   cached beta-normal forms are not followed, so this is only for
+//   first-order problems.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, changes bank
+//
+/----------------------------------------------------------------------*/
+
+void TBFreeze(TB_p bank)
+{
+   assert(!bank->gc_minor);
+
+   TermCellStoreFreeze(&(bank->term_store));
+   bank->frozen_limit = bank->in_count;
+   if(!bank->frozen_links)
+   {
+      bank->frozen_links = PStackAlloc();
+   }
+   PStackReset(bank->frozen_links);
+   if(bank->young)
+   {
+      PStackReset(bank->young);
+      PStackReset(bank->remembered);
+      bank->old_limit = bank->in_count;
+   }
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: TBCreateConstTerm()
@@ -50,6 +50,10 @@ typedef struct tbcell
                                     (as a measure of work done. */
    unsigned long long recovered; /* How many terms have been recovered
                                     by garbage collection? */
+   unsigned long gc_epoch;       /* Incremented whenever cells of this
+                                    bank are released, so that caches
+                                    keyed on term pointers can detect
+                                    stale entries */
    Sig_p         sig;            /* Store sig info */
    VarBank_p     vars;           /* Information about (shared) variables */
    DBVarBank_p   db_vars;        /* de Bruijn (shared) variable bank
@@ -68,6 +72,23 @@ typedef struct tbcell
                                     get the new value, so that marking
                                     can be done by flipping in the
                                     term cell. */
+   PStack_p       young;         /* Term cells created since the last
+                                    collection, NULL unless
+                                    generational collection is
+                                    enabled */
+   PStack_p       remembered;    /* Old term cells with a rewrite
+                                    link to a young one */
+   long           old_limit;     /* Cells with entry_no up to this are
+                                    old */
+   bool           gc_minor;      /* Marking stops at old cells */
+   long           full_survivors;/* Term cells left after the last
+                                    full sweep */
+   long           minor_gcs;     /* Number of minor collections */
+   long           full_gcs;      /* Number of full collections */
+   long           frozen_limit;  /* Cells with entry_no up to this are
+                                    frozen (see TBFreeze()) */
+   PStack_p       frozen_links;  /* Frozen cells with a rewrite link
+                                    to a non-frozen one, or NULL */
    GCAdmin_p      gc;            /* Higher level code can register
                                   * garbage collection information
                                   * here. This is only a convenience
@@ -171,6 +192,13 @@ long    TBTermSetPropCount(Term_p term, TermProperties prop);
    (GiveProps((term),TPGarbageFlag)!=(bank)->garbage_state)
 void    TBGCMarkTerm(TB_p bank, Term_p term);
 long    TBGCSweep(TB_p bank);
+void    TBGCEnableGenerations(TB_p bank);
+long    TBGCSweepYoung(TB_p bank);
+#define TBGCYoungCells(bank) ((bank)->young?PStackGetSP((bank)->young):0)
+void    TBFreeze(TB_p bank);
+#define TBTermIsFrozen(bank, term)                                      \
+   (!TermIsAnyVar(term) && (term)->entry_no <= (bank)->frozen_limit)
+static inline void TBGCNoteRWLink(TB_p bank, Term_p term, Term_p replace);
 Term_p  TBCreateConstTerm(TB_p bank, FunCode const);
 Term_p  TBCreateMinTerm(TB_p bank, FunCode min_const);
 
@@ -189,12 +217,47 @@ Term_p TermApplyArg(TypeBank_p tb, Term_p s, Term_p arg);
 #define TBGCRegisterClauseSet(terms, set)    GCRegisterClauseSet((terms)->gc,(set))
 #define TBGCDeregisterFormulaSet(terms, set) GCDeregisterFormulaSet((terms)->gc,(set))
 #define TBGCDeregisterClauseSet(terms, set)  GCDeregisterClauseSet((terms)->gc,(set))
+#define TBGCRegisterTermStack(terms, stack)   GCRegisterTermStack((terms)->gc,(stack))
+#define TBGCDeregisterTermStack(terms, stack) GCDeregisterTermStack((terms)->gc,(stack))
 
 
 /*---------------------------------------------------------------------*/
 /*                Inline Functions                                     */
 /*---------------------------------------------------------------------*/
 
+/*-----------------------------------------------------------------------
+//
+// Function: TBGCNoteRWLink()
+//
+//   Record that term (in bank) now has a rewrite link to
+//   replace. Minor collections do not look into old cells, and no
+//   collection looks into frozen cells, so such cells pointing to
+//   younger ones have to be remembered as additional roots.
+//
+// Global Variables: -
+//
+// Side Effects    : May push term onto bank->remembered or
+//                   bank->frozen_links
+//
+/----------------------------------------------------------------------*/
+
+static inline void TBGCNoteRWLink(TB_p bank, Term_p term, Term_p replace)
+{
+   if(TBTermIsFrozen(bank, term))
+   {
+      if(!TBTermIsFrozen(bank, replace))
+      {
+         PStackPushP(bank->frozen_links, term);
+      }
+   }
+   else if(bank->young &&
+      term->entry_no <= bank->old_limit &&
+      replace->entry_no > bank->old_limit)
+   {
+      PStackPushP(bank->remembered, term);
+   }
+}
+
 static inline Term_p  TBTermParse(Scanner_p in, TB_p bank)
 {
    return TBTermParseReal(in, bank, true);
@@ -6,8 +6,12 @@ Author: Stephan Schulz
 
 Contents
 
-  Implementation of term cell stores (except for all intersting parts,
-  which are realized as macros...
+  Implementation of term cell stores as open-addressing hash tables
+  with linear probing. Deletion from the current table uses backward
+  shifting, so that the table never contains tombstones. Only the
+  old table of an incremental resize uses a deletion marker, since
+  slots there are vacated in arbitrary order. The frozen table is
+  built once by TermCellStoreFreeze() and then only read.
 
   Copyright 1998, 1999 by the author.
   This code is released under the GNU General Public Licence and
@@ -19,6 +23,8 @@ Changes
 
 <1> Mon Oct  5 01:09:50 MEST 1998
     New
+<2> Sat Oct 17 21:12:05 CEST 2026
+    Frozen tables
 
 -----------------------------------------------------------------------*/
 
@@ -30,6 +36,16 @@ Changes
 /*                        Global Variables                             */
 /*---------------------------------------------------------------------*/
 
+/* Marks vacated slots in the old table during incremental resizing */
+
+static char tcs_deleted_marker;
+#define TCS_DELETED ((Term_p)&tcs_deleted_marker)
+
+#define TCS_HASH_MULT ((uintptr_t)0x9E3779B97F4A7C15ULL)
+
+/* Grow if more than 2/3 of the slots are used */
+#define tcs_overloaded(entries, size) (3*(entries) > 2*(size))
+
 
 /*---------------------------------------------------------------------*/
 /*                      Forward Declarations                           */
@@ -40,13 +56,63 @@ Changes
 /*                         Internal Functions                          */
 /*---------------------------------------------------------------------*/
 
+/*-----------------------------------------------------------------------
+//
+// Function: tcs_hash()
+//
+//   Compute the hash value of a term cell from its top symbol and
+//   the addresses of its (shared) arguments.
+//
+// Global Variables: -
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static inline uintptr_t tcs_hash(Term_p term)
+{
+   uintptr_t hash = (uintptr_t)term->f_code*TCS_HASH_MULT;
+   int i;
+
+   for(i=0; i<term->arity; i++)
+   {
+      hash = (hash^((uintptr_t)term->args[i]>>4))*TCS_HASH_MULT;
+   }
+   return hash^(hash>>29);
+}
+
 
 /*-----------------------------------------------------------------------
 //
-// Function: collect_unmarked_termcells()
+// Function: tcs_table_alloc()
 //
-//   Push the addresses of all unmarked term cells in the tree onto
-//   the stack.
+//   Allocate an empty table with size slots.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static Term_p* tcs_table_alloc(long size)
+{
+   Term_p *table = SizeMalloc(size*sizeof(Term_p));
+   long   i;
+
+   for(i=0; i<size; i++)
+   {
+      table[i] = NULL;
+   }
+   return table;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: tcs_table_find()
+//
+//   Return the slot index of the term cell equal to term in table,
+//   or -1 if no such cell exists.
 //
 // Global Variables: -
 //
@@ -54,38 +120,208 @@ Changes
 //
 /----------------------------------------------------------------------*/
 
-static void collect_unmarked_termcells(PStack_p res_stack, Term_p tree,
-                   TermProperties gc_state)
+static long tcs_table_find(Term_p *table, long size, Term_p term,
+                           uintptr_t hash)
+{
+   long   mask = size-1;
+   long   i    = hash&mask;
+   Term_p cell;
+
+   while((cell = table[i]))
+   {
+      if(cell != TCS_DELETED &&
+         cell->f_code == term->f_code &&
+         TermTopCompare(cell, term) == 0)
+      {
+         return i;
+      }
+      i = (i+1)&mask;
+   }
+   return -1;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: tcs_table_put()
+//
+//   Put term into the first free slot of its probe sequence. The
+//   term must not be in the table, and the table must not contain
+//   deletion markers.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes table
+//
+/----------------------------------------------------------------------*/
+
+static void tcs_table_put(Term_p *table, long size, Term_p term,
+                          uintptr_t hash)
+{
+   long mask = size-1;
+   long i    = hash&mask;
+
+   while(table[i])
+   {
+      i = (i+1)&mask;
+   }
+   table[i] = term;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: tcs_table_remove()
+//
+//   Remove the entry at slot pos from table by shifting later
+//   members of the cluster back, so that all remaining entries stay
+//   reachable from their home slots.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes table
+//
+/----------------------------------------------------------------------*/
+
+static void tcs_table_remove(Term_p *table, long size, long pos)
 {
-   PStack_p stack = PStackAlloc();
+   long mask = size-1;
+   long hole = pos, i = pos, home;
+
+   for(;;)
+   {
+      i = (i+1)&mask;
+      if(!table[i])
+      {
+         break;
+      }
+      home = tcs_hash(table[i])&mask;
+      /* Move table[i] into the hole unless its home slot lies
+         cyclically in (hole, i] */
+      if((hole < i)?(home <= hole || home > i):(home <= hole && home > i))
+      {
+         table[hole] = table[i];
+         hole = i;
+      }
+   }
+   table[hole] = NULL;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: tcs_migrate()
+//
+//   Move up to steps slots from the old table into the current
+//   one. Free the old table once it is exhausted.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes store, memory operations
+//
+/----------------------------------------------------------------------*/
 
-   PStackPushP(stack, tree);
+static void tcs_migrate(TermCellStore_p store, long steps)
+{
+   Term_p cell;
 
-   while(!PStackEmpty(stack))
+   while(store->old_store && steps--)
    {
-      tree = PStackPopP(stack);
-      if(tree)
+      cell = store->old_store[store->old_pos];
+      if(cell && cell != TCS_DELETED)
       {
-    if(GiveProps(tree,TPGarbageFlag)==gc_state)
-    {
-       PStackPushP(res_stack, tree);
-    }
-    PStackPushP(stack, tree->lson);
-    PStackPushP(stack, tree->rson);
+         tcs_table_put(store->store, store->size, cell, tcs_hash(cell));
+         store->old_store[store->old_pos] = TCS_DELETED;
+      }
+      store->old_pos++;
+      if(store->old_pos == store->old_size)
+      {
+         SizeFree(store->old_store, store->old_size*sizeof(Term_p));
+         store->old_store = NULL;
+         store->old_size  = 0;
+         store->old_pos   = 0;
       }
    }
-   PStackFree(stack);
 }
 
+
+/*-----------------------------------------------------------------------
+//
+// Function: tcs_grow()
+//
+//   Start migrating the store into a table of twice the size. Any
+//   pending migration is completed first.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes store, memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void tcs_grow(TermCellStore_p store)
+{
+   if(store->old_store)
+   {
+      tcs_migrate(store, store->old_size);
+   }
+   store->old_store = store->store;
+   store->old_size  = store->size;
+   store->old_pos   = 0;
+   store->size      = 2*store->size;
+   store->store     = tcs_table_alloc(store->size);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: tcs_traverse_live()
+//
+//   As TermCellStoreTraverseNext(), but only visit cells that are
+//   not frozen. Positions are compatible.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes *pos
+//
+/----------------------------------------------------------------------*/
+
+static Term_p tcs_traverse_live(TermCellStore_p store, long *pos)
+{
+   Term_p cell;
+
+   while(*pos < store->size)
+   {
+      cell = store->store[(*pos)++];
+      if(cell)
+      {
+         return cell;
+      }
+   }
+   while(*pos < store->size+store->old_size)
+   {
+      cell = store->old_store[(*pos)++ - store->size];
+      if(cell && cell != TCS_DELETED)
+      {
+         return cell;
+      }
+   }
+   return NULL;
+}
+
+
 /*---------------------------------------------------------------------*/
 /*                         Exported Functions                          */
 /*---------------------------------------------------------------------*/
 
+
 /*-----------------------------------------------------------------------
 //
-// Function: TermCellStoreInit()
+// Function: TermTopCompare()
 //
-//   Initialize a term cell storage.
+//   Compare two top level term cells as
+//   f_code.masked_properties.args_as_pointers, return a value >0 if
+//   t1 is greater, 0 if the terms are identical, <0 if t2 is
+//   greater.
 //
 // Global Variables: -
 //
@@ -93,23 +329,80 @@ static void collect_unmarked_termcells(PStack_p res_stack, Term_p tree,
 //
 /----------------------------------------------------------------------*/
 
-void TermCellStoreInit(TermCellStore_p store)
+long TermTopCompare(Term_p t1, Term_p t2)
 {
    int i;
 
-   store->entries = 0;
-   store->arg_count = 0;
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   long res = t1->f_code - t2->f_code;
+   if(res)
+   {
+      return res;
+   }
+
+   assert(t1->type);
+   assert(t2->type);
+   assert(problemType == PROBLEM_HO || t1->type == t2->type);
+   //Not true with polymorphism!
+
+   if(problemType == PROBLEM_HO)
+   {
+      res = PCmp(t1->type, t2->type);
+      if(res)
+      {
+         return res;
+      }
+   }
+
+   if(t1->arity != t2->arity)
+   {
+      return t1->arity - t2->arity;
+   }
+
+   for(i=0; i<t1->arity; i++)
    {
-      store->store[i] = NULL;
+      res = PCmp(t1->args[i], t2->args[i]);
+      if(res)
+      {
+         return res;
+      }
    }
+   return res;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: TermCellStoreInit()
+//
+//   Initialize a term cell storage.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void TermCellStoreInit(TermCellStore_p store)
+{
+   store->entries   = 0;
+   store->arg_count = 0;
+   store->size      = TERM_STORE_INITIAL_SIZE;
+   store->store     = tcs_table_alloc(store->size);
+   store->old_size  = 0;
+   store->old_pos   = 0;
+   store->old_store = NULL;
+   store->frozen_entries = 0;
+   store->frozen_args    = 0;
+   store->frozen_size    = 0;
+   store->frozen         = NULL;
 }
 
 /*-----------------------------------------------------------------------
 //
 // Function: TermCellStoreExit()
 //
-//   Free the trees in a term cell storage.
+//   Free the term cells and the tables of a term cell storage. Do
+//   not free variables, as they belong to a variable bank as well.
 //
 // Global Variables: -
 //
@@ -119,13 +412,32 @@ void TermCellStoreInit(TermCellStore_p store)
 
 void TermCellStoreExit(TermCellStore_p store)
 {
-   int i;
+   Term_p cell;
+   long   pos = 0;
 
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   while((cell = TermCellStoreTraverseNext(store, &pos)))
+   {
+      if(!TermIsAnyVar(cell))
+      {
+         TermTopFree(cell);
+      }
+   }
+   SizeFree(store->store, store->size*sizeof(Term_p));
+   if(store->old_store)
    {
-      TermTreeFree(store->store[i]);
-      store->store[i] = NULL;
+      SizeFree(store->old_store, store->old_size*sizeof(Term_p));
    }
+   if(store->frozen)
+   {
+      SizeFree(store->frozen, store->frozen_size*sizeof(Term_p));
+   }
+   store->store     = NULL;
+   store->old_store = NULL;
+   store->frozen    = NULL;
+   store->entries   = 0;
+   store->arg_count = 0;
+   store->frozen_entries = 0;
+   store->frozen_args    = 0;
 }
 
 
@@ -133,7 +445,7 @@ void TermCellStoreExit(TermCellStore_p store)
 //
 // Function: TermCellStoreFind()
 //
-//   Find a term cell in the store.
+//   Find a term cell in the store. Does not modify the store.
 //
 // Global Variables: -
 //
@@ -143,8 +455,31 @@ void TermCellStoreExit(TermCellStore_p store)
 
 Term_p  TermCellStoreFind(TermCellStore_p store, Term_p term)
 {
-   return TermTreeFind(&(store->store[TermCellHash(term)]), term);
+   uintptr_t hash = tcs_hash(term);
+   long      pos;
 
+   pos = tcs_table_find(store->store, store->size, term, hash);
+   if(pos != -1)
+   {
+      return store->store[pos];
+   }
+   if(store->old_store)
+   {
+      pos = tcs_table_find(store->old_store, store->old_size, term, hash);
+      if(pos != -1)
+      {
+         return store->old_store[pos];
+      }
+   }
+   if(store->frozen)
+   {
+      pos = tcs_table_find(store->frozen, store->frozen_size, term, hash);
+      if(pos != -1)
+      {
+         return store->frozen[pos];
+      }
+   }
+   return NULL;
 }
 
 
@@ -152,7 +487,8 @@ Term_p  TermCellStoreFind(TermCellStore_p store, Term_p term)
 //
 // Function: TermCellStoreInsert()
 //
-//   Insert a term cell into the store.
+//   Insert a term cell into the store. If an equivalent cell already
+//   exists, return it, otherwise return NULL.
 //
 // Global Variables: -
 //
@@ -162,22 +498,48 @@ Term_p  TermCellStoreFind(TermCellStore_p store, Term_p term)
 
 Term_p  TermCellStoreInsert(TermCellStore_p store, Term_p term)
 {
-   Term_p ret;
+   uintptr_t hash = tcs_hash(term);
+   long      pos;
 
-   ret = TermTreeInsert(&(store->store[TermCellHash(term)]), term);
-   if(!ret)
+   pos = tcs_table_find(store->store, store->size, term, hash);
+   if(pos != -1)
    {
-      store->entries++;
-      store->arg_count+=term->arity;
+      return store->store[pos];
    }
-   return ret;
+   if(store->old_store)
+   {
+      pos = tcs_table_find(store->old_store, store->old_size, term, hash);
+      if(pos != -1)
+      {
+         return store->old_store[pos];
+      }
+   }
+   if(store->frozen)
+   {
+      pos = tcs_table_find(store->frozen, store->frozen_size, term, hash);
+      if(pos != -1)
+      {
+         return store->frozen[pos];
+      }
+   }
+   if(tcs_overloaded(TermCellStoreLiveNodes(store)+1, store->size))
+   {
+      tcs_grow(store);
+   }
+   tcs_table_put(store->store, store->size, term, hash);
+   store->entries++;
+   store->arg_count+=term->arity;
+   tcs_migrate(store, TERM_STORE_REHASH_STEP);
+
+   return NULL;
 }
 
 /*-----------------------------------------------------------------------
 //
 // Function: TermCellStoreExtract()
 //
-//   Extract a term cell from the store, return it.
+//   Extract a term cell from the store, return it. Frozen cells
+//   cannot be extracted.
 //
 // Global Variables: -
 //
@@ -187,12 +549,29 @@ Term_p  TermCellStoreInsert(TermCellStore_p store, Term_p term)
 
 Term_p  TermCellStoreExtract(TermCellStore_p store, Term_p term)
 {
-   Term_p ret;
-   ret = TermTreeExtract(&(store->store[TermCellHash(term)]), term);
+   uintptr_t hash = tcs_hash(term);
+   Term_p    ret  = NULL;
+   long      pos;
+
+   pos = tcs_table_find(store->store, store->size, term, hash);
+   if(pos != -1)
+   {
+      ret = store->store[pos];
+      tcs_table_remove(store->store, store->size, pos);
+   }
+   else if(store->old_store)
+   {
+      pos = tcs_table_find(store->old_store, store->old_size, term, hash);
+      if(pos != -1)
+      {
+         ret = store->old_store[pos];
+         store->old_store[pos] = TCS_DELETED;
+      }
+   }
    if(ret)
    {
       store->entries--;
-      store->arg_count-=term->arity;
+      store->arg_count-=ret->arity;
    }
    assert(store->entries>=0);
    return ret;
@@ -213,17 +592,70 @@ Term_p  TermCellStoreExtract(TermCellStore_p store, Term_p term)
 
 bool TermCellStoreDelete(TermCellStore_p store, Term_p term)
 {
-   bool ret;
+   Term_p cell;
+
+   cell = TermCellStoreExtract(store, term);
+   if(cell)
+   {
+      TermTopFree(cell);
+      return true;
+   }
+   return false;
+}
 
-   ret = TermTreeDelete(&(store->store[TermCellHash(term)]), term);
 
-   if(ret)
+/*-----------------------------------------------------------------------
+//
+// Function: TermCellStoreFreeze()
+//
+//   Freeze all cells currently in the store. Afterwards, lookups
+//   only read the frozen table, and new cells go into a fresh
+//   (small) current table. If the store is frozen again, the
+//   previously frozen cells and the new ones are combined into a new
+//   frozen table, the old one is left alone.
+//
+// Global Variables: -
+//
+// Side Effects    : Memory operations, changes store
+//
+/----------------------------------------------------------------------*/
+
+void TermCellStoreFreeze(TermCellStore_p store)
+{
+   long   size, pos = 0;
+   Term_p *table, cell;
+
+   if(store->frozen && !TermCellStoreLiveNodes(store))
    {
-      store->entries--;
-      store->arg_count-=term->arity;
+      return;
    }
-   assert(store->entries>=0);
-   return ret;
+   tcs_migrate(store, store->old_size);
+   if(!store->frozen)
+   {
+      table = store->store;
+      size  = store->size;
+   }
+   else
+   {
+      size = TERM_STORE_INITIAL_SIZE;
+      while(tcs_overloaded(store->entries, size))
+      {
+         size = 2*size;
+      }
+      table = tcs_table_alloc(size);
+      while((cell = TermCellStoreTraverseNext(store, &pos)))
+      {
+         tcs_table_put(table, size, cell, tcs_hash(cell));
+      }
+      SizeFree(store->frozen, store->frozen_size*sizeof(Term_p));
+      SizeFree(store->store, store->size*sizeof(Term_p));
+   }
+   store->frozen         = table;
+   store->frozen_size    = size;
+   store->frozen_entries = store->entries;
+   store->frozen_args    = store->arg_count;
+   store->size           = TERM_STORE_INITIAL_SIZE;
+   store->store          = tcs_table_alloc(store->size);
 }
 
 
@@ -231,7 +663,8 @@ bool TermCellStoreDelete(TermCellStore_p store, Term_p term)
 //
 // Function: TermCellStoreSetProp()
 //
-//   Set the given properties in all term cells in store.
+//   Set the given properties in all term cells in store (including
+//   frozen ones).
 //
 // Global Variables: -
 //
@@ -241,11 +674,12 @@ bool TermCellStoreDelete(TermCellStore_p store, Term_p term)
 
 void TermCellStoreSetProp(TermCellStore_p store, TermProperties props)
 {
-   int i;
+   Term_p cell;
+   long   pos = 0;
 
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   while((cell = TermCellStoreTraverseNext(store, &pos)))
    {
-      TermTreeSetProp(store->store[i], props);
+      TermCellSetProp(cell, props);
    }
 }
 
@@ -263,11 +697,12 @@ void TermCellStoreSetProp(TermCellStore_p store, TermProperties props)
 
 void TermCellStoreDelProp(TermCellStore_p store, TermProperties props)
 {
-   int i;
+   Term_p cell;
+   long   pos = 0;
 
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   while((cell = TermCellStoreTraverseNext(store, &pos)))
    {
-      TermTreeDelProp(store->store[i], props);
+      TermCellDelProp(cell, props);
    }
 }
 
@@ -287,25 +722,61 @@ void TermCellStoreDelProp(TermCellStore_p store, TermProperties props)
 long TermCellStoreCountNodes(TermCellStore_p store)
 {
    long res = 0;
-   int i;
+   long pos = 0;
 
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   while(TermCellStoreTraverseNext(store, &pos))
    {
-      res+=TermTreeNodes(store->store[i]);
+      res++;
    }
    return res;
 }
 
 
+/*-----------------------------------------------------------------------
+//
+// Function: TermCellStoreTraverseNext()
+//
+//   Return the next term cell in the store, starting at slot *pos,
+//   and advance *pos past it. Return NULL if no cells are left. *pos
+//   should be 0 to start a traversal. The store must not be changed
+//   during a traversal.
+//
+// Global Variables: -
+//
+// Side Effects    : Changes *pos
+//
+/----------------------------------------------------------------------*/
+
+Term_p TermCellStoreTraverseNext(TermCellStore_p store, long *pos)
+{
+   Term_p cell;
+   long   base = store->size+store->old_size;
+
+   cell = tcs_traverse_live(store, pos);
+   if(cell)
+   {
+      return cell;
+   }
+   while(*pos < base+store->frozen_size)
+   {
+      cell = store->frozen[(*pos)++ - base];
+      if(cell)
+      {
+         return cell;
+      }
+   }
+   return NULL;
+}
+
+
 /*-----------------------------------------------------------------------
 //
 // Function: TermCellStoreGCSweep()
 //
 //   Sweep the term cell store and free unmarked cells. Return number
-//   of cells recovered. Note that we separate the collection of
-//   unmarked terms from the actual deletion, since walking the trees
-//   while they may be reorganized is somewhere between messy and
-//   impossible.
+//   of cells recovered. The surviving cells are rehashed into a
+//   fresh table sized for them, so that the store shrinks again after
+//   a large collection. Frozen cells are not looked at.
 //
 // Global Variables: -
 //
@@ -315,22 +786,51 @@ long TermCellStoreCountNodes(TermCellStore_p store)
 
 long TermCellStoreGCSweep(TermCellStore_p store, TermProperties gc_state)
 {
-   long recovered = 0;
-   int i;
-   PStack_p del_stack = PStackAlloc();
-   Term_p cell;
+   long   recovered = 0, survivors = 0, size, pos = 0;
+   Term_p *table, cell;
 
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   while((cell = tcs_traverse_live(store, &pos)))
    {
-      collect_unmarked_termcells(del_stack, store->store[i], gc_state);
-      while(!PStackEmpty(del_stack))
+      if(GiveProps(cell,TPGarbageFlag)!=gc_state)
       {
-    cell = PStackPopP(del_stack);
-    TermCellStoreDelete(store, cell);
-    recovered++;
+         survivors++;
       }
    }
-   PStackFree(del_stack);
+   size = TERM_STORE_INITIAL_SIZE;
+   while(tcs_overloaded(2*survivors, size))
+   {
+      size = 2*size;
+   }
+   table = tcs_table_alloc(size);
+
+   pos = 0;
+   while((cell = tcs_traverse_live(store, &pos)))
+   {
+      if(GiveProps(cell,TPGarbageFlag)==gc_state)
+      {
+         store->entries--;
+         store->arg_count-=cell->arity;
+         TermTopFree(cell);
+         recovered++;
+      }
+      else
+      {
+         tcs_table_put(table, size, cell, tcs_hash(cell));
+      }
+   }
+   assert(TermCellStoreLiveNodes(store) == survivors);
+
+   SizeFree(store->store, store->size*sizeof(Term_p));
+   if(store->old_store)
+   {
+      SizeFree(store->old_store, store->old_size*sizeof(Term_p));
+      store->old_store = NULL;
+      store->old_size  = 0;
+      store->old_pos   = 0;
+   }
+   store->store = table;
+   store->size  = size;
+
    return recovered;
 }
 
@@ -339,8 +839,8 @@ long TermCellStoreGCSweep(TermCellStore_p store, TermProperties gc_state)
 //
 // Function: TermCellStorePrintDistrib()
 //
-//   For each entry (hash value) in store, print the number of term
-//   cells in the corresponding tree.
+//   Print the size and load of the store and, for each probe
+//   length, the number of term cells found after that many probes.
 //
 // Global Variables: -
 //
@@ -350,12 +850,30 @@ long TermCellStoreGCSweep(TermCellStore_p store, TermProperties gc_state)
 
 void TermCellStorePrintDistrib(FILE* out, TermCellStore_p store)
 {
-   int i;
+   PDArray_p distrib = PDIntArrayAlloc(16, 16);
+   long      i, dist, max_dist = -1, mask = store->size-1;
+   Term_p    cell;
 
-   for(i=0; i<TERM_STORE_HASH_SIZE; i++)
+   for(i=0; i<store->size; i++)
+   {
+      cell = store->store[i];
+      if(cell)
+      {
+         dist = (i-(long)(tcs_hash(cell)&mask))&mask;
+         PDArrayElementIncInt(distrib, dist, 1);
+         max_dist = MAX(max_dist, dist);
+      }
+   }
+   fprintf(out, COMCHAR" Slots: %ld (+%ld old, %ld frozen), entries: %ld"
+           " (%ld frozen)\n",
+           store->size, store->old_size, store->frozen_size,
+           store->entries, store->frozen_entries);
+   for(i=0; i<=max_dist; i++)
    {
-      fprintf(out, COMCHAR" Hash %4d: %6ld\n", i, TermTreeNodes(store->store[i]));
+      fprintf(out, COMCHAR" Probes %4ld: %6ld\n", i+1,
+              PDArrayElementInt(distrib, i));
    }
+   PDArrayFree(distrib);
 }
 
 /*---------------------------------------------------------------------*/
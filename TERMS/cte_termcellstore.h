@@ -6,11 +6,14 @@ Author: Stephan Schulz
 
 Contents
 
-  Abstract interface for storing term cells, implemented by a
-  combination of a hashed array and term cell trees. Use
-  (term->f_code^term->args[1])&TERM_STORE_HASH_MASK  as
-  hash if args != NULL, otherwise use
-  term->f_code&TERM_STORE_HASH_MASK.
+  Abstract interface for storing term cells, implemented as a
+  resizable open-addressing hash table with linear probing. The key
+  of a term cell is its top symbol and the (shared) argument
+  pointers. The table grows by doubling, and the old table is
+  migrated incrementally over the next few insertions, so that no
+  single insertion has to pay for a full rehash. A store can be
+  frozen, after which its cells live in a separate table that is
+  only ever read, and new cells go into a private overlay.
 
   Copyright 1998, 1999 by the author.
   This code is released under the GNU General Public Licence and
@@ -25,6 +28,8 @@ Changes
 <2> Thu Apr 11 10:08:26 CEST 2002
     Support for mark-and-sweep garbage collection (the sweep pass) for
     term cells
+<3> Sat Oct 17 21:12:05 CEST 2026
+    Frozen tables (TermCellStoreFreeze())
 
 -----------------------------------------------------------------------*/
 
@@ -32,20 +37,34 @@ Changes
 
 #define CTE_TERMCELLSTORE
 
-#include <cte_termtrees.h>
+#include <cte_termfunc.h>
 
 /*---------------------------------------------------------------------*/
 /*                    Data type declarations                           */
 /*---------------------------------------------------------------------*/
 
-#define TERM_STORE_HASH_SIZE (8192*4)
-#define TERM_STORE_HASH_MASK (TERM_STORE_HASH_SIZE-1)
+#define TERM_STORE_INITIAL_SIZE 1024  /* Has to be a power of 2 */
+#define TERM_STORE_REHASH_STEP  16    /* Old slots migrated per insert */
+
+/* Frozen cells are found through frozen, which is never written
+   to, and are neither extracted nor swept. This keeps the pages of
+   the table and of the frozen cells shared with the parent if the
+   store is frozen right before a fork(). entries and arg_count
+   include the frozen cells. */
 
 typedef struct termcellstore
 {
-   long   entries;
-   long   arg_count;
-   Term_p store[TERM_STORE_HASH_SIZE];
+   long   entries;    /* Number of term cells (in all tables) */
+   long   arg_count;  /* Sum of arities of all term cells */
+   long   size;       /* Number of slots in store, power of 2 */
+   Term_p *store;     /* Current table */
+   long   old_size;   /* Number of slots in old_store */
+   long   old_pos;    /* Next slot of old_store to migrate */
+   Term_p *old_store; /* Table being migrated into store, or NULL */
+   long   frozen_entries; /* Number of frozen term cells */
+   long   frozen_args;    /* Sum of arities of frozen cells */
+   long   frozen_size;    /* Number of slots in frozen */
+   Term_p *frozen;        /* Read-only table, or NULL */
 }TermCellStoreCell, *TermCellStore_p;
 
 
@@ -53,15 +72,7 @@ typedef struct termcellstore
 /*                Exported Functions and Variables                     */
 /*---------------------------------------------------------------------*/
 
-#define tcs_arity0hash(term) ((term)->f_code)
-#define tcs_arity1hash(term) (tcs_arity0hash(term)^(((intptr_t)(term)->args[0])>>3))
-#define tcs_aritynhash(term) (tcs_arity1hash(term)^(((intptr_t)(term)->args[1])>>4))
-
-#define TermCellHash(term)\
-((((term)->arity == 0)?\
-  tcs_arity0hash(term):\
-  (((term)->arity == 1)?tcs_arity1hash(term):tcs_aritynhash(term)))\
-   &TERM_STORE_HASH_MASK)
+long    TermTopCompare(Term_p t1, Term_p t2);
 
 void    TermCellStoreInit(TermCellStore_p store);
 void    TermCellStoreExit(TermCellStore_p store);
@@ -70,6 +81,7 @@ Term_p  TermCellStoreFind(TermCellStore_p store, Term_p term);
 Term_p  TermCellStoreInsert(TermCellStore_p store, Term_p term);
 Term_p  TermCellStoreExtract(TermCellStore_p store, Term_p term);
 bool    TermCellStoreDelete(TermCellStore_p store, Term_p term);
+void    TermCellStoreFreeze(TermCellStore_p store);
 
 void    TermCellStoreSetProp(TermCellStore_p store, TermProperties
               props);
@@ -77,8 +89,12 @@ void    TermCellStoreDelProp(TermCellStore_p store, TermProperties
               props);
 
 #define TermCellStoreNodes(store) ((store)->entries)
+#define TermCellStoreLiveNodes(store)                   \
+   ((store)->entries-(store)->frozen_entries)
 long    TermCellStoreCountNodes(TermCellStore_p store);
 
+Term_p  TermCellStoreTraverseNext(TermCellStore_p store, long *pos);
+
 long    TermCellStoreGCSweep(TermCellStore_p store, TermProperties gc_state );
 
 void    TermCellStorePrintDistrib(FILE* out, TermCellStore_p store);
@@ -88,8 +104,3 @@ void    TermCellStorePrintDistrib(FILE* out, TermCellStore_p store);
 /*---------------------------------------------------------------------*/
 /*                        End of File                                  */
 /*---------------------------------------------------------------------*/
-
-
-
-
-
@@ -30,6 +30,30 @@
 /*                        Global Variables                             */
 /*---------------------------------------------------------------------*/
 
+#ifdef COMPACT_TERMCELLS
+
+/* Side table for the rewrite links of term cells, an open-addressing
+   hash table with linear probing, keyed by cell address. Pointers
+   to entries are only valid until the next change of the table. */
+
+typedef struct term_cold_slot
+{
+   Term_p      term;
+   RewriteDesc desc;
+}TermColdSlot;
+
+#define TERM_COLD_INITIAL_SIZE 1024
+
+RewriteDesc TermColdDefault = {NULL, NULL};
+
+static TermColdSlot *cold_table   = NULL;
+static long          cold_size    = 0;
+static long          cold_entries = 0;
+
+#define cold_hash(term) ((((uintptr_t)(term))>>4)*(uintptr_t)0x9E3779B97F4A7C15ULL)
+
+#endif
+
 /*---------------------------------------------------------------------*/
 /*                      Forward Declarations                           */
 /*---------------------------------------------------------------------*/
@@ -248,10 +272,207 @@ void DBGTermCheckUnownedSubtermReal(FILE* out, Term_p t, char* location)
 #endif
 
 
+#ifdef COMPACT_TERMCELLS
+
+/*-----------------------------------------------------------------------
+//
+// Function: cold_slot_find()
+//
+//   Return the index of the slot for term in the side table, or of
+//   the empty slot where it would be inserted.
+//
+// Global Variables: cold_table, cold_size
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+static long cold_slot_find(Term_p term)
+{
+   long mask = cold_size-1;
+   long i    = cold_hash(term)&mask;
+
+   while(cold_table[i].term && cold_table[i].term!=term)
+   {
+      i = (i+1)&mask;
+   }
+   return i;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: cold_table_resize()
+//
+//   Rehash the side table into a table with new_size slots.
+//
+// Global Variables: cold_table, cold_size
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+static void cold_table_resize(long new_size)
+{
+   TermColdSlot *old_table = cold_table;
+   long         old_size  = cold_size, i, j;
+
+   cold_table = SizeMalloc(new_size*sizeof(TermColdSlot));
+   cold_size  = new_size;
+   for(i=0; i<new_size; i++)
+   {
+      cold_table[i].term = NULL;
+   }
+   for(i=0; i<old_size; i++)
+   {
+      if(old_table[i].term)
+      {
+         j = cold_slot_find(old_table[i].term);
+         cold_table[j] = old_table[i];
+      }
+   }
+   if(old_table)
+   {
+      SizeFree(old_table, old_size*sizeof(TermColdSlot));
+   }
+}
+
+#endif
+
 /*---------------------------------------------------------------------*/
 /*                         Exported Functions                          */
 /*---------------------------------------------------------------------*/
 
+#ifdef COMPACT_TERMCELLS
+
+/*-----------------------------------------------------------------------
+//
+// Function: TermColdFind()
+//
+//   Return the side table record of term, which has to have
+//   TPHasColdData set (see TermRWDesc()).
+//
+// Global Variables: cold_table
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+RewriteDesc* TermColdFind(Term_p term)
+{
+   long i;
+
+   assert(TermCellQueryProp(term, TPHasColdData));
+   assert(cold_table);
+
+   i = cold_slot_find(term);
+   assert(cold_table[i].term == term);
+   return &(cold_table[i].desc);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: TermColdGet()
+//
+//   Return the side table record of term, creating an initialized
+//   one if necessary.
+//
+// Global Variables: cold_table, cold_size, cold_entries
+//
+// Side Effects    : Memory operations, sets TPHasColdData in term
+//
+/----------------------------------------------------------------------*/
+
+RewriteDesc* TermColdGet(Term_p term)
+{
+   long i;
+
+   if(TermCellQueryProp(term, TPHasColdData))
+   {
+      return TermColdFind(term);
+   }
+   if(2*(cold_entries+1) > cold_size)
+   {
+      cold_table_resize(cold_size?2*cold_size:TERM_COLD_INITIAL_SIZE);
+   }
+   i = cold_slot_find(term);
+   assert(!cold_table[i].term);
+   cold_table[i].term = term;
+   cold_table[i].desc = TermColdDefault;
+   cold_entries++;
+   TermCellSetProp(term, TPHasColdData);
+
+   return &(cold_table[i].desc);
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: TermColdDelete()
+//
+//   Remove the side table record of term (if any).
+//
+// Global Variables: cold_table, cold_size, cold_entries
+//
+// Side Effects    : Memory operations
+//
+/----------------------------------------------------------------------*/
+
+void TermColdDelete(Term_p term)
+{
+   long mask = cold_size-1, hole, i, home;
+
+   TermCellDelProp(term, TPHasColdData);
+   if(!cold_table)
+   {
+      return;
+   }
+   hole = cold_slot_find(term);
+   if(!cold_table[hole].term)
+   {
+      return;
+   }
+   cold_entries--;
+
+   i = hole;
+   for(;;)
+   {
+      i = (i+1)&mask;
+      if(!cold_table[i].term)
+      {
+         break;
+      }
+      home = cold_hash(cold_table[i].term)&mask;
+      if((hole < i)?(home <= hole || home > i):(home <= hole && home > i))
+      {
+         cold_table[hole] = cold_table[i];
+         hole = i;
+      }
+   }
+   cold_table[hole].term = NULL;
+}
+
+
+/*-----------------------------------------------------------------------
+//
+// Function: TermColdEntries()
+//
+//   Return the number of term cells with a side table record.
+//
+// Global Variables: cold_entries
+//
+// Side Effects    : -
+//
+/----------------------------------------------------------------------*/
+
+long TermColdEntries(void)
+{
+   return cold_entries;
+}
+
+#endif
+
 
 /*-----------------------------------------------------------------------
 //
@@ -268,6 +489,12 @@ void DBGTermCheckUnownedSubtermReal(FILE* out, Term_p t, char* location)
 void TermTopFree(Term_p junk)
 {
    assert(junk);
+#ifdef COMPACT_TERMCELLS
+   if(TermCellQueryProp(junk, TPHasColdData))
+   {
+      TermColdDelete(junk);
+   }
+#endif
    TermCellFree(junk, junk->arity);
 }
 
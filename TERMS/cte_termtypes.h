@@ -46,6 +46,8 @@ Created: Tue Feb 24 01:23:24 MET 1998 - Ripped out of the now obsolete
 typedef enum
 {
    TPIgnoreProps      =      0, /* For masking properties out */
+   TPHasColdData      =      1, /* Rewrite link is in the side table
+                                   (only with COMPACT_TERMCELLS) */
    TPTopPos           =      2, /* This cell is a entry point */
    TPIsGround         =      4, /* Shared term is ground */
    TPPredPos          =      8, /* This is an original predicate
@@ -111,21 +113,31 @@ typedef enum  /* See CLAUSES/ccl_rewrite.c for more */
    FullRewrite = 2    /* Rewrite with rules and equations */
 }RewriteLevel;
 
+typedef struct
+{
+   struct termcell*   replace;         /* If the term has been
+                                          rewritten, it has been
+                                          rewritten to this term */
+   struct clause_cell *demod;          /* NULL means subterm! */
+}RewriteDesc;
+
 typedef struct
 {
    SysDate          nf_date[FullRewrite]; /* If term is not rewritten,
                                              it is in normal form with
                                              respect to the
                                              demodulators at this date */
-   struct {
-      struct termcell*   replace;         /* ...otherwise, it has been
-                                             rewritten to this term */
-      struct clause_cell *demod;          /* NULL means subterm! */
-   }rw_desc;
+   RewriteDesc      rw_desc;              /* ...otherwise, see above */
 }RewriteState;
 
 struct tbcell;
 
+/* The fields used by matching, unification and the orderings come
+   first, so that they (and the first arguments) share a cache line
+   as far as possible. With COMPACT_TERMCELLS, the rewrite link (only
+   set for rewritten terms) is moved to a side table, see
+   TermRWDesc() below. */
+
 typedef struct termcell
 {
    FunCode          f_code;        /* Top symbol of term */
@@ -138,18 +150,19 @@ typedef struct termcell
                                       rewrites - it might be possible
                                       to combine the previous two in a
                                       union. */
+   long             weight;        /* Weight of the term, if term is in term bank */
+   unsigned int     v_count;       /* Number of variables, if term is in term bank */
+   unsigned int     f_count;       /* Number of function symbols, if term is in term bank */
+   Type_p           type;          /* Sort of the term */
    long             entry_no;      /* Counter for terms in a given
                                       termbank - needed for
                                       administration and external
                                       representation */
-   long             weight;        /* Weight of the term, if term is in term bank */
-   unsigned int     v_count;       /* Number of variables, if term is in term bank */
-   unsigned int     f_count;       /* Number of function symbols, if term is in term bank */
+#ifdef COMPACT_TERMCELLS
+   SysDate          nf_date[FullRewrite]; /* See RewriteState */
+#else
    RewriteState     rw_data;       /* See above */
-   Type_p           type;          /* Sort of the term */
-   struct termcell* lson;          /* For storing shared term nodes in */
-   struct termcell* rson;          /* a splay tree - see
-                                      cte_termcellstore.[ch] */
+#endif
 
 #ifdef ENABLE_LFHO
    struct termcell* binding_cache; /* For caching the term applied variable
@@ -318,12 +331,34 @@ Term_p  MakeRewrittenTerm(Term_p orig, Term_p new, int orig_remains, struct tbce
 #define MakeRewrittenTerm(orig, new, remains, bank) (assert(!remains), new)
 #endif
 
+/* With COMPACT_TERMCELLS, the rewrite link is kept out of the term
+   cell in a side table, keyed by the cell address. Only cells with
+   TPHasColdData set have an entry, all others have no link.
+   TermRWDesc() is for reading only, TermRWDescRef() creates the entry
+   if necessary and must be used for all updates. */
+
+#ifdef COMPACT_TERMCELLS
+extern RewriteDesc TermColdDefault;
+RewriteDesc* TermColdFind(Term_p term);
+RewriteDesc* TermColdGet(Term_p term);
+void         TermColdDelete(Term_p term);
+long         TermColdEntries(void);
+#define TermNFDates(term)   ((term)->nf_date)
+#define TermRWDesc(term)    (TermCellQueryProp((term), TPHasColdData)?\
+                             TermColdFind(term):&TermColdDefault)
+#define TermRWDescRef(term) TermColdGet(term)
+#else
+#define TermNFDates(term)   ((term)->rw_data.nf_date)
+#define TermRWDesc(term)    (&((term)->rw_data.rw_desc))
+#define TermRWDescRef(term) (&((term)->rw_data.rw_desc))
+#endif
+
 #define TermNFDate(term,i) (TermIsRewritten(term)?\
-                           SysDateCreationTime():(term)->rw_data.nf_date[i])
+                           SysDateCreationTime():TermNFDates(term)[i])
 
 /* Absolutely get the value of the replace and demod fields */
-#define TermRWReplaceField(term) ((term)->rw_data.rw_desc.replace)
-#define TermRWDemodField(term)   ((term)->rw_data.rw_desc.demod)
+#define TermRWReplaceField(term) (TermRWDesc(term)->replace)
+#define TermRWDemodField(term)   (TermRWDesc(term)->demod)
 #define REWRITE_AT_SUBTERM 0
 
 /* Get the logical value of the replaced term / demodulator */
@@ -635,10 +670,8 @@ static inline Term_p TermDefaultCellAlloc(void)
    handle->arity      = 0;
    handle->type       = NULL;
    handle->binding    = NULL;
-   handle->rw_data.nf_date[0] = SysDateCreationTime();
-   handle->rw_data.nf_date[1] = SysDateCreationTime();
-   handle->lson = NULL;
-   handle->rson = NULL;
+   TermNFDates(handle)[0] = SysDateCreationTime();
+   TermNFDates(handle)[1] = SysDateCreationTime();
    TermSetCache(handle, NULL);
    TermSetBank(handle, NULL);
 
@@ -670,10 +703,8 @@ static inline Term_p TermDefaultCellArityAlloc(int arity)
    for(int i = 0; i < arity; ++i)
       handle->args[i] = NULL;
 
-   handle->rw_data.nf_date[0] = SysDateCreationTime();
-   handle->rw_data.nf_date[1] = SysDateCreationTime();
-   handle->lson = NULL;
-   handle->rson = NULL;
+   TermNFDates(handle)[0] = SysDateCreationTime();
+   TermNFDates(handle)[1] = SysDateCreationTime();
    TermSetCache(handle, NULL);
    TermSetBank(handle, NULL);
 
@@ -0,0 +1,442 @@
+#!/usr/bin/env python3
+
+"""
+e_bench.py 0.1
+
+Usage: e_bench.py [options] <problem_list> ...
+
+Run E on the problems named in the problem lists (one problem per
+line, empty lines and lines starting with # are ignored), several
+times each, with deterministic search options. Collect status,
+processed and generated clause counts, CPU time, peak RSS and the
+per-phase profile (see --profile-out in E). Print a table of results
+and optionally compare them against a stored baseline.
+
+Problems are looked up as given, relative to the problem list, in
+EXAMPLE_PROBLEMS/TPTP and EXAMPLE_PROBLEMS/SMOKETEST, and in the TPTP
+library ($TPTP/Problems/<domain>/). Missing problems are skipped with
+a warning.
+
+Timing noise is handled as follows: For each problem, the median of
+all runs is used, and a problem only counts as slower if even its
+fastest run is slower than the baseline median by more than the
+threshold, and the difference also exceeds three times the median
+absolute deviation of the runs (plus a fixed floor for very short
+runs). Independently, the geometric mean of the ratios of the
+fastest runs (for problems above the minimal time) must not exceed
+1+threshold. Ratios of problems whose fastest runs differ by less
+than the noise bound above count as 1 here.
+
+Processed and generated clause counts are deterministic with the
+options used, so any difference (or a change of the status) means
+that the search changed, which is a failure unless
+--allow-search-changes is given.
+
+Options:
+
+-h
+--help
+ Print this help.
+
+-b <file>
+--baseline=<file>
+ Compare results against the baseline in <file>. Exit with status 1
+ if there are regressions.
+
+-s <file>
+--save-baseline=<file>
+ Store the results as a new baseline in <file>.
+
+-o <file>
+--csv=<file>
+ Also write the results in CSV format to <file>.
+
+-p <prog>
+--prover=<prog>
+ Use <prog> as the E binary. Default is PROVER/eprover relative to
+ the main E directory.
+
+-r <n>
+--runs=<n>
+ Run each problem <n> times (default 3).
+
+-t <limit>
+--cpu-limit=<limit>
+ CPU time limit per run in seconds (default 30).
+
+-T <ratio>
+--threshold=<ratio>
+ Allowed relative slowdown (default 0.05, i.e. 5%).
+
+-M <ratio>
+--mem-threshold=<ratio>
+ Allowed relative growth of the peak RSS (default 0.10).
+
+-m <secs>
+--min-time=<secs>
+ Ignore timing of problems with a baseline median below <secs>
+ (default 0.1).
+
+-a <args>
+--args=<args>
+ Additional arguments for E (appended to the fixed ones).
+
+--allow-search-changes
+ Do not fail on different status or clause counts.
+
+--proofs-only
+ Only check that every problem solved in the baseline is still
+ solved. Clause counts, time and memory are not compared. This is
+ meant for options that change the search (e.g. --lazy-eval-batch).
+
+This code is part of the support structure for the equational
+theorem prover E. Visit
+
+ http://www.eprover.org
+
+for more information.
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program ; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+MA  02111-1307 USA
+"""
+
+import sys
+import os
+import re
+import getopt
+import json
+import math
+import statistics
+import subprocess
+import tempfile
+
+E_HOME     = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+E_ARGS     = ["--auto", "--detsort-new", "--detsort-rw", "-s",
+              "--print-statistics", "--profile-sample=1000"]
+NOISE_FLOOR = 0.02
+
+prover        = os.path.join(E_HOME, "PROVER", "eprover")
+runs          = 3
+cpu_limit     = 30
+threshold     = 0.05
+mem_threshold = 0.10
+min_time      = 0.1
+extra_args    = []
+allow_search  = False
+proofs_only   = False
+
+status_re    = re.compile(r"SZS status (\S+)")
+processed_re = re.compile(r"Processed clauses\s*:\s*(\d+)")
+generated_re = re.compile(r"Generated clauses\s*:\s*(\d+)")
+
+SOLVED = ("Theorem", "Unsatisfiable", "CounterSatisfiable", "Satisfiable",
+          "ContradictoryAxioms")
+
+
+def find_problem(name, listdir):
+    """
+    Return the path of the problem name, or None.
+    """
+    cands = [name,
+             os.path.join(listdir, name),
+             os.path.join(E_HOME, "EXAMPLE_PROBLEMS", "TPTP", name),
+             os.path.join(E_HOME, "EXAMPLE_PROBLEMS", "SMOKETEST", name),
+             os.path.join(E_HOME, name)]
+    if "TPTP" in os.environ:
+        cands.append(os.path.join(os.environ["TPTP"], "Problems",
+                                  name[:3], name))
+    for cand in cands:
+        if os.path.isfile(cand):
+            return cand
+    return None
+
+
+def read_problems(listfile):
+    """
+    Return a list of (name, path) pairs for the problems in listfile.
+    """
+    res = []
+    listdir = os.path.dirname(os.path.abspath(listfile))
+    with open(listfile) as fp:
+        for line in fp:
+            name = line.split("#")[0].strip()
+            if not name:
+                continue
+            path = find_problem(name, listdir)
+            if path:
+                res.append((name, path))
+            else:
+                sys.stderr.write("Warning: %s not found. Skipping...\n"%(name,))
+    return res
+
+
+def run_once(path):
+    """
+    Run E once on path and return a dictionary of results.
+    """
+    fd, profname = tempfile.mkstemp(suffix=".json")
+    os.close(fd)
+    args = [prover] + E_ARGS + ["--cpu-limit=%d"%(cpu_limit,),
+                                "--profile-out="+profname] + \
+                                extra_args + [path]
+    proc = subprocess.Popen(args, stdout=subprocess.PIPE,
+                            stderr=subprocess.STDOUT)
+    out = proc.stdout.read().decode("utf-8", "replace")
+    proc.stdout.close()
+    pid, wstatus, rusage = os.wait4(proc.pid, 0)
+    proc.returncode = os.waitstatus_to_exitcode(wstatus)
+
+    res = {"status"   : "Unknown",
+           "processed": None,
+           "generated": None,
+           "time"     : rusage.ru_utime+rusage.ru_stime,
+           "rss_kb"   : rusage.ru_maxrss,
+           "phases"   : {}}
+    # Scheduling prints a summary status line (%%) after the one of
+    # the search, so the first one wins.
+    mo = status_re.search(out)
+    if mo:
+        res["status"] = mo.group(1)
+    mo = processed_re.search(out)
+    if mo:
+        res["processed"] = int(mo.group(1))
+    mo = generated_re.search(out)
+    if mo:
+        res["generated"] = int(mo.group(1))
+    try:
+        with open(profname) as fp:
+            prof = json.load(fp)
+        for scope in prof["scopes"]:
+            res["phases"][scope["name"]] = \
+                scope["self_seconds"] if prof["timing"] else scope["self_samples"]
+    except (IOError, ValueError, KeyError):
+        pass
+    os.unlink(profname)
+    return res
+
+
+def mad(values):
+    """
+    Return the median absolute deviation of values.
+    """
+    med = statistics.median(values)
+    return statistics.median([abs(v-med) for v in values])
+
+
+def bench_problem(name, path):
+    """
+    Run E runs times on path and return the summarized results.
+    """
+    results = [run_once(path) for i in range(runs)]
+    times   = [r["time"] for r in results]
+    first   = results[0]
+    phases  = {}
+    for phase in first["phases"]:
+        phases[phase] = statistics.median([r["phases"].get(phase, 0)
+                                           for r in results])
+    return {"problem"  : name,
+            "status"   : first["status"],
+            "processed": first["processed"],
+            "generated": first["generated"],
+            "time"     : statistics.median(times),
+            "time_min" : min(times),
+            "time_mad" : mad(times),
+            "rss_kb"   : max(r["rss_kb"] for r in results),
+            "phases"   : phases,
+            "stable"   : all((r["status"], r["processed"], r["generated"]) ==
+                             (first["status"], first["processed"],
+                              first["generated"]) for r in results)}
+
+
+def print_results(results):
+    """
+    Print the results as a table.
+    """
+    print("%-28s %-16s %9s %10s %8s %7s %10s"%
+          ("Problem", "Status", "Processed", "Generated", "Time",
+           "MAD", "RSS(KB)"))
+    for r in results:
+        print("%-28s %-16s %9s %10s %8.3f %7.3f %10d%s"%
+              (r["problem"], r["status"], r["processed"], r["generated"],
+               r["time"], r["time_mad"], r["rss_kb"],
+               "" if r["stable"] else "  (unstable)"))
+
+
+def write_csv(results, filename):
+    """
+    Write the results (with phases) as CSV.
+    """
+    phases = []
+    for r in results:
+        for phase in r["phases"]:
+            if phase not in phases:
+                phases.append(phase)
+    with open(filename, "w") as fp:
+        fp.write(",".join(["problem", "status", "processed", "generated",
+                           "time", "time_min", "time_mad", "rss_kb"]+
+                          ["phase_"+p for p in phases])+"\n")
+        for r in results:
+            fields = [r["problem"], r["status"], r["processed"],
+                      r["generated"], "%.3f"%(r["time"],),
+                      "%.3f"%(r["time_min"],), "%.3f"%(r["time_mad"],),
+                      r["rss_kb"]]
+            fields.extend(r["phases"].get(p, "") for p in phases)
+            fp.write(",".join("" if f is None else str(f)
+                              for f in fields)+"\n")
+
+
+def compare(results, baseline):
+    """
+    Compare results with baseline, print the differences, and return
+    the number of regressions.
+    """
+    base = dict((r["problem"], r) for r in baseline["results"])
+    failures = 0
+    ratios = []
+
+    for r in results:
+        b = base.get(r["problem"])
+        if not b:
+            print("%s: not in baseline"%(r["problem"],))
+            continue
+        if proofs_only:
+            if b["status"] in SOLVED and r["status"] not in SOLVED:
+                print("%s: lost proof: %s (baseline %s)"%
+                      (r["problem"], r["status"], b["status"]))
+                failures += 1
+            continue
+        if (r["status"], r["processed"], r["generated"]) != \
+           (b["status"], b["processed"], b["generated"]):
+            print("%s: search changed: %s %s/%s (baseline %s %s/%s)"%
+                  (r["problem"], r["status"], r["processed"],
+                   r["generated"], b["status"], b["processed"],
+                   b["generated"]))
+            if not allow_search:
+                failures += 1
+            continue
+        if b["rss_kb"] and r["rss_kb"] > b["rss_kb"]*(1+mem_threshold):
+            print("%s: peak RSS %d KB (baseline %d KB)"%
+                  (r["problem"], r["rss_kb"], b["rss_kb"]))
+            failures += 1
+        if b["time"] < min_time:
+            continue
+        noise = 3*max(r["time_mad"], b["time_mad"])+NOISE_FLOOR
+        b_min = b.get("time_min", b["time"])
+        if abs(r["time_min"]-b_min) > noise:
+            ratios.append(r["time_min"]/b_min)
+        else:
+            ratios.append(1.0)
+        if r["time_min"] > b["time"]*(1+threshold) and \
+           r["time"]-b["time"] > noise:
+            print("%s: slower: %.3fs (baseline %.3fs, +%.1f%%)"%
+                  (r["problem"], r["time"], b["time"],
+                   100*(r["time"]/b["time"]-1)))
+            failures += 1
+
+    if ratios:
+        geomean = math.exp(sum(math.log(x) for x in ratios)/len(ratios))
+        print("Time ratio (geometric mean over %d problems): %.3f"%
+              (len(ratios), geomean))
+        if geomean > 1+threshold:
+            print("Overall slowdown above threshold")
+            failures += 1
+    return failures
+
+
+if __name__ == '__main__':
+    baseline_file = None
+    save_file     = None
+    csv_file      = None
+
+    try:
+        opts, args = getopt.gnu_getopt(sys.argv[1:], "hb:s:o:p:r:t:T:M:m:a:",
+                                       ["help",
+                                        "baseline=",
+                                        "save-baseline=",
+                                        "csv=",
+                                        "prover=",
+                                        "runs=",
+                                        "cpu-limit=",
+                                        "threshold=",
+                                        "mem-threshold=",
+                                        "min-time=",
+                                        "args=",
+                                        "allow-search-changes",
+                                        "proofs-only"])
+    except getopt.GetoptError as err:
+        sys.exit("e_bench.py: "+str(err))
+
+    for option, optarg in opts:
+        if option in ("-h", "--help"):
+            print(__doc__)
+            sys.exit()
+        elif option in ("-b", "--baseline"):
+            baseline_file = optarg
+        elif option in ("-s", "--save-baseline"):
+            save_file = optarg
+        elif option in ("-o", "--csv"):
+            csv_file = optarg
+        elif option in ("-p", "--prover"):
+            prover = optarg
+        elif option in ("-r", "--runs"):
+            runs = max(1, int(optarg))
+        elif option in ("-t", "--cpu-limit"):
+            cpu_limit = int(optarg)
+        elif option in ("-T", "--threshold"):
+            threshold = float(optarg)
+        elif option in ("-M", "--mem-threshold"):
+            mem_threshold = float(optarg)
+        elif option in ("-m", "--min-time"):
+            min_time = float(optarg)
+        elif option in ("-a", "--args"):
+            extra_args = optarg.split()
+        elif option == "--allow-search-changes":
+            allow_search = True
+        elif option == "--proofs-only":
+            proofs_only = True
+
+    if not args:
+        sys.exit(__doc__)
+
+    problems = []
+    for listfile in args:
+        problems.extend(read_problems(listfile))
+
+    results = []
+    for name, path in problems:
+        results.append(bench_problem(name, path))
+        sys.stderr.write("%s done\n"%(name,))
+
+    print_results(results)
+    if csv_file:
+        write_csv(results, csv_file)
+    if save_file:
+        with open(save_file, "w") as fp:
+            json.dump({"prover"   : prover,
+                       "args"     : E_ARGS+extra_args,
+                       "cpu_limit": cpu_limit,
+                       "runs"     : runs,
+                       "results"  : results}, fp, indent=1)
+    if baseline_file:
+        if not os.path.isfile(baseline_file):
+            print("No baseline %s, nothing to compare"%(baseline_file,))
+            sys.exit()
+        with open(baseline_file) as fp:
+            baseline = json.load(fp)
+        failures = compare(results, baseline)
+        if failures:
+            print("%d regression(s)"%(failures,))
+            sys.exit(1)
+        print("No regressions")
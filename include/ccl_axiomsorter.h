@@ -0,0 +1 @@
+../CLAUSES/ccl_axiomsorter.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_bce.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_clausecpos.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_clausefunc.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_clausepos.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_clausepos_tree.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_clauses.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_clausesets.h
\ No newline at end of file
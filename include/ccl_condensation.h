@@ -0,0 +1 @@
+../CLAUSES/ccl_condensation.h
\ No newline at end of file
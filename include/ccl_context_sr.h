@@ -0,0 +1 @@
+../CLAUSES/ccl_context_sr.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_def_handling.h
\ No newline at end of file
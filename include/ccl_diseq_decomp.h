@@ -0,0 +1 @@
+../CLAUSES/ccl_diseq_decomp.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_eqnlist.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_ext_index.h
\ No newline at end of file
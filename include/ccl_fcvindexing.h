@@ -0,0 +1 @@
+../CLAUSES/ccl_fcvindexing.h
\ No newline at end of file
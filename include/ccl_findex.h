@@ -0,0 +1 @@
+../CLAUSES/ccl_findex.h
\ No newline at end of file
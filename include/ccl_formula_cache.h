@@ -0,0 +1 @@
+../CLAUSES/ccl_formula_cache.h
\ No newline at end of file
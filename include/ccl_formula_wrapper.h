@@ -0,0 +1 @@
+../CLAUSES/ccl_formula_wrapper.h
\ No newline at end of file
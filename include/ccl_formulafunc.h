@@ -0,0 +1 @@
+../CLAUSES/ccl_formulafunc.h
\ No newline at end of file
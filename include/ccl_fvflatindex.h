@@ -0,0 +1 @@
+../CLAUSES/ccl_fvflatindex.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_g_lithash.h
\ No newline at end of file
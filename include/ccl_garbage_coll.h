@@ -0,0 +1 @@
+../CLAUSES/ccl_garbage_coll.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_gd_transformation.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_groundconstr.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_grounding.h
\ No newline at end of file
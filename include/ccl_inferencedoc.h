@@ -0,0 +1 @@
+../CLAUSES/ccl_inferencedoc.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_paramod.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_pdtrees.h
\ No newline at end of file
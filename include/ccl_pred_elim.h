@@ -0,0 +1 @@
+../CLAUSES/ccl_pred_elim.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_proofstate.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_propclauses.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_relevance.h
\ No newline at end of file
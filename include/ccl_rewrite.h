@@ -0,0 +1 @@
+../CLAUSES/ccl_rewrite.h
\ No newline at end of file
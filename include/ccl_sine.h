@@ -0,0 +1 @@
+../CLAUSES/ccl_sine.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_subterm_tree.h
\ No newline at end of file
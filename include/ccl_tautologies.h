@@ -0,0 +1 @@
+../CLAUSES/ccl_tautologies.h
\ No newline at end of file
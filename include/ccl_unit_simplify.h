@@ -0,0 +1 @@
+../CLAUSES/ccl_unit_simplify.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CLAUSES/ccl_watchlist.h
\ No newline at end of file
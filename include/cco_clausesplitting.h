@@ -0,0 +1 @@
+../CONTROL/cco_clausesplitting.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CONTROL/cco_diseq_decomp.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CONTROL/cco_eserver.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CONTROL/cco_esession.h
\ No newline at end of file
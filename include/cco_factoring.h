@@ -0,0 +1 @@
+../CONTROL/cco_factoring.h
\ No newline at end of file
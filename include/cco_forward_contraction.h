@@ -0,0 +1 @@
+../CONTROL/cco_forward_contraction.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CONTROL/cco_gproc_ctrl.h
\ No newline at end of file
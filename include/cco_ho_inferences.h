@@ -0,0 +1 @@
+../CONTROL/cco_ho_inferences.h
\ No newline at end of file
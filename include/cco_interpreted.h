@@ -0,0 +1 @@
+../CONTROL/cco_interpreted.h
\ No newline at end of file
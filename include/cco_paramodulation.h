@@ -0,0 +1 @@
+../CONTROL/cco_paramodulation.h
\ No newline at end of file
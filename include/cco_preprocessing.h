@@ -0,0 +1 @@
+../CONTROL/cco_preprocessing.h
\ No newline at end of file
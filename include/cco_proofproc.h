@@ -0,0 +1 @@
+../CONTROL/cco_proofproc.h
\ No newline at end of file
@@ -0,0 +1 @@
+../CONTROL/cco_scheduling.h
\ No newline at end of file
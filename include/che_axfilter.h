@@ -0,0 +1 @@
+../HEURISTICS/che_axfilter.h
\ No newline at end of file
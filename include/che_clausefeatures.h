@@ -0,0 +1 @@
+../HEURISTICS/che_clausefeatures.h
\ No newline at end of file
@@ -0,0 +1 @@
+../HEURISTICS/che_clausesetfeatures.h
\ No newline at end of file
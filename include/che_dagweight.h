@@ -0,0 +1 @@
+../HEURISTICS/che_dagweight.h
\ No newline at end of file
@@ -0,0 +1 @@
+../HEURISTICS/che_diversityweight.h
\ No newline at end of file
@@ -0,0 +1 @@
+../HEURISTICS/che_gdweight.h
\ No newline at end of file
@@ -0,0 +1 @@
+../HEURISTICS/che_heuristics.h
\ No newline at end of file
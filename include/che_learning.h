@@ -0,0 +1 @@
+../HEURISTICS/che_learning.h
\ No newline at end of file
@@ -0,0 +1 @@
+../HEURISTICS/che_new_autoschedule.h
\ No newline at end of file
@@ -0,0 +1 @@
+../HEURISTICS/che_normsubst.h
\ No newline at end of file
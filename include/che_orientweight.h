@@ -0,0 +1 @@
+../HEURISTICS/che_orientweight.h
\ No newline at end of file
@@ -0,0 +1 @@
+../HEURISTICS/che_preparsed.h
\ No newline at end of file
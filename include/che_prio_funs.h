@@ -0,0 +1 @@
+../HEURISTICS/che_prio_funs.h
\ No newline at end of file
@@ -0,0 +1 @@
+../HEURISTICS/che_rawspecfeatures.h
\ No newline at end of file
@@ -0,0 +1 @@
+../HEURISTICS/che_refinedweight.h
\ No newline at end of file
@@ -0,0 +1 @@
+../HEURISTICS/che_specsigfeatures.h
\ No newline at end of file
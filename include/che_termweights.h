@@ -0,0 +1 @@
+../HEURISTICS/che_termweights.h
\ No newline at end of file
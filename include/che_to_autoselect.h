@@ -0,0 +1 @@
+../HEURISTICS/che_to_autoselect.h
\ No newline at end of file
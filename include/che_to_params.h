@@ -0,0 +1 @@
+../HEURISTICS/che_to_params.h
\ No newline at end of file
@@ -0,0 +1 @@
+../HEURISTICS/che_treeweight.h
\ No newline at end of file
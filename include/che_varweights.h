@@ -0,0 +1 @@
+../HEURISTICS/che_varweights.h
\ No newline at end of file
@@ -0,0 +1 @@
+../HEURISTICS/che_wfcb.h
\ No newline at end of file
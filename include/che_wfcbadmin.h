@@ -0,0 +1 @@
+../HEURISTICS/che_wfcbadmin.h
\ No newline at end of file
@@ -0,0 +1 @@
+../INOUT/cio_commandline.h
\ No newline at end of file
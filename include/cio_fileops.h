@@ -0,0 +1 @@
+../INOUT/cio_fileops.h
\ No newline at end of file
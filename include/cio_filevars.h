@@ -0,0 +1 @@
+../INOUT/cio_filevars.h
\ No newline at end of file
@@ -0,0 +1 @@
+../INOUT/cio_initio.h
\ No newline at end of file
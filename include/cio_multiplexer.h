@@ -0,0 +1 @@
+../INOUT/cio_multiplexer.h
\ No newline at end of file
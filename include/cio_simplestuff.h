@@ -0,0 +1 @@
+../INOUT/cio_simplestuff.h
\ No newline at end of file
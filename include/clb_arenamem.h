@@ -0,0 +1 @@
+../BASICS/clb_arenamem.h
\ No newline at end of file
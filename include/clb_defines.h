@@ -0,0 +1 @@
+../BASICS/clb_defines.h
\ No newline at end of file
@@ -0,0 +1 @@
+../BASICS/clb_dstacks.h
\ No newline at end of file
@@ -0,0 +1 @@
+../BASICS/clb_error.h
\ No newline at end of file
@@ -0,0 +1 @@
+../BASICS/clb_floattrees.h
\ No newline at end of file
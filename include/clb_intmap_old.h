@@ -0,0 +1 @@
+../BASICS/clb_intmap_old.h
\ No newline at end of file
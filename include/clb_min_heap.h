@@ -0,0 +1 @@
+../BASICS/clb_min_heap.h
\ No newline at end of file
@@ -0,0 +1 @@
+../BASICS/clb_numarrtrees.h
\ No newline at end of file
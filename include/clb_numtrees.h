@@ -0,0 +1 @@
+../BASICS/clb_numtrees.h
\ No newline at end of file
@@ -0,0 +1 @@
+../BASICS/clb_numxtrees.h
\ No newline at end of file
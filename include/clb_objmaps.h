@@ -0,0 +1 @@
+../BASICS/clb_objmaps.h
\ No newline at end of file
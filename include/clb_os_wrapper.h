@@ -0,0 +1 @@
+../BASICS/clb_os_wrapper.h
\ No newline at end of file
@@ -0,0 +1 @@
+../BASICS/clb_pdrangearrays.h
\ No newline at end of file
@@ -0,0 +1 @@
+../BASICS/clb_permastrings.h
\ No newline at end of file
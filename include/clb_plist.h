@@ -0,0 +1 @@
+../BASICS/clb_plist.h
\ No newline at end of file
@@ -0,0 +1 @@
+../BASICS/clb_plocalstacks.h
\ No newline at end of file
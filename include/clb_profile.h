@@ -0,0 +1 @@
+../BASICS/clb_profile.h
\ No newline at end of file
@@ -0,0 +1 @@
+../BASICS/clb_properties.h
\ No newline at end of file
@@ -0,0 +1 @@
+../BASICS/clb_pstacks.h
\ No newline at end of file
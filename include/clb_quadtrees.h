@@ -0,0 +1 @@
+../BASICS/clb_quadtrees.h
\ No newline at end of file
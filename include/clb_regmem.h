@@ -0,0 +1 @@
+../BASICS/clb_regmem.h
\ No newline at end of file
@@ -0,0 +1 @@
+../BASICS/clb_simple_stuff.h
\ No newline at end of file
@@ -0,0 +1 @@
+../BASICS/clb_sysdate.h
\ No newline at end of file
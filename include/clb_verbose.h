@@ -0,0 +1 @@
+../BASICS/clb_verbose.h
\ No newline at end of file
@@ -0,0 +1 @@
+../BASICS/clb_workpool.h
\ No newline at end of file
@@ -0,0 +1 @@
+../LEARN/cle_clauseenc.h
\ No newline at end of file
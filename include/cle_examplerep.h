@@ -0,0 +1 @@
+../LEARN/cle_examplerep.h
\ No newline at end of file
@@ -0,0 +1 @@
+../LEARN/cle_flatannoterms.h
\ No newline at end of file
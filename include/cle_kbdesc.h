@@ -0,0 +1 @@
+../LEARN/cle_kbdesc.h
\ No newline at end of file
@@ -0,0 +1 @@
+../LEARN/cle_kbinsert.h
\ No newline at end of file
@@ -0,0 +1 @@
+../LEARN/cle_numfeatures.h
\ No newline at end of file
@@ -0,0 +1 @@
+../LEARN/cle_patterns.h
\ No newline at end of file
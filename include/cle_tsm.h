@@ -0,0 +1 @@
+../LEARN/cle_tsm.h
\ No newline at end of file
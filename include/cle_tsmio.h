@@ -0,0 +1 @@
+../LEARN/cle_tsmio.h
\ No newline at end of file
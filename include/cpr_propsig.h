@@ -0,0 +1 @@
+../PROPOSITIONAL/cpr_propsig.h
\ No newline at end of file
@@ -0,0 +1 @@
+../PROPOSITIONAL/cpr_varset.h
\ No newline at end of file
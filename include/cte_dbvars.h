@@ -0,0 +1 @@
+../TERMS/cte_dbvars.h
\ No newline at end of file
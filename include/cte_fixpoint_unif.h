@@ -0,0 +1 @@
+../TERMS/cte_fixpoint_unif.h
\ No newline at end of file
@@ -0,0 +1 @@
+../TERMS/cte_fp_index.h
\ No newline at end of file
@@ -0,0 +1 @@
+../TERMS/cte_functypes.h
\ No newline at end of file
@@ -0,0 +1 @@
+../TERMS/cte_garbage_coll.h
\ No newline at end of file
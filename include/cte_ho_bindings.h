@@ -0,0 +1 @@
+../TERMS/cte_ho_bindings.h
\ No newline at end of file
@@ -0,0 +1 @@
+../TERMS/cte_ho_csu.h
\ No newline at end of file
@@ -0,0 +1 @@
+../TERMS/cte_idx_fp.h
\ No newline at end of file
@@ -0,0 +1 @@
+../TERMS/cte_lambda.h
\ No newline at end of file
@@ -0,0 +1 @@
+../TERMS/cte_localsubst.h
\ No newline at end of file
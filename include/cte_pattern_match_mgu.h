@@ -0,0 +1 @@
+../TERMS/cte_pattern_match_mgu.h
\ No newline at end of file
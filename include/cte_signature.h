@@ -0,0 +1 @@
+../TERMS/cte_signature.h
\ No newline at end of file
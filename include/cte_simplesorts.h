@@ -0,0 +1 @@
+../TERMS/cte_simplesorts.h
\ No newline at end of file
@@ -0,0 +1 @@
+../TERMS/cte_subst.h
\ No newline at end of file
@@ -0,0 +1 @@
+../TERMS/cte_termcellstore.h
\ No newline at end of file
@@ -0,0 +1 @@
+../TERMS/cte_termweightext.h
\ No newline at end of file
@@ -0,0 +1 @@
+../TERMS/cte_typecheck.h
\ No newline at end of file
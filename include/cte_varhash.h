@@ -0,0 +1 @@
+../TERMS/cte_varhash.h
\ No newline at end of file
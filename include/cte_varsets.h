@@ -0,0 +1 @@
+../TERMS/cte_varsets.h
\ No newline at end of file
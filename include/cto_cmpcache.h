@@ -0,0 +1 @@
+../ORDERINGS/cto_cmpcache.h
\ No newline at end of file
@@ -0,0 +1 @@
+../ORDERINGS/cto_orderings.h
\ No newline at end of file
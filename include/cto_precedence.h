@@ -0,0 +1 @@
+../ORDERINGS/cto_precedence.h
\ No newline at end of file
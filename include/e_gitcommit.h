@@ -0,0 +1 @@
+../PROVER/e_gitcommit.h
\ No newline at end of file
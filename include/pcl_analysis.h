@@ -0,0 +1 @@
+../PCL2/pcl_analysis.h
\ No newline at end of file
@@ -0,0 +1 @@
+../PCL2/pcl_lemmas.h
\ No newline at end of file
@@ -0,0 +1 @@
+../PCL2/pcl_ministeps.h
\ No newline at end of file
@@ -0,0 +1 @@
+../PCL2/pcl_positions.h
\ No newline at end of file
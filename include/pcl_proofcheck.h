@@ -0,0 +1 @@
+../PCL2/pcl_proofcheck.h
\ No newline at end of file
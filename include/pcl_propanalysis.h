@@ -0,0 +1 @@
+../PCL2/pcl_propanalysis.h
\ No newline at end of file
@@ -0,0 +1 @@
+../PCL2/pcl_protocol.h
\ No newline at end of file